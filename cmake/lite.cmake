@@ -43,11 +43,12 @@ function (lite_deps TARGET)
     foreach(var ${lite_deps_ARM_DEPS})
       set(deps ${deps} ${var})
     endforeach(var)
-    if(LITE_WITH_CV)
-      foreach(var ${lite_deps_CV_DEPS})
-        set(deps ${deps} ${var})
-      endforeach(var)
-    endif()
+  endif()
+
+  if(LITE_WITH_CV AND (LITE_WITH_ARM OR LITE_WITH_X86))
+    foreach(var ${lite_deps_CV_DEPS})
+      set(deps ${deps} ${var})
+    endforeach(var)
   endif()
 
   if(LITE_WITH_PROFILE)
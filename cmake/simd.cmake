@@ -11,6 +11,9 @@ if(CMAKE_COMPILER_IS_GNUCC OR CMAKE_COMPILER_IS_GNUCXX OR CMAKE_CXX_COMPILER_ID
     set(AVX_FLAG "-mavx")
     set(AVX2_FLAG "-mavx2")
     set(AVX512F_FLAG "-mavx512f")
+    set(F16C_FLAG "-mf16c")
+    set(FMA_FLAG "-mfma")
+    set(AVX512VNNI_FLAG "-mavx512f -mavx512bw -mavx512vnni")
 elseif(MSVC)
     set(MMX_FLAG "/arch:MMX")
     set(SSE2_FLAG "/arch:SSE2")
@@ -95,5 +98,46 @@ int main()
     return 0;
 }" AVX512F_FOUND)
 
+# Check AVX512 VNNI is supported by the compiler, the kernels using it are
+# picked at runtime so the building machine may not have it.
+if(AVX512VNNI_FLAG)
+    set(CMAKE_REQUIRED_FLAGS ${AVX512VNNI_FLAG})
+    CHECK_CXX_SOURCE_COMPILES("
+#include <immintrin.h>
+int main()
+{
+    __m512i a = _mm512_set1_epi32(1);
+    __m512i result = _mm512_dpbusd_epi32(a, a, a);
+    return _mm512_reduce_add_epi32(result);
+}" AVX512VNNI_FOUND)
+endif()
+
+# Check F16C is supported by the compiler, the conversions using it are picked
+# at runtime as well.
+if(F16C_FLAG)
+    set(CMAKE_REQUIRED_FLAGS ${F16C_FLAG})
+    CHECK_CXX_SOURCE_COMPILES("
+#include <immintrin.h>
+int main()
+{
+    __m256 result = _mm256_cvtph_ps(_mm_set1_epi16(0x3c00));
+    return static_cast<int>(_mm256_cvtss_f32(result));
+}" F16C_FOUND)
+endif()
+
+# Check FMA is supported by the compiler along with AVX2, the kernels using them
+# are picked at runtime too.
+if(FMA_FLAG)
+    set(CMAKE_REQUIRED_FLAGS "${AVX2_FLAG} ${FMA_FLAG}")
+    CHECK_CXX_SOURCE_COMPILES("
+#include <immintrin.h>
+int main()
+{
+    __m256 a = _mm256_set1_ps(1.f);
+    __m256 result = _mm256_fmadd_ps(a, a, a);
+    return static_cast<int>(_mm256_cvtss_f32(result));
+}" FMA_FOUND)
+endif()
+
 set(CMAKE_REQUIRED_FLAGS ${CMAKE_REQUIRED_FLAGS_RETAINED})
-mark_as_advanced(MMX_FOUND SSE2_FOUND SSE3_FOUND AVX_FOUND AVX2_FOUND AVX512F_FOUND)
+mark_as_advanced(MMX_FOUND SSE2_FOUND SSE3_FOUND AVX_FOUND AVX2_FOUND AVX512F_FOUND AVX512VNNI_FOUND F16C_FOUND FMA_FOUND)
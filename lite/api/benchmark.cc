@@ -58,6 +58,11 @@ DEFINE_int32(power_mode,
              "2 for all cores, "
              "3 for no bind");
 DEFINE_int32(threads, 1, "threads num");
+DEFINE_int32(inter_op_threads,
+             1,
+             "threads num to run the independent ops concurrently, "
+             "if it is greater than 1, the serial execution is also "
+             "tested for comparison");
 DEFINE_string(result_filename,
               "result.txt",
               "save benchmark "
@@ -111,10 +116,12 @@ void OutputOptModel(const std::string& save_optimized_model_dir,
 #ifdef LITE_WITH_LIGHT_WEIGHT_FRAMEWORK
 void Run(const std::vector<std::vector<int64_t>>& input_shapes,
          const std::string& model_dir,
-         const std::string model_name) {
+         const std::string model_name,
+         int inter_op_threads) {
   // set config and create predictor
   lite_api::MobileConfig config;
   config.set_threads(FLAGS_threads);
+  config.set_inter_op_threads(inter_op_threads);
   config.set_power_mode(static_cast<PowerMode>(FLAGS_power_mode));
   config.set_model_from_file(model_dir + ".nb");
 
@@ -160,6 +167,7 @@ void Run(const std::vector<std::vector<int64_t>>& input_shapes,
   }
   ofs.precision(5);
   ofs << std::setw(30) << std::fixed << std::left << model_name;
+  ofs << "inter_op_threads = " << std::setw(4) << inter_op_threads;
   ofs << "min = " << std::setw(12) << min_res;
   ofs << "max = " << std::setw(12) << max_res;
   ofs << "average = " << std::setw(12) << avg_res;
@@ -229,7 +237,11 @@ int main(int argc, char** argv) {
   // Run inference using optimized model
   std::string run_model_dir =
       FLAGS_run_model_optimize ? save_optimized_model_dir : FLAGS_model_dir;
-  paddle::lite_api::Run(input_shapes, run_model_dir, model_name);
+  paddle::lite_api::Run(input_shapes, run_model_dir, model_name, 1);
+  if (FLAGS_inter_op_threads > 1) {
+    paddle::lite_api::Run(
+        input_shapes, run_model_dir, model_name, FLAGS_inter_op_threads);
+  }
 #endif
   return 0;
 }
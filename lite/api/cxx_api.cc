@@ -13,31 +13,244 @@
 // limitations under the License.
 
 #include "lite/api/cxx_api.h"
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
 #include <algorithm>
+#include <fstream>
 #include <memory>
 #include <set>
 #include <string>
 #include <utility>
 #include <vector>
+#include "lite/core/version.h"
 #include "lite/utils/io.h"
 
 namespace paddle {
 namespace lite {
 
+namespace {
+
+// Ask the embedding_quantization_pass to quantize the tables of the lookup ops.
+void MarkEmbeddingQuantization(lite_api::PrecisionType precision,
+                               cpp::ProgramDesc *desc) {
+  std::string quant_type;
+  switch (precision) {
+    case lite_api::PrecisionType::kInt8:
+      quant_type = "int8";
+      break;
+    case lite_api::PrecisionType::kFP16:
+      quant_type = "fp16";
+      break;
+    default:
+      LOG(FATAL) << "Unsupported embedding precision: "
+                 << lite_api::PrecisionToStr(precision);
+  }
+  for (size_t i = 0; i < desc->BlocksSize(); ++i) {
+    auto *block = desc->GetBlock<cpp::BlockDesc>(i);
+    for (size_t j = 0; j < block->OpsSize(); ++j) {
+      auto *op = block->GetOp<cpp::OpDesc>(j);
+      if (op->Type() == "lookup_table" || op->Type() == "lookup_table_v2") {
+        op->SetAttr<std::string>("embedding_quant_type", quant_type);
+      }
+    }
+  }
+}
+
+// Ask the weight_half_quantization_pass to store the weights of the fc, mul,
+// matmul and conv ops in 16 bits.
+void MarkWeightQuantization(const std::string &quant_type,
+                            cpp::ProgramDesc *desc) {
+  CHECK(quant_type == "fp16" || quant_type == "bf16")
+      << "Unsupported weight quant type: " << quant_type;
+  const std::set<std::string> weight_ops = {
+      "fc", "mul", "matmul", "conv2d", "depthwise_conv2d"};
+  for (size_t i = 0; i < desc->BlocksSize(); ++i) {
+    auto *block = desc->GetBlock<cpp::BlockDesc>(i);
+    for (size_t j = 0; j < block->OpsSize(); ++j) {
+      auto *op = block->GetOp<cpp::OpDesc>(j);
+      if (weight_ops.count(op->Type())) {
+        op->SetAttr<std::string>("weight_quant_type", quant_type);
+      }
+    }
+  }
+}
+
+// FNV-1a over 8 bytes words, cheap enough to hash the params at every start.
+class Fingerprint {
+ public:
+  void Update(const char *data, size_t size) {
+    size_t i = 0;
+    for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+      uint64_t word;
+      memcpy(&word, data + i, sizeof(uint64_t));
+      Mix(word);
+    }
+    for (; i < size; i++) {
+      Mix(static_cast<uint8_t>(data[i]));
+    }
+    Mix(size);
+  }
+  void Update(const std::string &str) { Update(str.data(), str.size()); }
+  void UpdateFile(const std::string &path) {
+    std::ifstream file(path, std::ios::binary);
+    CHECK(file.is_open()) << "Open file: [" << path << "] failed.";
+    std::vector<char> buffer(1 << 20);
+    size_t size = 0;
+    while (file) {
+      file.read(buffer.data(), buffer.size());
+      Update(buffer.data(), file.gcount());
+      size += file.gcount();
+    }
+    Mix(size);
+  }
+  std::string Hex() const { return string_format("%016" PRIx64, hash_); }
+
+ private:
+  void Mix(uint64_t word) {
+    hash_ ^= word;
+    hash_ *= 1099511628211ULL;
+  }
+
+  uint64_t hash_{14695981039346656037ULL};
+};
+
+// The regular files of `dir` by name, a cache dir inside it is not included.
+std::vector<std::string> ListFiles(const std::string &dir) {
+  std::vector<std::string> files;
+  DIR *dir_fd = opendir(dir.c_str());
+  CHECK(dir_fd) << "[" << dir << "] is not a valid dir path.";
+  dirent *dp;
+  while ((dp = readdir(dir_fd)) != nullptr) {
+    std::string path = dir + "/" + dp->d_name;
+    struct stat info;
+    if (stat(path.c_str(), &info) == 0 && S_ISREG(info.st_mode)) {
+      files.push_back(dp->d_name);
+    }
+  }
+  closedir(dir_fd);
+  std::sort(files.begin(), files.end());
+  return files;
+}
+
+// The model name and the features of the CPU in /proc/cpuinfo, the kernels
+// picked depend on them.
+std::string CpuSignature() {
+  std::ifstream cpuinfo("/proc/cpuinfo");
+  std::string line;
+  std::string model = "unknown";
+  std::string features;
+  while (std::getline(cpuinfo, line)) {
+    auto pos = line.find(':');
+    if (pos == std::string::npos) continue;
+    if (line.compare(0, 10, "model name") == 0 ||
+        line.compare(0, 8, "Hardware") == 0) {
+      model = line.substr(pos + 1);
+    } else if (line.compare(0, 5, "flags") == 0 ||
+               line.compare(0, 8, "Features") == 0) {
+      features = line.substr(pos + 1);
+    }
+  }
+  return model + "\n" + features;
+}
+
+// The name of the cached program of a build, anything changing the optimized
+// program changes it: the model and params, the places, the passes, the
+// options of the passes, the CPU and the version of the library.
+std::string ProgramCacheKey(const lite_api::CxxConfig &config,
+                            const std::vector<Place> &valid_places,
+                            const std::vector<std::string> &passes,
+                            lite_api::LiteModelType model_type) {
+  Fingerprint fingerprint;
+  fingerprint.Update(version());
+  fingerprint.Update(CpuSignature());
+  fingerprint.Update(std::to_string(static_cast<int>(model_type)));
+  if (config.model_from_memory()) {
+    fingerprint.Update(config.model_file());
+    fingerprint.Update(config.param_file());
+  } else if (!config.model_file().empty() && !config.param_file().empty()) {
+    fingerprint.UpdateFile(config.model_file());
+    fingerprint.UpdateFile(config.param_file());
+  } else if (IsDir(config.model_dir())) {
+    for (auto &name : ListFiles(config.model_dir())) {
+      fingerprint.Update(name);
+      fingerprint.UpdateFile(config.model_dir() + "/" + name);
+    }
+  } else {
+    fingerprint.UpdateFile(config.model_dir());
+  }
+  for (auto &place : valid_places) {
+    fingerprint.Update(place.DebugString());
+  }
+  for (auto &pass : passes) {
+    fingerprint.Update(pass);
+  }
+  fingerprint.Update(lite_api::PrecisionToStr(config.embedding_precision()));
+  fingerprint.Update(config.weight_quant_type());
+  fingerprint.Update(config.kernel_tune() ? "tune" : "");
+  return fingerprint.Hex();
+}
+
+}  // namespace
+
+void Predictor::LoadProgramCache(const std::string &path) {
+  LoadModelNaiveFromFile(path, scope_.get(), &program_desc_);
+  program_.reset(new RuntimeProgram(program_desc_, scope_));
+  program_->set_inter_op_threads(inter_op_threads_);
+  program_->set_tracing(profiling_);
+  exec_scope_ = program_->exec_scope();
+  program_generated_ = true;
+  PrepareFeedFetch();
+}
+
+void Predictor::SaveProgramCache(const std::string &dir,
+                                 const std::string &path) {
+  MkDirRecur(dir);
+  if (!IsDir(dir)) {
+    LOG(WARNING) << "The program cache dir " << dir << " is not available.";
+    return;
+  }
+  if (!program_generated_) {
+    GenRuntimeProgram();
+  }
+  // Renamed into place when complete, so the processes starting concurrently
+  // never load a partial file.
+  const std::string tmp_path = path + "." + std::to_string(getpid());
+  // Only read by this version, so the params are aligned for the mmap loading.
+  SaveModelNaive(
+      tmp_path, *program_->exec_scope(), OptimizedProgramDesc(), true, true);
+  if (rename((tmp_path + ".nb").c_str(), path.c_str()) != 0) {
+    LOG(WARNING) << "Failed to cache the optimized program in " << path;
+    remove((tmp_path + ".nb").c_str());
+  }
+}
+
+cpp::ProgramDesc Predictor::OptimizedProgramDesc() const {
+  CHECK(program_);
+  cpp::ProgramDesc desc = program_desc_;
+  program_->SaveOpInfosToProgram(&desc);
+  program_->UpdateVarsOfProgram(&desc);
+  return desc;
+}
+
 void Predictor::SaveModel(const std::string &dir,
                           lite_api::LiteModelType model_type,
                           bool record_info) {
   if (!program_) {
     GenRuntimeProgram();
   }
-  program_->SaveOpInfosToProgram(&program_desc_);
-  program_->UpdateVarsOfProgram(&program_desc_);
+  const cpp::ProgramDesc optimized_desc = OptimizedProgramDesc();
   switch (model_type) {
     case lite_api::LiteModelType::kProtobuf:
-      SaveModelPb(dir, *program_->exec_scope(), program_desc_, true);
+      SaveModelPb(dir, *program_->exec_scope(), optimized_desc, true);
       break;
     case lite_api::LiteModelType::kNaiveBuffer:
-      SaveModelNaive(dir, *program_->exec_scope(), program_desc_);
+      SaveModelNaive(dir,
+                     *program_->exec_scope(),
+                     optimized_desc,
+                     true,
+                     aligned_naive_buffer_);
       break;
     default:
       LOG(FATAL) << "Unknown model type";
@@ -244,7 +457,24 @@ void Predictor::Build(const lite_api::CxxConfig &config,
   } else {
     LOG(INFO) << "Load model from file.";
   }
-
+  embedding_precision_ = config.embedding_precision();
+  weight_quant_type_ = config.weight_quant_type();
+  aligned_naive_buffer_ = config.aligned_naive_buffer();
+  optimizer_.set_kernel_tune(config.kernel_tune(),
+                             config.kernel_tune_cache_file());
+
+  const std::string &cache_dir = config.program_cache_dir();
+  std::string cache_path;
+  if (!cache_dir.empty()) {
+    cache_path =
+        cache_dir + "/" +
+        ProgramCacheKey(config, valid_places, passes, model_type) + ".nb";
+    if (IsFileExists(cache_path)) {
+      LOG(INFO) << "Load the optimized program from " << cache_path;
+      LoadProgramCache(cache_path);
+      return;
+    }
+  }
   Build(model_path,
         model_file,
         param_file,
@@ -252,6 +482,9 @@ void Predictor::Build(const lite_api::CxxConfig &config,
         passes,
         model_type,
         model_from_memory);
+  if (!cache_path.empty()) {
+    SaveProgramCache(cache_dir, cache_path);
+  }
 }
 void Predictor::Build(const std::string &model_path,
                       const std::string &model_file,
@@ -294,7 +527,24 @@ void Predictor::Build(const cpp::ProgramDesc &desc,
   inner_places.emplace_back(TARGET(kHost), PRECISION(kAny), DATALAYOUT(kAny));
   inner_places.emplace_back(
       TARGET(kHost), PRECISION(kFloat), DATALAYOUT(kNCHW));
-  Program program(desc, scope_, inner_places);
+  // Only the X86 lookup kernels read the quantized tables, the
+  // embedding_quantization_pass is bound to kX86 as well.
+  bool with_x86 = std::any_of(
+      valid_places.begin(), valid_places.end(), [](const Place &place) {
+        return place.target == TARGET(kX86);
+      });
+  if (embedding_precision_ != lite_api::PrecisionType::kFloat) {
+    if (with_x86) {
+      MarkEmbeddingQuantization(embedding_precision_, &program_desc_);
+    } else {
+      LOG(WARNING) << "The embedding precision is only supported by the X86 "
+                      "kernels, keep the tables in float.";
+    }
+  }
+  if (!weight_quant_type_.empty()) {
+    MarkWeightQuantization(weight_quant_type_, &program_desc_);
+  }
+  Program program(program_desc_, scope_, inner_places);
 
   core::KernelPickFactor factor;
   factor.ConsiderTarget();
@@ -306,12 +556,66 @@ void Predictor::Build(const cpp::ProgramDesc &desc,
   PrepareFeedFetch();
 }
 
+void Predictor::Build(const Predictor &source) {
+  CHECK(source.program_);
+  scope_ = source.scope_;
+  // The ops of the clone refer to the blocks of the desc it's built from, so
+  // it's kept as the program desc of the clone.
+  program_desc_ = source.OptimizedProgramDesc();
+  program_.reset(new RuntimeProgram(program_desc_, scope_));
+  program_->ShareWeightsFrom(*source.program_);
+  program_->set_inter_op_threads(inter_op_threads_);
+  program_->set_tracing(profiling_);
+  exec_scope_ = program_->exec_scope();
+  own_exec_scope_ = true;
+  program_generated_ = true;
+  input_names_ = source.input_names_;
+  output_names_ = source.output_names_;
+}
+
+Predictor::~Predictor() {
+  // The root scope may be shared with the clones and outlive this predictor.
+  if (own_exec_scope_) {
+    program_.reset();
+    scope_->DeleteScope(exec_scope_);
+  }
+}
+
 void Predictor::GenRuntimeProgram() {
   program_ = optimizer_.GenRuntimeProgram();
   CHECK_EQ(exec_scope_, program_->exec_scope());
+  program_->set_inter_op_threads(inter_op_threads_);
+  program_->set_tracing(profiling_);
   program_generated_ = true;
 }
 
+void Predictor::set_inter_op_threads(int threads) {
+  inter_op_threads_ = threads;
+  if (program_generated_) {
+    program_->set_inter_op_threads(threads);
+  }
+}
+
+void Predictor::BindOutput(size_t offset,
+                           void *data,
+                           size_t memory_size,
+                           TargetType target) {
+  CHECK(output_names_.size() > offset)
+      << "The network has " << output_names_.size() << " outputs"
+      << ", the offset should be less than this.";
+  if (!program_generated_) {
+    GenRuntimeProgram();
+  }
+  program_->BindOutput(output_names_.at(offset), data, memory_size, target);
+}
+
+void Predictor::set_profiling(bool enabled) {
+  profiling_ = enabled;
+  if (program_generated_) {
+    program_->set_tracing(enabled);
+  }
+}
+
 const lite::Tensor *Predictor::GetTensor(const std::string &name) const {
   auto *var = exec_scope_->FindVar(name);
   return &var->Get<lite::Tensor>();
@@ -67,8 +67,26 @@ class LITE_API Predictor {
              const std::vector<Place>& valid_places,
              const std::vector<std::string>& passes = {});
 
+  // Build from the optimized program of `source` without optimizing it again.
+  // The weights are shared with `source`, including the ones transformed by
+  // the kernels if `source` has run, the exec scope and the activations are
+  // private.
+  void Build(const Predictor& source);
+
+  ~Predictor();
+
   void GenRuntimeProgram();
 
+  // Set the number of threads to run the independent instructions.
+  void set_inter_op_threads(int threads);
+
+  // Record the runs of the instructions, see RuntimeProgram::set_tracing.
+  void set_profiling(bool enabled);
+  // The records, nullptr if the profiling has never been enabled.
+  const profile::Tracer* tracer() const {
+    return program_generated_ ? program_->tracer() : nullptr;
+  }
+
   // Run the predictor for a single batch of data.
   void Run() {
     if (!program_generated_) {
@@ -88,6 +106,12 @@ class LITE_API Predictor {
 
   // Get offset-th col of fetch results.
   const lite::Tensor* GetOutput(size_t offset) const;
+  // Bind the caller owned `data` to the offset-th output, see
+  // RuntimeProgram::BindOutput.
+  void BindOutput(size_t offset,
+                  void* data,
+                  size_t memory_size,
+                  TargetType target);
   std::vector<const lite::Tensor*> GetOutputs() const;
 
   const cpp::ProgramDesc& program_desc() const;
@@ -111,12 +135,32 @@ class LITE_API Predictor {
 #endif
 
  private:
+  // Build from the optimized program cached in the file `path`, see
+  // `CxxConfig::set_program_cache_dir`.
+  void LoadProgramCache(const std::string& path);
+  // Cache the optimized program in the file `path` of `dir`.
+  void SaveProgramCache(const std::string& dir, const std::string& path);
+  // The desc of the runtime program as saved, built upon `program_desc_`,
+  // which is left untouched since the ops may refer to its blocks.
+  cpp::ProgramDesc OptimizedProgramDesc() const;
+
   Optimizer optimizer_;
   cpp::ProgramDesc program_desc_;
   std::shared_ptr<Scope> scope_;
   const Scope* exec_scope_;
   std::unique_ptr<RuntimeProgram> program_;
   bool program_generated_{false};
+  // Whether the exec scope is created for a clone, which is deleted with it.
+  bool own_exec_scope_{false};
+  int inter_op_threads_{1};
+  bool profiling_{false};
+  // The precision the embedding tables are quantized to, see
+  // `CxxConfig::set_embedding_precision`.
+  lite_api::PrecisionType embedding_precision_{lite_api::PrecisionType::kFloat};
+  // See `CxxConfig::set_weight_quant_type`.
+  std::string weight_quant_type_;
+  // See `CxxConfig::set_aligned_naive_buffer`.
+  bool aligned_naive_buffer_{false};
   std::vector<std::string> input_names_;
   std::vector<std::string> output_names_;
 };
@@ -154,6 +198,15 @@ class CxxPaddleApiImpl : public lite_api::PaddlePredictor {
       lite_api::LiteModelType model_type = lite_api::LiteModelType::kProtobuf,
       bool record_info = false) override;
 
+  void BindOutput(int i,
+                  void* data,
+                  size_t memory_size,
+                  TargetType type = TargetType::kHost) override;
+
+  void EnableProfiling(bool enabled) override;
+  std::string GetProfilingSummary() const override;
+  bool SaveProfilingTrace(const std::string& path) const override;
+
  private:
   Predictor raw_predictor_;
   lite_api::CxxConfig config_;
@@ -20,6 +20,9 @@
 #include "lite/core/device_info.h"
 #include "lite/core/version.h"
 
+#ifdef LITE_WITH_X86
+#include "lite/backends/x86/parallel.h"
+#endif
 #if (defined LITE_WITH_X86) && (defined PADDLE_WITH_MKLML) && \
     !(defined LITE_ON_MODEL_OPTIMIZE_TOOL)
 #include <omp.h>
@@ -56,6 +59,12 @@ void CxxPaddleApiImpl::Init(const lite_api::CxxConfig &config) {
              "number of threads is:"
           << num_threads;
 #endif
+#ifdef LITE_WITH_X86
+  lite::x86::SetParallelForThreads(threads_);
+#endif
+  // NOTE: after setting the math library threads, the inter-op workers
+  // inherit the number of threads of the current one.
+  raw_predictor_.set_inter_op_threads(config.inter_op_threads());
 }
 
 std::unique_ptr<lite_api::Tensor> CxxPaddleApiImpl::GetInput(int i) {
@@ -80,6 +89,11 @@ std::vector<std::string> CxxPaddleApiImpl::GetOutputNames() {
 void CxxPaddleApiImpl::Run() {
 #ifdef LITE_WITH_ARM
   lite::DeviceInfo::Global().SetRunMode(mode_, threads_);
+#endif
+#ifdef LITE_WITH_X86
+  // The pool of RunParallelFor is owned by the current thread, size it for
+  // this predictor.
+  lite::x86::SetParallelForThreads(threads_);
 #endif
   raw_predictor_.Run();
 }
@@ -87,7 +101,11 @@ void CxxPaddleApiImpl::Run() {
 std::shared_ptr<lite_api::PaddlePredictor> CxxPaddleApiImpl::Clone() {
   std::lock_guard<std::mutex> lock(mutex_);
   auto predictor = std::make_shared<lite::CxxPaddleApiImpl>();
-  predictor->Init(config_);
+  predictor->config_ = config_;
+  predictor->mode_ = mode_;
+  predictor->threads_ = threads_;
+  predictor->raw_predictor_.Build(raw_predictor_);
+  predictor->raw_predictor_.set_inter_op_threads(config_.inter_op_threads());
   return predictor;
 }
 
@@ -111,6 +129,31 @@ void CxxPaddleApiImpl::SaveOptimizedModel(const std::string &model_dir,
   raw_predictor_.SaveModel(model_dir, model_type, record_info);
 }
 
+void CxxPaddleApiImpl::BindOutput(int i,
+                                  void *data,
+                                  size_t memory_size,
+                                  TargetType type) {
+  raw_predictor_.BindOutput(i, data, memory_size, type);
+}
+
+void CxxPaddleApiImpl::EnableProfiling(bool enabled) {
+  raw_predictor_.set_profiling(enabled);
+}
+
+std::string CxxPaddleApiImpl::GetProfilingSummary() const {
+  const auto *tracer = raw_predictor_.tracer();
+  return tracer ? tracer->Summary() : "";
+}
+
+bool CxxPaddleApiImpl::SaveProfilingTrace(const std::string &path) const {
+  const auto *tracer = raw_predictor_.tracer();
+  if (!tracer) {
+    LOG(WARNING) << "Nothing is profiled, please EnableProfiling and Run first.";
+    return false;
+  }
+  return tracer->SaveChromeTrace(path);
+}
+
 }  // namespace lite
 
 namespace lite_api {
@@ -13,8 +13,13 @@
 // limitations under the License.
 
 #include "lite/api/cxx_api.h"
+#include <dirent.h>
+#include <algorithm>
 #include <gflags/gflags.h>
 #include <gtest/gtest.h>
+#include <map>
+#include <memory>
+#include <string>
 #include <vector>
 #include "lite/api/lite_api_test_helper.h"
 #include "lite/api/paddle_use_kernels.h"
@@ -22,6 +27,8 @@
 #include "lite/api/paddle_use_passes.h"
 #include "lite/core/op_registry.h"
 #include "lite/core/tensor.h"
+#include "lite/model_parser/model_parser.h"
+#include "lite/utils/string.h"
 
 // For training.
 DEFINE_string(startup_program_path, "", "");
@@ -53,6 +60,239 @@ TEST(CXXApi, save_model) {
                       lite_api::LiteModelType::kNaiveBuffer);
 }
 
+// The cached programs, i.e. the naive buffer files, in `dir`.
+std::vector<std::string> CachedPrograms(const std::string& dir) {
+  std::vector<std::string> files;
+  DIR* dir_fd = opendir(dir.c_str());
+  if (dir_fd == nullptr) return files;
+  while (dirent* dp = readdir(dir_fd)) {
+    std::string name(dp->d_name);
+    if (name.size() > 3 && name.substr(name.size() - 3) == ".nb") {
+      files.push_back(name);
+    }
+  }
+  closedir(dir_fd);
+  return files;
+}
+
+// Check the sub blocks of the subgraph ops of a saved program, and return the
+// number of the subgraph ops.
+int CheckSubgraphOps(const cpp::ProgramDesc& desc) {
+  auto& program = const_cast<cpp::ProgramDesc&>(desc);
+  auto* main_block = program.GetBlock<cpp::BlockDesc>(0);
+  int subgraph_ops = 0;
+  for (size_t i = 0; i < main_block->OpsSize(); i++) {
+    auto* op = main_block->GetOp<cpp::OpDesc>(i);
+    if (op->Type() != "subgraph") continue;
+    int sub_block_idx = op->GetAttr<int32_t>("sub_block");
+    EXPECT_GT(sub_block_idx, 0);
+    int blocks = static_cast<int>(program.BlocksSize());
+    EXPECT_LT(sub_block_idx, blocks);
+    if (sub_block_idx > 0 && sub_block_idx < blocks) {
+      EXPECT_GT(program.GetBlock<cpp::BlockDesc>(sub_block_idx)->OpsSize(), 0);
+    }
+    subgraph_ops++;
+  }
+  return subgraph_ops;
+}
+
+// Run `predictor` on an input of `input_shape` and return the output.
+std::vector<float> RunPredictor(Predictor* predictor,
+                                const std::vector<int64_t>& input_shape) {
+  auto* input_tensor = predictor->GetInput(0);
+  input_tensor->Resize(input_shape);
+  auto* data = input_tensor->mutable_data<float>();
+  for (int j = 0; j < input_tensor->numel(); j++) {
+    data[j] = (j % 100) * 0.02f - 1.f;
+  }
+  predictor->Run();
+  const auto* out = predictor->GetOutput(0);
+  return std::vector<float>(out->data<float>(),
+                            out->data<float>() + out->numel());
+}
+
+// Build the model of `config` twice with an empty program cache. The first
+// build optimizes the model and caches the program, the second one loads the
+// cached program, both of them have to compute the same outputs. Return the
+// number of the subgraph ops of the optimized program.
+int TestProgramCache(lite_api::CxxConfig config,
+                     lite_api::LiteModelType model_type,
+                     const std::vector<int64_t>& input_shape) {
+  const std::string cache_dir = FLAGS_optimized_model + ".cache";
+  // Start without the programs cached by the previous runs.
+  int ret = system(string_format("rm -rf %s", cache_dir.c_str()).c_str());
+  EXPECT_EQ(ret, 0) << "Failed to delete " << cache_dir;
+  EXPECT_TRUE(CachedPrograms(cache_dir).empty());
+
+  config.set_program_cache_dir(cache_dir);
+  std::vector<Place> valid_places({Place{TARGET(kX86), PRECISION(kFloat)}});
+  std::vector<std::vector<float>> outputs;
+  std::string cached_program;
+  int subgraph_ops = 0;
+  for (int i = 0; i < 2; i++) {
+    lite::Predictor predictor;
+    predictor.Build(config, valid_places, {}, model_type);
+    auto cached = CachedPrograms(cache_dir);
+    EXPECT_EQ(cached.size(), 1u) << "after the build " << i;
+    if (cached.empty()) break;
+    if (i == 0) {
+      cached_program = cached[0];
+    } else {
+      EXPECT_EQ(cached[0], cached_program);
+    }
+    outputs.push_back(RunPredictor(&predictor, input_shape));
+    if (i == 0) {
+      // Caching the program leaves the runtime program intact, so it still
+      // runs and saves a valid model.
+      const std::string saved_model = FLAGS_optimized_model + ".after_cache";
+      predictor.SaveModel(saved_model, lite_api::LiteModelType::kNaiveBuffer);
+      Scope scope;
+      cpp::ProgramDesc saved_desc;
+      LoadModelNaiveFromFile(saved_model + ".nb", &scope, &saved_desc);
+      subgraph_ops = CheckSubgraphOps(saved_desc);
+      EXPECT_EQ(RunPredictor(&predictor, input_shape), outputs[0]);
+    }
+  }
+  EXPECT_EQ(outputs.size(), 2u);
+  if (outputs.size() == 2) {
+    EXPECT_EQ(outputs[0], outputs[1]);
+  }
+  return subgraph_ops;
+}
+
+// Save a naive buffer model of x + y -> relu -> square, whose ops are fused
+// into a subgraph op by the x86_subgraph_pass, and return its path. The square
+// is followed by a concat of it alone, whose output shares the buffer of its
+// input, if `concat_output`.
+std::string SaveElementwiseChainModel(const std::string& model_dir,
+                                      bool concat_output = false) {
+  cpp::ProgramDesc desc;
+  auto* block = desc.AddBlock<cpp::BlockDesc>();
+  Scope scope;
+  auto add_var = [&](const std::string& name,
+                     VarDescAPI::Type type,
+                     bool persistable) {
+    auto* var = block->AddVar<cpp::VarDesc>();
+    var->SetName(name);
+    var->SetType(type);
+    var->SetPersistable(persistable);
+  };
+  add_var("feed", VarDescAPI::Type::FEED_MINIBATCH, true);
+  add_var("fetch", VarDescAPI::Type::FETCH_LIST, true);
+  for (auto name : {"x", "add_out", "relu_out", "square_out"}) {
+    add_var(name, VarDescAPI::Type::LOD_TENSOR, false);
+  }
+  add_var("y", VarDescAPI::Type::LOD_TENSOR, true);
+  auto* y = scope.Var("y")->GetMutable<Tensor>();
+  y->Resize({8});
+  auto* y_data = y->mutable_data<float>();
+  for (int i = 0; i < 8; i++) {
+    y_data[i] = i * 0.1f - 0.3f;
+  }
+
+  auto add_op = [&](const std::string& type,
+                    const std::map<std::string, std::string>& inputs,
+                    const std::string& output) {
+    auto* op = block->AddOp<cpp::OpDesc>();
+    op->SetType(type);
+    for (auto& input : inputs) {
+      op->SetInput(input.first, {input.second});
+    }
+    op->SetOutput("Out", {output});
+    return op;
+  };
+  add_op("feed", {{"X", "feed"}}, "x")->SetAttr<int>("col", 0);
+  add_op("elementwise_add", {{"X", "x"}, {"Y", "y"}}, "add_out")
+      ->SetAttr<int>("axis", -1);
+  add_op("relu", {{"X", "add_out"}}, "relu_out");
+  add_op("square", {{"X", "relu_out"}}, "square_out");
+  std::string output = "square_out";
+  if (concat_output) {
+    add_var("concat_out", VarDescAPI::Type::LOD_TENSOR, false);
+    add_op("concat", {{"X", output}}, "concat_out")->SetAttr<int>("axis", 0);
+    output = "concat_out";
+  }
+  add_op("fetch", {{"X", output}}, "fetch")->SetAttr<int>("col", 0);
+  SaveModelNaive(model_dir, scope, desc);
+  return model_dir + ".nb";
+}
+
+TEST(CXXApi, program_cache) {
+  lite_api::CxxConfig config;
+  config.set_model_dir(FLAGS_model_dir);
+  TestProgramCache(config, lite_api::LiteModelType::kProtobuf, {100, 100});
+
+  // The ops of this model are fused into a subgraph op, whose sub block has to
+  // outlive the caching and saving of the program.
+  lite_api::CxxConfig chain_config;
+  chain_config.set_model_dir(
+      SaveElementwiseChainModel(FLAGS_optimized_model + ".chain"));
+  EXPECT_GT(TestProgramCache(
+                chain_config, lite_api::LiteModelType::kNaiveBuffer, {4, 8}),
+            0);
+}
+
+TEST(CXXApi, clone) {
+  lite_api::CxxConfig config;
+  config.set_model_dir(
+      SaveElementwiseChainModel(FLAGS_optimized_model + ".chain"));
+  std::vector<Place> valid_places({Place{TARGET(kX86), PRECISION(kFloat)}});
+  std::unique_ptr<Predictor> source(new Predictor);
+  source->Build(
+      config, valid_places, {}, lite_api::LiteModelType::kNaiveBuffer);
+  auto expected = RunPredictor(source.get(), {4, 8});
+
+  Predictor clone;
+  clone.Build(*source);
+  // The subgraph ops of the source still run on their own sub blocks.
+  EXPECT_EQ(RunPredictor(source.get(), {4, 8}), expected);
+  EXPECT_GT(CheckSubgraphOps(clone.program_desc()), 0);
+  // The clone runs on the desc it keeps, not on the one of the source.
+  source.reset();
+  EXPECT_EQ(RunPredictor(&clone, {4, 8}), expected);
+}
+
+TEST(CXXApi, bind_output) {
+  std::vector<Place> valid_places({Place{TARGET(kX86), PRECISION(kFloat)}});
+  const std::vector<int64_t> shape({4, 8});
+  const size_t size = 4 * 8 * sizeof(float);
+  float* buffer = static_cast<float*>(TargetMalloc(TARGET(kHost), size));
+  // The square is written into the bound buffer in place, while the output of
+  // the concat shares the buffer of the square and is copied after the run.
+  for (bool concat_output : {false, true}) {
+    lite_api::CxxConfig config;
+    config.set_model_dir(SaveElementwiseChainModel(
+        FLAGS_optimized_model + ".bind", concat_output));
+    Predictor predictor;
+    predictor.Build(
+        config, valid_places, {}, lite_api::LiteModelType::kNaiveBuffer);
+    auto expected = RunPredictor(&predictor, shape);
+
+    predictor.BindOutput(0, buffer, size, TARGET(kHost));
+    for (int i = 0; i < 2; i++) {
+      std::fill_n(buffer, 4 * 8, 0.f);
+      EXPECT_EQ(RunPredictor(&predictor, shape), expected);
+      EXPECT_EQ(predictor.GetOutput(0)->raw_data(), buffer);
+      EXPECT_EQ(std::vector<float>(buffer, buffer + 4 * 8), expected);
+      EXPECT_EQ(predictor.GetTensor("square_out")->raw_data() == buffer,
+                !concat_output);
+    }
+
+    // The output needs more bytes than bound.
+    predictor.BindOutput(0, buffer, size - sizeof(float), TARGET(kHost));
+    EXPECT_DEATH(predictor.Run(), "bytes bound");
+
+    // The unbound buffer is left untouched.
+    predictor.BindOutput(0, nullptr, 0, TARGET(kHost));
+    std::fill_n(buffer, 4 * 8, 0.f);
+    EXPECT_EQ(RunPredictor(&predictor, shape), expected);
+    EXPECT_NE(predictor.GetOutput(0)->raw_data(), buffer);
+    EXPECT_EQ(std::vector<float>(buffer, buffer + 4 * 8),
+              std::vector<float>(4 * 8, 0.f));
+  }
+  TargetFree(TARGET(kHost), buffer);
+}
+
 /*TEST(CXXTrainer, train) {
   Place place({TARGET(kHost), PRECISION(kFloat), DATALAYOUT(kNCHW)});
   std::vector<Place> valid_places({place});
@@ -19,11 +19,13 @@ namespace paddle {
 namespace lite {
 
 void LightPredictor::Build(const std::string& lite_model_file,
-                           bool model_from_memory) {
+                           bool model_from_memory,
+                           bool use_mmap) {
   if (model_from_memory) {
     LoadModelNaiveFromMemory(lite_model_file, scope_.get(), &cpp_program_desc_);
   } else {
-    LoadModelNaiveFromFile(lite_model_file, scope_.get(), &cpp_program_desc_);
+    LoadModelNaiveFromFile(
+        lite_model_file, scope_.get(), &cpp_program_desc_, use_mmap);
   }
 
   DequantizeWeight();
@@ -95,6 +97,17 @@ const Tensor* LightPredictor::GetOutput(size_t offset) {
                  << " in exec_scope";
   return out_var->GetMutable<lite::Tensor>();
 }
+
+void LightPredictor::BindOutput(size_t offset,
+                                void* data,
+                                size_t memory_size,
+                                TargetType target) {
+  CHECK(output_names_.size() > offset)
+      << "The network has " << output_names_.size() << " outputs"
+      << ", the offset should be less than this.";
+  program_->BindOutput(output_names_.at(offset), data, memory_size, target);
+}
+
 // get inputs names
 std::vector<std::string> LightPredictor::GetInputNames() {
   return input_names_;
@@ -129,34 +142,29 @@ void LightPredictor::PrepareFeedFetch() {
 }
 
 void LightPredictor::BuildRuntimeProgram(const cpp::ProgramDesc& prog) {
-  std::vector<Instruction> insts;
-  // 1. Create op first
-  Program program(prog, scope_, {});
-
-  // 2. Create Instructs
-
-  // Create the kernels of the target places, and filter out the specific
-  // kernel with the target alias.
-  for (auto& op : program.ops()) {
-    auto kernel_type = op->op_info()->GetAttr<std::string>(kKernelTypeAttr);
-    std::string op_type, alias;
-    Place place;
-    KernelBase::ParseKernelType(kernel_type, &op_type, &alias, &place);
-    auto kernels = op->CreateKernels({place});
-    // filter out a kernel
-    auto it = std::find_if(
-        kernels.begin(), kernels.end(), [&](std::unique_ptr<KernelBase>& it) {
-          return it->alias() == alias;
-        });
-    CHECK(it != kernels.end());
-    (*it)->SetContext(ContextScheduler::Global().NewContext((*it)->target()));
-
-    insts.emplace_back(op, std::move(*it));
-  }
-  program_.reset(new RuntimeProgram(std::move(insts)));
+  program_.reset(new RuntimeProgram(prog, scope_));
+}
 
-  CHECK(program.exec_scope());
-  program_->set_exec_scope(program.exec_scope());
+std::unique_ptr<LightPredictor> LightPredictor::Clone() const {
+  std::unique_ptr<LightPredictor> predictor(new LightPredictor);
+  predictor->scope_ = scope_;
+  predictor->cpp_program_desc_ = cpp_program_desc_;
+  predictor->BuildRuntimeProgram(predictor->cpp_program_desc_);
+  predictor->program_->ShareWeightsFrom(*program_);
+  predictor->program_->set_inter_op_threads(program_->inter_op_threads());
+  predictor->input_names_ = input_names_;
+  predictor->output_names_ = output_names_;
+  return predictor;
+}
+
+LightPredictor::~LightPredictor() {
+  // The exec scope is a kid of the root scope, which may be shared with the
+  // clones and outlive this predictor.
+  if (program_) {
+    Scope* exec_scope = program_->exec_scope();
+    program_.reset();
+    scope_->DeleteScope(exec_scope);
+  }
 }
 
 void LightPredictor::DequantizeWeight() {
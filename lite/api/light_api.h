@@ -42,11 +42,12 @@ class LITE_API LightPredictor {
  public:
   // constructor function of LightPredictor, `lite_model_file` refers to data in
   // model file or buffer,`model_from_memory` refers to whther to load model
-  // from memory.
+  // from memory, `use_mmap` refers to whether to map the model file.
   LightPredictor(const std::string& lite_model_file,
-                 bool model_from_memory = false) {
+                 bool model_from_memory = false,
+                 bool use_mmap = false) {
     scope_ = std::make_shared<Scope>();
-    Build(lite_model_file, model_from_memory);
+    Build(lite_model_file, model_from_memory, use_mmap);
   }
 
   // NOTE: This is a deprecated API and will be removed in latter release.
@@ -60,14 +61,37 @@ class LITE_API LightPredictor {
     Build(model_dir, model_buffer, param_buffer, model_type, model_from_memory);
   }
 
+  ~LightPredictor();
+
   void Run() { program_->Run(); }
 
+  // Create a predictor sharing the weights with this one, including the ones
+  // transformed by the kernels if this one has run. The exec scope and the
+  // activations are private to the new predictor.
+  std::unique_ptr<LightPredictor> Clone() const;
+
+  // Set the number of threads to run the independent instructions.
+  void set_inter_op_threads(int threads) {
+    program_->set_inter_op_threads(threads);
+  }
+
+  // Record the runs of the instructions, see RuntimeProgram::set_tracing.
+  void set_profiling(bool enabled) { program_->set_tracing(enabled); }
+  // The records, nullptr if the profiling has never been enabled.
+  const profile::Tracer* tracer() const { return program_->tracer(); }
+
   // Get offset-th col of feed inputs.
   Tensor* GetInput(size_t offset);
   // get input by name.
   Tensor* GetInputByName(const std::string& name);
   // Get offset-th col of fetch outputs.
   const Tensor* GetOutput(size_t offset);
+  // Bind the caller owned `data` to the offset-th output, see
+  // RuntimeProgram::BindOutput.
+  void BindOutput(size_t offset,
+                  void* data,
+                  size_t memory_size,
+                  TargetType target);
 
   const lite::Tensor* GetTensor(const std::string& name) const {
     auto* var = program_->exec_scope()->FindVar(name);
@@ -81,7 +105,8 @@ class LITE_API LightPredictor {
 
  private:
   void Build(const std::string& lite_model_file,
-             bool model_from_memory = false);
+             bool model_from_memory = false,
+             bool use_mmap = false);
 
   // NOTE: This is a deprecated API and will be removed in latter release.
   void Build(
@@ -95,6 +120,8 @@ class LITE_API LightPredictor {
 
   void DequantizeWeight();
 
+  LightPredictor() = default;
+
  private:
   std::shared_ptr<Scope> scope_;
   std::unique_ptr<RuntimeProgram> program_;
@@ -125,6 +152,15 @@ class LightPredictorImpl : public lite_api::PaddlePredictor {
   std::unique_ptr<lite_api::Tensor> GetInputByName(
       const std::string& name) override;
 
+  void BindOutput(int i,
+                  void* data,
+                  size_t memory_size,
+                  TargetType type = TargetType::kHost) override;
+
+  void EnableProfiling(bool enabled) override;
+  std::string GetProfilingSummary() const override;
+  bool SaveProfilingTrace(const std::string& path) const override;
+
   void Init(const lite_api::MobileConfig& config);
 
  private:
@@ -17,6 +17,9 @@
 #include "lite/api/paddle_api.h"
 #include "lite/core/version.h"
 #include "lite/model_parser/model_parser.h"
+#ifdef LITE_WITH_X86
+#include "lite/backends/x86/parallel.h"
+#endif
 
 namespace paddle {
 namespace lite {
@@ -32,10 +35,15 @@ void LightPredictorImpl::Init(const lite_api::MobileConfig& config) {
                            lite_api::LiteModelType::kNaiveBuffer));
   } else {
     raw_predictor_.reset(new LightPredictor(config.lite_model_file(),
-                                            config.model_from_memory()));
+                                            config.model_from_memory(),
+                                            config.use_mmap()));
   }
   mode_ = config.power_mode();
   threads_ = config.threads();
+#ifdef LITE_WITH_X86
+  lite::x86::SetParallelForThreads(threads_);
+#endif
+  raw_predictor_->set_inter_op_threads(config.inter_op_threads());
 }
 
 std::unique_ptr<lite_api::Tensor> LightPredictorImpl::GetInput(int i) {
@@ -52,12 +60,19 @@ std::unique_ptr<const lite_api::Tensor> LightPredictorImpl::GetOutput(
 void LightPredictorImpl::Run() {
 #ifdef LITE_WITH_ARM
   lite::DeviceInfo::Global().SetRunMode(mode_, threads_);
+#endif
+#ifdef LITE_WITH_X86
+  lite::x86::SetParallelForThreads(threads_);
 #endif
   raw_predictor_->Run();
 }
 
 std::shared_ptr<lite_api::PaddlePredictor> LightPredictorImpl::Clone() {
-  LOG(FATAL) << "The Clone API is not supported in LigthPredictor";
+  auto predictor = std::make_shared<LightPredictorImpl>();
+  predictor->raw_predictor_ = raw_predictor_->Clone();
+  predictor->mode_ = mode_;
+  predictor->threads_ = threads_;
+  return predictor;
 }
 
 std::string LightPredictorImpl::GetVersion() const { return lite::version(); }
@@ -81,6 +96,31 @@ std::vector<std::string> LightPredictorImpl::GetOutputNames() {
   return raw_predictor_->GetOutputNames();
 }
 
+void LightPredictorImpl::BindOutput(int i,
+                                    void* data,
+                                    size_t memory_size,
+                                    TargetType type) {
+  raw_predictor_->BindOutput(i, data, memory_size, type);
+}
+
+void LightPredictorImpl::EnableProfiling(bool enabled) {
+  raw_predictor_->set_profiling(enabled);
+}
+
+std::string LightPredictorImpl::GetProfilingSummary() const {
+  const auto* tracer = raw_predictor_->tracer();
+  return tracer ? tracer->Summary() : "";
+}
+
+bool LightPredictorImpl::SaveProfilingTrace(const std::string& path) const {
+  const auto* tracer = raw_predictor_->tracer();
+  if (!tracer) {
+    LOG(WARNING) << "Nothing is profiled, please EnableProfiling and Run first.";
+    return false;
+  }
+  return tracer->SaveChromeTrace(path);
+}
+
 }  // namespace lite
 
 namespace lite_api {
@@ -68,6 +68,21 @@ DEFINE_string(valid_targets,
               "The targets this model optimized for, should be one of (arm, "
               "opencl, x86), splitted by space");
 DEFINE_bool(prefer_int8_kernel, false, "Prefer to run model with int8 kernels");
+DEFINE_string(weight_quant_type,
+              "",
+              "Store the weights of fc, mul, matmul and conv in 16 bits, "
+              "should be one of (fp16, bf16), only supported by x86");
+DEFINE_bool(kernel_tune,
+            false,
+            "Time the candidate kernels and algorithms of the ops to pick the "
+            "fastest ones on this machine");
+DEFINE_string(kernel_tune_cache,
+              "",
+              "The tuning cache file read and updated by --kernel_tune");
+DEFINE_bool(aligned_naive_buffer,
+            false,
+            "Align the params of the naive buffer model to 64 bytes for the "
+            "zero-copy mmap loading, which the older runtimes can't load");
 DEFINE_bool(print_supported_ops,
             false,
             "Print supported operators on the inputed target");
@@ -143,6 +158,12 @@ void RunOptimize(const std::string& model_dir,
   config.set_model_file(model_file);
   config.set_param_file(param_file);
   config.set_valid_places(valid_places);
+  if (!FLAGS_weight_quant_type.empty()) {
+    config.set_weight_quant_type(FLAGS_weight_quant_type);
+  }
+  config.set_kernel_tune(FLAGS_kernel_tune);
+  config.set_kernel_tune_cache_file(FLAGS_kernel_tune_cache);
+  config.set_aligned_naive_buffer(FLAGS_aligned_naive_buffer);
   auto predictor = lite_api::CreatePaddlePredictor(config);
 
   LiteModelType model_type;
@@ -253,6 +274,9 @@ void PrintHelpInfo() {
       "        `--optimize_out=<output_optimize_model_dir>`\n"
       "        `--valid_targets=(arm|opencl|x86|npu|xpu)`\n"
       "        `--prefer_int8_kernel=(true|false)`\n"
+      "        `--weight_quant_type=(fp16|bf16)`\n"
+      "        `--kernel_tune=(true|false)`\n"
+      "        `--kernel_tune_cache=<tuning_cache_file>`\n"
       "        `--record_tailoring_info=(true|false)`\n"
       "  Arguments of model checking and ops information:\n"
       "        `--print_all_ops=true`   Display all the valid operators of "
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "lite/api/paddle_api.h"
+#include <algorithm>
 #include "lite/core/device_info.h"
 #include "lite/core/target_wrapper.h"
 #include "lite/core/tensor.h"
@@ -113,6 +114,47 @@ void Tensor::CopyToCpu(T *data) const {
   }
 }
 
+// The alignment of the memory allocated by TargetMalloc, which the kernels
+// may rely on.
+const size_t kExternalMemoryAlignment = 64;
+
+template <typename T>
+void Tensor::ShareExternalMemory(const T *data,
+                                 size_t memory_size,
+                                 TargetType type,
+                                 std::shared_ptr<void> holder) {
+  auto *x = tensor(raw_tensor_);
+  CHECK(data);
+  CHECK_EQ(reinterpret_cast<uintptr_t>(data) % kExternalMemoryAlignment, 0UL)
+      << "The external memory should be aligned to "
+      << kExternalMemoryAlignment << " bytes";
+  CHECK_GE(memory_size, x->numel() * sizeof(T))
+      << "You should call Resize interface first";
+  if (!holder) {
+    // The predictor never frees the caller's memory.
+    holder.reset(const_cast<T *>(data), [](void *) {});
+  }
+  x->ShareExternalMemory(data, memory_size, type, holder);
+  x->set_precision(lite_api::PrecisionTypeTrait<T>::Type());
+}
+
+template void Tensor::ShareExternalMemory(const float *,
+                                          size_t,
+                                          TargetType,
+                                          std::shared_ptr<void>);
+template void Tensor::ShareExternalMemory(const int8_t *,
+                                          size_t,
+                                          TargetType,
+                                          std::shared_ptr<void>);
+template void Tensor::ShareExternalMemory(const int *,
+                                          size_t,
+                                          TargetType,
+                                          std::shared_ptr<void>);
+template void Tensor::ShareExternalMemory(const int64_t *,
+                                          size_t,
+                                          TargetType,
+                                          std::shared_ptr<void>);
+
 template void Tensor::CopyFromCpu<int, TargetType::kHost>(const int *);
 template void Tensor::CopyFromCpu<float, TargetType::kHost>(const float *);
 template void Tensor::CopyFromCpu<int8_t, TargetType::kHost>(const int8_t *);
@@ -160,6 +202,27 @@ void PaddlePredictor::SaveOptimizedModel(const std::string &model_dir,
       << "The SaveOptimizedModel API is only supported by CxxConfig predictor.";
 }
 
+void PaddlePredictor::BindOutput(int i,
+                                 void *data,
+                                 size_t memory_size,
+                                 TargetType type) {
+  LOG(FATAL) << "The BindOutput API is not supported by this predictor.";
+}
+
+void PaddlePredictor::EnableProfiling(bool enabled) {
+  LOG(FATAL) << "The profiling is not supported by this predictor.";
+}
+
+std::string PaddlePredictor::GetProfilingSummary() const {
+  LOG(FATAL) << "The profiling is not supported by this predictor.";
+  return "";
+}
+
+bool PaddlePredictor::SaveProfilingTrace(const std::string &path) const {
+  LOG(FATAL) << "The profiling is not supported by this predictor.";
+  return false;
+}
+
 template <typename ConfigT>
 std::shared_ptr<PaddlePredictor> CreatePaddlePredictor(const ConfigT &) {
   return std::shared_ptr<PaddlePredictor>();
@@ -171,6 +234,8 @@ ConfigBase::ConfigBase(PowerMode mode, int threads) {
   lite::DeviceInfo::Global().SetRunMode(mode, threads);
   mode_ = lite::DeviceInfo::Global().mode();
   threads_ = lite::DeviceInfo::Global().threads();
+#else
+  threads_ = std::max(threads, 1);
 #endif
 }
 
@@ -187,6 +252,8 @@ void ConfigBase::set_threads(int threads) {
   lite::DeviceInfo::Global().SetRunMode(mode_, threads);
   mode_ = lite::DeviceInfo::Global().mode();
   threads_ = lite::DeviceInfo::Global().threads();
+#else
+  threads_ = std::max(threads, 1);
 #endif
 }
 
@@ -50,6 +50,18 @@ struct LITE_API Tensor {
 
   template <typename T>
   void CopyToCpu(T* data) const;
+
+  /// Use the caller owned `data` of `memory_size` bytes as the data of the
+  /// tensor without copying it, call Resize first. It is for the inputs, the
+  /// predictor only reads `data`, which must stay valid during the runs and be
+  /// aligned to 64 bytes as the memory allocated by the predictor. `holder`,
+  /// if set, is kept until the tensor stops using `data`.
+  template <typename T>
+  void ShareExternalMemory(const T* data,
+                           size_t memory_size,
+                           TargetType type = TargetType::kHost,
+                           std::shared_ptr<void> holder = nullptr);
+
   /// Shape of the tensor.
   shape_t shape() const;
   TargetType target() const;
@@ -101,6 +113,27 @@ class LITE_API PaddlePredictor {
       LiteModelType model_type = LiteModelType::kProtobuf,
       bool record_info = false);
 
+  /// Bind the caller owned `data` of `memory_size` bytes to the i-th output,
+  /// the kernel producing the output writes into `data` directly, and
+  /// GetOutput(i) returns a tensor on it, so no copy is needed to get the
+  /// result. `data` must stay valid until it is unbound by passing nullptr,
+  /// be aligned to 64 bytes and be large enough for the output. This API is
+  /// only supported by CxxConfig and MobileConfig predictors.
+  virtual void BindOutput(int i,
+                          void* data,
+                          size_t memory_size,
+                          TargetType type = TargetType::kHost);
+
+  /// Record the runs of the operators from now on, with their times, threads,
+  /// tensor shapes and estimated FLOPs, or stop recording if `enabled` is
+  /// false. Enabling it drops the former records. It costs nothing when off.
+  virtual void EnableProfiling(bool enabled);
+  /// The calls, times and GFLOPS of the operator types recorded.
+  virtual std::string GetProfilingSummary() const;
+  /// Save the runs recorded as a Chrome trace JSON file, which can be opened
+  /// in chrome://tracing or https://ui.perfetto.dev.
+  virtual bool SaveProfilingTrace(const std::string& path) const;
+
   virtual ~PaddlePredictor() = default;
 
  protected:
@@ -112,6 +145,7 @@ class LITE_API PaddlePredictor {
 class LITE_API ConfigBase {
   std::string model_dir_;
   int threads_{1};
+  int inter_op_threads_{1};
   PowerMode mode_{LITE_POWER_NO_BIND};
 
  public:
@@ -125,6 +159,10 @@ class LITE_API ConfigBase {
   // set Thread
   void set_threads(int threads);
   int threads() const { return threads_; }
+  // set the number of threads running the independent ops concurrently, 1
+  // means running the ops one by one.
+  void set_inter_op_threads(int threads) { inter_op_threads_ = threads; }
+  int inter_op_threads() const { return inter_op_threads_; }
 };
 
 /// CxxConfig is the config for the Full feature predictor.
@@ -133,6 +171,24 @@ class LITE_API CxxConfig : public ConfigBase {
   std::string model_file_;
   std::string param_file_;
   bool model_from_memory_{false};
+  // The precision of the embedding tables of the lookup ops, kInt8 and kFP16
+  // quantize them at build time, only the X86 kernels support it for now.
+  PrecisionType embedding_precision_{PrecisionType::kFloat};
+  // "fp16" or "bf16" to store the weights of fc, mul, matmul and conv in 16
+  // bits at build time, only the X86 kernels support it for now.
+  std::string weight_quant_type_;
+  // Time the candidate kernels and algorithms of the ops at build time to pick
+  // the fastest ones, the winners are recorded in the tuning cache file if set.
+  bool kernel_tune_{false};
+  std::string kernel_tune_cache_file_;
+  // Keep the optimized programs in this dir, keyed by the model, the places,
+  // the CPU and the version, a predictor of the same key loads the program
+  // instead of optimizing the model again.
+  std::string program_cache_dir_;
+  // Save the naive buffer models of meta version 1, whose params are aligned
+  // for the zero-copy MobileConfig::set_use_mmap, but which the runtimes
+  // before it can't load.
+  bool aligned_naive_buffer_{false};
 #ifdef LITE_WITH_X86
   int x86_math_library_math_threads_ = 1;
 #endif
@@ -155,6 +211,35 @@ class LITE_API CxxConfig : public ConfigBase {
   std::string param_file() const { return param_file_; }
   bool model_from_memory() const { return model_from_memory_; }
 
+  void set_embedding_precision(PrecisionType precision) {
+    embedding_precision_ = precision;
+  }
+  PrecisionType embedding_precision() const { return embedding_precision_; }
+
+  void set_weight_quant_type(const std::string& quant_type) {
+    weight_quant_type_ = quant_type;
+  }
+  const std::string& weight_quant_type() const { return weight_quant_type_; }
+
+  void set_kernel_tune(bool enabled) { kernel_tune_ = enabled; }
+  bool kernel_tune() const { return kernel_tune_; }
+  void set_kernel_tune_cache_file(const std::string& path) {
+    kernel_tune_cache_file_ = path;
+  }
+  const std::string& kernel_tune_cache_file() const {
+    return kernel_tune_cache_file_;
+  }
+
+  void set_program_cache_dir(const std::string& dir) {
+    program_cache_dir_ = dir;
+  }
+  const std::string& program_cache_dir() const { return program_cache_dir_; }
+
+  void set_aligned_naive_buffer(bool aligned) {
+    aligned_naive_buffer_ = aligned;
+  }
+  bool aligned_naive_buffer() const { return aligned_naive_buffer_; }
+
 #ifdef LITE_WITH_X86
   void set_x86_math_library_num_threads(int threads) {
     x86_math_library_math_threads_ = threads;
@@ -175,6 +260,10 @@ class LITE_API MobileConfig : public ConfigBase {
   // model data readed from file or memory buffer in combined format.
   std::string lite_model_file_;
 
+  // whether to map the model file into memory instead of reading it, weights
+  // then share the page cache with other processes using the same file.
+  bool use_mmap_{false};
+
   // NOTE: This is a deprecated variable and will be removed in latter release.
   std::string model_buffer_;
   std::string param_buffer_;
@@ -192,6 +281,11 @@ class LITE_API MobileConfig : public ConfigBase {
   // memory buffer.
   bool model_from_memory() const { return model_from_memory_; }
 
+  // map the model set by `set_model_from_file` instead of reading it, only
+  // models saved by an opt of this version are loaded without copy.
+  void set_use_mmap(bool x) { use_mmap_ = x; }
+  bool use_mmap() const { return use_mmap_; }
+
   // NOTE: This is a deprecated API and will be removed in latter release.
   void set_model_buffer(const char* model_buffer,
                         size_t model_buffer_size,
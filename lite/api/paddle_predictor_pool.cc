@@ -0,0 +1,388 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/api/paddle_predictor_pool.h"
+#include <algorithm>
+#include <cstring>
+#include <utility>
+#include "lite/utils/cp_logging.h"
+
+namespace paddle {
+namespace lite_api {
+
+namespace {
+
+template <typename T>
+struct PrecisionOf;
+template <>
+struct PrecisionOf<float> {
+  static constexpr PrecisionType value = PrecisionType::kFloat;
+};
+template <>
+struct PrecisionOf<int8_t> {
+  static constexpr PrecisionType value = PrecisionType::kInt8;
+};
+template <>
+struct PrecisionOf<int32_t> {
+  static constexpr PrecisionType value = PrecisionType::kInt32;
+};
+template <>
+struct PrecisionOf<int64_t> {
+  static constexpr PrecisionType value = PrecisionType::kInt64;
+};
+
+int64_t ShapeProduction(const shape_t& shape) {
+  int64_t res = 1;
+  for (auto i : shape) res *= i;
+  return res;
+}
+
+// Number of rows of a request, it is the unit of `max_batch_size`.
+int64_t RequestRows(const PredictorPool::Request& request) {
+  if (request.empty() || request[0].shape.empty()) return 1;
+  return request[0].shape[0];
+}
+
+// Number of top level sequences of a request, 0 if it is not a sequence.
+int64_t RequestSeqs(const PredictorPool::Request& request) {
+  if (request.empty() || request[0].lod.empty()) return 0;
+  return static_cast<int64_t>(request[0].lod[0].size()) - 1;
+}
+
+void* MutableData(Tensor* tensor, PrecisionType precision) {
+  switch (precision) {
+    case PrecisionType::kFloat:
+      return tensor->mutable_data<float>();
+    case PrecisionType::kInt8:
+      return tensor->mutable_data<int8_t>();
+    case PrecisionType::kInt32:
+      return tensor->mutable_data<int>();
+    case PrecisionType::kInt64:
+      return tensor->mutable_data<int64_t>();
+    default:
+      LOG(FATAL) << "PredictorPool does not support the input precision "
+                 << PrecisionRepr(precision);
+  }
+  return nullptr;
+}
+
+const void* Data(const Tensor& tensor) {
+  switch (tensor.precision()) {
+    case PrecisionType::kFloat:
+      return tensor.data<float>();
+    case PrecisionType::kInt8:
+      return tensor.data<int8_t>();
+    case PrecisionType::kInt32:
+      return tensor.data<int32_t>();
+    case PrecisionType::kInt64:
+      return tensor.data<int64_t>();
+    default:
+      LOG(FATAL) << "PredictorPool does not support the output precision "
+                 << PrecisionRepr(tensor.precision());
+  }
+  return nullptr;
+}
+
+void Feed(PaddlePredictor* predictor, const PredictorPool::Request& inputs) {
+  for (size_t i = 0; i < inputs.size(); i++) {
+    auto tensor = predictor->GetInput(i);
+    tensor->Resize(inputs[i].shape);
+    tensor->SetLoD(inputs[i].lod);
+    std::memcpy(MutableData(tensor.get(), inputs[i].precision),
+                inputs[i].buffer.data(),
+                inputs[i].buffer.size());
+  }
+}
+
+PredictorPool::Response Fetch(PaddlePredictor* predictor) {
+  PredictorPool::Response outputs(predictor->GetOutputNames().size());
+  for (size_t i = 0; i < outputs.size(); i++) {
+    auto tensor = predictor->GetOutput(i);
+    auto& out = outputs[i];
+    out.shape = tensor->shape();
+    out.lod = tensor->lod();
+    out.precision = tensor->precision();
+    auto* data = static_cast<const char*>(Data(*tensor));
+    out.buffer.assign(
+        data, data + out.numel() * PrecisionTypeLength(out.precision));
+  }
+  return outputs;
+}
+
+PredictorPool::Response RunOne(PaddlePredictor* predictor,
+                               const PredictorPool::Request& inputs) {
+  Feed(predictor, inputs);
+  predictor->Run();
+  return Fetch(predictor);
+}
+
+// Concatenate the i-th inputs of the requests along dim 0. The offsets of
+// each LoD level index the items of the next level (or the rows for the last
+// one), so they are shifted by the items of the previous requests.
+PoolTensor ConcatInputs(const std::vector<const PredictorPool::Request*>& reqs,
+                        size_t i) {
+  const auto& first = reqs.front()->at(i);
+  PoolTensor res;
+  res.shape = first.shape;
+  res.shape[0] = 0;
+  res.precision = first.precision;
+  res.lod.assign(first.lod.size(), std::vector<uint64_t>(1, 0));
+  for (auto* req : reqs) {
+    const auto& in = req->at(i);
+    res.shape[0] += in.shape[0];
+    for (size_t level = 0; level < in.lod.size(); level++) {
+      auto& merged = res.lod[level];
+      uint64_t base = merged.back();
+      for (size_t j = 1; j < in.lod[level].size(); j++) {
+        merged.push_back(base + in.lod[level][j]);
+      }
+    }
+    res.buffer.insert(res.buffer.end(), in.buffer.begin(), in.buffer.end());
+  }
+  return res;
+}
+
+// Slice the rows [begin, end) of `x`.
+PoolTensor SliceRows(const PoolTensor& x, int64_t begin, int64_t end) {
+  PoolTensor res;
+  res.shape = x.shape;
+  res.shape[0] = end - begin;
+  res.precision = x.precision;
+  size_t row_bytes =
+      x.shape[0] == 0 ? 0 : x.buffer.size() / static_cast<size_t>(x.shape[0]);
+  res.buffer.assign(x.buffer.begin() + begin * row_bytes,
+                    x.buffer.begin() + end * row_bytes);
+  return res;
+}
+
+// Slice the top level sequences [begin, end) of `x`.
+PoolTensor SliceSeqs(const PoolTensor& x, uint64_t begin, uint64_t end) {
+  lod_t lod;
+  for (const auto& level : x.lod) {
+    std::vector<uint64_t> offsets;
+    for (uint64_t j = begin; j <= end; j++) {
+      offsets.push_back(level[j] - level[begin]);
+    }
+    lod.push_back(std::move(offsets));
+    begin = level[begin];
+    end = level[end];
+  }
+  auto res = SliceRows(x, begin, end);
+  res.lod = std::move(lod);
+  return res;
+}
+
+// Split a batched output back to the requests, returns false if the output
+// can not be related to the rows or to the sequences of the requests.
+bool SplitOutput(const PoolTensor& out,
+                 const std::vector<int64_t>& rows,
+                 const std::vector<int64_t>& seqs,
+                 std::vector<PoolTensor>* pieces) {
+  int64_t total_rows = 0, total_seqs = 0;
+  for (size_t k = 0; k < rows.size(); k++) {
+    total_rows += rows[k];
+    total_seqs += seqs[k];
+  }
+  if (out.shape.empty()) return false;
+  pieces->clear();
+  if (!out.lod.empty()) {
+    if (total_seqs == 0 ||
+        static_cast<int64_t>(out.lod[0].size()) - 1 != total_seqs) {
+      return false;
+    }
+    int64_t begin = 0;
+    for (auto n : seqs) {
+      pieces->push_back(SliceSeqs(out, begin, begin + n));
+      begin += n;
+    }
+    return true;
+  }
+  const std::vector<int64_t>* units = nullptr;
+  if (out.shape[0] == total_rows) {
+    units = &rows;
+  } else if (total_seqs > 0 && out.shape[0] == total_seqs) {
+    units = &seqs;
+  } else {
+    return false;
+  }
+  int64_t begin = 0;
+  for (auto n : *units) {
+    pieces->push_back(SliceRows(out, begin, begin + n));
+    begin += n;
+  }
+  return true;
+}
+
+}  // namespace
+
+template <typename T>
+PoolTensor::PoolTensor(const shape_t& shape, const T* data, const lod_t& lod)
+    : shape(shape), lod(lod), precision(PrecisionOf<T>::value) {
+  auto* bytes = reinterpret_cast<const char*>(data);
+  buffer.assign(bytes, bytes + ShapeProduction(shape) * sizeof(T));
+}
+
+template PoolTensor::PoolTensor(const shape_t&, const float*, const lod_t&);
+template PoolTensor::PoolTensor(const shape_t&, const int8_t*, const lod_t&);
+template PoolTensor::PoolTensor(const shape_t&, const int32_t*, const lod_t&);
+template PoolTensor::PoolTensor(const shape_t&, const int64_t*, const lod_t&);
+
+int64_t PoolTensor::numel() const { return ShapeProduction(shape); }
+
+PredictorPool::PredictorPool(std::shared_ptr<PaddlePredictor> predictor,
+                             const PredictorPoolConfig& config)
+    : config_(config) {
+  CHECK(predictor);
+  CHECK_GE(config_.num_predictors, 1);
+  CHECK_GE(config_.max_batch_size, 1);
+  CHECK_GE(config_.max_batch_delay_us, 0);
+  predictors_.push_back(predictor);
+  for (int i = 1; i < config_.num_predictors; i++) {
+    predictors_.push_back(predictor->Clone());
+  }
+  for (int i = 0; i < config_.num_predictors; i++) {
+    workers_.emplace_back(&PredictorPool::Work, this, i);
+  }
+}
+
+PredictorPool::~PredictorPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  cv_.notify_all();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+std::future<PredictorPool::Response> PredictorPool::Submit(Request inputs) {
+  TaskPtr task(new Task);
+  task->inputs = std::move(inputs);
+  task->deadline =
+      Clock::now() + std::chrono::microseconds(config_.max_batch_delay_us);
+  auto res = task->promise.get_future();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    CHECK(!stop_) << "Submit to a stopped PredictorPool";
+    tasks_.push_back(std::move(task));
+  }
+  // The workers waiting for a batch to fill up are woken too.
+  cv_.notify_all();
+  return res;
+}
+
+void PredictorPool::Work(int idx) {
+  auto* predictor = predictors_[idx].get();
+  while (true) {
+    auto batch = NextBatch();
+    if (batch.empty()) break;
+    RunBatch(predictor, &batch);
+  }
+}
+
+bool PredictorPool::Compatible(const Request& a, const Request& b) const {
+  if (a.size() != b.size()) return false;
+  for (size_t i = 0; i < a.size(); i++) {
+    if (a[i].precision != b[i].precision) return false;
+    if (a[i].shape.empty() || a[i].shape.size() != b[i].shape.size()) {
+      return false;
+    }
+    if (!std::equal(
+            a[i].shape.begin() + 1, a[i].shape.end(), b[i].shape.begin() + 1)) {
+      return false;
+    }
+    if (a[i].lod.size() != b[i].lod.size()) return false;
+  }
+  return true;
+}
+
+std::vector<PredictorPool::TaskPtr> PredictorPool::NextBatch() {
+  std::vector<TaskPtr> batch;
+  std::unique_lock<std::mutex> lock(mutex_);
+  cv_.wait(lock, [this] { return stop_ || !tasks_.empty(); });
+  // The pending tasks are still served after the pool is stopped.
+  if (tasks_.empty()) return batch;
+  batch.push_back(std::move(tasks_.front()));
+  tasks_.pop_front();
+  if (!batching_ || config_.max_batch_size <= 1) return batch;
+
+  const auto& head = batch.front()->inputs;
+  int64_t rows = RequestRows(head);
+  while (rows < config_.max_batch_size) {
+    for (auto it = tasks_.begin();
+         it != tasks_.end() && rows < config_.max_batch_size;) {
+      int64_t n = RequestRows((*it)->inputs);
+      if (rows + n <= config_.max_batch_size &&
+          Compatible(head, (*it)->inputs)) {
+        rows += n;
+        batch.push_back(std::move(*it));
+        it = tasks_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    if (rows >= config_.max_batch_size || stop_ ||
+        cv_.wait_until(lock, batch.front()->deadline) ==
+            std::cv_status::timeout) {
+      break;
+    }
+  }
+  return batch;
+}
+
+void PredictorPool::RunBatch(PaddlePredictor* predictor,
+                             std::vector<TaskPtr>* batch) {
+  if (batch->size() == 1) {
+    auto& task = batch->front();
+    task->promise.set_value(RunOne(predictor, task->inputs));
+    return;
+  }
+
+  std::vector<const Request*> requests;
+  std::vector<int64_t> rows, seqs;
+  for (auto& task : *batch) {
+    requests.push_back(&task->inputs);
+    rows.push_back(RequestRows(task->inputs));
+    seqs.push_back(RequestSeqs(task->inputs));
+  }
+  Request inputs;
+  for (size_t i = 0; i < requests.front()->size(); i++) {
+    inputs.push_back(ConcatInputs(requests, i));
+  }
+
+  auto outputs = RunOne(predictor, inputs);
+  std::vector<Response> responses(batch->size());
+  std::vector<PoolTensor> pieces;
+  for (size_t i = 0; i < outputs.size(); i++) {
+    if (!SplitOutput(outputs[i], rows, seqs, &pieces)) {
+      LOG(WARNING) << "The " << i << "-th output of a batched run can not be "
+                   << "split along dim 0, disable the batching of the pool";
+      batching_ = false;
+      for (auto& task : *batch) {
+        task->promise.set_value(RunOne(predictor, task->inputs));
+      }
+      return;
+    }
+    for (size_t k = 0; k < pieces.size(); k++) {
+      responses[k].push_back(std::move(pieces[k]));
+    }
+  }
+  for (size_t k = 0; k < batch->size(); k++) {
+    (*batch)[k]->promise.set_value(std::move(responses[k]));
+  }
+}
+
+}  // namespace lite_api
+}  // namespace paddle
@@ -0,0 +1,129 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/*
+ * This file defines PredictorPool, a server-side API on top of the
+ * PaddlePredictor which serves concurrent requests with several predictors
+ * sharing the same weights, and optionally coalesces compatible requests into
+ * one batched run.
+ */
+
+#pragma once
+#include <atomic>
+#include <chrono>              // NOLINT
+#include <condition_variable>  // NOLINT
+#include <deque>
+#include <future>  // NOLINT
+#include <memory>
+#include <mutex>  // NOLINT
+#include <thread>  // NOLINT
+#include <vector>
+#include "paddle_api.h"  // NOLINT
+
+namespace paddle {
+namespace lite_api {
+
+/// A host tensor owned by a request, inputs and outputs of the pool are
+/// passed by value so that the caller never touches the predictors' tensors.
+struct LITE_API PoolTensor {
+  shape_t shape;
+  lod_t lod;
+  PrecisionType precision{PrecisionType::kFloat};
+  std::vector<char> buffer;
+
+  PoolTensor() = default;
+  template <typename T>
+  PoolTensor(const shape_t& shape, const T* data, const lod_t& lod = lod_t());
+
+  int64_t numel() const;
+  template <typename T>
+  const T* data() const {
+    return reinterpret_cast<const T*>(buffer.data());
+  }
+};
+
+struct LITE_API PredictorPoolConfig {
+  // Number of predictors, each one is served by a dedicated thread.
+  int num_predictors{1};
+  // Maximum number of rows (the sum of dim 0 of the first input) in a
+  // coalesced run, 1 disables the batching.
+  int max_batch_size{1};
+  // Maximum time a request waits for others to be batched with, in
+  // microseconds.
+  int max_batch_delay_us{0};
+};
+
+/*
+ * PredictorPool owns `num_predictors` clones of a predictor, they share the
+ * weights and each of them runs in its own thread.
+ *
+ * Requests are queued by `Submit` and served in order. When the batching is
+ * enabled, a worker takes the oldest request and coalesces the following
+ * compatible ones, that is with the same input precisions and the same input
+ * shapes except dim 0, by concatenating them along dim 0 (and the offsets of
+ * the LoD for the sequence inputs) until `max_batch_size` rows are reached or
+ * the deadline of the oldest request expires. The outputs are split back
+ * along dim 0, by rows or by the top level sequences of the first input.
+ *
+ * It is only valid for models in which each sample is computed independently
+ * from the others in the batch.
+ */
+class LITE_API PredictorPool {
+ public:
+  using Request = std::vector<PoolTensor>;
+  using Response = std::vector<PoolTensor>;
+
+  PredictorPool(std::shared_ptr<PaddlePredictor> predictor,
+                const PredictorPoolConfig& config);
+  ~PredictorPool();
+
+  /// Queue a request, the inputs are in the order of `GetInputNames`.
+  std::future<Response> Submit(Request inputs);
+  /// Submit a request and wait for its outputs.
+  Response Run(Request inputs) { return Submit(std::move(inputs)).get(); }
+
+  int num_predictors() const { return static_cast<int>(predictors_.size()); }
+  const PredictorPoolConfig& config() const { return config_; }
+
+ private:
+  using Clock = std::chrono::steady_clock;
+  struct Task {
+    Request inputs;
+    std::promise<Response> promise;
+    Clock::time_point deadline;
+  };
+  using TaskPtr = std::unique_ptr<Task>;
+
+  void Work(int idx);
+  // Pop the oldest task and the following ones it can be batched with.
+  // Returns an empty batch if the pool is stopped.
+  std::vector<TaskPtr> NextBatch();
+  bool Compatible(const Request& a, const Request& b) const;
+  void RunBatch(PaddlePredictor* predictor, std::vector<TaskPtr>* batch);
+
+  PredictorPoolConfig config_;
+  std::vector<std::shared_ptr<PaddlePredictor>> predictors_;
+  std::vector<std::thread> workers_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<TaskPtr> tasks_;
+  bool stop_{false};
+  // Cleared once an output could not be split along dim 0, the requests are
+  // run one by one from then on.
+  std::atomic<bool> batching_{true};
+};
+
+}  // namespace lite_api
+}  // namespace paddle
@@ -0,0 +1,202 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/api/paddle_predictor_pool.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <string>
+#include <vector>
+#include "lite/core/tensor.h"
+
+namespace paddle {
+namespace lite_api {
+
+// A predictor computing `x * 2` and the sum of each sequence of x (or of each
+// row if x has no LoD), with `pool_output` the sum of the whole batch which
+// can not be split back.
+class FakePredictor : public PaddlePredictor {
+ public:
+  explicit FakePredictor(std::atomic<int>* runs, bool pool_output = false)
+      : runs_(runs), pool_output_(pool_output) {}
+
+  std::unique_ptr<Tensor> GetInput(int i) override {
+    return std::unique_ptr<Tensor>(new Tensor(&x_));
+  }
+  std::unique_ptr<const Tensor> GetOutput(int i) const override {
+    return std::unique_ptr<const Tensor>(
+        new Tensor(i == 0 ? &scaled_ : &sum_));
+  }
+
+  void Run() override {
+    (*runs_)++;
+    scaled_.Resize(x_.dims());
+    scaled_.set_lod(x_.lod());
+    auto* x = x_.data<float>();
+    auto* scaled = scaled_.mutable_data<float>();
+    for (int64_t i = 0; i < x_.numel(); i++) scaled[i] = x[i] * 2;
+
+    std::vector<uint64_t> offsets;
+    int64_t rows = x_.dims()[0];
+    int64_t width = x_.numel() / rows;
+    if (x_.lod().empty()) {
+      for (int64_t i = 0; i <= rows; i++) offsets.push_back(i);
+    } else {
+      offsets = x_.lod()[0];
+    }
+    if (pool_output_) offsets = {0, static_cast<uint64_t>(rows)};
+    sum_.Resize({static_cast<int64_t>(offsets.size()) - 1, 1});
+    auto* sum = sum_.mutable_data<float>();
+    for (size_t i = 0; i + 1 < offsets.size(); i++) {
+      sum[i] = 0;
+      for (auto j = offsets[i] * width; j < offsets[i + 1] * width; j++) {
+        sum[i] += x[j];
+      }
+    }
+  }
+
+  std::shared_ptr<PaddlePredictor> Clone() override {
+    return std::make_shared<FakePredictor>(runs_, pool_output_);
+  }
+  std::string GetVersion() const override { return "fake"; }
+  std::vector<std::string> GetInputNames() override { return {"x"}; }
+  std::vector<std::string> GetOutputNames() override {
+    return {"scaled", "sum"};
+  }
+  std::unique_ptr<Tensor> GetInputByName(const std::string& name) override {
+    return GetInput(0);
+  }
+  std::unique_ptr<const Tensor> GetTensor(
+      const std::string& name) const override {
+    return nullptr;
+  }
+
+ private:
+  std::atomic<int>* runs_;
+  bool pool_output_;
+  lite::Tensor x_, scaled_, sum_;
+};
+
+PredictorPool::Request MakeRequest(int64_t rows, float value, lod_t lod = {}) {
+  std::vector<float> data(rows * 3);
+  for (size_t i = 0; i < data.size(); i++) data[i] = value + i;
+  return {PoolTensor({rows, 3}, data.data(), lod)};
+}
+
+void CheckResponse(const PredictorPool::Request& request,
+                   const PredictorPool::Response& response) {
+  const auto& x = request[0];
+  ASSERT_EQ(response.size(), 2UL);
+  EXPECT_EQ(response[0].shape, x.shape);
+  EXPECT_EQ(response[0].lod, x.lod);
+  for (int64_t i = 0; i < x.numel(); i++) {
+    EXPECT_EQ(response[0].data<float>()[i], x.data<float>()[i] * 2);
+  }
+  std::vector<uint64_t> offsets;
+  if (x.lod.empty()) {
+    for (int64_t i = 0; i <= x.shape[0]; i++) offsets.push_back(i);
+  } else {
+    offsets = x.lod[0];
+  }
+  ASSERT_EQ(response[1].shape[0], static_cast<int64_t>(offsets.size()) - 1);
+  for (size_t i = 0; i + 1 < offsets.size(); i++) {
+    float sum = 0;
+    for (auto j = offsets[i] * 3; j < offsets[i + 1] * 3; j++) {
+      sum += x.data<float>()[j];
+    }
+    EXPECT_EQ(response[1].data<float>()[i], sum);
+  }
+}
+
+TEST(PredictorPool, run) {
+  std::atomic<int> runs{0};
+  PredictorPoolConfig config;
+  config.num_predictors = 3;
+  PredictorPool pool(std::make_shared<FakePredictor>(&runs), config);
+  EXPECT_EQ(pool.num_predictors(), 3);
+
+  std::vector<PredictorPool::Request> requests;
+  std::vector<std::future<PredictorPool::Response>> responses;
+  for (int i = 0; i < 16; i++) {
+    requests.push_back(MakeRequest(i % 4 + 1, i));
+    responses.push_back(pool.Submit(requests.back()));
+  }
+  for (size_t i = 0; i < requests.size(); i++) {
+    CheckResponse(requests[i], responses[i].get());
+  }
+  EXPECT_EQ(runs, 16);
+}
+
+TEST(PredictorPool, batching) {
+  std::atomic<int> runs{0};
+  PredictorPoolConfig config;
+  config.max_batch_size = 8;
+  config.max_batch_delay_us = 200000;
+  PredictorPool pool(std::make_shared<FakePredictor>(&runs), config);
+
+  std::vector<PredictorPool::Request> requests;
+  for (int i = 0; i < 4; i++) requests.push_back(MakeRequest(2, i * 10));
+  // A request with another width is not batched with the others.
+  std::vector<float> other(2 * 5, 1.f);
+  requests.push_back({PoolTensor({2, 5}, other.data())});
+
+  std::vector<std::future<PredictorPool::Response>> responses;
+  for (auto& request : requests) responses.push_back(pool.Submit(request));
+  for (int i = 0; i < 4; i++) CheckResponse(requests[i], responses[i].get());
+  auto response = responses[4].get();
+  EXPECT_EQ(response[0].shape, shape_t({2, 5}));
+  EXPECT_EQ(response[1].data<float>()[1], 5.f);
+  EXPECT_LE(runs, 3);
+}
+
+TEST(PredictorPool, batching_lod) {
+  std::atomic<int> runs{0};
+  PredictorPoolConfig config;
+  config.max_batch_size = 16;
+  config.max_batch_delay_us = 200000;
+  PredictorPool pool(std::make_shared<FakePredictor>(&runs), config);
+
+  std::vector<PredictorPool::Request> requests;
+  requests.push_back(MakeRequest(5, 0, {{0, 2, 5}}));
+  requests.push_back(MakeRequest(1, 100, {{0, 1}}));
+  requests.push_back(MakeRequest(4, 200, {{0, 1, 3, 4}}));
+  std::vector<std::future<PredictorPool::Response>> responses;
+  for (auto& request : requests) responses.push_back(pool.Submit(request));
+  for (size_t i = 0; i < requests.size(); i++) {
+    CheckResponse(requests[i], responses[i].get());
+  }
+  EXPECT_LE(runs, 2);
+}
+
+TEST(PredictorPool, batching_fallback) {
+  std::atomic<int> runs{0};
+  PredictorPoolConfig config;
+  config.max_batch_size = 8;
+  config.max_batch_delay_us = 200000;
+  PredictorPool pool(std::make_shared<FakePredictor>(&runs, true), config);
+
+  std::vector<PredictorPool::Request> requests;
+  for (int i = 0; i < 3; i++) requests.push_back(MakeRequest(2, i));
+  std::vector<std::future<PredictorPool::Response>> responses;
+  for (auto& request : requests) responses.push_back(pool.Submit(request));
+  for (size_t i = 0; i < requests.size(); i++) {
+    auto response = responses[i].get();
+    ASSERT_EQ(response[1].shape, shape_t({1, 1}));
+    float sum = 0;
+    for (int j = 0; j < 6; j++) sum += requests[i][0].data<float>()[j];
+    EXPECT_EQ(response[1].data<float>()[0], sum);
+  }
+}
+
+}  // namespace lite_api
+}  // namespace paddle
@@ -32,6 +32,9 @@ USE_MIR_PASS(lite_shuffle_channel_fuse_pass);
 USE_MIR_PASS(lite_transpose_softmax_transpose_fuse_pass);
 USE_MIR_PASS(lite_interpolate_fuse_pass);
 USE_MIR_PASS(lite_sequence_pool_concat_fuse_pass);
+USE_MIR_PASS(lite_embedding_seq_pool_fuse_pass);
+USE_MIR_PASS(lite_attention_fuse_pass);
+USE_MIR_PASS(lite_add_layer_norm_fuse_pass);
 USE_MIR_PASS(identity_scale_eliminate_pass);
 USE_MIR_PASS(lite_conv_elementwise_fuse_pass);
 USE_MIR_PASS(lite_conv_activation_fuse_pass);
@@ -45,4 +48,8 @@ USE_MIR_PASS(memory_optimize_pass);
 USE_MIR_PASS(elementwise_mul_constant_eliminate_pass)
 USE_MIR_PASS(npu_subgraph_pass);
 USE_MIR_PASS(xpu_subgraph_pass);
+USE_MIR_PASS(x86_subgraph_pass);
 USE_MIR_PASS(weight_quantization_preprocess_pass);
+USE_MIR_PASS(embedding_quantization_pass);
+USE_MIR_PASS(weight_half_quantization_pass);
+USE_MIR_PASS(kernel_tune_pass);
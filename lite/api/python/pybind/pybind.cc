@@ -102,7 +102,9 @@ void BindLiteCxxConfig(py::module *m) {
       .def("param_file", &CxxConfig::param_file)
       .def("set_valid_places", &CxxConfig::set_valid_places)
       .def("set_model_buffer", &CxxConfig::set_model_buffer)
-      .def("model_from_memory", &CxxConfig::model_from_memory);
+      .def("model_from_memory", &CxxConfig::model_from_memory)
+      .def("set_inter_op_threads", &CxxConfig::set_inter_op_threads)
+      .def("inter_op_threads", &CxxConfig::inter_op_threads);
 #ifdef LITE_WITH_ARM
   cxx_config.def("set_threads", &CxxConfig::set_threads)
       .def("threads", &CxxConfig::threads)
@@ -121,7 +123,11 @@ void BindLiteMobileConfig(py::module *m) {
       .def("set_model_dir", &MobileConfig::set_model_dir)
       .def("model_dir", &MobileConfig::model_dir)
       .def("set_model_buffer", &MobileConfig::set_model_buffer)
-      .def("model_from_memory", &MobileConfig::model_from_memory);
+      .def("model_from_memory", &MobileConfig::model_from_memory)
+      .def("set_use_mmap", &MobileConfig::set_use_mmap)
+      .def("use_mmap", &MobileConfig::use_mmap)
+      .def("set_inter_op_threads", &MobileConfig::set_inter_op_threads)
+      .def("inter_op_threads", &MobileConfig::inter_op_threads);
 #ifdef LITE_WITH_ARM
   mobile_config.def("set_threads", &MobileConfig::set_threads)
       .def("threads", &MobileConfig::threads)
@@ -182,6 +188,93 @@ void BindLitePlace(py::module *m) {
       .def("is_valid", &Place::is_valid);
 }
 
+// The alignment the predictor requires of the external memory, see
+// Tensor::ShareExternalMemory.
+static const size_t kExternalMemoryAlignment = 64;
+
+// The buffer on the memory of the tensor in the predictor, which is valid
+// until the tensor is resized or reallocated by the next run.
+static py::buffer_info TensorBufferInfo(const Tensor &tensor) {
+  auto target = tensor.target();
+  if (target != TargetType::kHost && target != TargetType::kX86 &&
+      target != TargetType::kARM) {
+    throw py::value_error(
+        "Only the tensors on the host can be viewed as numpy arrays");
+  }
+  const void *data = nullptr;
+  size_t item_size = 0;
+  std::string format;
+  switch (tensor.precision()) {
+#define TENSOR_DATA_CASE(precision__, T)          \
+  case PrecisionType::precision__:                \
+    data = tensor.data<T>();                      \
+    item_size = sizeof(T);                        \
+    format = py::format_descriptor<T>::format(); \
+    break
+    TENSOR_DATA_CASE(kFloat, float);
+    TENSOR_DATA_CASE(kInt8, int8_t);
+    TENSOR_DATA_CASE(kInt32, int32_t);
+    TENSOR_DATA_CASE(kInt64, int64_t);
+#undef TENSOR_DATA_CASE
+    default:
+      throw py::type_error("The precision " +
+                           lite_api::PrecisionToStr(tensor.precision()) +
+                           " can not be viewed as numpy arrays");
+  }
+  auto shape = tensor.shape();
+  std::vector<ssize_t> strides(shape.size());
+  ssize_t stride = item_size;
+  for (int i = static_cast<int>(shape.size()) - 1; i >= 0; --i) {
+    strides[i] = stride;
+    stride *= shape[i];
+  }
+  return py::buffer_info(const_cast<void *>(data),
+                         item_size,
+                         format,
+                         shape.size(),
+                         std::vector<ssize_t>(shape.begin(), shape.end()),
+                         strides);
+}
+
+// Set the shape and data of the tensor from the array. A C contiguous array
+// on the host aligned as the predictor requires is shared without copying and
+// kept alive until the tensor stops using it, the others are copied.
+template <typename T>
+static void SetTensorFromNumpy(Tensor *tensor,
+                               py::array array,
+                               TargetType type) {
+  const auto *shape = array.shape();
+  tensor->Resize(lite_api::shape_t(shape, shape + array.ndim()));
+  size_t memory_size = array.size() * sizeof(T);
+  bool on_host = type == TargetType::kHost || type == TargetType::kX86 ||
+                 type == TargetType::kARM;
+  if (on_host && array.size() > 0 &&
+      (array.flags() & py::array::c_style) &&
+      reinterpret_cast<uintptr_t>(array.data()) % kExternalMemoryAlignment ==
+          0) {
+    // The last reference may be dropped by the threads of the predictor,
+    // which do not hold the GIL.
+    std::shared_ptr<void> holder(array.inc_ref().ptr(), [](void *obj) {
+      if (!Py_IsInitialized()) return;
+      py::gil_scoped_acquire gil;
+      Py_DECREF(static_cast<PyObject *>(obj));
+    });
+    tensor->ShareExternalMemory(
+        static_cast<const T *>(array.data()), memory_size, type, holder);
+    return;
+  }
+  auto contiguous = py::array_t<T, py::array::c_style>::ensure(array);
+  if (!contiguous) {
+    throw py::type_error("The array can not be converted to a C contiguous "
+                         "one");
+  }
+  if (type == TargetType::kCUDA) {
+    tensor->CopyFromCpu<T, TargetType::kCUDA>(contiguous.data());
+  } else {
+    std::memcpy(tensor->mutable_data<T>(), contiguous.data(), memory_size);
+  }
+}
+
 void BindLiteTensor(py::module *m) {
   auto data_size_func = [](const std::vector<int64_t> &shape) -> int64_t {
     int64_t res = 1;
@@ -191,14 +284,44 @@ void BindLiteTensor(py::module *m) {
     return res;
   };
 
-  py::class_<Tensor> tensor(*m, "Tensor");
+  py::class_<Tensor> tensor(*m, "Tensor", py::buffer_protocol());
 
   tensor.def("resize", &Tensor::Resize)
       .def("shape", &Tensor::shape)
       .def("target", &Tensor::target)
       .def("precision", &Tensor::precision)
       .def("lod", &Tensor::lod)
-      .def("set_lod", &Tensor::SetLoD);
+      .def("set_lod", &Tensor::SetLoD)
+      .def_buffer([](Tensor &self) { return TensorBufferInfo(self); })
+      // A numpy array on the memory of the tensor without copying, which is
+      // valid until the tensor is resized or reallocated by the next run.
+      .def("numpy",
+           [](py::object self) -> py::array {
+             auto info = TensorBufferInfo(self.cast<const Tensor &>());
+             return py::array(
+                 py::dtype(info), info.shape, info.strides, info.ptr, self);
+           })
+      .def("from_numpy",
+           [](Tensor &self, py::array array, TargetType type) {
+             // isinstance compares the dtypes by equivalence, the dtype
+             // objects of the same type need not be identical.
+             if (py::isinstance<py::array_t<float>>(array)) {
+               SetTensorFromNumpy<float>(&self, array, type);
+             } else if (py::isinstance<py::array_t<int8_t>>(array)) {
+               SetTensorFromNumpy<int8_t>(&self, array, type);
+             } else if (py::isinstance<py::array_t<int32_t>>(array)) {
+               SetTensorFromNumpy<int32_t>(&self, array, type);
+             } else if (py::isinstance<py::array_t<int64_t>>(array)) {
+               SetTensorFromNumpy<int64_t>(&self, array, type);
+             } else {
+               throw py::type_error(
+                   "Only the float32, int8, int32 and int64 arrays are "
+                   "supported, got " +
+                   py::str(array.dtype()).cast<std::string>());
+             }
+           },
+           py::arg("array"),
+           py::arg("type") = TargetType::kHost);
 
 #define DO_GETTER_ONCE(data_type__, name__)                           \
   tensor.def(#name__, [=](Tensor &self) -> std::vector<data_type__> { \
@@ -241,25 +364,39 @@ void BindLiteTensor(py::module *m) {
 void BindLiteCxxPredictor(py::module *m) {
   py::class_<CxxPaddleApiImpl>(*m, "CxxPredictor")
       .def(py::init<>())
-      .def("get_input", &CxxPaddleApiImpl::GetInput)
-      .def("get_output", &CxxPaddleApiImpl::GetOutput)
-      .def("run", &CxxPaddleApiImpl::Run)
+      // The tensors keep the predictor owning them alive.
+      .def("get_input", &CxxPaddleApiImpl::GetInput, py::keep_alive<0, 1>())
+      .def("get_output", &CxxPaddleApiImpl::GetOutput, py::keep_alive<0, 1>())
+      // Other Python threads run while the predictor runs.
+      .def("run",
+           &CxxPaddleApiImpl::Run,
+           py::call_guard<py::gil_scoped_release>())
       .def("get_version", &CxxPaddleApiImpl::GetVersion)
       .def("save_optimized_model",
            [](CxxPaddleApiImpl &self, const std::string &output_dir) {
              self.SaveOptimizedModel(output_dir,
                                      lite_api::LiteModelType::kNaiveBuffer);
-           });
+           })
+      .def("enable_profiling", &CxxPaddleApiImpl::EnableProfiling)
+      .def("get_profiling_summary", &CxxPaddleApiImpl::GetProfilingSummary)
+      .def("save_profiling_trace", &CxxPaddleApiImpl::SaveProfilingTrace);
 }
 #endif
 
 void BindLiteLightPredictor(py::module *m) {
   py::class_<LightPredictorImpl>(*m, "LightPredictor")
       .def(py::init<>())
-      .def("get_input", &LightPredictorImpl::GetInput)
-      .def("get_output", &LightPredictorImpl::GetOutput)
-      .def("run", &LightPredictorImpl::Run)
-      .def("get_version", &LightPredictorImpl::GetVersion);
+      // The tensors keep the predictor owning them alive.
+      .def("get_input", &LightPredictorImpl::GetInput, py::keep_alive<0, 1>())
+      .def("get_output", &LightPredictorImpl::GetOutput, py::keep_alive<0, 1>())
+      // Other Python threads run while the predictor runs.
+      .def("run",
+           &LightPredictorImpl::Run,
+           py::call_guard<py::gil_scoped_release>())
+      .def("get_version", &LightPredictorImpl::GetVersion)
+      .def("enable_profiling", &LightPredictorImpl::EnableProfiling)
+      .def("get_profiling_summary", &LightPredictorImpl::GetProfilingSummary)
+      .def("save_profiling_trace", &LightPredictorImpl::SaveProfilingTrace);
 }
 
 }  // namespace pybind
@@ -150,6 +150,10 @@ bool MayIUse(const cpu_isa_t cpu_isa) {
     case avx512_mic_4ops:
       return true && MayIUse(avx512_mic) && cpu.has(Cpu::tAVX512_4FMAPS) &&
              cpu.has(Cpu::tAVX512_4VNNIW);
+    case f16c:
+      return cpu.has(Cpu::tF16C);
+    case fma:
+      return cpu.has(Cpu::tFMA);
     case isa_any:
       return true;
   }
@@ -70,6 +70,8 @@ typedef enum {
   avx512_core_vnni,
   avx512_mic,
   avx512_mic_4ops,
+  f16c,
+  fma,
 } cpu_isa_t;  // Instruction set architecture
 
 // May I use some instruction
@@ -0,0 +1,240 @@
+/* Copyright (c) 2018 PaddlePaddle Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "lite/backends/x86/jit/gen/fused_elementwise.h"
+#include <memory>
+#include <vector>
+#include "lite/backends/x86/jit/registry.h"
+#include "lite/utils/paddle_enforce.h"
+
+namespace paddle {
+namespace lite {
+namespace jit {
+namespace gen {
+
+FusedElementwiseJitCode::FusedElementwiseJitCode(
+    const fused_elementwise_attr_t& attr, size_t code_size, void* code_ptr)
+    : VActFunc(code_size, code_ptr), attr_(attr) {
+  PADDLE_ENFORCE(AllocateRegs(attr_, &regs_),
+                 "Too many values are alive in the fused elementwise steps.");
+  consts_.resize(2 * attr_.num_steps);
+  for (int s = 0; s < attr_.num_steps; ++s) {
+    consts_[2 * s] = attr_.steps[s].alpha;
+    consts_[2 * s + 1] = attr_.steps[s].beta;
+  }
+  this->genCode();
+}
+
+bool FusedElementwiseJitCode::AllocateRegs(
+    const fused_elementwise_attr_t& attr, std::vector<int>* regs) {
+  const int num_inputs = attr.num_inputs;
+  std::vector<int> last_use(attr.num_steps, -1);
+  for (int s = 0; s < attr.num_steps; ++s) {
+    const auto& step = attr.steps[s];
+    if (step.x >= num_inputs) {
+      last_use[step.x - num_inputs] = s;
+    }
+    if (IsBinaryFusedElementwise(step.type) && step.y >= num_inputs) {
+      last_use[step.y - num_inputs] = s;
+    }
+  }
+  std::vector<int> free_regs;
+  for (int i = kMaxValueRegs - 1; i >= 0; --i) {
+    free_regs.push_back(i);
+  }
+  regs->assign(attr.num_steps, -1);
+  for (int s = 0; s < attr.num_steps; ++s) {
+    const auto& step = attr.steps[s];
+    const int x = step.x - num_inputs;
+    const int y =
+        IsBinaryFusedElementwise(step.type) ? step.y - num_inputs : -1;
+    if (x >= 0 && last_use[x] == s) {
+      // Overwrite the operand in place.
+      (*regs)[s] = (*regs)[x];
+    } else {
+      if (free_regs.empty()) return false;
+      (*regs)[s] = free_regs.back();
+      free_regs.pop_back();
+    }
+    if (y >= 0 && y != x && last_use[y] == s) {
+      free_regs.push_back((*regs)[y]);
+    }
+    if (last_use[s] < 0) {
+      // Only stored to the outputs.
+      free_regs.push_back((*regs)[s]);
+    }
+  }
+  return true;
+}
+
+template <typename JMM>
+void FusedElementwiseJitCode::load(JMM& dst, int input, bool single) {
+  mov(reg_ptr, qword[param_x + input * sizeof(float*)]);
+  if ((attr_.scalar_mask >> input) & 1) {
+    vbroadcastss(dst, ptr[reg_ptr]);
+  } else if (single) {
+    vmovss(dst, ptr[reg_ptr + reg_offset]);
+  } else {
+    vmovups(dst, ptr[reg_ptr + reg_offset]);
+  }
+}
+
+template <typename JMM>
+void FusedElementwiseJitCode::store(int output, JMM& src, bool single) {
+  mov(reg_ptr, qword[param_out + output * sizeof(float*)]);
+  if (single) {
+    vmovss(ptr[reg_ptr + reg_offset], src);
+  } else {
+    vmovups(ptr[reg_ptr + reg_offset], src);
+  }
+}
+
+template <typename JMM>
+void FusedElementwiseJitCode::genSteps(bool single) {
+  const int num_inputs = attr_.num_inputs;
+  JMM tmp = JMM(kMaxValueRegs);
+  for (int s = 0; s < attr_.num_steps; ++s) {
+    const auto& step = attr_.steps[s];
+    JMM dst = JMM(regs_[s]);
+    int x_idx = regs_[s];
+    if (step.x < num_inputs) {
+      load<JMM>(dst, step.x, single);
+    } else {
+      x_idx = regs_[step.x - num_inputs];
+    }
+    JMM x = JMM(x_idx);
+    int y_idx = kMaxValueRegs;
+    if (IsBinaryFusedElementwise(step.type)) {
+      if (step.y < num_inputs) {
+        load<JMM>(tmp, step.y, single);
+      } else {
+        y_idx = regs_[step.y - num_inputs];
+      }
+    }
+    JMM y = JMM(y_idx);
+    switch (step.type) {
+      case kFusedAdd:
+        vaddps(dst, x, y);
+        break;
+      case kFusedSub:
+        vsubps(dst, x, y);
+        break;
+      case kFusedMul:
+        vmulps(dst, x, y);
+        break;
+      case kFusedDiv:
+        vdivps(dst, x, y);
+        break;
+      case kFusedMax:
+        vmaxps(dst, x, y);
+        break;
+      case kFusedMin:
+        vminps(dst, x, y);
+        break;
+      case kFusedScale:
+        mov(reg_ptr, reinterpret_cast<size_t>(&consts_[2 * s]));
+        vbroadcastss(tmp, ptr[reg_ptr]);
+        vmulps(dst, x, tmp);
+        vbroadcastss(tmp, ptr[reg_ptr + sizeof(float)]);
+        vaddps(dst, dst, tmp);
+        break;
+      case kFusedRelu:
+        act<JMM>(dst, x, operand_type::RELU);
+        break;
+      case kFusedExp:
+        act<JMM>(dst, x, operand_type::EXP);
+        break;
+      case kFusedSigmoid:
+        act<JMM>(dst, x, operand_type::SIGMOID);
+        break;
+      case kFusedTanh:
+        act<JMM>(dst, x, operand_type::TANH);
+        break;
+      case kFusedSquare:
+        act<JMM>(dst, x, operand_type::SQUARE);
+        break;
+      case kFusedIdentity:
+        if (x_idx != regs_[s]) {
+          vmovaps(dst, x);
+        }
+        break;
+      default:
+        LOG(FATAL) << "Do not support this fused elementwise type: "
+                   << step.type;
+    }
+    for (int k = 0; k < attr_.num_outputs; ++k) {
+      if (attr_.outputs[k] == num_inputs + s) {
+        store<JMM>(k, dst, single);
+      }
+    }
+  }
+}
+
+void FusedElementwiseJitCode::genCode() {
+  // The offsets are in bytes.
+  movsxd(reg_end, param_n);
+  shl(reg_end, 2);
+  mov(reg_end_block, reg_end);
+  shr(reg_end_block, 5);
+  shl(reg_end_block, 5);
+  xor_(reg_offset, reg_offset);
+
+  Label l_next_block, l_next_rest, l_done;
+  L(l_next_block);
+  cmp(reg_offset, reg_end_block);
+  jge(l_next_rest, T_NEAR);
+  genSteps<ymm_t>(false);
+  add(reg_offset, YMM_FLOAT_BLOCK * sizeof(float));
+  jmp(l_next_block, T_NEAR);
+
+  L(l_next_rest);
+  cmp(reg_offset, reg_end);
+  jge(l_done, T_NEAR);
+  genSteps<xmm_t>(true);
+  add(reg_offset, sizeof(float));
+  jmp(l_next_rest, T_NEAR);
+
+  L(l_done);
+  vzeroupper();
+  ret();
+}
+
+class FusedElementwiseCreator
+    : public JitCodeCreator<fused_elementwise_attr_t> {
+ public:
+  bool CanBeUsed(const fused_elementwise_attr_t& attr) const override {
+    std::vector<int> regs;
+    return x86::MayIUse(x86::avx) &&
+           FusedElementwiseJitCode::AllocateRegs(attr, &regs);
+  }
+  size_t CodeSize(const fused_elementwise_attr_t& attr) const override {
+    // The steps are generated for the blocks and for the rest, the
+    // activations take up to 90 instructions.
+    return 256 + 2 * (attr.num_steps * 96 + attr.num_outputs * 2) * 8;
+  }
+  std::unique_ptr<GenBase> CreateJitCode(
+      const fused_elementwise_attr_t& attr) const override {
+    PADDLE_ENFORCE_GT(attr.num_steps, 0);
+    return make_unique<FusedElementwiseJitCode>(attr, CodeSize(attr));
+  }
+};
+
+}  // namespace gen
+}  // namespace jit
+}  // namespace lite
+}  // namespace paddle
+
+namespace gen = paddle::lite::jit::gen;
+
+REGISTER_JITKERNEL_GEN_LITE(kFusedElementwise, gen::FusedElementwiseCreator);
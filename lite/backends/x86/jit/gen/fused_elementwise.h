@@ -0,0 +1,72 @@
+/* Copyright (c) 2018 PaddlePaddle Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include "lite/backends/x86/jit/gen/act.h"
+
+namespace paddle {
+namespace lite {
+namespace jit {
+namespace gen {
+
+// Generate one loop over the elements for a chain of elementwise steps. The
+// results of the steps stay in ymm0~ymm9 until their last uses, ymm10 holds
+// the loaded inputs and the constants, ymm11~ymm15 are used by the
+// activations. The elements out of the blocks are computed one by one.
+class FusedElementwiseJitCode : public VActFunc {
+ public:
+  static constexpr int kMaxValueRegs = 10;
+
+  explicit FusedElementwiseJitCode(const fused_elementwise_attr_t& attr,
+                                   size_t code_size,
+                                   void* code_ptr = nullptr);
+
+  DECLARE_JIT_CODE(FusedElementwiseJitCode);
+  void genCode() override;
+
+  // Assign the registers of the results of the steps, return false if more
+  // than kMaxValueRegs results are alive at the same time.
+  static bool AllocateRegs(const fused_elementwise_attr_t& attr,
+                           std::vector<int>* regs);
+
+ private:
+  template <typename JMM>
+  void load(JMM& dst, int input, bool single);  // NOLINT
+  template <typename JMM>
+  void store(int output, JMM& src, bool single);  // NOLINT
+  template <typename JMM>
+  void genSteps(bool single);
+
+  fused_elementwise_attr_t attr_;
+  std::vector<int> regs_;
+  // The alpha and beta of every step, broadcasted from here.
+  std::vector<float> consts_;
+
+  reg64_t param_x{abi_param1};
+  reg64_t param_out{abi_param2};
+  reg32_t param_n{abi_param3};
+
+  reg64_t reg_offset{r8};
+  reg64_t reg_end_block{r9};
+  reg64_t reg_ptr{r10};
+  reg64_t reg_end{r11};
+};
+
+}  // namespace gen
+}  // namespace jit
+}  // namespace lite
+}  // namespace paddle
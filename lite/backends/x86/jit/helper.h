@@ -258,6 +258,19 @@ inline std::ostream& operator<<(std::ostream& os, const matmul_attr_t& attr) {
   return os;
 }
 
+inline std::ostream& operator<<(std::ostream& os,
+                                const fused_elementwise_attr_t& attr) {
+  os << "inputs[" << attr.num_inputs << "],scalar_mask[" << attr.scalar_mask
+     << "],steps[";
+  for (int i = 0; i < attr.num_steps; ++i) {
+    const auto& step = attr.steps[i];
+    os << (i > 0 ? "," : "") << step.type << "(" << step.x << "," << step.y
+       << ")";
+  }
+  os << "],outputs[" << attr.num_outputs << "]";
+  return os;
+}
+
 // expose the method to pack matmul weight
 template <typename T>
 void pack_weights(const T* src, T* dst, int n, int k);
@@ -25,6 +25,7 @@ typedef enum {
   // sort by alphabet
   kCRFDecoding = 1,
   kEmbSeqPool = 2,
+  kFusedElementwise,
   kGRUH1,
   kGRUHtPart1,
   kGRUHtPart2,
@@ -133,6 +134,27 @@ DECLARE_KERNELTUPLE(XRNTuple, HSum);
 
 DECLARE_KERNELTUPLE(XRNSTuple, StrideASum);
 
+typedef enum {
+  kFusedNone = 0,
+  kFusedAdd = 1,
+  kFusedSub,
+  kFusedMul,
+  kFusedDiv,
+  kFusedMax,
+  kFusedMin,
+  kFusedScale,  // x * alpha + beta
+  kFusedRelu,
+  kFusedExp,
+  kFusedSigmoid,
+  kFusedTanh,
+  kFusedSquare,
+  kFusedIdentity,
+} FusedElementwiseType;
+
+inline bool IsBinaryFusedElementwise(FusedElementwiseType type) {
+  return type >= kFusedAdd && type <= kFusedMin;
+}
+
 typedef struct {
   void* gates;  // gates: x_ch, x_ih, x_fh, x_oh
   const void* ct_1;
@@ -328,6 +350,39 @@ struct NCHW16CMulNCTuple {
   typedef void (*func_type)(const T*, const T*, T*, int, int);
 };
 
+typedef struct fused_elementwise_step_s {
+  FusedElementwiseType type;
+  int x, y;  // y is only used by the binary types
+  float alpha, beta;
+} fused_elementwise_step_t;
+
+// A chain of elementwise steps computed in one pass over the elements. The
+// values are numbered by the inputs first and then by the steps, the step i
+// writes the value num_inputs + i, and only the values in outputs are stored.
+typedef struct fused_elementwise_attr_s {
+  static constexpr int kMaxInputs = 16;
+  static constexpr int kMaxSteps = 32;
+  static constexpr int kMaxOutputs = 16;
+  int num_inputs{0};
+  int num_steps{0};
+  int num_outputs{0};
+  // The bit i is set if the input i is a single value for all the elements.
+  int scalar_mask{0};
+  fused_elementwise_step_t steps[kMaxSteps];
+  int outputs[kMaxOutputs];
+} fused_elementwise_attr_t;
+
+template <typename T>
+struct FusedElementwiseTuple {
+  static constexpr KernelType kernel_type = kFusedElementwise;
+  typedef T data_type;
+  typedef fused_elementwise_attr_t attr_type;
+  typedef void (*func_type)(const T* const*,
+                            T* const*,
+                            int,
+                            const fused_elementwise_attr_t*);
+};
+
 // Just for adding to kernel pool without template
 class Kernel {
  public:
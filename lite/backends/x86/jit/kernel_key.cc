@@ -61,6 +61,19 @@ int64_t JitCodeKey<emb_seq_pool_attr_t>(const emb_seq_pool_attr_t& attr) {
   return attr.table_width;
 }
 
+template <>
+int64_t JitCodeKey<fused_elementwise_attr_t>(
+    const fused_elementwise_attr_t& attr) {
+  // The length is given at runtime, the code only depends on the steps.
+  int64_t key = XXH64(&attr.num_inputs, sizeof(int) * 4, 0);
+  key = XXH64(attr.steps,
+              sizeof(fused_elementwise_step_t) * attr.num_steps,
+              static_cast<uint64_t>(key));
+  return XXH64(attr.outputs,
+               sizeof(int) * attr.num_outputs,
+               static_cast<uint64_t>(key));
+}
+
 template <>
 int64_t JitCodeKey<sgd_attr_t>(const sgd_attr_t& attr) {
   return attr.grad_width;
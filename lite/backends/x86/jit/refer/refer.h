@@ -541,6 +541,72 @@ void Sgd(const T* lr,
   }
 }
 
+template <typename T>
+void FusedElementwise(const T* const* x,
+                      T* const* out,
+                      int n,
+                      const lite::jit::fused_elementwise_attr_t* attr) {
+  using attr_t = lite::jit::fused_elementwise_attr_t;
+  T values[attr_t::kMaxInputs + attr_t::kMaxSteps];
+  for (int i = 0; i < n; ++i) {
+    for (int k = 0; k < attr->num_inputs; ++k) {
+      values[k] = ((attr->scalar_mask >> k) & 1) ? x[k][0] : x[k][i];
+    }
+    for (int s = 0; s < attr->num_steps; ++s) {
+      const auto& step = attr->steps[s];
+      const T a = values[step.x];
+      const T b = IsBinaryFusedElementwise(step.type) ? values[step.y] : a;
+      T* res = &values[attr->num_inputs + s];
+      switch (step.type) {
+        case kFusedAdd:
+          *res = a + b;
+          break;
+        case kFusedSub:
+          *res = a - b;
+          break;
+        case kFusedMul:
+          *res = a * b;
+          break;
+        case kFusedDiv:
+          *res = a / b;
+          break;
+        case kFusedMax:
+          *res = a > b ? a : b;
+          break;
+        case kFusedMin:
+          *res = a < b ? a : b;
+          break;
+        case kFusedScale:
+          *res = a * static_cast<T>(step.alpha) + static_cast<T>(step.beta);
+          break;
+        case kFusedRelu:
+          VRelu(&a, res, 1);
+          break;
+        case kFusedExp:
+          VExp(&a, res, 1);
+          break;
+        case kFusedSigmoid:
+          VSigmoid(&a, res, 1);
+          break;
+        case kFusedTanh:
+          VTanh(&a, res, 1);
+          break;
+        case kFusedSquare:
+          VSquare(&a, res, 1);
+          break;
+        case kFusedIdentity:
+          *res = a;
+          break;
+        default:
+          LOG(FATAL) << "Not support type: " << step.type;
+      }
+    }
+    for (int k = 0; k < attr->num_outputs; ++k) {
+      out[k][i] = values[attr->outputs[k]];
+    }
+  }
+}
+
 #define DECLARE_REFER_KERNEL(name)                                     \
   template <typename T>                                                \
   class name##Kernel : public lite::jit::ReferKernel<name##Tuple<T>> { \
@@ -594,6 +660,7 @@ DECLARE_REFER_KERNEL(Softmax);
 DECLARE_REFER_KERNEL(EmbSeqPool);
 DECLARE_REFER_KERNEL(Sgd);
 DECLARE_REFER_KERNEL(VBroadcast);
+DECLARE_REFER_KERNEL(FusedElementwise);
 
 #undef DECLARE_REFER_KERNEL
 
@@ -1031,6 +1031,56 @@ void TestKernelVBroadcast() {
   }
 }
 
+template <typename KernelTuple, typename PlaceType>
+void TestKernelFusedElementwise() {
+  using T = typename KernelTuple::data_type;
+  VLOG(10) << "Test JITKernel: " << jit::to_string(KernelTuple::kernel_type);
+  // out0 = relu((x + y) * 0.5 - 1), out1 = tanh(sigmoid(out0 * s) - x)
+  jit::fused_elementwise_attr_t attr;
+  attr.num_inputs = 3;
+  attr.scalar_mask = 1 << 2;
+  attr.steps[0] = {jit::kFusedAdd, 0, 1, 0.f, 0.f};
+  attr.steps[1] = {jit::kFusedScale, 3, 3, 0.5f, -1.f};
+  attr.steps[2] = {jit::kFusedRelu, 4, 4, 0.f, 0.f};
+  attr.steps[3] = {jit::kFusedMul, 5, 2, 0.f, 0.f};
+  attr.steps[4] = {jit::kFusedSigmoid, 6, 6, 0.f, 0.f};
+  attr.steps[5] = {jit::kFusedSub, 7, 0, 0.f, 0.f};
+  attr.steps[6] = {jit::kFusedTanh, 8, 8, 0.f, 0.f};
+  attr.num_steps = 7;
+  attr.outputs[0] = 5;
+  attr.outputs[1] = 9;
+  attr.num_outputs = 2;
+  auto ref = jit::GetReferFunc<KernelTuple>();
+  EXPECT_TRUE(ref != nullptr);
+  for (int n : TestSizes()) {
+    std::vector<T> x(n), y(n), s(1), out0ref(n), out1ref(n);
+    RandomVec<T>(n, x.data());
+    RandomVec<T>(n, y.data());
+    RandomVec<T>(1, s.data());
+    const T* inputs[] = {x.data(), y.data(), s.data()};
+    T* outputs[] = {out0ref.data(), out1ref.data()};
+    ref(inputs, outputs, n, &attr);
+    auto verifier = [](const typename KernelTuple::func_type tgt,
+                       const std::vector<T>& x,
+                       const std::vector<T>& y,
+                       const std::vector<T>& s,
+                       const std::vector<T>& out0ref,
+                       const std::vector<T>& out1ref,
+                       const typename KernelTuple::attr_type& attr) {
+      EXPECT_TRUE(tgt != nullptr);
+      int n = x.size();
+      std::vector<T> out0(n), out1(n);
+      const T* inputs[] = {x.data(), y.data(), s.data()};
+      T* outputs[] = {out0.data(), out1.data()};
+      tgt(inputs, outputs, n, &attr);
+      ExpectEQ<T>(out0.data(), out0ref.data(), n);
+      ExpectEQ<T>(out1.data(), out1ref.data(), n);
+    };
+    TestAllImpls<KernelTuple, PlaceType>(
+        attr, verifier, x, y, s, out0ref, out1ref, attr);
+  }
+}
+
 // test pool
 TEST(JITKernel_pool, jitcreator) {
   const auto& jitcreators = jit::JitCodeCreatorPool::Instance().AllCreators();
@@ -1353,6 +1403,28 @@ TEST(JITKernel_key, emb_seq_pool) {
   EXPECT_TRUE(key4 != key5);
 }
 
+TEST(JITKernel_key, fused_elementwise) {
+  jit::fused_elementwise_attr_t attr1, attr2, attr3;
+  for (auto* attr : {&attr1, &attr2, &attr3}) {
+    attr->num_inputs = 2;
+    attr->num_steps = 2;
+    attr->num_outputs = 1;
+    attr->steps[0] = {jit::kFusedAdd, 0, 1, 0.f, 0.f};
+    attr->steps[1] = {jit::kFusedRelu, 2, 2, 0.f, 0.f};
+    attr->outputs[0] = 3;
+  }
+  // The unused steps do not change the key.
+  attr2.steps[2] = {jit::kFusedExp, 3, 3, 1.f, 2.f};
+  attr3.steps[1].type = jit::kFusedTanh;
+
+  auto key1 = jit::JitCodeKey<jit::fused_elementwise_attr_t>(attr1);
+  auto key2 = jit::JitCodeKey<jit::fused_elementwise_attr_t>(attr2);
+  auto key3 = jit::JitCodeKey<jit::fused_elementwise_attr_t>(attr3);
+
+  EXPECT_TRUE(key1 == key2);
+  EXPECT_TRUE(key1 != key3);
+}
+
 TEST(JITKernel_key, sgd) {
   jit::sgd_attr_t attr1(1, 2, 3, 4, 5);
   jit::sgd_attr_t attr2(1, 2, 3, 4, 5);
@@ -1442,6 +1514,7 @@ TEST_CPU_KERNEL(MatMul);
 TEST_CPU_KERNEL(Softmax);
 TEST_CPU_KERNEL(Sgd);
 TEST_CPU_KERNEL(VBroadcast);
+TEST_CPU_KERNEL(FusedElementwise);
 
 TEST_CPU_KERNEL(StrideASum);
 TEST_CPU_KERNEL(StrideScal);
@@ -0,0 +1,263 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/x86/math/conv_direct.h"
+#include <algorithm>
+#include "lite/backends/x86/cpu_info.h"
+#include "lite/backends/x86/math/conv_kernels.h"
+#include "lite/backends/x86/parallel.h"
+
+#ifdef __AVX__
+#include <immintrin.h>
+#endif
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+namespace {
+
+struct VecScalar {
+  typedef float type;
+  static const int kWidth = 1;
+  static type zero() { return 0.f; }
+  static type set1(float x) { return x; }
+  static type load(const float* p) { return *p; }
+  static void store(float* p, type v) { *p = v; }
+  static type fmadd(type a, type b, type c) { return a * b + c; }
+};
+
+#ifdef __AVX__
+// For the CPUs with AVX but no FMA, the others pick conv_kernels_avx2.
+struct VecAvx {
+  typedef __m256 type;
+  static const int kWidth = 8;
+  static type zero() { return _mm256_setzero_ps(); }
+  static type set1(float x) { return _mm256_set1_ps(x); }
+  static type load(const float* p) { return _mm256_loadu_ps(p); }
+  static void store(float* p, type v) { _mm256_storeu_ps(p, v); }
+  static type fmadd(type a, type b, type c) {
+    return _mm256_add_ps(_mm256_mul_ps(a, b), c);
+  }
+};
+#endif
+
+const ConvKernels& PickConvKernels() {
+#ifdef LITE_CONV_WITH_AVX512
+  if (MayIUse(avx512f)) return conv_kernels_avx512();
+#endif
+#ifdef LITE_CONV_WITH_AVX2
+  if (MayIUse(avx2) && MayIUse(fma)) return conv_kernels_avx2();
+#endif
+#ifdef __AVX__
+  if (MayIUse(avx)) {
+    static const ConvKernels kernels = CONV_KERNELS(VecAvx);
+    return kernels;
+  }
+#endif
+  static const ConvKernels kernels = CONV_KERNELS(VecScalar);
+  return kernels;
+}
+
+struct PaddedShape {
+  int h;
+  int w;
+};
+
+PaddedShape GetPaddedShape(const operators::ConvParam& param,
+                           int hout,
+                           int wout) {
+  const auto& w_dims = param.filter->dims();
+  // All the input pixels used by the output, the bottom and right paddings
+  // may be cropped.
+  return {static_cast<int>((hout - 1) * param.strides[0] + w_dims[2]),
+          static_cast<int>((wout - 1) * param.strides[1] + w_dims[3])};
+}
+
+}  // namespace
+
+const ConvKernels& conv_kernels() {
+  static const ConvKernels& kernels = PickConvKernels();
+  return kernels;
+}
+
+int conv_direct_block() { return conv_kernels().block; }
+
+size_t conv_direct_packed_weights_size(int oc, int ic, int kh, int kw) {
+  int block = conv_direct_block();
+  return static_cast<size_t>((oc + block - 1) / block) * block * ic * kh * kw;
+}
+
+void conv_direct_pack_weights(
+    const float* weights, int oc, int ic, int kh, int kw, float* packed) {
+  const int block = conv_direct_block();
+  const int num_blocks = (oc + block - 1) / block;
+  const int kernel_size = ic * kh * kw;
+  for (int ob = 0; ob < num_blocks; ++ob) {
+    for (int k = 0; k < kernel_size; ++k) {
+      for (int b = 0; b < block; ++b) {
+        int o = ob * block + b;
+        *(packed++) = o < oc ? weights[o * kernel_size + k] : 0.f;
+      }
+    }
+  }
+}
+
+size_t conv_direct_workspace_size(const operators::ConvParam& param) {
+  const auto& x_dims = param.x->dims();
+  const auto& out_dims = param.output->dims();
+  auto padded = GetPaddedShape(param, out_dims[2], out_dims[3]);
+  return static_cast<size_t>(x_dims[0] * x_dims[1]) * padded.h * padded.w;
+}
+
+void conv_direct_fp32(const float* din,
+                      float* dout,
+                      int num,
+                      int chout,
+                      int hout,
+                      int wout,
+                      int chin,
+                      int hin,
+                      int win,
+                      const float* packed_weights,
+                      const operators::ConvParam& param,
+                      float* workspace) {
+  const auto& kernels = conv_kernels();
+  const int block = kernels.block;
+  const int kh = param.filter->dims()[2];
+  const int kw = param.filter->dims()[3];
+  const int sh = param.strides[0];
+  const int sw = param.strides[1];
+  const int pad_top = (*param.paddings)[0];
+  const int pad_left = (*param.paddings)[2];
+  const auto padded = GetPaddedShape(param, hout, wout);
+  const int padded_size = padded.h * padded.w;
+
+  // Zero pad the input, so the inner loops need no bound checks.
+  RunParallelFor(0, num * chin, [&](int64_t begin, int64_t end) {
+    for (int64_t idx = begin; idx < end; ++idx) {
+      const float* in = din + idx * hin * win;
+      float* out = workspace + idx * padded_size;
+      for (int h = 0; h < padded.h; ++h) {
+        int ih = h - pad_top;
+        float* out_row = out + h * padded.w;
+        if (ih < 0 || ih >= hin) {
+          std::fill(out_row, out_row + padded.w, 0.f);
+          continue;
+        }
+        for (int w = 0; w < padded.w; ++w) {
+          int iw = w - pad_left;
+          out_row[w] = (iw < 0 || iw >= win) ? 0.f : in[ih * win + iw];
+        }
+      }
+    }
+  });
+
+  const int num_blocks = (chout + block - 1) / block;
+  const int out_size = hout * wout;
+  const int weights_step = chin * kh * kw * block;
+  RunParallelFor(
+      0, num * num_blocks * hout, [&](int64_t begin, int64_t end) {
+        for (int64_t idx = begin; idx < end; ++idx) {
+          int n = idx / (num_blocks * hout);
+          int ob = (idx / hout) % num_blocks;
+          int h = idx % hout;
+          kernels.direct_row(
+              workspace + n * chin * padded_size + h * sh * padded.w,
+              packed_weights + ob * weights_step,
+              dout + (n * chout + ob * block) * out_size + h * wout,
+              chin,
+              kh,
+              kw,
+              sw,
+              padded.w,
+              padded_size,
+              wout,
+              out_size,
+              std::min(block, chout - ob * block));
+        }
+      });
+}
+
+void conv_depthwise_s1_fp32(const float* din,
+                            float* dout,
+                            int num,
+                            int chout,
+                            int hout,
+                            int wout,
+                            int chin,
+                            int hin,
+                            int win,
+                            const float* weights,
+                            const operators::ConvParam& param) {
+  const auto& kernels = conv_kernels();
+  const int kh = param.filter->dims()[2];
+  const int kw = param.filter->dims()[3];
+  const int pad_top = (*param.paddings)[0];
+  const int pad_left = (*param.paddings)[2];
+  const int multiplier = chout / chin;
+  // The outputs in [x_begin, x_end) of a row read no horizontal padding.
+  const int x_begin = std::min(pad_left, wout);
+  const int x_end = std::max(x_begin, std::min(wout, win + pad_left - kw + 1));
+
+  RunParallelFor(0, num * chout, [&](int64_t begin, int64_t end) {
+    for (int64_t idx = begin; idx < end; ++idx) {
+      int n = idx / chout;
+      int oc = idx % chout;
+      const float* in = din + (n * chin + oc / multiplier) * hin * win;
+      const float* w = weights + oc * kh * kw;
+      float* out = dout + idx * hout * wout;
+      for (int h = 0; h < hout; ++h) {
+        int ih0 = h - pad_top;
+        int i_begin = std::max(0, -ih0);
+        int i_end = std::min(kh, hin - ih0);
+        auto compute = [&](int x) {
+          float sum = 0.f;
+          for (int i = i_begin; i < i_end; ++i) {
+            const float* row = in + (ih0 + i) * win;
+            for (int j = 0; j < kw; ++j) {
+              int iw = x - pad_left + j;
+              if (iw >= 0 && iw < win) sum += row[iw] * w[i * kw + j];
+            }
+          }
+          out[h * wout + x] = sum;
+        };
+        int x = 0;
+        for (; x < x_begin; ++x) {
+          compute(x);
+        }
+        x = kernels.depthwise_row(in,
+                                  w,
+                                  out + h * wout,
+                                  win,
+                                  kw,
+                                  ih0,
+                                  pad_left,
+                                  i_begin,
+                                  i_end,
+                                  x,
+                                  x_end);
+        for (; x < wout; ++x) {
+          compute(x);
+        }
+      }
+    }
+  });
+}
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
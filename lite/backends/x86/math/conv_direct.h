@@ -0,0 +1,69 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "lite/core/context.h"
+#include "lite/operators/op_params.h"
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+/// The direct convolutions compute a block of output channels with one SIMD
+/// register, the block is 16 with AVX-512, 8 with AVX and 1 otherwise.
+int conv_direct_block();
+
+/// Pack the weights [oc, ic, kh, kw] to [ceil(oc / block), ic, kh, kw, block],
+/// the tail of the last block is filled with zeros.
+size_t conv_direct_packed_weights_size(int oc, int ic, int kh, int kw);
+void conv_direct_pack_weights(
+    const float* weights, int oc, int ic, int kh, int kw, float* packed);
+
+/// The number of floats of the zero padded input.
+size_t conv_direct_workspace_size(const operators::ConvParam& param);
+
+/// The direct convolution without groups and dilation, in NCHW.
+void conv_direct_fp32(const float* din,
+                      float* dout,
+                      int num,
+                      int chout,
+                      int hout,
+                      int wout,
+                      int chin,
+                      int hin,
+                      int win,
+                      const float* packed_weights,
+                      const operators::ConvParam& param,
+                      float* workspace);
+
+/// The depthwise convolution with stride 1 and no dilation of any kernel size,
+/// every input channel produces `chout / chin` output channels.
+void conv_depthwise_s1_fp32(const float* din,
+                            float* dout,
+                            int num,
+                            int chout,
+                            int hout,
+                            int wout,
+                            int chin,
+                            int hin,
+                            int win,
+                            const float* weights,
+                            const operators::ConvParam& param);
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,348 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+// The vectorized inner loops of the direct and winograd convolutions, written
+// once over a vector type V with the static members type, kWidth, zero, set1,
+// load, store and fmadd. The SIMD ones are built in their own translation
+// units with the flags of their ISA and only called if MayIUse reports it, so
+// this header is kept free of the inline functions of other headers, whose ISA
+// specific copies could be picked by the linker.
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+// Y = A^T [(G g G^T) .* (B^T d B)] A
+struct ConvWinogradMatrices {
+  int m;
+  int alpha;
+  const float* g;   // alpha x 3
+  const float* bt;  // alpha x alpha
+  const float* at;  // m x alpha
+};
+
+// The shape of the tiles of an image.
+struct ConvTileShape {
+  int h;
+  int w;
+  int tiles_w;
+  int pad_top;
+  int pad_left;
+};
+
+// Compute the output row `out` of a block of output channels, whose weights
+// are packed by conv_direct_pack_weights, from the zero padded input `in`
+// which starts at the top left pixel of the row. Only the first `valid`
+// channels of the block are stored.
+typedef void (*ConvDirectRowFunc)(const float* in,
+                                  const float* weights,
+                                  float* out,
+                                  int chin,
+                                  int kh,
+                                  int kw,
+                                  int sw,
+                                  int padded_w,
+                                  int padded_size,
+                                  int wout,
+                                  int out_size,
+                                  int valid);
+
+// Compute the outputs [x, x_end) of the depthwise row `out` with stride 1 by
+// whole vectors from the input image `in`, whose kernel rows [i_begin, i_end)
+// start at the input row ih0. Return the first output left.
+typedef int (*ConvDepthwiseRowFunc)(const float* in,
+                                    const float* weights,
+                                    float* out,
+                                    int win,
+                                    int kw,
+                                    int ih0,
+                                    int pad_left,
+                                    int i_begin,
+                                    int i_end,
+                                    int x,
+                                    int x_end);
+
+// v[k * stride + l] = (B^T d B)[k] of the `count` tiles from `tile` of the
+// image `in`, which are transformed together.
+typedef void (*ConvWinogradInputFunc)(const ConvWinogradMatrices& mat,
+                                      const float* in,
+                                      const ConvTileShape& shape,
+                                      int tile,
+                                      int count,
+                                      float* v,
+                                      int stride);
+
+// out = A^T M A of the `count` tiles from `tile` of the image `out`, whose
+// M[k] are at mt[k * stride + l]. The tiles are cropped to the image.
+typedef void (*ConvWinogradOutputFunc)(const ConvWinogradMatrices& mat,
+                                       const float* mt,
+                                       int stride,
+                                       const ConvTileShape& shape,
+                                       int tile,
+                                       int count,
+                                       float* out);
+
+// The kernels of a vector width, `block` is the number of output channels of
+// the direct convolutions and of tiles of the winograd ones.
+struct ConvKernels {
+  int block;
+  ConvDirectRowFunc direct_row;
+  ConvDepthwiseRowFunc depthwise_row;
+  ConvWinogradInputFunc winograd_input;
+  ConvWinogradOutputFunc winograd_output;
+};
+
+// The kernels of the vector type V.
+#define CONV_KERNELS(V)                                   \
+  {                                                       \
+    V::kWidth, conv_direct_row<V>, conv_depthwise_row<V>, \
+        conv_winograd_input<V>, conv_winograd_output<V>   \
+  }
+
+template <class V>
+static void conv_direct_row(const float* in,
+                            const float* weights,
+                            float* out,
+                            int chin,
+                            int kh,
+                            int kw,
+                            int sw,
+                            int padded_w,
+                            int padded_size,
+                            int wout,
+                            int out_size,
+                            int valid) {
+  typedef typename V::type vec_t;
+  const int block = V::kWidth;
+  float tmp[V::kWidth];
+  int x = 0;
+  // Four output pixels share every weight vector.
+  for (; x + 4 <= wout; x += 4) {
+    vec_t acc[4] = {V::zero(), V::zero(), V::zero(), V::zero()};
+    const float* w = weights;
+    for (int c = 0; c < chin; ++c) {
+      for (int i = 0; i < kh; ++i) {
+        const float* row = in + c * padded_size + i * padded_w + x * sw;
+        for (int j = 0; j < kw; ++j, w += block) {
+          vec_t wv = V::load(w);
+          acc[0] = V::fmadd(V::set1(row[j]), wv, acc[0]);
+          acc[1] = V::fmadd(V::set1(row[j + sw]), wv, acc[1]);
+          acc[2] = V::fmadd(V::set1(row[j + 2 * sw]), wv, acc[2]);
+          acc[3] = V::fmadd(V::set1(row[j + 3 * sw]), wv, acc[3]);
+        }
+      }
+    }
+    for (int p = 0; p < 4; ++p) {
+      V::store(tmp, acc[p]);
+      for (int k = 0; k < valid; ++k) {
+        out[k * out_size + x + p] = tmp[k];
+      }
+    }
+  }
+  for (; x < wout; ++x) {
+    vec_t acc = V::zero();
+    const float* w = weights;
+    for (int c = 0; c < chin; ++c) {
+      for (int i = 0; i < kh; ++i) {
+        const float* row = in + c * padded_size + i * padded_w + x * sw;
+        for (int j = 0; j < kw; ++j, w += block) {
+          acc = V::fmadd(V::set1(row[j]), V::load(w), acc);
+        }
+      }
+    }
+    V::store(tmp, acc);
+    for (int k = 0; k < valid; ++k) {
+      out[k * out_size + x] = tmp[k];
+    }
+  }
+}
+
+template <class V>
+static int conv_depthwise_row(const float* in,
+                              const float* weights,
+                              float* out,
+                              int win,
+                              int kw,
+                              int ih0,
+                              int pad_left,
+                              int i_begin,
+                              int i_end,
+                              int x,
+                              int x_end) {
+  typedef typename V::type vec_t;
+  for (; x + V::kWidth <= x_end; x += V::kWidth) {
+    vec_t acc = V::zero();
+    for (int i = i_begin; i < i_end; ++i) {
+      const float* row = in + (ih0 + i) * win + x - pad_left;
+      for (int j = 0; j < kw; ++j) {
+        acc = V::fmadd(V::set1(weights[i * kw + j]), V::load(row + j), acc);
+      }
+    }
+    V::store(out + x, acc);
+  }
+  return x;
+}
+
+// c[rows x cols] = a[rows x k] * b[k x cols], every element of b and c is a
+// vector of the same element of V::kWidth tiles.
+template <class V>
+static void conv_winograd_matmul(const float* a,
+                                 const typename V::type* b,
+                                 typename V::type* c,
+                                 int rows,
+                                 int k,
+                                 int cols) {
+  for (int i = 0; i < rows * cols; ++i) {
+    c[i] = V::zero();
+  }
+  for (int i = 0; i < rows; ++i) {
+    for (int l = 0; l < k; ++l) {
+      // Many of the entries of the transform matrices are zeros.
+      const float s = a[i * k + l];
+      if (s == 0.f) continue;
+      const typename V::type vs = V::set1(s);
+      for (int j = 0; j < cols; ++j) {
+        c[i * cols + j] = V::fmadd(vs, b[l * cols + j], c[i * cols + j]);
+      }
+    }
+  }
+}
+
+// c[rows x cols] = b[rows x k] * a^T, a is [cols x k].
+template <class V>
+static void conv_winograd_matmul_trans_a(const typename V::type* b,
+                                         const float* a,
+                                         typename V::type* c,
+                                         int rows,
+                                         int k,
+                                         int cols) {
+  for (int i = 0; i < rows; ++i) {
+    for (int j = 0; j < cols; ++j) {
+      typename V::type sum = V::zero();
+      for (int l = 0; l < k; ++l) {
+        const float s = a[j * k + l];
+        if (s == 0.f) continue;
+        sum = V::fmadd(V::set1(s), b[i * k + l], sum);
+      }
+      c[i * cols + j] = sum;
+    }
+  }
+}
+
+template <class V>
+static void conv_winograd_input(const ConvWinogradMatrices& mat,
+                                const float* in,
+                                const ConvTileShape& shape,
+                                int tile,
+                                int count,
+                                float* v,
+                                int stride) {
+  const int w = V::kWidth;
+  const int alpha = mat.alpha;
+  const int alpha2 = alpha * alpha;
+  float d[8 * 8 * V::kWidth];
+  for (int l = 0; l < w; ++l) {
+    int ih0 = ((tile + l) / shape.tiles_w) * mat.m - shape.pad_top;
+    int iw0 = ((tile + l) % shape.tiles_w) * mat.m - shape.pad_left;
+    for (int i = 0; i < alpha; ++i) {
+      int ih = ih0 + i;
+      for (int j = 0; j < alpha; ++j) {
+        int iw = iw0 + j;
+        d[(i * alpha + j) * w + l] =
+            (l >= count || ih < 0 || ih >= shape.h || iw < 0 || iw >= shape.w)
+                ? 0.f
+                : in[ih * shape.w + iw];
+      }
+    }
+  }
+  typename V::type vd[8 * 8];
+  typename V::type tmp[8 * 8];
+  typename V::type vv[8 * 8];
+  for (int k = 0; k < alpha2; ++k) {
+    vd[k] = V::load(d + k * w);
+  }
+  conv_winograd_matmul<V>(mat.bt, vd, tmp, alpha, alpha, alpha);
+  conv_winograd_matmul_trans_a<V>(tmp, mat.bt, vv, alpha, alpha, alpha);
+  for (int k = 0; k < alpha2; ++k) {
+    if (count == w) {
+      V::store(v + k * stride, vv[k]);
+      continue;
+    }
+    // The partial groups must not write the tiles of the next row of v.
+    V::store(d, vv[k]);
+    for (int l = 0; l < count; ++l) {
+      v[k * stride + l] = d[l];
+    }
+  }
+}
+
+template <class V>
+static void conv_winograd_output(const ConvWinogradMatrices& mat,
+                                 const float* mt,
+                                 int stride,
+                                 const ConvTileShape& shape,
+                                 int tile,
+                                 int count,
+                                 float* out) {
+  const int w = V::kWidth;
+  const int m = mat.m;
+  const int alpha = mat.alpha;
+  typename V::type vm[8 * 8];
+  typename V::type tmp[6 * 8];
+  typename V::type vy[6 * 6];
+  float y[6 * 6 * V::kWidth];
+  for (int k = 0; k < alpha * alpha; ++k) {
+    if (count == w) {
+      vm[k] = V::load(mt + k * stride);
+      continue;
+    }
+    for (int l = 0; l < w; ++l) {
+      y[l] = l < count ? mt[k * stride + l] : 0.f;
+    }
+    vm[k] = V::load(y);
+  }
+  conv_winograd_matmul<V>(mat.at, vm, tmp, m, alpha, alpha);
+  conv_winograd_matmul_trans_a<V>(tmp, mat.at, vy, m, alpha, m);
+  for (int k = 0; k < m * m; ++k) {
+    V::store(y + k * w, vy[k]);
+  }
+  for (int l = 0; l < count; ++l) {
+    int oh0 = ((tile + l) / shape.tiles_w) * m;
+    int ow0 = ((tile + l) % shape.tiles_w) * m;
+    int rows = shape.h - oh0 < m ? shape.h - oh0 : m;
+    int cols = shape.w - ow0 < m ? shape.w - ow0 : m;
+    for (int i = 0; i < rows; ++i) {
+      for (int j = 0; j < cols; ++j) {
+        out[(oh0 + i) * shape.w + ow0 + j] = y[(i * m + j) * w + l];
+      }
+    }
+  }
+}
+
+// The kernels of the widest vectors supported by the CPU, picked at runtime in
+// conv_direct.cc.
+const ConvKernels& conv_kernels();
+// Built with AVX2_FLAG and FMA_FLAG in conv_kernels_avx2.cc if
+// LITE_CONV_WITH_AVX2.
+const ConvKernels& conv_kernels_avx2();
+// Built with AVX512F_FLAG in conv_kernels_avx512.cc if LITE_CONV_WITH_AVX512.
+const ConvKernels& conv_kernels_avx512();
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,226 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/x86/math/conv_winograd.h"
+#include <algorithm>
+#include "lite/backends/x86/math/blas.h"
+#include "lite/backends/x86/math/conv_kernels.h"
+#include "lite/backends/x86/parallel.h"
+#include "lite/utils/cp_logging.h"
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+namespace {
+
+// The number of tiles transformed and multiplied at a time, which bounds the
+// workspace for the large images.
+const int kTileBlock = 64;
+
+const float kG43[] = {1.f / 4,   0.f,       0.f,      -1.f / 6, -1.f / 6,
+                      -1.f / 6,  -1.f / 6,  1.f / 6,  -1.f / 6, 1.f / 24,
+                      1.f / 12,  1.f / 6,   1.f / 24, -1.f / 12, 1.f / 6,
+                      0.f,       0.f,       1.f};
+const float kBT43[] = {4.f, 0.f,  -5.f, 0.f,  1.f, 0.f,  //
+                       0.f, -4.f, -4.f, 1.f,  1.f, 0.f,  //
+                       0.f, 4.f,  -4.f, -1.f, 1.f, 0.f,  //
+                       0.f, -2.f, -1.f, 2.f,  1.f, 0.f,  //
+                       0.f, 2.f,  -1.f, -2.f, 1.f, 0.f,  //
+                       0.f, 4.f,  0.f,  -5.f, 0.f, 1.f};
+const float kAT43[] = {1.f, 1.f, 1.f,  1.f, 1.f,  0.f,  //
+                       0.f, 1.f, -1.f, 2.f, -2.f, 0.f,  //
+                       0.f, 1.f, 1.f,  4.f, 4.f,  0.f,  //
+                       0.f, 1.f, -1.f, 8.f, -8.f, 1.f};
+
+const float kG63[] = {1.f,         0.f,         0.f,          //
+                      -2.f / 9,    -2.f / 9,    -2.f / 9,     //
+                      -2.f / 9,    2.f / 9,     -2.f / 9,     //
+                      1.f / 90,    1.f / 45,    2.f / 45,     //
+                      1.f / 90,    -1.f / 45,   2.f / 45,     //
+                      32.f / 45,   16.f / 45,   8.f / 45,     //
+                      32.f / 45,   -16.f / 45,  8.f / 45,     //
+                      0.f,         0.f,         1.f};
+const float kBT63[] = {
+    1.f, 0.f,    -21.f / 4, 0.f,       21.f / 4, 0.f,       -1.f, 0.f,  //
+    0.f, 1.f,    1.f,       -17.f / 4, -17.f / 4, 1.f,      1.f,  0.f,  //
+    0.f, -1.f,   1.f,       17.f / 4,  -17.f / 4, -1.f,     1.f,  0.f,  //
+    0.f, 0.5f,   0.25f,     -2.5f,     -1.25f,    2.f,      1.f,  0.f,  //
+    0.f, -0.5f,  0.25f,     2.5f,      -1.25f,    -2.f,     1.f,  0.f,  //
+    0.f, 2.f,    4.f,       -2.5f,     -5.f,      0.5f,     1.f,  0.f,  //
+    0.f, -2.f,   4.f,       2.5f,      -5.f,      -0.5f,    1.f,  0.f,  //
+    0.f, -1.f,   0.f,       21.f / 4,  0.f,       -21.f / 4, 0.f, 1.f};
+const float kAT63[] = {
+    1.f, 1.f, 1.f,  1.f,  1.f,   1.f,         1.f,          0.f,  //
+    0.f, 1.f, -1.f, 2.f,  -2.f,  0.5f,        -0.5f,        0.f,  //
+    0.f, 1.f, 1.f,  4.f,  4.f,   0.25f,       0.25f,        0.f,  //
+    0.f, 1.f, -1.f, 8.f,  -8.f,  0.125f,      -0.125f,      0.f,  //
+    0.f, 1.f, 1.f,  16.f, 16.f,  1.f / 16,    1.f / 16,     0.f,  //
+    0.f, 1.f, -1.f, 32.f, -32.f, 1.f / 32,    -1.f / 32,    1.f};
+
+ConvWinogradMatrices GetMatrices(int m) {
+  CHECK(m == 4 || m == 6) << "unsupported winograd tile size " << m;
+  if (m == 4) {
+    return {4, 6, kG43, kBT43, kAT43};
+  }
+  return {6, 8, kG63, kBT63, kAT63};
+}
+
+// c[rows x cols] = a[rows x k] * b, b is [k x cols], or [cols x k] if
+// `trans_b` is true.
+void SmallMatMul(const float* a,
+                 const float* b,
+                 float* c,
+                 int rows,
+                 int k,
+                 int cols,
+                 bool trans_b) {
+  for (int i = 0; i < rows; ++i) {
+    for (int j = 0; j < cols; ++j) {
+      float sum = 0.f;
+      for (int l = 0; l < k; ++l) {
+        sum += a[i * k + l] * (trans_b ? b[j * k + l] : b[l * cols + j]);
+      }
+      c[i * cols + j] = sum;
+    }
+  }
+}
+
+}  // namespace
+
+size_t conv_winograd_weights_size(int oc, int ic, int m) {
+  int alpha = m + 2;
+  return static_cast<size_t>(alpha) * alpha * oc * ic;
+}
+
+void conv_winograd_transform_weights(
+    const float* weights, int oc, int ic, int m, float* trans_weights) {
+  auto mat = GetMatrices(m);
+  const int alpha = mat.alpha;
+  const int alpha2 = alpha * alpha;
+  float tmp[8 * 3];
+  float u[8 * 8];
+  for (int o = 0; o < oc; ++o) {
+    for (int c = 0; c < ic; ++c) {
+      const float* g = weights + (o * ic + c) * 9;
+      SmallMatMul(mat.g, g, tmp, alpha, 3, 3, false);
+      SmallMatMul(tmp, mat.g, u, alpha, 3, alpha, true);
+      for (int k = 0; k < alpha2; ++k) {
+        trans_weights[(k * oc + o) * ic + c] = u[k];
+      }
+    }
+  }
+}
+
+size_t conv_winograd_workspace_size(int chout, int chin, int m) {
+  int alpha = m + 2;
+  return static_cast<size_t>(alpha) * alpha * (chin + chout) * kTileBlock;
+}
+
+// The transforms of the tiles are vectorized across conv_kernels().block
+// tiles, the last ones of a block too.
+void conv_winograd_fp32(const float* din,
+                        float* dout,
+                        int num,
+                        int chout,
+                        int hout,
+                        int wout,
+                        int chin,
+                        int hin,
+                        int win,
+                        const float* trans_weights,
+                        int m,
+                        int pad_top,
+                        int pad_left,
+                        float* workspace,
+                        const X86Context& ctx) {
+  const auto& kernels = conv_kernels();
+  const int block = kernels.block;
+  auto mat = GetMatrices(m);
+  const int alpha = mat.alpha;
+  const int alpha2 = alpha * alpha;
+  const int tiles_h = (hout + m - 1) / m;
+  const int tiles_w = (wout + m - 1) / m;
+  const int num_tiles = tiles_h * tiles_w;
+  const ConvTileShape in_shape{hin, win, tiles_w, pad_top, pad_left};
+  const ConvTileShape out_shape{hout, wout, tiles_w, 0, 0};
+  float* v_data = workspace;
+  float* m_data = workspace + alpha2 * chin * kTileBlock;
+  auto blas = GetBlas<lite::TargetType::kX86, float>(ctx);
+
+  for (int n = 0; n < num; ++n) {
+    const float* in_batch = din + n * chin * hin * win;
+    float* out_batch = dout + n * chout * hout * wout;
+    for (int t0 = 0; t0 < num_tiles; t0 += kTileBlock) {
+      const int nt = std::min(kTileBlock, num_tiles - t0);
+
+      // V[k][c][t] = (B^T d B)[k]
+      RunParallelFor(0, chin, [&](int64_t begin, int64_t end) {
+        for (int64_t c = begin; c < end; ++c) {
+          const float* in = in_batch + c * hin * win;
+          for (int t = 0; t < nt; t += block) {
+            kernels.winograd_input(mat,
+                                   in,
+                                   in_shape,
+                                   t0 + t,
+                                   std::min(block, nt - t),
+                                   v_data + c * nt + t,
+                                   chin * nt);
+          }
+        }
+      });
+
+      // M[k] = U[k] * V[k]
+      RunParallelFor(0, alpha2, [&](int64_t begin, int64_t end) {
+        for (int64_t k = begin; k < end; ++k) {
+          blas.GEMM(false,
+                    false,
+                    chout,
+                    nt,
+                    chin,
+                    1.f,
+                    trans_weights + k * chout * chin,
+                    chin,
+                    v_data + k * chin * nt,
+                    nt,
+                    0.f,
+                    m_data + k * chout * nt,
+                    nt);
+        }
+      });
+
+      // Y = A^T M A
+      RunParallelFor(0, chout, [&](int64_t begin, int64_t end) {
+        for (int64_t o = begin; o < end; ++o) {
+          float* out = out_batch + o * hout * wout;
+          for (int t = 0; t < nt; t += block) {
+            kernels.winograd_output(mat,
+                                    m_data + o * nt + t,
+                                    chout * nt,
+                                    out_shape,
+                                    t0 + t,
+                                    std::min(block, nt - t),
+                                    out);
+          }
+        }
+      });
+    }
+  }
+}
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
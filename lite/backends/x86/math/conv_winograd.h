@@ -0,0 +1,57 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "lite/core/context.h"
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+/// Winograd F(m, 3) convolution for 3x3 filters with stride 1 and no
+/// dilation, `m` is the output tile size, 4 or 6.
+
+/// Transform the weights [oc, ic, 3, 3] to [(m + 2) * (m + 2), oc, ic].
+size_t conv_winograd_weights_size(int oc, int ic, int m);
+void conv_winograd_transform_weights(
+    const float* weights, int oc, int ic, int m, float* trans_weights);
+
+/// The number of floats of the workspace.
+size_t conv_winograd_workspace_size(int chout, int chin, int m);
+
+/// The input and output transforms of conv_direct_block() tiles are computed
+/// together in SIMD registers.
+
+void conv_winograd_fp32(const float* din,
+                        float* dout,
+                        int num,
+                        int chout,
+                        int hout,
+                        int wout,
+                        int chin,
+                        int hin,
+                        int win,
+                        const float* trans_weights,
+                        int m,
+                        int pad_top,
+                        int pad_left,
+                        float* workspace,
+                        const X86Context& ctx);
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
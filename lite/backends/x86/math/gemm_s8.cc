@@ -0,0 +1,208 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/x86/math/gemm_s8.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "lite/backends/x86/cpu_info.h"
+#include "lite/backends/x86/math/gemm_s8_kernels.h"
+#include "lite/backends/x86/parallel.h"
+#include "lite/utils/cp_logging.h"
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+namespace {
+
+const int kMR = kGemmS8MR;
+const int kNR = kGemmS8NR;
+// The columns of C computed by a task.
+const int kNBlock = 64;
+
+enum class GemmS8Isa { kScalar, kAvx2, kVnni };
+
+// The SIMD kernels are compiled whatever SIMD_FLAG is, see CMakeLists.txt.
+GemmS8Isa GetIsa() {
+#ifdef LITE_GEMM_S8_WITH_VNNI
+  if (MayIUse(avx512_core_vnni)) return GemmS8Isa::kVnni;
+#endif
+#ifdef LITE_GEMM_S8_WITH_AVX2
+  if (MayIUse(avx2)) return GemmS8Isa::kAvx2;
+#endif
+  return GemmS8Isa::kScalar;
+}
+
+template <int MR, int NR>
+void DotScalar(const int8_t* a,
+               int lda,
+               const int8_t* b,
+               int ldb,
+               int K,
+               const int32_t* comp,
+               int32_t* acc) {
+  std::fill(acc, acc + MR * NR, 0);
+  gemm_s8_dot_tail<MR, NR>(a, lda, b, ldb, 0, K, acc);
+}
+
+inline void StoreOutput(float v, float* c) { *c = v; }
+
+inline void StoreOutput(float v, int8_t* c) {
+  v = std::round(v);
+  *c = static_cast<int8_t>(std::min(std::max(v, -127.f), 127.f));
+}
+
+}  // namespace
+
+template <typename Dtype>
+void gemm_s8(int M,
+             int N,
+             int K,
+             const int8_t* A,
+             int lda,
+             const int8_t* B,
+             int ldb,
+             Dtype* C,
+             int ldc,
+             const float* scale,
+             const float* bias,
+             bool per_row,
+             bool is_relu,
+             const int32_t* comp) {
+  CHECK(scale) << "the int8 gemm needs the scales";
+  static const GemmS8DotTable scalar_table = GEMM_S8_DOT_TABLE(DotScalar);
+  const GemmS8DotFunc(*table)[kNR] = scalar_table;
+  std::vector<int32_t> own_comp;
+  switch (GetIsa()) {
+#ifdef LITE_GEMM_S8_WITH_VNNI
+    case GemmS8Isa::kVnni:
+      table = gemm_s8_vnni_table();
+      if (!comp) {
+        own_comp = gemm_s8_compensation(N, K, B, ldb);
+        comp = own_comp.data();
+      }
+      break;
+#endif
+#ifdef LITE_GEMM_S8_WITH_AVX2
+    case GemmS8Isa::kAvx2:
+      table = gemm_s8_avx2_table();
+      break;
+#endif
+    default:
+      break;
+  }
+
+  const int num_mb = (M + kMR - 1) / kMR;
+  const int num_nb = (N + kNBlock - 1) / kNBlock;
+  lite::x86::RunParallelFor(
+      0, num_mb * num_nb, [&](int64_t begin, int64_t end) {
+        int32_t acc[kMR * kNR];
+        for (int64_t task = begin; task < end; ++task) {
+          const int i0 = static_cast<int>(task % num_mb) * kMR;
+          const int j_begin = static_cast<int>(task / num_mb) * kNBlock;
+          const int j_end = std::min(N, j_begin + kNBlock);
+          const int mr = std::min(kMR, M - i0);
+          for (int j0 = j_begin; j0 < j_end; j0 += kNR) {
+            const int nr = std::min(kNR, j_end - j0);
+            table[mr - 1][nr - 1](A + i0 * lda,
+                                  lda,
+                                  B + j0 * ldb,
+                                  ldb,
+                                  K,
+                                  comp ? comp + j0 : nullptr,
+                                  acc);
+            for (int i = 0; i < mr; ++i) {
+              for (int j = 0; j < nr; ++j) {
+                const int idx = per_row ? i0 + i : j0 + j;
+                float v = acc[i * nr + j] * scale[idx];
+                if (bias) {
+                  v += bias[idx];
+                }
+                if (is_relu) {
+                  v = std::max(v, 0.f);
+                }
+                StoreOutput(v, C + (i0 + i) * ldc + j0 + j);
+              }
+            }
+          }
+        }
+      });
+}
+
+template void gemm_s8<float>(int M,
+                             int N,
+                             int K,
+                             const int8_t* A,
+                             int lda,
+                             const int8_t* B,
+                             int ldb,
+                             float* C,
+                             int ldc,
+                             const float* scale,
+                             const float* bias,
+                             bool per_row,
+                             bool is_relu,
+                             const int32_t* comp);
+template void gemm_s8<int8_t>(int M,
+                              int N,
+                              int K,
+                              const int8_t* A,
+                              int lda,
+                              const int8_t* B,
+                              int ldb,
+                              int8_t* C,
+                              int ldc,
+                              const float* scale,
+                              const float* bias,
+                              bool per_row,
+                              bool is_relu,
+                              const int32_t* comp);
+
+std::vector<int32_t> gemm_s8_compensation(int N,
+                                          int K,
+                                          const int8_t* B,
+                                          int ldb) {
+  std::vector<int32_t> comp;
+  if (GetIsa() != GemmS8Isa::kVnni) return comp;
+  // The VNNI kernels add 128 to A over the multiple of 64 of K.
+  const int k_vec = K / 64 * 64;
+  comp.resize(N);
+  lite::x86::RunParallelFor(0, N, [&](int64_t begin, int64_t end) {
+    for (int64_t j = begin; j < end; ++j) {
+      int32_t sum = 0;
+      for (int k = 0; k < k_vec; ++k) {
+        sum += B[j * ldb + k];
+      }
+      comp[j] = 128 * sum;
+    }
+  });
+  return comp;
+}
+
+void transpose_s8(const int8_t* in, int rows, int cols, int ld, int8_t* out) {
+  lite::x86::RunParallelFor(0, cols, [&](int64_t begin, int64_t end) {
+    for (int64_t j = begin; j < end; ++j) {
+      for (int i = 0; i < rows; ++i) {
+        out[j * rows + i] = in[i * ld + j];
+      }
+    }
+  });
+}
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,64 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+/// The int8 GEMM C[M, N] = A[M, K] * B[N, K]^T, both operands are row major
+/// with K contiguous and accumulated in int32. The output is
+/// act(acc * scale + bias), where the scale and the bias are indexed by the
+/// row if `per_row` is true, otherwise by the column, the bias can be null.
+/// The int8 output is rounded and clamped to [-127, 127].
+///
+/// It uses AVX512-VNNI if compiled and supported by the CPU, otherwise AVX2.
+/// `comp` is the gemm_s8_compensation of B, computed by every call if null.
+template <typename Dtype>
+void gemm_s8(int M,
+             int N,
+             int K,
+             const int8_t* A,
+             int lda,
+             const int8_t* B,
+             int ldb,
+             Dtype* C,
+             int ldc,
+             const float* scale,
+             const float* bias,
+             bool per_row,
+             bool is_relu,
+             const int32_t* comp = nullptr);
+
+/// The compensation of the columns of B needed by the AVX512-VNNI kernels,
+/// empty if they are not used. B of the weights is constant, so the kernels
+/// compute it once in PrepareForRun.
+std::vector<int32_t> gemm_s8_compensation(int N,
+                                          int K,
+                                          const int8_t* B,
+                                          int ldb);
+
+/// Transpose the int8 matrix [rows, cols] with the leading dimension `ld` to
+/// [cols, rows], which gives the K contiguous operands of gemm_s8.
+void transpose_s8(const int8_t* in, int rows, int cols, int ld, int8_t* out);
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
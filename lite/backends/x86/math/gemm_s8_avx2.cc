@@ -0,0 +1,82 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <immintrin.h>
+#include "lite/backends/x86/math/gemm_s8_kernels.h"
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+namespace {
+
+inline int32_t ReduceAdd(__m256i v) {
+  __m128i s = _mm_add_epi32(_mm256_castsi256_si128(v),
+                            _mm256_extracti128_si256(v, 1));
+  s = _mm_hadd_epi32(s, s);
+  s = _mm_hadd_epi32(s, s);
+  return _mm_cvtsi128_si32(s);
+}
+
+// The int8 values are widened to int16 and multiplied by vpmaddwd, unlike
+// vpmaddubsw it never saturates the int16 sums of pairs.
+template <int MR, int NR>
+void DotAvx2(const int8_t* a,
+             int lda,
+             const int8_t* b,
+             int ldb,
+             int K,
+             const int32_t* comp,
+             int32_t* acc) {
+  __m256i sum[MR][NR];
+  for (int i = 0; i < MR; ++i) {
+    for (int j = 0; j < NR; ++j) {
+      sum[i][j] = _mm256_setzero_si256();
+    }
+  }
+  int k = 0;
+  for (; k + 16 <= K; k += 16) {
+    __m256i vb[NR];
+    for (int j = 0; j < NR; ++j) {
+      vb[j] = _mm256_cvtepi8_epi16(
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + j * ldb + k)));
+    }
+    for (int i = 0; i < MR; ++i) {
+      __m256i va = _mm256_cvtepi8_epi16(
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i * lda + k)));
+      for (int j = 0; j < NR; ++j) {
+        sum[i][j] = _mm256_add_epi32(sum[i][j], _mm256_madd_epi16(va, vb[j]));
+      }
+    }
+  }
+  for (int i = 0; i < MR; ++i) {
+    for (int j = 0; j < NR; ++j) {
+      acc[i * NR + j] = ReduceAdd(sum[i][j]);
+    }
+  }
+  gemm_s8_dot_tail<MR, NR>(a, lda, b, ldb, k, K, acc);
+}
+
+}  // namespace
+
+const GemmS8DotTable& gemm_s8_avx2_table() {
+  static const GemmS8DotTable table = GEMM_S8_DOT_TABLE(DotAvx2);
+  return table;
+}
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,80 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <stdint.h>
+
+// The micro kernels of gemm_s8. The SIMD ones are built in their own
+// translation units with the flags of their ISA and only called if MayIUse
+// reports it, so this header is kept free of the inline functions of other
+// headers, whose ISA specific copies could be picked by the linker.
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+// The register block of the micro kernels, MR rows of A by NR rows of B.
+const int kGemmS8MR = 4;
+const int kGemmS8NR = 2;
+
+// Compute the int32 dot products of MR rows of A by NR rows of B over K into
+// acc[MR * NR], `comp` is the compensation of the columns for the VNNI ones.
+typedef void (*GemmS8DotFunc)(const int8_t* a,
+                              int lda,
+                              const int8_t* b,
+                              int ldb,
+                              int K,
+                              const int32_t* comp,
+                              int32_t* acc);
+typedef GemmS8DotFunc GemmS8DotTable[kGemmS8MR][kGemmS8NR];
+
+// The kernels of the register blocks of the remaining rows and columns.
+#define GEMM_S8_DOT_TABLE(kernel)                                    \
+  {                                                                  \
+    {kernel<1, 1>, kernel<1, 2>}, {kernel<2, 1>, kernel<2, 2>},      \
+        {kernel<3, 1>, kernel<3, 2>}, { kernel<4, 1>, kernel<4, 2> } \
+  }
+
+// The scalar dot products of [k_begin, K), added to acc.
+template <int MR, int NR>
+static inline void gemm_s8_dot_tail(const int8_t* a,
+                                    int lda,
+                                    const int8_t* b,
+                                    int ldb,
+                                    int k_begin,
+                                    int K,
+                                    int32_t* acc) {
+  for (int i = 0; i < MR; ++i) {
+    for (int j = 0; j < NR; ++j) {
+      int32_t sum = 0;
+      for (int k = k_begin; k < K; ++k) {
+        sum += static_cast<int32_t>(a[i * lda + k]) * b[j * ldb + k];
+      }
+      acc[i * NR + j] += sum;
+    }
+  }
+}
+
+// Built with AVX2_FLAG in gemm_s8_avx2.cc if LITE_GEMM_S8_WITH_AVX2.
+const GemmS8DotTable& gemm_s8_avx2_table();
+// Built with AVX512VNNI_FLAG in gemm_s8_vnni.cc if LITE_GEMM_S8_WITH_VNNI,
+// the columns are compensated by 128 * sum(b) over the multiple of 64 of K.
+const GemmS8DotTable& gemm_s8_vnni_table();
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
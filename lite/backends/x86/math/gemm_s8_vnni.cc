@@ -0,0 +1,74 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <immintrin.h>
+#include "lite/backends/x86/math/gemm_s8_kernels.h"
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+namespace {
+
+// vpdpbusd multiplies unsigned by signed bytes, so A is shifted to unsigned by
+// flipping the sign bit, i.e. a + 128, and `comp` holds 128 * sum(b) of the
+// vectorized part of K to subtract.
+template <int MR, int NR>
+void DotVnni(const int8_t* a,
+             int lda,
+             const int8_t* b,
+             int ldb,
+             int K,
+             const int32_t* comp,
+             int32_t* acc) {
+  const __m512i flip = _mm512_set1_epi8(static_cast<char>(0x80));
+  __m512i sum[MR][NR];
+  for (int i = 0; i < MR; ++i) {
+    for (int j = 0; j < NR; ++j) {
+      sum[i][j] = _mm512_setzero_si512();
+    }
+  }
+  int k = 0;
+  for (; k + 64 <= K; k += 64) {
+    __m512i vb[NR];
+    for (int j = 0; j < NR; ++j) {
+      vb[j] = _mm512_loadu_si512(b + j * ldb + k);
+    }
+    for (int i = 0; i < MR; ++i) {
+      __m512i va = _mm512_xor_si512(_mm512_loadu_si512(a + i * lda + k), flip);
+      for (int j = 0; j < NR; ++j) {
+        sum[i][j] = _mm512_dpbusd_epi32(sum[i][j], va, vb[j]);
+      }
+    }
+  }
+  for (int i = 0; i < MR; ++i) {
+    for (int j = 0; j < NR; ++j) {
+      acc[i * NR + j] = _mm512_reduce_add_epi32(sum[i][j]) - comp[j];
+    }
+  }
+  gemm_s8_dot_tail<MR, NR>(a, lda, b, ldb, k, K, acc);
+}
+
+}  // namespace
+
+const GemmS8DotTable& gemm_s8_vnni_table() {
+  static const GemmS8DotTable table = GEMM_S8_DOT_TABLE(DotVnni);
+  return table;
+}
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,159 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/x86/math/gemm_w16.h"
+#include <algorithm>
+#include <vector>
+#include "lite/backends/x86/cpu_info.h"
+#include "lite/backends/x86/math/blas.h"
+#include "lite/backends/x86/math/gemm_w16_kernels.h"
+#include "lite/backends/x86/parallel.h"
+#include "lite/utils/cp_logging.h"
+#include "lite/utils/half.h"
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+namespace {
+
+// The columns of C computed by a task, and the rows of K in a panel of B,
+// a float panel is at most 256KB.
+const int kNBlock = 64;
+const int kKBlock = 1024;
+
+typedef int (*CvtFunc)(const uint16_t* in, int n, float* out);
+
+// The SIMD conversions of a type picked at runtime, the widest one first and
+// null if not built or not supported by the CPU.
+struct Converter {
+  W16Type type;
+  CvtFunc wide{nullptr};
+  CvtFunc narrow{nullptr};
+};
+
+Converter GetConverter(W16Type type) {
+  Converter cvt;
+  cvt.type = type;
+  if (type == W16Type::kFP16) {
+#ifdef LITE_GEMM_W16_WITH_F16C
+    if (MayIUse(f16c)) cvt.narrow = fp16_to_float_f16c;
+#endif
+#ifdef LITE_GEMM_W16_WITH_AVX512
+    if (MayIUse(avx512f)) cvt.wide = fp16_to_float_avx512;
+#endif
+  } else {
+#ifdef LITE_GEMM_W16_WITH_AVX2
+    if (MayIUse(avx2)) cvt.narrow = bf16_to_float_avx2;
+#endif
+#ifdef LITE_GEMM_W16_WITH_AVX512
+    if (MayIUse(avx512f)) cvt.wide = bf16_to_float_avx512;
+#endif
+  }
+  return cvt;
+}
+
+void Convert(const Converter& cvt, const uint16_t* in, int n, float* out) {
+  int i = 0;
+  if (cvt.wide) i = cvt.wide(in, n, out);
+  if (cvt.narrow) i += cvt.narrow(in + i, n - i, out + i);
+  if (cvt.type == W16Type::kFP16) {
+    for (; i < n; ++i) {
+      out[i] = HalfToFloat(in[i]);
+    }
+  } else {
+    for (; i < n; ++i) {
+      out[i] = BFloat16ToFloat(in[i]);
+    }
+  }
+}
+
+}  // namespace
+
+W16Type GetW16Type(const std::string& quant_type) {
+  if (quant_type == "bf16") return W16Type::kBF16;
+  CHECK_EQ(quant_type, "fp16") << "Unsupported weight quant type";
+  return W16Type::kFP16;
+}
+
+void w16_to_float(W16Type type, const uint16_t* in, int n, float* out) {
+  Convert(GetConverter(type), in, n, out);
+}
+
+void gemm_w16(const lite::X86Context& context,
+              W16Type type,
+              bool trans_b,
+              int M,
+              int N,
+              int K,
+              float alpha,
+              const float* A,
+              int lda,
+              const uint16_t* B,
+              int ldb,
+              float beta,
+              float* C,
+              int ldc) {
+  if (M <= 0 || N <= 0) return;
+  auto blas = GetBlas<lite::TargetType::kX86, float>(context);
+  const Converter cvt = GetConverter(type);
+  const int kb_max = std::min(K, kKBlock);
+  auto compute = [&](int64_t begin, int64_t end) {
+    std::vector<float> panel(static_cast<size_t>(kNBlock) * kb_max);
+    for (int64_t t = begin; t < end; ++t) {
+      const int n0 = static_cast<int>(t) * kNBlock;
+      const int nb = std::min(kNBlock, N - n0);
+      for (int k0 = 0; k0 < K; k0 += kKBlock) {
+        const int kb = std::min(kKBlock, K - k0);
+        // The panel is [kb, nb], or [nb, kb] if trans_b.
+        if (trans_b) {
+          for (int j = 0; j < nb; ++j) {
+            Convert(cvt,
+                    B + static_cast<int64_t>(n0 + j) * ldb + k0,
+                    kb,
+                    panel.data() + j * kb);
+          }
+        } else {
+          for (int k = 0; k < kb; ++k) {
+            Convert(cvt,
+                    B + static_cast<int64_t>(k0 + k) * ldb + n0,
+                    nb,
+                    panel.data() + k * nb);
+          }
+        }
+        blas.GEMM(false,
+                  trans_b,
+                  M,
+                  nb,
+                  kb,
+                  alpha,
+                  A + k0,
+                  lda,
+                  panel.data(),
+                  trans_b ? kb : nb,
+                  k0 == 0 ? beta : 1.f,
+                  C + n0,
+                  ldc);
+      }
+    }
+  };
+  const int64_t num_tasks = (N + kNBlock - 1) / kNBlock;
+  RunParallelFor(0, num_tasks, compute);
+}
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
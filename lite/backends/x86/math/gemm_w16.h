@@ -0,0 +1,62 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include "lite/core/context.h"
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+/// The 16 bits storage formats of the weights.
+enum class W16Type { kFP16, kBF16 };
+
+/// The W16Type of the "weight_quant_type" attribute, "fp16" or "bf16".
+W16Type GetW16Type(const std::string& quant_type);
+
+/// Convert `n` fp16 or bf16 values to float. It uses F16C (fp16) or AVX2
+/// (bf16) if compiled and supported by the CPU, AVX512F if available.
+void w16_to_float(W16Type type, const uint16_t* in, int n, float* out);
+
+/// The GEMM C[M, N] = alpha * A[M, K] * op(B) + beta * C with the weights B
+/// stored in 16 bits, [K, N] or [N, K] if `trans_b`, with the leading
+/// dimension `ldb`.
+///
+/// B is converted to float by panels small enough to stay in the cache, each
+/// of them is multiplied with the float GEMM right after, so that only the 16
+/// bits weights are read from the memory. The panels of the columns of C are
+/// computed in parallel.
+void gemm_w16(const lite::X86Context& context,
+              W16Type type,
+              bool trans_b,
+              int M,
+              int N,
+              int K,
+              float alpha,
+              const float* A,
+              int lda,
+              const uint16_t* B,
+              int ldb,
+              float beta,
+              float* C,
+              int ldc);
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,42 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <stdint.h>
+
+// The SIMD conversions of gemm_w16. They are built in their own translation
+// units with the flags of their ISA and only called if MayIUse reports it, so
+// this header is kept free of the inline functions of other headers.
+//
+// Each of them converts the leading multiple of its vector width of the `n`
+// values and returns the number converted, the rest is left to the caller.
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+// Built with F16C_FLAG in gemm_w16_f16c.cc if LITE_GEMM_W16_WITH_F16C.
+int fp16_to_float_f16c(const uint16_t* in, int n, float* out);
+// Built with AVX2_FLAG in gemm_w16_avx2.cc if LITE_GEMM_W16_WITH_AVX2.
+int bf16_to_float_avx2(const uint16_t* in, int n, float* out);
+// Built with AVX512F_FLAG in gemm_w16_avx512.cc if LITE_GEMM_W16_WITH_AVX512.
+int fp16_to_float_avx512(const uint16_t* in, int n, float* out);
+int bf16_to_float_avx512(const uint16_t* in, int n, float* out);
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
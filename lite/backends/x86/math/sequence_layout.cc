@@ -0,0 +1,107 @@
+/* Copyright (c) 2018 PaddlePaddle Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License. */
+
+#include "lite/backends/x86/math/sequence_layout.h"
+#include <algorithm>
+#include <list>
+#include <utility>
+#include "lite/utils/cp_logging.h"
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+namespace {
+
+// The number of the layouts cached per thread, it covers the LoDs of the
+// query, the title and their derived sequences of a batch.
+const size_t kLayoutCacheSize = 8;
+
+std::shared_ptr<const SequenceLayout> BuildSequenceLayout(
+    const std::vector<int>& lengths) {
+  auto* layout = new SequenceLayout;
+  std::shared_ptr<const SequenceLayout> res(layout);
+  int batch = lengths.size();
+  layout->lengths = lengths;
+  layout->sorted_idx.resize(batch);
+  for (int i = 0; i < batch; i++) {
+    CHECK_GE(lengths[i], 0) << "negative sequence length";
+    layout->sorted_idx[i] = i;
+  }
+  std::stable_sort(layout->sorted_idx.begin(),
+                   layout->sorted_idx.end(),
+                   [&lengths](int a, int b) {
+                     return lengths[a] > lengths[b];
+                   });
+  layout->max_length = batch > 0 ? lengths[layout->sorted_idx[0]] : 0;
+
+  // The sequences still running at step i are the first `running` ones of
+  // sorted_idx.
+  layout->step_offset.resize(layout->max_length + 1);
+  layout->step_offset[0] = 0;
+  int running = batch;
+  for (int i = 0; i < layout->max_length; i++) {
+    while (running > 0 && lengths[layout->sorted_idx[running - 1]] <= i) {
+      running--;
+    }
+    layout->step_offset[i + 1] = layout->step_offset[i] + running;
+  }
+
+  for (int idx : layout->sorted_idx) {
+    if (layout->buckets.empty() ||
+        layout->buckets.back().length != lengths[idx]) {
+      layout->buckets.emplace_back();
+      layout->buckets.back().length = lengths[idx];
+    }
+    layout->buckets.back().seqs.push_back(idx);
+  }
+  return res;
+}
+
+}  // namespace
+
+std::shared_ptr<const SequenceLayout> GetSequenceLayout(
+    const std::vector<int>& lengths) {
+  // Most recently used first.
+  thread_local std::list<std::shared_ptr<const SequenceLayout>> cache;
+  for (auto it = cache.begin(); it != cache.end(); ++it) {
+    if ((*it)->lengths == lengths) {
+      if (it != cache.begin()) {
+        cache.splice(cache.begin(), cache, it);
+      }
+      return cache.front();
+    }
+  }
+  cache.push_front(BuildSequenceLayout(lengths));
+  if (cache.size() > kLayoutCacheSize) {
+    cache.pop_back();
+  }
+  return cache.front();
+}
+
+std::shared_ptr<const SequenceLayout> GetSequenceLayout(
+    const std::vector<uint64_t>& offset) {
+  CHECK(!offset.empty());
+  std::vector<int> lengths(offset.size() - 1);
+  for (size_t i = 0; i < lengths.size(); i++) {
+    lengths[i] = offset[i + 1] - offset[i];
+  }
+  return GetSequenceLayout(lengths);
+}
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,62 @@
+/* Copyright (c) 2018 PaddlePaddle Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License. */
+
+#pragma once
+#include <stdint.h>
+#include <memory>
+#include <vector>
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+/*
+ * The length bucketed layout of a batch of sequences, shared by the LoD
+ * sequence kernels (search_grnn, search_group_padding, var_conv_2d, ...)
+ * instead of every kernel sorting and scanning the lengths by itself.
+ */
+struct SequenceLayout {
+  struct Bucket {
+    int length{0};
+    // The indices of the sequences of the length, in their original order.
+    std::vector<int> seqs;
+  };
+
+  std::vector<int> lengths;
+  // The indices of the sequences sorted by length descendingly, the sequences
+  // of the same length keep their original order.
+  std::vector<int> sorted_idx;
+  int max_length{0};
+  // The time major offsets, the i-th steps of the sequences longer than i are
+  // the rows [step_offset[i], step_offset[i + 1]) in the order of sorted_idx.
+  std::vector<uint64_t> step_offset;
+  // The sequences grouped by length, the longest first.
+  std::vector<Bucket> buckets;
+};
+
+// The layout of the lengths. The recent layouts are cached per thread, so the
+// kernels of a program running on the same LoD share one layout which is
+// built once per batch.
+std::shared_ptr<const SequenceLayout> GetSequenceLayout(
+    const std::vector<int>& lengths);
+
+// The layout of the sequences of a LoD level.
+std::shared_ptr<const SequenceLayout> GetSequenceLayout(
+    const std::vector<uint64_t>& offset);
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
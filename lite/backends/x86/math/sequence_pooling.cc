@@ -19,6 +19,7 @@ limitations under the License. */
 #include "lite/backends/x86/math/blas.h"
 #include "lite/backends/x86/math/math_function.h"
 #include "lite/backends/x86/math/sequence_pooling.h"
+#include "lite/backends/x86/parallel.h"
 #include "lite/fluid/eigen.h"
 
 namespace paddle {
@@ -60,27 +61,29 @@ class MaxSeqPoolFunctor {
 
     int64_t num_seq = out_dims[0];
     int64_t dim = output->numel() / num_seq;
-    for (int64_t i = 0; i < num_seq; ++i) {
-      if (starts[i] == starts[i + 1]) {
-        for (int64_t k = 0; k < dim; ++k) {
-          out_data[i * dim + k] = pad_value;
-          max_index[i * dim + k] = -1;
+    RunParallelForSegments(starts, [&](int64_t begin, int64_t end) {
+      for (int64_t i = begin; i < end; ++i) {
+        if (starts[i] == starts[i + 1]) {
+          for (int64_t k = 0; k < dim; ++k) {
+            out_data[i * dim + k] = pad_value;
+            max_index[i * dim + k] = -1;
+          }
+          continue;
         }
-        continue;
-      }
-      for (int64_t k = 0; k < dim; ++k) {
-        out_data[i * dim + k] = in_data[starts[i] * dim + k];
-        max_index[i * dim + k] = starts[i];
-      }
-      for (size_t j = starts[i] + 1; j < starts[i + 1]; ++j) {
         for (int64_t k = 0; k < dim; ++k) {
-          if (in_data[j * dim + k] > out_data[i * dim + k]) {
-            out_data[i * dim + k] = in_data[j * dim + k];
-            max_index[i * dim + k] = j;
+          out_data[i * dim + k] = in_data[starts[i] * dim + k];
+          max_index[i * dim + k] = starts[i];
+        }
+        for (size_t j = starts[i] + 1; j < starts[i + 1]; ++j) {
+          for (int64_t k = 0; k < dim; ++k) {
+            if (in_data[j * dim + k] > out_data[i * dim + k]) {
+              out_data[i * dim + k] = in_data[j * dim + k];
+              max_index[i * dim + k] = j;
+            }
           }
         }
       }
-    }
+    });
   }
 };
 // Instantisation of Max Sequence Pooling for test phase eg. no need to fill
@@ -107,23 +110,25 @@ class MaxSeqPoolFunctor<T, true> {
 
     int64_t num_seq = out_dims[0];
     int64_t dim = output->numel() / num_seq;
-    for (int64_t i = 0; i < num_seq; ++i) {
-      if (starts[i] == starts[i + 1]) {
-        for (int64_t k = 0; k < dim; ++k) {
-          out_data[i * dim + k] = pad_value;
+    RunParallelForSegments(starts, [&](int64_t begin, int64_t end) {
+      for (int64_t i = begin; i < end; ++i) {
+        if (starts[i] == starts[i + 1]) {
+          for (int64_t k = 0; k < dim; ++k) {
+            out_data[i * dim + k] = pad_value;
+          }
+          continue;
         }
-        continue;
-      }
-      std::memcpy(
-          &out_data[i * dim], &in_data[starts[i] * dim], dim * sizeof(T));
-      for (size_t j = starts[i] + 1; j < starts[i + 1]; ++j) {
-        for (int64_t k = 0; k < dim; ++k) {
-          if (in_data[j * dim + k] > out_data[i * dim + k]) {
-            out_data[i * dim + k] = in_data[j * dim + k];
+        std::memcpy(
+            &out_data[i * dim], &in_data[starts[i] * dim], dim * sizeof(T));
+        for (size_t j = starts[i] + 1; j < starts[i + 1]; ++j) {
+          for (int64_t k = 0; k < dim; ++k) {
+            if (in_data[j * dim + k] > out_data[i * dim + k]) {
+              out_data[i * dim + k] = in_data[j * dim + k];
+            }
           }
         }
       }
-    }
+    });
   }
 };
 template <typename T>
@@ -175,22 +180,21 @@ class LastSeqPoolFunctor {
     // Calculate the size of each item in sequence
     int64_t item_size = input.numel() / input.dims()[0];
     auto lod = input.lod()[0];
-    int seq_num = static_cast<int>(lod.size()) - 1;
-    for (int i = 0; i < seq_num; ++i) {
-      // Calculate the length of each sequence
-      int64_t seq_len = static_cast<int64_t>(lod[i + 1] - lod[i]);
-      if (seq_len == 0) {
-        for (int j = 0; j < item_size; ++j) {
-          out_data[j] = pad_value;
+    RunParallelForSegments(lod, [&](int64_t begin, int64_t end) {
+      for (int64_t i = begin; i < end; ++i) {
+        auto* out_item = out_data + i * item_size;
+        if (lod[i] == lod[i + 1]) {
+          for (int j = 0; j < item_size; ++j) {
+            out_item[j] = pad_value;
+          }
+        } else {
+          // Copy the last item of sequence to output
+          std::memcpy(out_item,
+                      in_data + (lod[i + 1] - 1) * item_size,
+                      item_size * sizeof(T));
         }
-      } else {
-        // Point to the begin of next sequence
-        in_data += seq_len * item_size;
-        // Copy the last item of sequence to output
-        std::memcpy(out_data, (in_data - item_size), item_size * sizeof(T));
       }
-      out_data += item_size;
-    }
+    });
   }
 };
 
@@ -208,22 +212,20 @@ class FirstSeqPoolFunctor {
     // Calculate the size of each item in sequence
     int64_t item_size = input.numel() / input.dims()[0];
     auto lod = input.lod()[0];
-    int seq_num = static_cast<int>(lod.size()) - 1;
-    for (int i = 0; i < seq_num; ++i) {
-      // Calculate the length of each sequence
-      int64_t seq_len = static_cast<int64_t>(lod[i + 1] - lod[i]);
-      if (seq_len == 0) {
-        for (int j = 0; j < item_size; ++j) {
-          out_data[j] = pad_value;
+    RunParallelForSegments(lod, [&](int64_t begin, int64_t end) {
+      for (int64_t i = begin; i < end; ++i) {
+        auto* out_item = out_data + i * item_size;
+        if (lod[i] == lod[i + 1]) {
+          for (int j = 0; j < item_size; ++j) {
+            out_item[j] = pad_value;
+          }
+        } else {
+          // Copy the first item of sequence to output
+          std::memcpy(
+              out_item, in_data + lod[i] * item_size, item_size * sizeof(T));
         }
-      } else {
-        // Copy the first item of sequence to output
-        std::memcpy(out_data, in_data, item_size * sizeof(T));
-        // Point to the next sequence
-        in_data += seq_len * item_size;
       }
-      out_data += item_size;
-    }
+    });
   }
 };
 
@@ -295,44 +297,50 @@ class SequencePoolFunctor<TARGET(kX86), T> {
       auto seqpool =
           jit::KernelFuncs<jit::SeqPoolTuple<T>, lite::fluid::CPUPlace>::Cache()
               .At(attr);
-      for (int i = 0; i < static_cast<int>(lod.size()) - 1; ++i) {
-        attr.h = static_cast<int>(lod[i + 1] - lod[i]);
-        if (attr.h == 0) {
-          for (int j = 0; j < attr.w; ++j) {
-            dst[j] = pad_value;
+      RunParallelForSegments(lod, [&](int64_t begin, int64_t end) {
+        jit::seq_pool_attr_t seq_attr(attr.w, jit::SeqPoolType::kSum);
+        for (int64_t i = begin; i < end; ++i) {
+          seq_attr.h = static_cast<int>(lod[i + 1] - lod[i]);
+          T* seq_dst = dst + i * seq_attr.w;
+          if (seq_attr.h == 0) {
+            for (int j = 0; j < seq_attr.w; ++j) {
+              seq_dst[j] = pad_value;
+            }
+          } else {
+            seqpool(src + lod[i] * seq_attr.w, seq_dst, &seq_attr);
           }
-        } else {
-          seqpool(src, dst, &attr);
         }
-        dst += attr.w;
-        src += attr.h * attr.w;
-      }
+      });
       return;
     }
-    auto eigen_device = lite::fluid::EigenDeviceType<TARGET(kX86)>();
-    for (int i = 0; i < static_cast<int>(lod.size()) - 1; ++i) {
-      Tensor out_t = output->Slice<float>(i, i + 1);
-      int64_t w = input.numel() / input.dims()[0];
-      if (lod[i] == lod[i + 1]) {
-        for (int j = 0; j < w; ++j) {
-          out_t.mutable_data<T>()[j] = pad_value;
+    if (pooltype != "AVERAGE" && pooltype != "SQRT") {
+      PADDLE_THROW("unsupported pooling pooltype");
+    }
+    T* out_data = output->mutable_data<T>();
+    int64_t w = input.numel() / input.dims()[0];
+    RunParallelForSegments(lod, [&](int64_t begin, int64_t end) {
+      auto eigen_device = lite::fluid::EigenDeviceType<TARGET(kX86)>();
+      for (int64_t i = begin; i < end; ++i) {
+        if (lod[i] == lod[i + 1]) {
+          for (int j = 0; j < w; ++j) {
+            out_data[i * w + j] = pad_value;
+          }
+          continue;
+        }
+        Tensor out_t = output->Slice<float>(i, i + 1);
+        Tensor in_t = input.Slice<float>(static_cast<int>(lod[i]),
+                                         static_cast<int>(lod[i + 1]));
+        int64_t h = static_cast<int64_t>(lod[i + 1] - lod[i]);
+        auto in_e = EigenMatrix<T>::From(in_t, lite::DDim({h, w}));
+        auto out_e = EigenVector<T>::Flatten(out_t);
+        if (pooltype == "AVERAGE") {
+          out_e.device(eigen_device) = in_e.mean(Eigen::array<int, 1>({{0}}));
+        } else {
+          out_e.device(eigen_device) = in_e.sum(Eigen::array<int, 1>({{0}})) /
+                                       std::sqrt(static_cast<T>(h));
         }
-        continue;
-      }
-      Tensor in_t = input.Slice<float>(static_cast<int>(lod[i]),
-                                       static_cast<int>(lod[i + 1]));
-      int64_t h = static_cast<int64_t>(lod[i + 1] - lod[i]);
-      auto in_e = EigenMatrix<T>::From(in_t, lite::DDim({h, w}));
-      auto out_e = EigenVector<T>::Flatten(out_t);
-      if (pooltype == "AVERAGE") {
-        out_e.device(eigen_device) = in_e.mean(Eigen::array<int, 1>({{0}}));
-      } else if (pooltype == "SQRT") {
-        out_e.device(eigen_device) = in_e.sum(Eigen::array<int, 1>({{0}})) /
-                                     std::sqrt(static_cast<T>(h));
-      } else {
-        PADDLE_THROW("unsupported pooling pooltype");
       }
-    }
+    });
   }
 };
 
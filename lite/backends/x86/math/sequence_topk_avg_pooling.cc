@@ -15,6 +15,7 @@ limitations under the License. */
 #include "lite/backends/x86/math/sequence_topk_avg_pooling.h"
 #include <algorithm>
 #include <vector>
+#include "lite/backends/x86/parallel.h"
 
 namespace paddle {
 namespace lite {
@@ -97,46 +98,54 @@ class SequenceTopkAvgPoolingFunctor<lite::TargetType::kX86, T> {
     auto in_data = in.data<T>();
     auto out_data = out->mutable_data<T>(lite::TargetType::kX86);
 
-    T* sum_data = new T[max_k];
     for (int i = 0; i < batch_size; ++i) {
       int total_size = in_lod[i + 1] - in_lod[i];
       int row_size = row_lod[i + 1] - row_lod[i];
       int col_size = col_lod[i + 1] - col_lod[i];
-
       CHECK_EQ(total_size, channel_num * row_size * col_size)
           << "size wrong in sequence_topk_avg_pooling_op!";
+    }
 
-      int feature_num = row_size * col_size;
-      for (int j = 0; j < channel_num; ++j) {
-        auto input_offset_feature_data = in_data + in_lod[i] + j * feature_num;
-
-        for (int r = 0; r < row_size; ++r) {
-          auto row_data = input_offset_feature_data + r * col_size;
-          auto pos_slice_data = pos_data + row_lod[i] * channel_num * max_k +
-                                r * channel_num * max_k + j * max_k;
-          auto out_slice_data = out_data + row_lod[i] * channel_num * k_num +
-                                r * channel_num * k_num + j * k_num;
-
-          get_topk_pos<T>(row_data, col_size, max_k, pos_slice_data);
-          if (pos_slice_data[0] == -1) {
-            sum_data[0] = 0.0;
-          } else {
-            sum_data[0] = row_data[pos_slice_data[0]];
-          }
-          for (int k = 1; k < max_k; ++k) {
-            if (pos_slice_data[k] == -1) {
-              sum_data[k] = sum_data[k - 1];
+    // the samples are balanced by their input sizes
+    RunParallelForSegments(in_lod, [&](int64_t begin, int64_t end) {
+      std::vector<T> sum_data(max_k);
+      for (int64_t i = begin; i < end; ++i) {
+        int row_size = row_lod[i + 1] - row_lod[i];
+        int col_size = col_lod[i + 1] - col_lod[i];
+        int feature_num = row_size * col_size;
+        for (int j = 0; j < channel_num; ++j) {
+          auto input_offset_feature_data =
+              in_data + in_lod[i] + j * feature_num;
+
+          for (int r = 0; r < row_size; ++r) {
+            auto row_data = input_offset_feature_data + r * col_size;
+            auto pos_slice_data = pos_data +
+                                  row_lod[i] * channel_num * max_k +
+                                  r * channel_num * max_k + j * max_k;
+            auto out_slice_data = out_data +
+                                  row_lod[i] * channel_num * k_num +
+                                  r * channel_num * k_num + j * k_num;
+
+            get_topk_pos<T>(row_data, col_size, max_k, pos_slice_data);
+            if (pos_slice_data[0] == -1) {
+              sum_data[0] = 0.0;
             } else {
-              sum_data[k] = sum_data[k - 1] + row_data[pos_slice_data[k]];
+              sum_data[0] = row_data[pos_slice_data[0]];
+            }
+            for (int k = 1; k < max_k; ++k) {
+              if (pos_slice_data[k] == -1) {
+                sum_data[k] = sum_data[k - 1];
+              } else {
+                sum_data[k] = sum_data[k - 1] + row_data[pos_slice_data[k]];
+              }
+            }
+            for (size_t k = 0; k < k_num; ++k) {
+              out_slice_data[k] = sum_data[topks[k] - 1] / topks[k];
             }
-          }
-          for (size_t k = 0; k < k_num; ++k) {
-            out_slice_data[k] = sum_data[topks[k] - 1] / topks[k];
           }
         }
       }
-    }
-    delete[] sum_data;
+    });
   }
 };
 
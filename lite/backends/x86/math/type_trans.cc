@@ -0,0 +1,110 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/x86/math/type_trans.h"
+#ifdef __AVX__
+#include <immintrin.h>
+#endif
+#include <algorithm>
+#include <cmath>
+#include "lite/backends/x86/parallel.h"
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+namespace {
+
+inline int8_t QuantizeOne(float x, float inv_scale) {
+  // Round half away from zero like the ARM kernels.
+  float v = std::round(x * inv_scale);
+  return static_cast<int8_t>(std::min(std::max(v, -127.f), 127.f));
+}
+
+}  // namespace
+
+void fp32_to_int8(const float* din,
+                  int8_t* dout,
+                  const float* scale,
+                  int axis_size,
+                  int64_t outer_size,
+                  int64_t inner_size) {
+  lite::x86::RunParallelFor(
+      0, outer_size * axis_size, [&](int64_t begin, int64_t end) {
+        for (int64_t j = begin; j < end; ++j) {
+          const float inv_scale = 1.f / scale[j % axis_size];
+          const float* in = din + j * inner_size;
+          int8_t* out = dout + j * inner_size;
+          int64_t i = 0;
+#ifdef __AVX2__
+          const __m256 vscale = _mm256_set1_ps(inv_scale);
+          const __m256 vmax = _mm256_set1_ps(127.f);
+          const __m256 vmin = _mm256_set1_ps(-127.f);
+          const __m256 vsign = _mm256_set1_ps(-0.f);
+          const __m256 vhalf = _mm256_set1_ps(0.5f);
+          for (; i + 8 <= inner_size; i += 8) {
+            __m256 v = _mm256_mul_ps(_mm256_loadu_ps(in + i), vscale);
+            // round half away from zero: trunc(v + copysign(0.5, v))
+            __m256 half = _mm256_or_ps(_mm256_and_ps(v, vsign), vhalf);
+            v = _mm256_round_ps(_mm256_add_ps(v, half),
+                                _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+            v = _mm256_min_ps(_mm256_max_ps(v, vmin), vmax);
+            __m256i v32 = _mm256_cvttps_epi32(v);
+            __m128i v16 = _mm_packs_epi32(_mm256_castsi256_si128(v32),
+                                          _mm256_extracti128_si256(v32, 1));
+            __m128i v8 = _mm_packs_epi16(v16, v16);
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(out + i), v8);
+          }
+#endif
+          for (; i < inner_size; ++i) {
+            out[i] = QuantizeOne(in[i], inv_scale);
+          }
+        }
+      });
+}
+
+void int8_to_fp32(const int8_t* din,
+                  float* dout,
+                  const float* scale,
+                  int axis_size,
+                  int64_t outer_size,
+                  int64_t inner_size) {
+  lite::x86::RunParallelFor(
+      0, outer_size * axis_size, [&](int64_t begin, int64_t end) {
+        for (int64_t j = begin; j < end; ++j) {
+          const float in_scale = scale[j % axis_size];
+          const int8_t* in = din + j * inner_size;
+          float* out = dout + j * inner_size;
+          int64_t i = 0;
+#ifdef __AVX2__
+          const __m256 vscale = _mm256_set1_ps(in_scale);
+          for (; i + 8 <= inner_size; i += 8) {
+            __m256i v32 = _mm256_cvtepi8_epi32(
+                _mm_loadl_epi64(reinterpret_cast<const __m128i*>(in + i)));
+            _mm256_storeu_ps(out + i,
+                             _mm256_mul_ps(_mm256_cvtepi32_ps(v32), vscale));
+          }
+#endif
+          for (; i < inner_size; ++i) {
+            out[i] = in[i] * in_scale;
+          }
+        }
+      });
+}
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
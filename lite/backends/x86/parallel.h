@@ -15,59 +15,127 @@
 #pragma once
 
 #include <algorithm>
+#include <functional>
+#include <vector>
 #ifdef PADDLE_WITH_MKLML
 #include <omp.h>
 #include "lite/backends/x86/mklml.h"
 #endif
+#include "lite/backends/x86/thread_pool.h"
 
 namespace paddle {
 namespace lite {
 namespace x86 {
 
-static void SetNumThreads(int num_threads) {
-#ifdef PADDLE_WITH_MKLML
+// Set the number of threads of RunParallelFor in the current thread.
+static inline void SetParallelForThreads(int num_threads) {
+  ThreadPool::Global().Resize(num_threads);
+}
+
+// Set the number of threads of both RunParallelFor and the math library in
+// the current thread.
+static inline void SetNumThreads(int num_threads) {
   int real_num_threads = std::max(num_threads, 1);
+#ifdef PADDLE_WITH_MKLML
   x86::MKL_Set_Num_Threads(real_num_threads);
   omp_set_num_threads(real_num_threads);
 #endif
+  SetParallelForThreads(real_num_threads);
 }
 
 static inline int64_t GetMaxThreads() {
-  int64_t num_threads = 1;
+  // Do not support nested parallelism.
+  bool in_parallel = ThreadPool::InParallelRegion();
 #ifdef PADDLE_WITH_MKLML
-  // Do not support nested omp parallem.
-  num_threads = omp_in_parallel() ? 1 : omp_get_max_threads();
+  in_parallel = in_parallel || omp_in_parallel();
 #endif
-  return std::max(num_threads, 1L);
+  return in_parallel ? 1 : ThreadPool::Global().num_threads();
 }
 
 using ThreadHandler =
     std::function<void(const int64_t begin, const int64_t end)>;
 
+// Run the chunks of `f` with a serial math library. The BLAS calls of the
+// tasks would otherwise each open an OMP team of the math library threads on
+// top of the threads of the pool.
+static inline ThreadHandler WithSerialMathLibrary(const ThreadHandler& f) {
+#ifdef PADDLE_WITH_MKLML
+  return [f](const int64_t begin, const int64_t end) {
+    // It only changes the setting of the current thread, 0 restores the
+    // global one.
+    int prev = x86::mkl_set_num_threads_local(1);
+    f(begin, end);
+    x86::mkl_set_num_threads_local(prev);
+  };
+#else
+  return f;
+#endif
+}
+
+// Split [begin, end) into a chunk per thread. If `grain_size` is positive,
+// the threads grab the chunks of `grain_size` dynamically instead, which is
+// better when the cost of the iterations varies.
 static inline void RunParallelFor(const int64_t begin,
                                   const int64_t end,
-                                  const ThreadHandler& f) {
+                                  const ThreadHandler& f,
+                                  const int64_t grain_size = 0) {
   if (begin >= end) {
     return;
   }
-
-#ifdef PADDLE_WITH_MKLML
-  int64_t num_threads = std::min(GetMaxThreads(), end - begin);
-  if (num_threads > 1) {
-#pragma omp parallel num_threads(num_threads)
-    {
-      int64_t tid = omp_get_thread_num();
-      int64_t chunk_size = (end - begin + num_threads - 1) / num_threads;
-      int64_t begin_tid = begin + tid * chunk_size;
-      f(begin_tid, std::min(end, chunk_size + begin_tid));
-    }
+  if (GetMaxThreads() > 1) {
+    ThreadPool::Global().ParallelFor(
+        begin, end, grain_size, WithSerialMathLibrary(f));
     return;
   }
-#endif
-
   f(begin, end);
 }
 
+// Run `f` over the sub-ranges of the segments [0, offset.size() - 1) of a LoD
+// level. The segments are split by their rows into a few chunks per thread,
+// which the threads grab dynamically, so a batch of skewed lengths is still
+// balanced. A segment is always processed by one thread as a whole, the
+// results do not depend on the number of threads.
+template <typename OffsetT>
+static inline void RunParallelForSegments(const std::vector<OffsetT>& offset,
+                                          const ThreadHandler& f) {
+  if (offset.size() < 2) {
+    return;
+  }
+  const int64_t num_segments = offset.size() - 1;
+  const int64_t num_threads = GetMaxThreads();
+  if (num_threads <= 1 || num_segments == 1) {
+    f(0, num_segments);
+    return;
+  }
+  // The cost of the first i segments, an empty segment costs one row.
+  auto cost = [&offset](int64_t i) {
+    return static_cast<int64_t>(offset[i] - offset[0]) + i;
+  };
+  const int64_t total_cost = cost(num_segments);
+  const int64_t num_chunks = std::min(num_segments, num_threads * 4);
+  std::vector<int64_t> bounds(num_chunks + 1, num_segments);
+  bounds[0] = 0;
+  int64_t segment = 0;
+  for (int64_t c = 1; c < num_chunks; ++c) {
+    const int64_t target = total_cost * c / num_chunks;
+    while (segment < num_segments && cost(segment) < target) {
+      ++segment;
+    }
+    bounds[c] = segment;
+  }
+  ThreadPool::Global().ParallelFor(
+      0,
+      num_chunks,
+      1,
+      WithSerialMathLibrary([&](int64_t begin, int64_t end) {
+        for (int64_t c = begin; c < end; ++c) {
+          if (bounds[c] < bounds[c + 1]) {
+            f(bounds[c], bounds[c + 1]);
+          }
+        }
+      }));
+}
+
 }  // namespace x86
 }  // namespace lite
 }  // namespace paddle
@@ -0,0 +1,158 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/x86/thread_pool.h"
+#include <algorithm>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+#include "lite/utils/cp_logging.h"
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+
+namespace {
+// The number of checks a worker spins for a new job before sleeping.
+const int kSpinCount = 4000;
+thread_local bool in_parallel_region = false;
+
+void BindToCore(std::thread* thread, int core_id) {
+#ifdef __linux__
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+  CPU_SET(core_id, &mask);
+  if (pthread_setaffinity_np(thread->native_handle(), sizeof(mask), &mask)) {
+    LOG(WARNING) << "failed to bind the thread to core " << core_id;
+  }
+#endif
+}
+}  // namespace
+
+ThreadPool& ThreadPool::Global() {
+  static thread_local ThreadPool pool;
+  return pool;
+}
+
+bool ThreadPool::InParallelRegion() { return in_parallel_region; }
+
+ThreadPool::~ThreadPool() { Stop(); }
+
+void ThreadPool::Stop() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  cv_.notify_all();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+  workers_.clear();
+  stop_ = false;
+}
+
+void ThreadPool::Resize(int num_threads, const std::vector<int>& core_ids) {
+  CHECK(!in_parallel_region) << "can not resize the pool in a parallel loop";
+  num_threads = std::max(num_threads, 1);
+  if (num_threads == this->num_threads() && core_ids.empty()) return;
+  Stop();
+  // The workers may start after the first job is posted, they have to know
+  // the generation before it.
+  uint64_t generation = generation_.load(std::memory_order_relaxed);
+  for (int i = 1; i < num_threads; i++) {
+    workers_.emplace_back(
+        [this, i, generation] { WorkerLoop(i, generation); });
+    if (!core_ids.empty()) {
+      BindToCore(&workers_.back(), core_ids[(i - 1) % core_ids.size()]);
+    }
+  }
+}
+
+void ThreadPool::RunChunks(int id) {
+  if (grain_size_ > 0) {
+    while (true) {
+      int64_t begin = next_.fetch_add(grain_size_, std::memory_order_relaxed);
+      if (begin >= end_) break;
+      (*handler_)(begin, std::min(end_, begin + grain_size_));
+    }
+  } else if (id < num_job_threads_) {
+    int64_t chunk_size =
+        (end_ - begin_ + num_job_threads_ - 1) / num_job_threads_;
+    int64_t begin = begin_ + id * chunk_size;
+    if (begin < end_) {
+      (*handler_)(begin, std::min(end_, begin + chunk_size));
+    }
+  }
+}
+
+void ThreadPool::WorkerLoop(int id, uint64_t seen) {
+  in_parallel_region = true;
+  while (true) {
+    int spins = 0;
+    while (generation_.load(std::memory_order_acquire) == seen) {
+      if (stop_.load(std::memory_order_acquire)) return;
+      if (++spins < kSpinCount) {
+        std::this_thread::yield();
+        continue;
+      }
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock, [this, seen] {
+        return stop_ || generation_.load(std::memory_order_acquire) != seen;
+      });
+    }
+    seen = generation_.load(std::memory_order_acquire);
+    RunChunks(id);
+    pending_.fetch_sub(1, std::memory_order_acq_rel);
+  }
+}
+
+void ThreadPool::ParallelFor(int64_t begin,
+                             int64_t end,
+                             int64_t grain_size,
+                             const Handler& f) {
+  if (begin >= end) return;
+  int64_t num_chunks = grain_size > 0
+                           ? (end - begin + grain_size - 1) / grain_size
+                           : end - begin;
+  if (in_parallel_region || workers_.empty() || num_chunks == 1) {
+    f(begin, end);
+    return;
+  }
+  handler_ = &f;
+  begin_ = begin;
+  end_ = end;
+  grain_size_ = grain_size;
+  num_job_threads_ =
+      static_cast<int>(std::min<int64_t>(num_threads(), num_chunks));
+  next_.store(begin, std::memory_order_relaxed);
+  pending_.store(static_cast<int>(workers_.size()), std::memory_order_relaxed);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    generation_.fetch_add(1, std::memory_order_release);
+  }
+  cv_.notify_all();
+
+  in_parallel_region = true;
+  RunChunks(0);
+  in_parallel_region = false;
+  while (pending_.load(std::memory_order_acquire) > 0) {
+    std::this_thread::yield();
+  }
+  handler_ = nullptr;
+}
+
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,97 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>  // NOLINT
+#include <cstdint>
+#include <functional>
+#include <mutex>   // NOLINT
+#include <thread>  // NOLINT
+#include <vector>
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+
+/*
+ * The fork-join thread pool running the parallel loops of the x86 kernels.
+ * The calling thread works as the first worker. The other workers spin for a
+ * while before sleeping when there is no job, so the back-to-back loops of a
+ * program do not pay for the wake-up latency.
+ */
+class ThreadPool {
+ public:
+  using Handler = std::function<void(int64_t begin, int64_t end)>;
+
+  // The pool of the current thread. Every thread running the kernels, e.g. the
+  // threads of different predictors, owns a pool, so they never compete for
+  // the workers.
+  static ThreadPool& Global();
+
+  // Whether the current thread is running a parallel loop, the nested loops
+  // are executed serially.
+  static bool InParallelRegion();
+
+  ~ThreadPool();
+
+  // Set the number of threads including the calling one. If `core_ids` is not
+  // empty, the i-th worker is bound to core_ids[i % core_ids.size()], the
+  // calling thread is not bound.
+  void Resize(int num_threads, const std::vector<int>& core_ids = {});
+  int num_threads() const { return static_cast<int>(workers_.size()) + 1; }
+
+  // Run `f` over the sub-ranges of [begin, end). If `grain_size` is not
+  // positive, the range is split into a chunk per thread statically,
+  // otherwise the threads grab the chunks of `grain_size` dynamically, which
+  // balances the loops whose iterations cost differently.
+  void ParallelFor(int64_t begin,
+                   int64_t end,
+                   int64_t grain_size,
+                   const Handler& f);
+
+ private:
+  ThreadPool() = default;
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  // `seen` is the generation of the last job before the worker is created.
+  void WorkerLoop(int id, uint64_t seen);
+  // Run the chunks of the current job owned by the `id`-th thread.
+  void RunChunks(int id);
+  void Stop();
+
+  std::vector<std::thread> workers_;
+
+  // The current job.
+  const Handler* handler_{nullptr};
+  int64_t begin_{0};
+  int64_t end_{0};
+  int64_t grain_size_{0};
+  int num_job_threads_{0};
+  std::atomic<int64_t> next_{0};
+
+  // Increased by one when a job is posted.
+  std::atomic<uint64_t> generation_{0};
+  // The number of workers which have not finished the current job.
+  std::atomic<int> pending_{0};
+  std::atomic<bool> stop_{false};
+  std::mutex mutex_;
+  std::condition_variable cv_;
+};
+
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,122 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/x86/thread_pool.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <vector>
+#include "lite/backends/x86/parallel.h"
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+
+TEST(ThreadPool, static_chunks) {
+  ThreadPool::Global().Resize(4);
+  ASSERT_EQ(ThreadPool::Global().num_threads(), 4);
+  std::vector<int> data(1003, 0);
+  for (int repeat = 0; repeat < 100; ++repeat) {
+    RunParallelFor(0, data.size(), [&](int64_t begin, int64_t end) {
+      for (int64_t i = begin; i < end; ++i) {
+        data[i] += 1;
+      }
+    });
+  }
+  for (auto x : data) {
+    ASSERT_EQ(x, 100);
+  }
+}
+
+TEST(ThreadPool, dynamic_chunks) {
+  ThreadPool::Global().Resize(3);
+  std::atomic<int64_t> sum{0};
+  RunParallelFor(0,
+                 1000,
+                 [&](int64_t begin, int64_t end) {
+                   ASSERT_LE(end - begin, 7);
+                   for (int64_t i = begin; i < end; ++i) {
+                     sum += i;
+                   }
+                 },
+                 7);
+  ASSERT_EQ(sum.load(), 999 * 1000 / 2);
+}
+
+TEST(ThreadPool, resize) {
+  // The loop posted right after resizing must not be missed by the workers
+  // which have not started yet.
+  for (int repeat = 0; repeat < 100; ++repeat) {
+    ThreadPool::Global().Resize(1);
+    ThreadPool::Global().Resize(4);
+    std::atomic<int> count{0};
+    RunParallelFor(0, 4, [&](int64_t begin, int64_t end) {
+      count += end - begin;
+    });
+    ASSERT_EQ(count.load(), 4);
+  }
+}
+
+TEST(ThreadPool, nested) {
+  SetNumThreads(4);
+  std::atomic<int> count{0};
+  RunParallelFor(0, 8, [&](int64_t begin, int64_t end) {
+    ASSERT_EQ(GetMaxThreads(), 1);
+    for (int64_t i = begin; i < end; ++i) {
+      RunParallelFor(0, 10, [&](int64_t b, int64_t e) { count += e - b; });
+    }
+  });
+  ASSERT_EQ(count.load(), 80);
+}
+
+TEST(ThreadPool, segments) {
+  ThreadPool::Global().Resize(4);
+  // A long sequence among many short and empty ones.
+  std::vector<uint64_t> offset{0};
+  for (int i = 0; i < 300; ++i) {
+    offset.push_back(offset.back() + (i == 7 ? 1000 : i % 3));
+  }
+  std::vector<std::atomic<int>> visits(offset.size() - 1);
+  std::atomic<int64_t> max_rows{0};
+  RunParallelForSegments(offset, [&](int64_t begin, int64_t end) {
+    ASSERT_LT(begin, end);
+    int64_t rows = offset[end] - offset[begin];
+    int64_t cur = max_rows.load();
+    while (rows > cur && !max_rows.compare_exchange_weak(cur, rows)) {
+    }
+    for (int64_t i = begin; i < end; ++i) {
+      visits[i]++;
+    }
+  });
+  for (auto& v : visits) {
+    ASSERT_EQ(v.load(), 1);
+  }
+  // The long sequence is not chunked with many others.
+  ASSERT_LT(max_rows.load(), 1100);
+}
+
+TEST(ThreadPool, serial) {
+  SetNumThreads(1);
+  ASSERT_EQ(GetMaxThreads(), 1);
+  int calls = 0;
+  RunParallelFor(0, 100, [&](int64_t begin, int64_t end) {
+    ++calls;
+    ASSERT_EQ(begin, 0);
+    ASSERT_EQ(end, 100);
+  });
+  ASSERT_EQ(calls, 1);
+}
+
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
@@ -13,19 +13,205 @@
 // limitations under the License.
 
 #include "lite/core/arena/framework.h"
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <sstream>
 #include "lite/core/context.h"
 #include "lite/operators/subgraph_op.h"
+#include "lite/utils/string.h"
+
+DEFINE_bool(arena_benchmark,
+            false,
+            "Run the benchmarks of the kernel tests, which are skipped by "
+            "default, e.g. --gtest_filter=*benchmark* --arena_benchmark.");
+DEFINE_bool(arena_benchmark_all,
+            false,
+            "Benchmark every case checked by Arena::TestPrecision as well, "
+            "which covers all the kernels with an arena test.");
+DEFINE_int32(arena_benchmark_warmup, 10, "The warm-up runs of a benchmark.");
+DEFINE_int32(arena_benchmark_repeats, 100, "The timed runs of a benchmark.");
+DEFINE_string(arena_benchmark_shapes,
+              "",
+              "The input shapes the benchmarks sweep instead of their "
+              "defaults, e.g. \"1,3,224,224;1,32,112,112\".");
+DEFINE_string(arena_benchmark_output,
+              "",
+              "The file the benchmark results are appended to.");
+DEFINE_string(arena_benchmark_baseline,
+              "",
+              "The results of a former run to check the regressions against.");
+DEFINE_double(arena_benchmark_tolerance,
+              0.1,
+              "The ratio of the median latency a benchmark can be slower "
+              "than its baseline.");
 
 namespace paddle {
 namespace lite {
 namespace arena {
 
+std::string BenchmarkResult::Header() {
+  return "# key\trepeats\tmin_us\tavg_us\tp50_us\tp90_us\tp99_us\tgflops\t"
+         "gbps";
+}
+
+std::string BenchmarkResult::ToString() const {
+  std::stringstream ss;
+  ss << std::fixed << std::setprecision(3) << key << "\t" << repeats << "\t"
+     << min_us << "\t" << avg_us << "\t" << p50_us << "\t" << p90_us << "\t"
+     << p99_us << "\t" << gflops << "\t" << gbps;
+  return ss.str();
+}
+
+bool BenchmarkResult::Parse(const std::string& line, BenchmarkResult* result) {
+  auto fields = Split(line, "\t");
+  if (line.empty() || line[0] == '#' || fields.size() != 9) return false;
+  result->key = fields[0];
+  result->repeats = std::atoi(fields[1].c_str());
+  result->min_us = std::atof(fields[2].c_str());
+  result->avg_us = std::atof(fields[3].c_str());
+  result->p50_us = std::atof(fields[4].c_str());
+  result->p90_us = std::atof(fields[5].c_str());
+  result->p99_us = std::atof(fields[6].c_str());
+  result->gflops = std::atof(fields[7].c_str());
+  result->gbps = std::atof(fields[8].c_str());
+  return true;
+}
+
+std::vector<DDim> BenchmarkShapes(const std::vector<DDim>& defaults) {
+  if (FLAGS_arena_benchmark_shapes.empty()) return defaults;
+  std::vector<DDim> shapes;
+  for (const auto& shape : Split(FLAGS_arena_benchmark_shapes, ";")) {
+    std::vector<int64_t> dims;
+    for (const auto& dim : Split(shape, ",")) {
+      dims.push_back(std::atoll(dim.c_str()));
+    }
+    shapes.emplace_back(dims);
+  }
+  return shapes;
+}
+
+namespace {
+
+// The baseline results by key, loaded at the first use.
+const std::map<std::string, BenchmarkResult>& Baseline() {
+  static std::map<std::string, BenchmarkResult> baseline;
+  static bool loaded = false;
+  if (loaded || FLAGS_arena_benchmark_baseline.empty()) return baseline;
+  loaded = true;
+  std::ifstream file(FLAGS_arena_benchmark_baseline);
+  CHECK(file.is_open()) << "Failed to open the benchmark baseline "
+                        << FLAGS_arena_benchmark_baseline;
+  std::string line;
+  while (std::getline(file, line)) {
+    BenchmarkResult result;
+    if (BenchmarkResult::Parse(line, &result)) {
+      baseline[result.key] = result;
+    }
+  }
+  return baseline;
+}
+
+}  // namespace
+
+BenchmarkResult Arena::Benchmark(const std::string& case_name) {
+  for (int i = 0; i < FLAGS_arena_benchmark_warmup; i++) {
+    tester_->RunInstruction();
+  }
+  // A traced run for the shapes, the FLOPs and the bytes.
+  profile::Tracer tracer;
+  tester_->set_tracer(&tracer);
+  tester_->RunInstruction();
+  tester_->set_tracer(nullptr);
+  const auto event = tracer.events().front();
+
+  const int repeats = std::max(FLAGS_arena_benchmark_repeats, 1);
+  std::vector<double> latencies(repeats);
+  for (int i = 0; i < repeats; i++) {
+    auto start = std::chrono::steady_clock::now();
+    tester_->RunInstruction();
+    latencies[i] = std::chrono::duration<double, std::micro>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+  }
+  std::sort(latencies.begin(), latencies.end());
+  auto percentile = [&](double p) {
+    return latencies[std::min<int>(repeats * p, repeats - 1)];
+  };
+
+  BenchmarkResult result;
+  result.key = event.kernel + " " + case_name + " " + event.inputs;
+  result.repeats = repeats;
+  result.min_us = latencies.front();
+  for (double latency : latencies) result.avg_us += latency / repeats;
+  result.p50_us = percentile(0.5);
+  result.p90_us = percentile(0.9);
+  result.p99_us = percentile(0.99);
+  if (result.p50_us > 0) {
+    result.gflops = event.flops / result.p50_us / 1e3;
+    result.gbps = event.bytes / result.p50_us / 1e3;
+  }
+  LOG(INFO) << result.ToString();
+
+  if (!FLAGS_arena_benchmark_output.empty()) {
+    std::ofstream file(FLAGS_arena_benchmark_output, std::ios::app);
+    CHECK(file.is_open()) << "Failed to open the benchmark output "
+                          << FLAGS_arena_benchmark_output;
+    if (file.tellp() == 0) {
+      file << BenchmarkResult::Header() << std::endl;
+    }
+    file << result.ToString() << std::endl;
+  }
+
+  const auto& baseline = Baseline();
+  auto base = baseline.find(result.key);
+  if (base != baseline.end()) {
+    EXPECT_LE(result.p50_us,
+              base->second.p50_us * (1 + FLAGS_arena_benchmark_tolerance))
+        << "Regression of " << result.key << ", the baseline p50 is "
+        << base->second.p50_us << " us";
+  } else if (!FLAGS_arena_benchmark_baseline.empty()) {
+    LOG(WARNING) << "No baseline for " << result.key;
+  }
+  return result;
+}
+
+std::string Arena::PrecisionCaseName() {
+  static std::map<std::string, int> counts;
+  const auto* info = ::testing::UnitTest::GetInstance()->current_test_info();
+  std::string test =
+      info ? std::string(info->test_case_name()) + "." + info->name() : "";
+  return test + "#" + std::to_string(counts[test]++);
+}
+
+void RunBenchmarks(
+    const std::vector<DDim>& default_shapes,
+    const std::function<BenchmarkCases(const Place&, const DDim&)>&
+        make_cases) {
+  if (!FLAGS_arena_benchmark) return;
+  Place place;
+#if defined(LITE_WITH_X86)
+  place = TARGET(kX86);
+#elif defined(LITE_WITH_ARM)
+  place = TARGET(kARM);
+#else
+  LOG(WARNING) << "The benchmarks only run on X86 or ARM.";
+  return;
+#endif
+  for (const auto& dims : BenchmarkShapes(default_shapes)) {
+    for (auto& item : make_cases(place, dims)) {
+      Arena arena(std::move(item.second), place);
+      arena.Benchmark(item.first);
+    }
+  }
+}
+
 void TestCase::CreateInstruction() {
   std::shared_ptr<lite::OpLite> op = nullptr;
   if (place_.target == TARGET(kNPU) || place_.target == TARGET(kXPU)) {
     // Create a new block desc to wrap the original op desc
     int sub_block_idx = 0;
-    auto sub_block_desc = new cpp::BlockDesc();
+    std::unique_ptr<cpp::BlockDesc> sub_block_desc(new cpp::BlockDesc());
     sub_block_desc->ClearOps();
     sub_block_desc->ClearVars();
     auto sub_block_op_desc = sub_block_desc->AddOp<cpp::OpDesc>();
@@ -42,7 +228,8 @@ void TestCase::CreateInstruction() {
     op_desc_->SetAttr<std::vector<std::string>>("input_data_names", in_names);
     op_desc_->SetAttr<std::vector<std::string>>("output_data_names", out_names);
     op = LiteOpRegistry::Global().Create(op_desc().Type());
-    static_cast<operators::SubgraphOp*>(op.get())->SetSubBlock(sub_block_desc);
+    static_cast<operators::SubgraphOp*>(op.get())->SetSubBlock(
+        std::move(sub_block_desc));
   } else {
     op = LiteOpRegistry::Global().Create(op_desc().Type());
   }
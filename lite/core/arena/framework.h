@@ -13,11 +13,13 @@
 // limitations under the License.
 
 #pragma once
+#include <gflags/gflags.h>
 #include <gtest/gtest.h>
 #include <time.h>
 #include <algorithm>
 #include <chrono>  // NOLINT
 #include <cmath>
+#include <functional>
 #include <iomanip>
 #include <memory>
 #include <string>
@@ -25,15 +27,54 @@
 #include <utility>
 #include <vector>
 #include "lite/core/op_registry.h"
+#include "lite/core/profile/tracer.h"
 #include "lite/core/program.h"
 #include "lite/core/scope.h"
 #include "lite/core/types.h"
 #include "lite/model_parser/cpp/op_desc.h"
 
+DECLARE_bool(arena_benchmark);
+DECLARE_bool(arena_benchmark_all);
+DECLARE_int32(arena_benchmark_warmup);
+DECLARE_int32(arena_benchmark_repeats);
+DECLARE_string(arena_benchmark_shapes);
+DECLARE_string(arena_benchmark_output);
+DECLARE_string(arena_benchmark_baseline);
+DECLARE_double(arena_benchmark_tolerance);
+
 namespace paddle {
 namespace lite {
 namespace arena {
 
+/*
+ * The latencies of the runs of a kernel on a case, in microseconds, and its
+ * throughput estimated with profile::EstimateFlops and the bytes of the input
+ * and output tensors.
+ */
+struct BenchmarkResult {
+  // "<kernel name> <case name> <input shapes>", which identifies the result
+  // in the baseline.
+  std::string key;
+  int repeats{0};
+  double min_us{0};
+  double avg_us{0};
+  double p50_us{0};
+  double p90_us{0};
+  double p99_us{0};
+  double gflops{0};
+  double gbps{0};
+
+  // A line of the tab separated fields, in the order of `Header()`.
+  std::string ToString() const;
+  static std::string Header();
+  // Parse a line of `ToString()`, return false if it is malformed.
+  static bool Parse(const std::string& line, BenchmarkResult* result);
+};
+
+// The input shapes to sweep in the benchmarks, `FLAGS_arena_benchmark_shapes`
+// if set, e.g. "1,3,224,224;1,32,112,112", otherwise `defaults`.
+std::vector<DDim> BenchmarkShapes(const std::vector<DDim>& defaults);
+
 /*
  * Init data and prepare the op.
  */
@@ -59,6 +100,11 @@ class TestCase {
   /// Run the target instruction, that is run the test operator.
   void RunInstruction() { instruction_->Run(); }
 
+  /// Record the runs of the instruction to `tracer`, nullptr to stop.
+  void set_tracer(profile::Tracer* tracer) {
+    instruction_->set_tracer(tracer, 0);
+  }
+
   KernelContext* context() { return ctx_.get(); }
 
   /// The baseline should be implemented, which acts similar to an operator,
@@ -206,6 +252,9 @@ class Arena {
       }
     }
     LOG(INFO) << "done";
+    if (FLAGS_arena_benchmark_all) {
+      Benchmark(PrecisionCaseName());
+    }
     return success;
   }
 
@@ -229,7 +278,18 @@ class Arena {
               << static_cast<float>(duration_basic.count()) / duration.count();
   }
 
+  /// Time the instruction for `FLAGS_arena_benchmark_repeats` runs after
+  /// `FLAGS_arena_benchmark_warmup` ones. The result is appended to
+  /// `FLAGS_arena_benchmark_output` if set, and expected to be no slower than
+  /// the one of the same key in `FLAGS_arena_benchmark_baseline` by more than
+  /// `FLAGS_arena_benchmark_tolerance` if set.
+  BenchmarkResult Benchmark(const std::string& case_name);
+
  private:
+  // "<test name>#<n>" of the n-th case checked by the current gtest, which is
+  // deterministic as long as the test is.
+  static std::string PrecisionCaseName();
+
   // input_name: X
   bool CompareTensor(const std::string& arg_name, const std::string& var_name) {
     // get tensor type.
@@ -262,6 +322,17 @@ class Arena {
   float abs_error_;
 };
 
+/// The benchmark cases of a shape, by their names.
+using BenchmarkCases =
+    std::vector<std::pair<std::string, std::unique_ptr<TestCase>>>;
+
+/// Benchmark the cases made by `make_cases` for every shape of
+/// `BenchmarkShapes(default_shapes)` on the X86 or the ARM place, whichever is
+/// built. It does nothing unless `FLAGS_arena_benchmark` is set.
+void RunBenchmarks(
+    const std::vector<DDim>& default_shapes,
+    const std::function<BenchmarkCases(const Place&, const DDim&)>& make_cases);
+
 template <typename T>
 bool TestCase::CheckPrecision(const std::string& var_name, float abs_error) {
   auto a_tensor = inst_scope_->FindTensor(var_name);
@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <map>
 #include <memory>
 #include <set>
@@ -54,9 +55,30 @@ class KernelBase {
   /// Run kernel initialization if needed at every run (eg. input shape changed)
   virtual void ReInitWhenNeeded() {}
 
+  /// Reuse the weights transformed by `PrepareForRun` of `other`, the same
+  /// kernel in the program this one is cloned from, instead of transforming
+  /// them again. They are shared readonly, and `PrepareForRun` is skipped if
+  /// the kernel supports it. Nothing is shared if `other` is not prepared yet,
+  /// `other` may be running its first epoch meanwhile.
+  void ShareWeightsFrom(const KernelBase& other) {
+    CHECK_EQ(SerializedKernelType(), other.SerializedKernelType());
+    if (!other.is_first_epoch_ && ShareWeights(other)) {
+      is_first_epoch_ = false;
+    }
+  }
+
   /// Run the kernel. Before Run, both the param_ and context_ should be valid.
   virtual void Run() = 0;
 
+  /// The names of the algorithms the kernel can choose from to run the
+  /// attached param, empty if it has only one. The input shapes must be known.
+  virtual std::vector<std::string> Algorithms() const { return {}; }
+
+  /// Force one of `Algorithms()` instead of the kernel's own heuristics, as
+  /// picked by the kernel_tune_pass. It takes effect at `PrepareForRun`.
+  void set_algorithm(const std::string& algorithm) { algorithm_ = algorithm; }
+  const std::string& algorithm() const { return algorithm_; }
+
 #ifdef LITE_WITH_PROFILE
   void SetProfiler(profile::Profiler* profiler, int id) {
     profiler_ = profiler;
@@ -64,7 +86,9 @@ class KernelBase {
   }
 #endif
 
-  void Launch() {
+  /// `shape_changed` is false if the input shapes are known to be the same as
+  /// the last run, then the re-initialization check is skipped.
+  void Launch(bool shape_changed = true) {
     /// First run, init kernel, do weights transform once
     if (is_first_epoch_) {
       PrepareForRun();
@@ -72,7 +96,9 @@ class KernelBase {
     }
     /// re-init the kernel if needed (input shape should be checked in conv
     /// kernel)
-    ReInitWhenNeeded();
+    if (shape_changed) {
+      ReInitWhenNeeded();
+    }
 
     // Reset the workspace to make every kernel in the same thread to share the
     // temporary memory.
@@ -167,6 +193,11 @@ class KernelBase {
   void Torch() {}
 
  protected:
+  /// Take the state set by `PrepareForRun` from `other`, a prepared kernel of
+  /// the same type, sharing the tensors of the transformed weights. Returns
+  /// false if not supported, then `PrepareForRun` runs as usual.
+  virtual bool ShareWeights(const KernelBase& other) { return false; }
+
   std::unique_ptr<KernelContext> ctx_{nullptr};
   mutable operators::param_t param_;
   // The corresponding op type.
@@ -174,7 +205,11 @@ class KernelBase {
   // The extra identity to help defficiate a specific kernel, op_type_ + alias_
   // is the unique ID for the kernel.
   std::string alias_{};
-  bool is_first_epoch_{true};
+  // The forced algorithm, empty to let the kernel choose.
+  std::string algorithm_{};
+  // Atomic as it is read by the kernels cloned from this one, it is set after
+  // the weights are transformed by `PrepareForRun`.
+  std::atomic<bool> is_first_epoch_{true};
 
 #ifdef LITE_WITH_PROFILE
   profile::Profiler* profiler_{nullptr};
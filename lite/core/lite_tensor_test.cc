@@ -13,6 +13,8 @@
 // limitations under the License.
 
 #include <gtest/gtest.h>
+#include <memory>
+#include <vector>
 #include "lite/core/tensor.h"
 
 namespace paddle {
@@ -28,5 +30,34 @@ TEST(tensor, test) {
   }
 }
 
+TEST(tensor, external_memory) {
+  std::vector<float> data(8, 1.f);
+  std::shared_ptr<void> holder(data.data(), [](void*) {});
+  TensorLite tensor;
+  tensor.Resize({2, 4});
+
+  // The readonly memory is copied before the first write.
+  tensor.ShareExternalMemory(
+      data.data(), data.size() * sizeof(float), TARGET(kHost), holder);
+  EXPECT_EQ(tensor.data<float>(), data.data());
+  auto* copy = tensor.mutable_data<float>();
+  EXPECT_NE(copy, data.data());
+  copy[0] = 2.f;
+  EXPECT_EQ(data[0], 1.f);
+
+  // The writable memory is written in place, and the former buffer is kept
+  // by the tensors sharing it.
+  TensorLite shared;
+  shared.ShareDataWith(tensor);
+  tensor.ShareExternalMemory(
+      data.data(), data.size() * sizeof(float), TARGET(kHost), holder, true);
+  EXPECT_EQ(tensor.mutable_data<float>(), data.data());
+  EXPECT_EQ(shared.data<float>(), copy);
+
+  // A larger output does not fit in it.
+  tensor.Resize({4, 4});
+  EXPECT_NE(tensor.mutable_data<float>(), data.data());
+}
+
 }  // namespace lite
 }  // namespace paddle
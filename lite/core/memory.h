@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #pragma once
+#include <memory>
 #include "lite/api/paddle_place.h"
 #include "lite/core/target_wrapper.h"
 #include "lite/utils/macros.h"
@@ -100,9 +101,35 @@ class Buffer {
       data_ = TargetMalloc(target, size);
       target_ = target;
       space_ = size;
+    } else if (holder_ && !writable_) {
+      // External memory is readonly, copy it before handing it out for write.
+      void* data = TargetMalloc(target_, space_);
+      TargetCopy(target_, data, data_, space_);
+      holder_.reset();
+      data_ = data;
     }
   }
 
+  // Reference `size` bytes of readonly memory kept alive by `holder`, such as
+  // the pages of a memory-mapped model, instead of allocating. The memory is
+  // never released by TargetFree, and is copied on the first ResetLazy unless
+  // it is `writable`, such as an output buffer bound by the caller, which is
+  // written in place as long as it is large enough.
+  void ResetFromExternal(TargetType target,
+                         const void* data,
+                         size_t size,
+                         std::shared_ptr<void> holder,
+                         bool writable = false) {
+    Free();
+    data_ = const_cast<void*>(data);
+    target_ = target;
+    space_ = size;
+    holder_ = holder;
+    writable_ = writable;
+  }
+
+  bool is_external() const { return holder_ != nullptr; }
+
   void ResizeLazy(size_t size) { ResetLazy(target_, size); }
 
 #ifdef LITE_WITH_OPENCL
@@ -126,7 +153,10 @@ class Buffer {
 #endif
 
   void Free() {
-    if (space_ > 0) {
+    if (holder_) {
+      holder_.reset();
+      writable_ = false;
+    } else if (space_ > 0) {
       TargetFree(target_, data_);
     }
     data_ = nullptr;
@@ -150,6 +180,9 @@ class Buffer {
   size_t cl_image2d_height_{0};  // only used for OpenCL Image2D
   void* data_{nullptr};
   TargetType target_{TargetType::kHost};
+  // Owner of external memory, empty if data_ is allocated by this buffer.
+  std::shared_ptr<void> holder_;
+  bool writable_{false};
 };
 
 }  // namespace lite
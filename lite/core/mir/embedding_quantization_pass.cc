@@ -0,0 +1,132 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/mir/embedding_quantization_pass.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+#include "lite/core/mir/pass_registry.h"
+#include "lite/utils/half.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+void EmbeddingQuantizationPass::QuantizeTable(const std::string& quant_type,
+                                              lite::Tensor* table) {
+  CHECK_EQ(table->dims().size(), 2UL);
+  CHECK(table->precision() == PRECISION(kFloat));
+  int64_t rows = table->dims()[0];
+  int64_t width = table->dims()[1];
+  const float* src = table->data<float>();
+  lite::Tensor quantized;
+  if (quant_type == "int8") {
+    int64_t stride = width + static_cast<int64_t>(sizeof(float));
+    quantized.Resize({rows, stride});
+    auto* dst = quantized.mutable_data<int8_t>();
+    for (int64_t i = 0; i < rows; ++i) {
+      const float* row = src + i * width;
+      float absmax = 0.f;
+      for (int64_t k = 0; k < width; ++k) {
+        absmax = std::max(absmax, std::abs(row[k]));
+      }
+      float scale = absmax / 127.f;
+      float inv_scale = absmax > 0.f ? 1.f / scale : 0.f;
+      int8_t* out = dst + i * stride;
+      for (int64_t k = 0; k < width; ++k) {
+        float v = std::round(row[k] * inv_scale);
+        out[k] = static_cast<int8_t>(std::min(127.f, std::max(-127.f, v)));
+      }
+      std::memcpy(out + width, &scale, sizeof(float));
+    }
+    quantized.set_precision(PRECISION(kInt8));
+  } else if (quant_type == "fp16") {
+    quantized.Resize({rows, width});
+    auto* dst = quantized.mutable_data<int16_t>();
+    for (int64_t i = 0; i < rows * width; ++i) {
+      dst[i] = static_cast<int16_t>(FloatToHalf(src[i]));
+    }
+    quantized.set_precision(PRECISION(kInt16));
+  } else {
+    LOG(FATAL) << "Unsupported embedding quant type: " << quant_type;
+  }
+  table->ShareDataWith(quantized);
+  table->set_precision(quantized.precision());
+}
+
+void EmbeddingQuantizationPass::Apply(const std::unique_ptr<SSAGraph>& graph) {
+  const std::set<std::string> lookup_ops = {
+      "lookup_table", "lookup_table_v2", "fused_embedding_seq_pool"};
+  for (auto& node : graph->mutable_nodes()) {
+    if (!node.IsArg() || !node.AsArg().is_weight) continue;
+    const auto& table_name = node.AsArg().name;
+    // The table is quantized only if all its readers are lookup ops asking
+    // for the same quant type.
+    std::vector<Node*> marked;
+    std::string quant_type;
+    bool quantizable = true;
+    for (auto* op_node : node.outlinks) {
+      auto& stmt = op_node->AsStmt();
+      const auto* op_info = stmt.op_info();
+      std::string type;
+      if (lookup_ops.count(stmt.op_type()) &&
+          op_info->Input("W").front() == table_name &&
+          op_info->HasAttr("embedding_quant_type")) {
+        type = op_info->GetAttr<std::string>("embedding_quant_type");
+      }
+      if (type.empty() || (!quant_type.empty() && type != quant_type)) {
+        quantizable = false;
+      }
+      if (!type.empty()) {
+        marked.push_back(op_node);
+        quant_type = type;
+      }
+    }
+    if (marked.empty()) continue;
+
+    auto* scope = marked.front()->AsStmt().op()->scope();
+    auto* table = scope->FindVar(table_name)->GetMutable<lite::Tensor>();
+    if (table->precision() != PRECISION(kFloat)) {
+      // Quantized already, e.g. loaded from an optimized model.
+      continue;
+    }
+    if (!quantizable) {
+      LOG(WARNING) << "The embedding table " << table_name
+                   << " is shared with other ops or quant types, keep it in "
+                      "float.";
+      for (auto* op_node : marked) {
+        auto& stmt = op_node->AsStmt();
+        cpp::OpDesc op_desc = *stmt.op_info();
+        op_desc.SetAttr<std::string>("embedding_quant_type", "");
+        stmt.ResetOp(op_desc, graph->valid_places());
+      }
+      continue;
+    }
+    VLOG(3) << "Quantize the embedding table " << table_name << " to "
+            << quant_type;
+    QuantizeTable(quant_type, table);
+  }
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_MIR_PASS(embedding_quantization_pass,
+                  paddle::lite::mir::EmbeddingQuantizationPass)
+    .BindTargets({TARGET(kX86)});
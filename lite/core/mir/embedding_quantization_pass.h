@@ -0,0 +1,45 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <memory>
+#include <string>
+#include "lite/core/mir/pass.h"
+#include "lite/core/op_registry.h"
+#include "lite/core/tensor.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+/*
+ * EmbeddingQuantizationPass compresses the embedding tables of the lookup
+ * ops (lookup_table, lookup_table_v2, fused_embedding_seq_pool) marked with
+ * the "embedding_quant_type" attribute by the predictor:
+ *  - "int8": each row is quantized symmetrically with its own scale
+ *    (absmax / 127), the float scale is stored in the last 4 bytes of the row,
+ *    so the table becomes an int8 tensor of [rows, width + 4].
+ *  - "fp16": the table is converted to half precision, stored as int16.
+ * The fp32 table is released, and the quantized table is saved as is in the
+ * optimized model. A table also read by other ops is left untouched.
+ */
+class EmbeddingQuantizationPass : public ProgramPass {
+ public:
+  void Apply(const std::unique_ptr<SSAGraph>& graph) override;
+
+  static void QuantizeTable(const std::string& quant_type, lite::Tensor* table);
+};
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,133 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/mir/fusion/add_layer_norm_fuser.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace paddle {
+namespace lite {
+namespace mir {
+namespace fusion {
+
+namespace {
+
+// Whether the inputs of the elementwise_add have the same static shape, that
+// is the residual connection rather than a broadcast add.
+bool IsResidualAdd(const Node* node) {
+  auto* op_info = node->stmt()->op_info();
+  if (op_info->GetAttr<int>("axis") != -1) return false;
+  std::string x_name = op_info->Input("X").front();
+  std::string y_name = op_info->Input("Y").front();
+  const std::vector<int64_t>* x_shape = nullptr;
+  const std::vector<int64_t>* y_shape = nullptr;
+  for (auto* in : node->inlinks) {
+    if (!in->IsArg()) continue;
+    if (in->arg()->name == x_name) x_shape = &in->arg()->shape;
+    if (in->arg()->name == y_name) y_shape = &in->arg()->shape;
+  }
+  return x_shape && y_shape && !x_shape->empty() && *x_shape == *y_shape;
+}
+
+}  // namespace
+
+// """
+// merge {elementwise_add, layer_norm} => fused_add_layer_norm
+//     x      y
+//      \    /
+//  elementwise_add                    x   y   scale   bias
+//         |                            \  |    |     /
+//     layer_norm <- scale, bias   =>  fused_add_layer_norm
+//     /   |    \                               |
+// mean   out   variance                       out
+// """
+void AddLayerNormFuser::BuildPattern() {
+  // create nodes.
+  auto* x = VarNode("x")
+                ->assert_is_op_input("elementwise_add", "X")
+                ->assert_var_not_persistable();
+  auto* y = VarNode("y")
+                ->assert_is_op_input("elementwise_add", "Y")
+                ->assert_var_not_persistable();
+  auto* add = OpNode("add", "elementwise_add")
+                  ->assert_node_satisfied(IsResidualAdd);
+  auto* add_out = VarNode("add_out")
+                      ->assert_is_op_output("elementwise_add", "Out")
+                      ->assert_is_op_input("layer_norm", "X");
+  auto* scale = VarNode("scale")
+                    ->assert_is_op_input("layer_norm", "Scale")
+                    ->assert_is_persistable_var();
+  auto* bias = VarNode("bias")
+                   ->assert_is_op_input("layer_norm", "Bias")
+                   ->assert_is_persistable_var();
+  auto* layer_norm = OpNode("layer_norm", "layer_norm");
+  auto* out = VarNode("out")->assert_is_op_output("layer_norm", "Y");
+  auto* mean = VarNode("mean")->assert_is_op_output("layer_norm", "Mean");
+  auto* variance =
+      VarNode("variance")->assert_is_op_output("layer_norm", "Variance");
+
+  // create topology.
+  std::vector<PMNode*> add_inputs{x, y};
+  std::vector<PMNode*> layer_norm_inputs{add_out, scale, bias};
+  std::vector<PMNode*> layer_norm_outputs{out, mean, variance};
+  add_inputs >> *add >> *add_out;
+  layer_norm_inputs >> *layer_norm >> layer_norm_outputs;
+
+  // Some op specialities.
+  add->AsIntermediate();
+  add_out->AsIntermediate();
+  layer_norm->AsIntermediate();
+  mean->AsIntermediate();
+  variance->AsIntermediate();
+}
+
+void AddLayerNormFuser::InsertNewNode(SSAGraph* graph,
+                                      const key2nodes_t& matched) {
+  auto op_desc = GenOpDesc(matched);
+  auto fused_op = LiteOpRegistry::Global().Create("fused_add_layer_norm");
+  auto layer_norm = matched.at("layer_norm")->stmt()->op();
+  auto* scope = layer_norm->scope();
+  auto& valid_places = layer_norm->valid_places();
+  fused_op->Attach(op_desc, scope);
+
+  auto* new_op_node = graph->GraphCreateInstructNode(fused_op, valid_places);
+
+  IR_NODE_LINK_TO(matched.at("x"), new_op_node);
+  IR_NODE_LINK_TO(matched.at("y"), new_op_node);
+  IR_NODE_LINK_TO(matched.at("scale"), new_op_node);
+  IR_NODE_LINK_TO(matched.at("bias"), new_op_node);
+  IR_NODE_LINK_TO(new_op_node, matched.at("out"));
+}
+
+cpp::OpDesc AddLayerNormFuser::GenOpDesc(const key2nodes_t& matched) {
+  auto* layer_norm_info = matched.at("layer_norm")->stmt()->op_info();
+
+  cpp::OpDesc op_desc;
+  op_desc.SetType("fused_add_layer_norm");
+  op_desc.SetInput("X", {matched.at("x")->arg()->name});
+  op_desc.SetInput("Y", {matched.at("y")->arg()->name});
+  op_desc.SetInput("Scale", {matched.at("scale")->arg()->name});
+  op_desc.SetInput("Bias", {matched.at("bias")->arg()->name});
+  op_desc.SetOutput("Out", {matched.at("out")->arg()->name});
+  op_desc.SetAttr("begin_norm_axis",
+                  layer_norm_info->GetAttr<int>("begin_norm_axis"));
+  op_desc.SetAttr("epsilon", layer_norm_info->GetAttr<float>("epsilon"));
+  return op_desc;
+}
+
+}  // namespace fusion
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,44 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/mir/fusion/attention_fuse_pass.h"
+#include <memory>
+#include <vector>
+#include "lite/core/mir/fusion/attention_fuser.h"
+#include "lite/core/mir/pass_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+void AttentionFusePass::Apply(const std::unique_ptr<SSAGraph>& graph) {
+  // The larger patterns go first.
+  for (bool transpose_out : {true, false}) {
+    for (bool with_mask : {true, false}) {
+      for (bool with_q_scale : {true, false}) {
+        fusion::AttentionFuser fuser(with_mask, with_q_scale, transpose_out);
+        fuser(graph.get());
+      }
+    }
+  }
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_MIR_PASS(lite_attention_fuse_pass,
+                  paddle::lite::mir::AttentionFusePass)
+    .BindTargets({TARGET(kX86)})
+    .BindKernel("fused_attention");
@@ -0,0 +1,177 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/mir/fusion/attention_fuser.h"
+#include <memory>
+#include <vector>
+
+namespace paddle {
+namespace lite {
+namespace mir {
+namespace fusion {
+
+namespace {
+
+bool IsFloatMatMul(const Node* node) {
+  auto* op_info = node->stmt()->op_info();
+  return !op_info->HasAttr("enable_int8") ||
+         !op_info->GetAttr<bool>("enable_int8");
+}
+
+}  // namespace
+
+// """
+// merge the scaled dot-product attention => fused_attention
+//     q       k
+//     |       |
+//  [scale]    |
+//      \     /
+//       matmul (transpose_Y)
+//         |
+//  [elementwise_add] <- mask
+//         |
+//      softmax      v              q   k   v  [mask]
+//          \       /                \  |  /  /
+//           matmul          =>   fused_attention
+//             |                        |
+//       [transpose2]                   |
+//             |                        |
+//            out                      out
+// """
+void AttentionFuser::BuildPattern() {
+  // create nodes.
+  auto* q = VarNode("q")->assert_is_op_input("matmul", "X");
+  auto* k = VarNode("k")->assert_is_op_input("matmul", "Y");
+  auto* qk_matmul = OpNode("qk_matmul", "matmul")
+                        ->assert_op_attr<bool>("transpose_X", false)
+                        ->assert_op_attr<bool>("transpose_Y", true)
+                        ->assert_node_satisfied(IsFloatMatMul);
+  auto* qk = VarNode("qk")->assert_is_op_output("matmul", "Out");
+  auto* softmax =
+      OpNode("softmax", "softmax")->assert_node_satisfied([](const Node* x) {
+        auto* op_info = x->stmt()->op_info();
+        return !op_info->HasAttr("axis") || op_info->GetAttr<int>("axis") == -1;
+      });
+  auto* probs = VarNode("probs")
+                    ->assert_is_op_output("softmax", "Out")
+                    ->assert_is_op_input("matmul", "X");
+  auto* v = VarNode("v")->assert_is_op_input("matmul", "Y");
+  auto* pv_matmul = OpNode("pv_matmul", "matmul")
+                        ->assert_op_attr<bool>("transpose_X", false)
+                        ->assert_op_attr<bool>("transpose_Y", false)
+                        ->assert_op_attr<float>("alpha", 1.f)
+                        ->assert_node_satisfied(IsFloatMatMul);
+  auto* out = VarNode("out");
+
+  // create topology.
+  std::vector<PMNode*> qk_inputs{q, k};
+  qk_inputs >> *qk_matmul >> *qk;
+  if (with_q_scale_) {
+    auto* q_in = VarNode("q_in")->assert_is_op_input("scale", "X");
+    auto* q_scale =
+        OpNode("q_scale", "scale")->assert_op_attr<float>("bias", 0.f);
+    *q_in >> *q_scale >> *q;
+    q->assert_is_op_output("scale", "Out");
+    q->AsIntermediate();
+    q_scale->AsIntermediate();
+  }
+  if (with_mask_) {
+    auto* mask = VarNode("mask")->assert_is_op_input("elementwise_add", "Y");
+    auto* mask_add = OpNode("mask_add", "elementwise_add")
+                         ->assert_op_attr<int>("axis", -1);
+    auto* qk_masked =
+        VarNode("qk_masked")->assert_is_op_output("elementwise_add", "Out");
+    qk->assert_is_op_input("elementwise_add", "X");
+    std::vector<PMNode*> mask_add_inputs{qk, mask};
+    mask_add_inputs >> *mask_add >> *qk_masked >> *softmax;
+    mask_add->AsIntermediate();
+    qk_masked->AsIntermediate();
+  } else {
+    *qk >> *softmax;
+  }
+  std::vector<PMNode*> pv_inputs{probs, v};
+  *softmax >> *probs;
+  pv_inputs >> *pv_matmul;
+  if (transpose_out_) {
+    auto* pv = VarNode("pv")
+                   ->assert_is_op_output("matmul", "Out")
+                   ->assert_is_op_input("transpose2", "X");
+    auto* transpose = OpNode("transpose", "transpose2")
+                          ->assert_op_attr<std::vector<int>>(
+                              "axis", std::vector<int>({0, 2, 1, 3}));
+    auto* xshape =
+        VarNode("xshape")->assert_is_op_output("transpose2", "XShape");
+    *pv_matmul >> *pv >> *transpose >> *out;
+    *transpose >> *xshape;
+    pv->AsIntermediate();
+    transpose->AsIntermediate();
+    xshape->AsIntermediate();
+  } else {
+    *pv_matmul >> *out;
+  }
+
+  // Some op specialities.
+  qk_matmul->AsIntermediate();
+  qk->AsIntermediate();
+  softmax->AsIntermediate();
+  probs->AsIntermediate();
+  pv_matmul->AsIntermediate();
+}
+
+void AttentionFuser::InsertNewNode(SSAGraph* graph,
+                                   const key2nodes_t& matched) {
+  auto op_desc = GenOpDesc(matched);
+  auto fused_op = LiteOpRegistry::Global().Create("fused_attention");
+  auto qk_matmul = matched.at("qk_matmul")->stmt()->op();
+  auto* scope = qk_matmul->scope();
+  auto& valid_places = qk_matmul->valid_places();
+  fused_op->Attach(op_desc, scope);
+
+  auto* new_op_node = graph->GraphCreateInstructNode(fused_op, valid_places);
+
+  IR_NODE_LINK_TO(matched.at(with_q_scale_ ? "q_in" : "q"), new_op_node);
+  IR_NODE_LINK_TO(matched.at("k"), new_op_node);
+  IR_NODE_LINK_TO(matched.at("v"), new_op_node);
+  if (with_mask_) {
+    IR_NODE_LINK_TO(matched.at("mask"), new_op_node);
+  }
+  IR_NODE_LINK_TO(new_op_node, matched.at("out"));
+}
+
+cpp::OpDesc AttentionFuser::GenOpDesc(const key2nodes_t& matched) {
+  float alpha =
+      matched.at("qk_matmul")->stmt()->op_info()->GetAttr<float>("alpha");
+  if (with_q_scale_) {
+    alpha *= matched.at("q_scale")->stmt()->op_info()->GetAttr<float>("scale");
+  }
+
+  cpp::OpDesc op_desc;
+  op_desc.SetType("fused_attention");
+  op_desc.SetInput("Q",
+                   {matched.at(with_q_scale_ ? "q_in" : "q")->arg()->name});
+  op_desc.SetInput("K", {matched.at("k")->arg()->name});
+  op_desc.SetInput("V", {matched.at("v")->arg()->name});
+  if (with_mask_) {
+    op_desc.SetInput("Mask", {matched.at("mask")->arg()->name});
+  }
+  op_desc.SetOutput("Out", {matched.at("out")->arg()->name});
+  op_desc.SetAttr("alpha", alpha);
+  op_desc.SetAttr("transpose_out", transpose_out_);
+  return op_desc;
+}
+
+}  // namespace fusion
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,50 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include "lite/core/mir/pattern_matcher_high_api.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+namespace fusion {
+
+class AttentionFuser : public FuseBase {
+ public:
+  // `with_mask`: the scores are masked by an elementwise_add.
+  // `with_q_scale`: Q is scaled by a scale op before the matmul.
+  // `transpose_out`: the output is transposed by transpose2 to
+  //  [batch, seq, heads, size].
+  AttentionFuser(bool with_mask, bool with_q_scale, bool transpose_out)
+      : with_mask_(with_mask),
+        with_q_scale_(with_q_scale),
+        transpose_out_(transpose_out) {}
+
+  void BuildPattern() override;
+  void InsertNewNode(SSAGraph* graph, const key2nodes_t& matched) override;
+
+ private:
+  cpp::OpDesc GenOpDesc(const key2nodes_t& matched) override;
+  bool with_mask_;
+  bool with_q_scale_;
+  bool transpose_out_;
+};
+
+}  // namespace fusion
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
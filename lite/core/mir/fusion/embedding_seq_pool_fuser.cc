@@ -0,0 +1,122 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/mir/fusion/embedding_seq_pool_fuser.h"
+#include <memory>
+#include <vector>
+
+namespace paddle {
+namespace lite {
+namespace mir {
+namespace fusion {
+
+// """
+// merge {lookup_table, sequence_pool} => fused_embedding_seq_pool
+//     ids     W
+//      |      |
+//      v      v
+//   lookup_table                ids     W
+//        |                 =>    |      |
+//        v                       v      v
+//   sequence_pool       fused_embedding_seq_pool
+//        |                          |
+//        v                          v
+//       out                        out
+// """
+void EmbeddingSeqPoolFuser::BuildPattern() {
+  // create nodes.
+  auto* ids = VarNode("ids")->assert_is_op_input("lookup_table", "Ids");
+  auto* w = VarNode("w")
+                ->assert_is_op_input("lookup_table", "W")
+                ->assert_is_persistable_var();
+  auto* lookup_table = OpNode("lookup_table", "lookup_table");
+  auto* lookup_table_out = VarNode("lookup_table_out")
+                               ->assert_is_op_output("lookup_table", "Out")
+                               ->assert_is_op_input("sequence_pool", "X");
+  auto* sequence_pool =
+      OpNode("sequence_pool", "sequence_pool")
+          ->assert_op_attr_satisfied<std::string>(
+              "pooltype", [](const std::string& pooltype) {
+                return pooltype == "SUM" || pooltype == "AVERAGE" ||
+                       pooltype == "SQRT";
+              });
+  auto* sequence_pool_out =
+      VarNode("sequence_pool_out")
+          ->assert_is_op_output("sequence_pool", "Out");
+  auto* sequence_pool_idx =
+      VarNode("sequence_pool_idx")
+          ->assert_is_op_output("sequence_pool", "MaxIndex");
+
+  // create topology.
+  std::vector<PMNode*> lookup_table_inputs{ids, w};
+  lookup_table_inputs >> *lookup_table >> *lookup_table_out >>
+      *sequence_pool >> *sequence_pool_out;
+  *sequence_pool >> *sequence_pool_idx;
+
+  // Some op specialities.
+  lookup_table->AsIntermediate();
+  lookup_table_out->AsIntermediate();
+  sequence_pool->AsIntermediate();
+  sequence_pool_idx->AsIntermediate();
+}
+
+void EmbeddingSeqPoolFuser::InsertNewNode(SSAGraph* graph,
+                                          const key2nodes_t& matched) {
+  auto op_desc = GenOpDesc(matched);
+  auto fused_op = LiteOpRegistry::Global().Create("fused_embedding_seq_pool");
+  auto lookup_table = matched.at("lookup_table")->stmt()->op();
+  auto* scope = lookup_table->scope();
+  auto& valid_places = lookup_table->valid_places();
+  fused_op->Attach(op_desc, scope);
+
+  auto* new_op_node = graph->GraphCreateInstructNode(fused_op, valid_places);
+
+  IR_NODE_LINK_TO(matched.at("ids"), new_op_node);
+  IR_NODE_LINK_TO(matched.at("w"), new_op_node);
+  IR_NODE_LINK_TO(new_op_node, matched.at("sequence_pool_out"));
+}
+
+cpp::OpDesc EmbeddingSeqPoolFuser::GenOpDesc(const key2nodes_t& matched) {
+  auto* lookup_table_info = matched.at("lookup_table")->stmt()->op_info();
+  auto pooltype = matched.at("sequence_pool")
+                      ->stmt()
+                      ->op_info()
+                      ->GetAttr<std::string>("pooltype");
+
+  cpp::OpDesc op_desc;
+  op_desc.SetType("fused_embedding_seq_pool");
+  op_desc.SetInput("W", {matched.at("w")->arg()->name});
+  op_desc.SetInput("Ids", {matched.at("ids")->arg()->name});
+  op_desc.SetOutput("Out", {matched.at("sequence_pool_out")->arg()->name});
+  if (pooltype == "SUM") {
+    op_desc.SetAttr("combiner", std::string("sum"));
+  } else if (pooltype == "AVERAGE") {
+    op_desc.SetAttr("combiner", std::string("average"));
+  } else {
+    op_desc.SetAttr("combiner", std::string("sqrt"));
+  }
+  op_desc.SetAttr("padding_idx",
+                  lookup_table_info->GetAttr<int64_t>("padding_idx"));
+  if (lookup_table_info->HasAttr("embedding_quant_type")) {
+    op_desc.SetAttr(
+        "embedding_quant_type",
+        lookup_table_info->GetAttr<std::string>("embedding_quant_type"));
+  }
+  return op_desc;
+}
+
+}  // namespace fusion
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
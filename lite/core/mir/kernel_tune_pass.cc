@@ -0,0 +1,360 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/mir/kernel_tune_pass.h"
+#include <algorithm>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "lite/core/mir/pass_registry.h"
+#include "lite/core/profile/timer.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+namespace {
+
+// The runs timed for each candidate, after a warm up run.
+const int kTuneRepeats = 10;
+
+// The ops holding sub blocks or moving data between devices are not tuned.
+const std::set<std::string> kUntunedOps = {"feed",
+                                           "fetch",
+                                           "while",
+                                           "conditional_block",
+                                           "subgraph",
+                                           "io_copy",
+                                           "io_copy_once",
+                                           "layout",
+                                           "layout_once",
+                                           "calib",
+                                           "calib_once"};
+
+// The model name of the first CPU in /proc/cpuinfo.
+std::string CpuModel() {
+  std::ifstream cpuinfo("/proc/cpuinfo");
+  std::string line;
+  while (std::getline(cpuinfo, line)) {
+    if (line.compare(0, 10, "model name") == 0 ||
+        line.compare(0, 8, "Hardware") == 0) {
+      auto pos = line.find(':');
+      if (pos != std::string::npos && pos + 2 <= line.size()) {
+        return line.substr(pos + 2);
+      }
+    }
+  }
+  return "unknown";
+}
+
+std::string Sanitize(std::string str) {
+  std::replace(str.begin(), str.end(), '\t', ' ');
+  std::replace(str.begin(), str.end(), '\n', ' ');
+  return str;
+}
+
+template <typename T>
+void PrintVector(const std::vector<T>& vec, std::ostream* os) {
+  *os << "[";
+  for (size_t i = 0; i < vec.size(); ++i) {
+    *os << (i ? "," : "") << vec[i];
+  }
+  *os << "]";
+}
+
+// The attributes affecting the kernels, the ones of the framework (op_role,
+// op_callstack...) and of the passes are skipped.
+void PrintAttrs(const OpInfo& op_info, std::ostream* os) {
+  using AttrType = OpDescAPI::AttrType;
+  for (const auto& name : op_info.AttrNames()) {
+    if (name.compare(0, 3, "op_") == 0 || name.compare(0, 3, "__@") == 0) {
+      continue;
+    }
+    std::stringstream value;
+    switch (op_info.GetAttrType(name)) {
+      case AttrType::INT:
+        value << op_info.GetAttr<int32_t>(name);
+        break;
+      case AttrType::LONG:
+        value << op_info.GetAttr<int64_t>(name);
+        break;
+      case AttrType::FLOAT:
+        value << op_info.GetAttr<float>(name);
+        break;
+      case AttrType::BOOLEAN:
+        value << op_info.GetAttr<bool>(name);
+        break;
+      case AttrType::STRING:
+        value << op_info.GetAttr<std::string>(name);
+        break;
+      case AttrType::INTS:
+        PrintVector(op_info.GetAttr<std::vector<int>>(name), &value);
+        break;
+      case AttrType::LONGS:
+        PrintVector(op_info.GetAttr<std::vector<int64_t>>(name), &value);
+        break;
+      case AttrType::FLOATS:
+        PrintVector(op_info.GetAttr<std::vector<float>>(name), &value);
+        break;
+      default:
+        continue;
+    }
+    *os << " " << name << "=" << value.str();
+  }
+}
+
+// The declared type of an argument of the kernel, nullptr if not declared.
+const Type* DeclType(const KernelBase& kernel,
+                     const std::string& slot,
+                     bool is_input) {
+  auto& registry = ParamTypeRegistry::Global();
+  const auto* type =
+      is_input ? registry.RetrieveInArgument(
+                     kernel.place(), kernel.GenParamTypeKey(), slot)
+               : registry.RetrieveOutArgument(
+                     kernel.place(), kernel.GenParamTypeKey(), slot);
+  return type ? type->type : nullptr;
+}
+
+// Create the tensors of the inputs which are not weights in `scope`, with the
+// static shapes of the model and synthetic data. Returns false if a shape is
+// unknown or dynamic beyond the batch size, or the input is not float.
+bool PrepareInputs(Node* node, const KernelBase& kernel, Scope* scope) {
+  const auto& stmt = node->AsStmt();
+  for (auto* in : node->inlinks) {
+    const auto& arg = in->AsArg();
+    if (arg.is_weight || arg.is_persist) continue;
+    std::string slot;
+    CHECK(stmt.op_info()->GetInputArgname(arg.name, &slot));
+    const auto* type = DeclType(kernel, slot, true);
+    if (!type || !type->IsTensor() || type->precision() != PRECISION(kFloat) ||
+        arg.shape.empty()) {
+      return false;
+    }
+    auto shape = arg.shape;
+    if (shape[0] < 0) shape[0] = 1;
+    for (auto dim : shape) {
+      if (dim <= 0) return false;
+    }
+    auto* tensor = scope->Var(arg.name)->GetMutable<lite::Tensor>();
+    tensor->Resize(shape);
+    auto* data = tensor->mutable_data<float>();
+    for (int64_t i = 0; i < tensor->numel(); ++i) {
+      data[i] = static_cast<float>(i * 37 % 101) / 50.f - 1.f;
+    }
+  }
+  for (auto* out : node->outlinks) {
+    scope->Var(out->AsArg().name)->GetMutable<lite::Tensor>();
+  }
+  return true;
+}
+
+// The op type, the input shapes and the attributes.
+std::string OpSignature(const OpInfo& op_info, const Scope& scope) {
+  std::stringstream ss;
+  ss << op_info.Type();
+  for (const auto& slot : op_info.input_argnames()) {
+    for (const auto& name : op_info.Input(slot)) {
+      auto* var = scope.FindVar(name);
+      if (!var || !var->IsType<lite::Tensor>()) continue;
+      ss << " " << slot << ":";
+      PrintVector(var->Get<lite::Tensor>().dims().Vectorize(), &ss);
+    }
+  }
+  PrintAttrs(op_info, &ss);
+  return Sanitize(ss.str());
+}
+
+std::unique_ptr<KernelBase> CreateKernel(OpLite* op,
+                                         const std::string& kernel_type) {
+  auto kernels = op->CreateKernels({}, kernel_type);
+  for (auto& kernel : kernels) {
+    if (kernel->SerializedKernelType() == kernel_type) {
+      return std::move(kernel);
+    }
+  }
+  return nullptr;
+}
+
+// Whether `kernel` can replace `picked`, without changing the types of the
+// arguments. The host targets are compatible with each other.
+bool SameArgTypes(const OpInfo& op_info,
+                  const KernelBase& picked,
+                  const KernelBase& kernel) {
+  auto same = [](const Type* a, const Type* b) {
+    if (!a || !b) return a == b;
+    return TargetCompatibleTo(*a, *b) && a->precision() == b->precision() &&
+           a->layout() == b->layout() && a->IsTensor() == b->IsTensor();
+  };
+  for (const auto& slot : op_info.input_argnames()) {
+    if (!same(DeclType(picked, slot, true), DeclType(kernel, slot, true))) {
+      return false;
+    }
+  }
+  for (const auto& slot : op_info.output_argnames()) {
+    if (!same(DeclType(picked, slot, false), DeclType(kernel, slot, false))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// The average milliseconds of a run of the kernel with the algorithm.
+float TimeKernel(OpLite* op,
+                 const std::string& kernel_type,
+                 const std::string& algorithm) {
+  auto kernel = CreateKernel(op, kernel_type);
+  CHECK(kernel);
+  kernel->set_algorithm(algorithm);
+  kernel->SetContext(ContextScheduler::Global().NewContext(kernel->target()));
+  kernel->PrepareForRun();
+  kernel->ReInitWhenNeeded();
+  kernel->Run();
+  profile::Timer timer;
+  timer.Start();
+  for (int i = 0; i < kTuneRepeats; ++i) {
+    kernel->Run();
+  }
+  return timer.Stop() / kTuneRepeats;
+}
+
+}  // namespace
+
+void KernelTunePass::LoadCache(const std::string& path,
+                               std::map<std::string, std::string>* cache) {
+  std::ifstream file(path);
+  std::string line;
+  while (std::getline(file, line)) {
+    // The key is the CPU model and the op signature, the value the kernel
+    // type and the algorithm.
+    size_t pos = line.find('\t');
+    pos = pos == std::string::npos ? pos : line.find('\t', pos + 1);
+    if (pos == std::string::npos ||
+        line.find('\t', pos + 1) == std::string::npos) {
+      LOG(WARNING) << "Skip the invalid tuning cache line: " << line;
+      continue;
+    }
+    (*cache)[line.substr(0, pos)] = line.substr(pos + 1);
+  }
+}
+
+void KernelTunePass::SaveCache(
+    const std::string& path, const std::map<std::string, std::string>& cache) {
+  std::ofstream file(path);
+  CHECK(file.is_open()) << "Failed to write the tuning cache " << path;
+  for (const auto& item : cache) {
+    file << item.first << "\t" << item.second << "\n";
+  }
+}
+
+void KernelTunePass::Apply(const std::unique_ptr<SSAGraph>& graph) {
+  if (!enabled_) return;
+  std::map<std::string, std::string> cache;
+  if (!cache_file_.empty()) {
+    LoadCache(cache_file_, &cache);
+  }
+  const std::string cpu_model = Sanitize(CpuModel());
+  bool cache_updated = false;
+
+  for (auto& node : graph->mutable_nodes()) {
+    if (!node.IsStmt()) continue;
+    auto& stmt = node.AsStmt();
+    const auto* op_info = stmt.op_info();
+    if (kUntunedOps.count(stmt.op_type()) ||
+        op_info->HasAttr("enable_int8") || stmt.kernels().size() != 1) {
+      continue;
+    }
+    const auto& picked = *stmt.kernels().front();
+    // The candidates run in a scratch scope, which reads the weights from the
+    // scope of the op.
+    auto* scope = &stmt.op()->scope()->NewScope();
+    if (!PrepareInputs(&node, picked, scope)) {
+      stmt.op()->scope()->DeleteScope(scope);
+      continue;
+    }
+    auto op = LiteOpRegistry::Global().Create(stmt.op_type());
+    CHECK(op) << "no Op found for " << stmt.op_type();
+    op->Attach(*op_info, scope);
+
+    // The candidates are the pairs of kernel type and algorithm.
+    std::vector<std::pair<std::string, std::string>> candidates;
+    for (auto& kernel : op->CreateKernels(graph->valid_places())) {
+      if (!SameArgTypes(*op_info, picked, *kernel)) continue;
+      auto algorithms = kernel->Algorithms();
+      if (algorithms.empty()) algorithms.emplace_back();
+      for (const auto& algorithm : algorithms) {
+        candidates.emplace_back(kernel->SerializedKernelType(), algorithm);
+      }
+    }
+    if (candidates.size() < 2) {
+      stmt.op()->scope()->DeleteScope(scope);
+      continue;
+    }
+
+    std::stringstream key;
+    key << cpu_model << "\t" << OpSignature(*op_info, *scope);
+    for (const auto& candidate : candidates) {
+      key << " " << candidate.first << "," << candidate.second;
+    }
+    std::pair<std::string, std::string> winner;
+    auto cached = cache.find(key.str());
+    if (cached != cache.end()) {
+      size_t pos = cached->second.find('\t');
+      winner = {cached->second.substr(0, pos), cached->second.substr(pos + 1)};
+    }
+    if (std::find(candidates.begin(), candidates.end(), winner) ==
+        candidates.end()) {
+      CHECK(op->CheckShape());
+      CHECK(op->InferShape());
+      float best = std::numeric_limits<float>::max();
+      for (const auto& candidate : candidates) {
+        float time = TimeKernel(op.get(), candidate.first, candidate.second);
+        VLOG(3) << stmt.op_type() << " " << candidate.first << " "
+                << candidate.second << ": " << time << " ms";
+        if (time < best) {
+          best = time;
+          winner = candidate;
+        }
+      }
+      cache[key.str()] = winner.first + "\t" + winner.second;
+      cache_updated = true;
+    }
+    stmt.op()->scope()->DeleteScope(scope);
+
+    VLOG(2) << "tune " << stmt.op_type() << ": pick " << winner.first << " "
+            << winner.second;
+    auto kernel = CreateKernel(stmt.op().get(), winner.first);
+    CHECK(kernel);
+    kernel->set_algorithm(winner.second);
+    stmt.kernels().clear();
+    stmt.kernels().emplace_back(std::move(kernel));
+  }
+
+  if (cache_updated && !cache_file_.empty()) {
+    SaveCache(cache_file_, cache);
+  }
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_MIR_PASS(kernel_tune_pass, paddle::lite::mir::KernelTunePass)
+    .BindTargets({TARGET(kAny)});
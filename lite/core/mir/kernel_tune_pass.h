@@ -0,0 +1,70 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "lite/core/mir/pass.h"
+#include "lite/core/op_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+/*
+ * KernelTunePass replaces the kernels picked by the StaticKernelPickPass with
+ * the fastest ones for the shapes of the model, by timing them. The candidates
+ * of an op are:
+ *  - its kernels whose arguments have the same types as the picked one, e.g.
+ *    the X86 and the host kernels of an op,
+ *  - the algorithms of the kernels, e.g. gemm, winograd or direct for the
+ *    X86 conv2d, see `KernelBase::Algorithms`.
+ * They run on the static shapes recorded in the model, the dynamic batch size
+ * is taken as 1, with the real weights and synthetic float inputs. The ops
+ * with other dynamic or unknown input shapes are not tuned.
+ *
+ * The winners are recorded in a tuning cache file, keyed by the CPU model and
+ * the signature of the op (type, input shapes, attributes and candidates), so
+ * the later builds on the same machine skip the timing. The picked kernels
+ * and algorithms are saved in the optimized model, the MobileConfig loads them
+ * without tuning.
+ *
+ * It does nothing unless enabled, see `CxxConfig::set_kernel_tune`.
+ */
+class KernelTunePass : public StmtPass {
+ public:
+  void Apply(const std::unique_ptr<SSAGraph>& graph) override;
+
+  // Enable the tuning, `cache_file` is read and updated if not empty.
+  void SetTuning(bool enabled, const std::string& cache_file) {
+    enabled_ = enabled;
+    cache_file_ = cache_file;
+  }
+
+  // The tuning cache file holds a line per op: the CPU model, the op signature,
+  // the winner kernel type and algorithm, separated by tabs.
+  static void LoadCache(const std::string& path,
+                        std::map<std::string, std::string>* cache);
+  static void SaveCache(const std::string& path,
+                        const std::map<std::string, std::string>& cache);
+
+ private:
+  bool enabled_{false};
+  std::string cache_file_;
+};
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
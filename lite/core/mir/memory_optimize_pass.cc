@@ -26,11 +26,16 @@ namespace mir {
 
 typedef struct {
   std::string name;
-  int cluster;
+  size_t size;
   std::pair<int, int> lifetime;
-  std::unordered_set<std::string> adj;
 } MemNode;
 
+typedef struct {
+  std::string name;
+  size_t size;
+  std::vector<std::pair<int, int>> lifetimes;
+} MemCluster;
+
 void MemoryOptimizePass::CollectLifeCycleByDevice(
     std::unordered_map<std::string, lifecycle_map_t>* lifecycles,
     SSAGraph* graph) {
@@ -103,54 +108,112 @@ void MemoryOptimizePass::CollectLifeCycleByDevice(
   LOG(INFO) << "There are " << (*lifecycles).size() << " types device var.";
 }
 
+void MemoryOptimizePass::CollectVarMemorySize(SSAGraph* graph) {
+  var_memory_size_.clear();
+  auto memory_size = [](const Node::Arg& arg) -> size_t {
+    size_t size = arg.type ? PrecisionTypeLength(arg.type->precision()) : 4;
+    for (auto dim : arg.shape) {
+      // The dims only known at runtime, such as batch size, are counted as 1.
+      size *= dim > 0 ? static_cast<size_t>(dim) : 1;
+    }
+    return size;
+  };
+
+  for (auto& op_node : graph->StmtTopologicalOrder()) {
+    if (!op_node->IsStmt()) continue;
+    // The vars created by passes(such as the outputs of io_copy, calib and
+    // layout) have no shape recorded, they are assumed to be as large as the
+    // largest input of the op.
+    size_t max_input_size = 0;
+    for (auto* in : op_node->inlinks) {
+      auto& arg = in->AsArg();
+      size_t size = arg.shape.empty() ? 0 : memory_size(arg);
+      if (var_memory_size_.count(arg.name)) {
+        size = std::max(size, var_memory_size_[arg.name]);
+      }
+      var_memory_size_[arg.name] = size;
+      max_input_size = std::max(max_input_size, size);
+    }
+    for (auto* out : op_node->outlinks) {
+      auto& arg = out->AsArg();
+      size_t size = arg.shape.empty() ? max_input_size : memory_size(arg);
+      if (var_memory_size_.count(arg.name)) {
+        size = std::max(size, var_memory_size_[arg.name]);
+      }
+      var_memory_size_[arg.name] = size;
+    }
+  }
+}
+
 void MemoryOptimizePass::MakeReusePlan(
     const lifecycle_map_t& lifecycles,
     std::unordered_map<std::string, std::string>* node2cluster) {
   std::vector<MemNode> mem_nodes;
-  std::vector<std::string> cluster;
+  std::vector<MemCluster> clusters;
   for (auto& data : lifecycles) {
     MemNode temp_node;
     temp_node.name = data.first;
-    temp_node.cluster = -1;
+    temp_node.size = var_memory_size_.count(data.first)
+                         ? var_memory_size_.at(data.first)
+                         : 0;
     temp_node.lifetime = data.second;
     mem_nodes.push_back(temp_node);
   }
+  // Place the large vars first, so that every cluster is owned by its largest
+  // var. The ties are broken by the lifetime and the name to make the plan
+  // deterministic.
+  std::sort(mem_nodes.begin(),
+            mem_nodes.end(),
+            [](const MemNode& a, const MemNode& b) {
+              if (a.size != b.size) return a.size > b.size;
+              if (a.lifetime != b.lifetime) return a.lifetime < b.lifetime;
+              return a.name < b.name;
+            });
   auto overlap = [](std::pair<int, int> a, std::pair<int, int> b) -> bool {
     return b.second >= a.first && a.second >= b.first;
   };
-  // If the lifetime of two nodes is overwritten, we set them as adjacent nodes.
-  for (size_t i = 0; i < mem_nodes.size(); i++) {
-    for (size_t j = i + 1; j < mem_nodes.size(); j++) {
-      if (overlap(mem_nodes[i].lifetime, mem_nodes[j].lifetime)) {
-        mem_nodes[i].adj.insert(mem_nodes[j].name);
-        mem_nodes[j].adj.insert(mem_nodes[i].name);
-      }
-    }
-  }
 
   // Generating Memory Reuse Strategy Based on Greedy Way
-  // The vars can be reused if there is no overlap between them.
-  for (size_t i = 0; i < mem_nodes.size(); i++) {
-    if (mem_nodes[i].cluster >= 0) continue;
-    int cluster_index = cluster.size();
-    mem_nodes[i].cluster = cluster_index;
-    (*node2cluster)[mem_nodes[i].name] = mem_nodes[i].name;
-    cluster.push_back(mem_nodes[i].name);
-    std::unordered_set<std::string> cluster_adj = mem_nodes[i].adj;
-    for (size_t j = i + 1; j < mem_nodes.size(); j++) {
-      if (mem_nodes[j].cluster < 0 &&
-          (cluster_adj.find(mem_nodes[j].name) == cluster_adj.end())) {
-        (*node2cluster)[mem_nodes[j].name] = mem_nodes[i].name;
-        mem_nodes[j].cluster = cluster_index;
-        for (auto& n : mem_nodes[j].adj) {
-          cluster_adj.insert(n);
+  // A var is assigned to the smallest cluster which has no lifetime overlap
+  // with it, all the clusters are larger than the var because of the order
+  // above. A new cluster is created if there is no such one.
+  for (auto& node : mem_nodes) {
+    int best_cluster = -1;
+    for (size_t i = 0; i < clusters.size(); i++) {
+      if (best_cluster >= 0 && clusters[i].size >= clusters[best_cluster].size)
+        continue;
+      bool is_free = true;
+      for (auto& lifetime : clusters[i].lifetimes) {
+        if (overlap(lifetime, node.lifetime)) {
+          is_free = false;
+          break;
         }
       }
+      if (is_free) best_cluster = i;
+    }
+    if (best_cluster < 0) {
+      MemCluster cluster;
+      cluster.name = node.name;
+      cluster.size = node.size;
+      clusters.push_back(cluster);
+      best_cluster = clusters.size() - 1;
     }
+    clusters[best_cluster].lifetimes.push_back(node.lifetime);
+    (*node2cluster)[node.name] = clusters[best_cluster].name;
+  }
+
+  size_t total_size = 0;
+  for (auto& node : mem_nodes) {
+    total_size += node.size;
   }
-  for (auto& name : cluster) {
-    LOG(INFO) << "cluster: " << name;
+  size_t reused_size = 0;
+  for (auto& cluster : clusters) {
+    reused_size += cluster.size;
+    LOG(INFO) << "cluster: " << cluster.name << ", size: " << cluster.size
+              << ", vars: " << cluster.lifetimes.size();
   }
+  LOG(INFO) << "The estimated memory size of temporary vars is reduced from "
+            << total_size << " bytes to " << reused_size << " bytes.";
 }
 
 void MemoryOptimizePass::PerformReusePlan(
@@ -236,13 +299,15 @@ void MemoryOptimizePass::Apply(const std::unique_ptr<SSAGraph>& graph) {
   // 1. Collect all var's lifetime, then classify them according to the device.
   // Only the vars on the same device can be reused.
   // 2. Make reuse plan: the vars can be reused if there is no overlap between
-  // them.
+  // them. The vars are sorted by their estimated memory size, and each one is
+  // put into the best fit cluster.
   // The final plan is a mapping table in which the key represents the original
   // name of var and the value in the table represents the current name of var.
   // 3. Perform reuse plan: Replace all var's name in the model according to the
   // mapping table.
   std::unordered_map<std::string, lifecycle_map_t> lifecycles;
   CollectLifeCycleByDevice(&lifecycles, graph.get());
+  CollectVarMemorySize(graph.get());
   for (auto& ele : lifecycles) {
     std::unordered_map<std::string, std::string> node2cluster;
     MakeReusePlan(ele.second, &node2cluster);
@@ -33,7 +33,10 @@ namespace lite {
 namespace mir {
 
 /*
- * MemoryOptimizePass will
+ * MemoryOptimizePass will make the temporary vars whose lifetimes don't overlap
+ * share the same memory. The vars are packed greedily by their estimated
+ * memory size, the largest var of a cluster owns the shared memory and the
+ * smaller vars are assigned to the best fit cluster.
  */
 class MemoryOptimizePass : public ProgramPass {
  public:
@@ -44,6 +47,9 @@ class MemoryOptimizePass : public ProgramPass {
  private:
   void CollectLifeCycleByDevice(
       std::unordered_map<std::string, lifecycle_map_t>* lifecycles, SSAGraph*);
+  // Estimate the memory size in bytes of the temporary vars by the static
+  // shapes recorded in the model.
+  void CollectVarMemorySize(SSAGraph* graph);
   void MakeReusePlan(
       const lifecycle_map_t& lifecycles,
       std::unordered_map<std::string, std::string>* node2cluster);
@@ -53,6 +59,7 @@ class MemoryOptimizePass : public ProgramPass {
 
  private:
   int max_lifecycle_{-1};
+  std::unordered_map<std::string, size_t> var_memory_size_;
 };
 
 }  // namespace mir
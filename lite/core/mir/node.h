@@ -93,6 +93,9 @@ class Node {
     // if the need more than one tool operator(eg. io_copy layout calib), the
     // argument between them should be persist to make sure it's only run once
     bool is_persist{false};
+    // The static shape recorded in the model, it is empty for the vars created
+    // by passes. It is used to estimate the memory footprint of the var.
+    std::vector<int64_t> shape;
   };
 
   Arg& AsArg(const std::string& name, int id);
@@ -162,6 +162,12 @@ struct PMNode {
         attr_name, [=](const T& src) { return src == attr; });
   }
 
+  // Assert an arbitrary condition on the matched node.
+  PMNode* assert_node_satisfied(const teller_t& cond) {
+    asserts_.push_back(cond);
+    return this;
+  }
+
  private:
   PMNode(PMPattern* pattern,
          const std::string& name = "",
@@ -125,6 +125,7 @@ void SSAGraph::Build(const Program &program,
 
   std::unordered_map<std::string, PrecisionType> var_types =
       program.var_data_type();
+  const auto &var_shapes = program.var_shape();
 
   std::unordered_map<std::string, mir::Node *> arg_update_node_map_;
   for (auto &op : program.ops()) {
@@ -144,6 +145,9 @@ void SSAGraph::Build(const Program &program,
         arg_node->arg()->type = LiteType::GetTensorTy(
             TARGET(kUnk), var_types[name], DATALAYOUT(kUnk));
       }
+      if (var_shapes.count(name) && arg_node->arg()->shape.empty()) {
+        arg_node->arg()->shape = var_shapes.at(name);
+      }
       if (is_weights(name)) arg_node->AsArg().is_weight = true;
       CHECK(arg_node->IsRoleSet());
       DirectedLink(arg_node, op_node);
@@ -157,6 +161,9 @@ void SSAGraph::Build(const Program &program,
         arg_node->arg()->type = LiteType::GetTensorTy(
             TARGET(kUnk), var_types[name], DATALAYOUT(kUnk));
       }
+      if (var_shapes.count(name)) {
+        arg_node->arg()->shape = var_shapes.at(name);
+      }
 
       if (is_weights(name)) arg_node->AsArg().is_weight = true;
       CHECK(arg_node->IsRoleSet());
@@ -18,6 +18,7 @@
 #include <unordered_set>
 #include <utility>
 #include <vector>
+#include "lite/core/framework.pb.h"
 #include "lite/core/mir/pass_registry.h"
 #include "lite/core/mir/subgraph/subgraph_detector.h"
 
@@ -67,6 +68,43 @@ void BMSubgraphPass::Apply(const std::unique_ptr<SSAGraph>& graph) {
   fuser();
 }
 
+void X86SubgraphPass::Apply(const std::unique_ptr<SSAGraph>& graph) {
+  const std::unordered_set<std::string> supported_lists{"elementwise_add",
+                                                        "elementwise_sub",
+                                                        "elementwise_mul",
+                                                        "elementwise_div",
+                                                        "elementwise_max",
+                                                        "elementwise_min",
+                                                        "scale",
+                                                        "relu",
+                                                        "exp",
+                                                        "sigmoid",
+                                                        "tanh",
+                                                        "square",
+                                                        "cast"};
+  auto teller = [&](Node* node) {
+    if (!node->IsStmt()) return false;
+    auto& stmt = node->AsStmt();
+    if (supported_lists.count(stmt.op_type()) == 0) return false;
+    if (stmt.op_type() == "cast") {
+      // Only the casts from float to float.
+      const int kFP32 = framework::proto::VarType::FP32;
+      auto* op_info = stmt.op_info();
+      if (op_info->GetAttr<int>("in_dtype") != kFP32 ||
+          op_info->GetAttr<int>("out_dtype") != kFP32) {
+        return false;
+      }
+    }
+    // The original ops are run on x86 if the shapes can not be fused.
+    for (auto& kernel : stmt.kernels()) {
+      if (kernel->target() == TARGET(kX86)) return true;
+    }
+    return false;
+  };
+  SubgraphFuser fuser(graph.get(), teller, 2 /* min_subgraph_size */);
+  fuser();
+}
+
 }  // namespace mir
 }  // namespace lite
 }  // namespace paddle
@@ -77,3 +115,12 @@ REGISTER_MIR_PASS(xpu_subgraph_pass, paddle::lite::mir::XPUSubgraphPass)
     .BindTargets({TARGET(kXPU)});
 REGISTER_MIR_PASS(bm_subgraph_pass, paddle::lite::mir::BMSubgraphPass)
     .BindTargets({TARGET(kBM)});
+REGISTER_MIR_PASS(x86_subgraph_pass, paddle::lite::mir::X86SubgraphPass)
+    .BindTargets({TARGET(kX86)})
+    .ExcludeTargets({TARGET(kCUDA),
+                     TARGET(kARM),
+                     TARGET(kOpenCL),
+                     TARGET(kFPGA),
+                     TARGET(kNPU),
+                     TARGET(kXPU),
+                     TARGET(kBM)});
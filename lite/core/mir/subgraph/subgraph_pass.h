@@ -37,6 +37,13 @@ class BMSubgraphPass : public ProgramPass {
   void Apply(const std::unique_ptr<SSAGraph>& graph) override;
 };
 
+// Group the chains of the elementwise ops and activations, which are computed
+// in one pass over the elements by the x86 subgraph kernel.
+class X86SubgraphPass : public ProgramPass {
+ public:
+  void Apply(const std::unique_ptr<SSAGraph>& graph) override;
+};
+
 }  // namespace mir
 }  // namespace lite
 }  // namespace paddle
@@ -0,0 +1,158 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/mir/weight_half_quantization_pass.h"
+#include <map>
+#include <memory>
+#include <string>
+#include "lite/core/mir/pass_registry.h"
+#include "lite/utils/half.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+namespace {
+
+// Whether the weight `name` read by `stmt` can be stored in 16 bits, the
+// x86 matmul kernel only supports a 2-D Y and a not transposed X.
+bool SupportsHalfWeight(const Node::Stmt& stmt,
+                        const std::string& slot,
+                        const std::string& name,
+                        const lite::Tensor& weight) {
+  const auto* op_info = stmt.op_info();
+  if (op_info->Input(slot).empty() || op_info->Input(slot).front() != name) {
+    return false;
+  }
+  if (op_info->HasAttr("enable_int8") &&
+      op_info->GetAttr<bool>("enable_int8")) {
+    return false;
+  }
+  if (stmt.op_type() == "matmul") {
+    return weight.dims().size() == 2 &&
+           !op_info->GetAttr<bool>("transpose_X");
+  }
+  return true;
+}
+
+}  // namespace
+
+void WeightHalfQuantizationPass::QuantizeWeight(const std::string& quant_type,
+                                                lite::Tensor* weight) {
+  CHECK(weight->precision() == PRECISION(kFloat));
+  const float* src = weight->data<float>();
+  lite::Tensor quantized;
+  quantized.Resize(weight->dims());
+  auto* dst = quantized.mutable_data<int16_t>();
+  int64_t numel = weight->numel();
+  if (quant_type == "fp16") {
+    for (int64_t i = 0; i < numel; ++i) {
+      dst[i] = static_cast<int16_t>(FloatToHalf(src[i]));
+    }
+  } else if (quant_type == "bf16") {
+    for (int64_t i = 0; i < numel; ++i) {
+      dst[i] = static_cast<int16_t>(FloatToBFloat16(src[i]));
+    }
+  } else {
+    LOG(FATAL) << "Unsupported weight quant type: " << quant_type;
+  }
+  weight->ShareDataWith(quantized);
+  weight->set_precision(PRECISION(kInt16));
+}
+
+void WeightHalfQuantizationPass::Apply(const std::unique_ptr<SSAGraph>& graph) {
+  const std::map<std::string, std::string> weight_slots = {
+      {"fc", "W"},
+      {"mul", "Y"},
+      {"matmul", "Y"},
+      {"conv2d", "Filter"},
+      {"depthwise_conv2d", "Filter"}};
+  auto quant_type_of = [&](Node* op_node, const std::string& name) {
+    auto& stmt = op_node->AsStmt();
+    const auto* op_info = stmt.op_info();
+    auto slot = weight_slots.find(stmt.op_type());
+    if (slot == weight_slots.end() || !op_info->HasAttr("weight_quant_type")) {
+      return std::string();
+    }
+    auto* weight =
+        stmt.op()->scope()->FindVar(name)->GetMutable<lite::Tensor>();
+    if (!SupportsHalfWeight(stmt, slot->second, name, *weight)) {
+      return std::string();
+    }
+    return op_info->GetAttr<std::string>("weight_quant_type");
+  };
+
+  for (auto& node : graph->mutable_nodes()) {
+    if (!node.IsArg() || !node.AsArg().is_weight) continue;
+    const auto& weight_name = node.AsArg().name;
+    // The weight is quantized only if all its readers are supported ops
+    // asking for the same quant type.
+    std::string quant_type;
+    bool quantizable = !node.outlinks.empty();
+    for (auto* op_node : node.outlinks) {
+      auto type = quant_type_of(op_node, weight_name);
+      if (type.empty() || (!quant_type.empty() && type != quant_type)) {
+        quantizable = false;
+        break;
+      }
+      quant_type = type;
+    }
+    if (!quantizable) continue;
+    auto* weight = node.outlinks.front()
+                       ->AsStmt()
+                       .op()
+                       ->scope()
+                       ->FindVar(weight_name)
+                       ->GetMutable<lite::Tensor>();
+    if (weight->precision() != PRECISION(kFloat)) {
+      // Quantized already, e.g. loaded from an optimized model.
+      continue;
+    }
+    VLOG(3) << "Quantize the weight " << weight_name << " to " << quant_type;
+    QuantizeWeight(quant_type, weight);
+  }
+
+  // The ops whose weights are kept in float, e.g. shared with other ops or
+  // not persistable, run in float.
+  for (auto& node : graph->mutable_nodes()) {
+    if (!node.IsStmt()) continue;
+    auto& stmt = node.AsStmt();
+    const auto* op_info = stmt.op_info();
+    auto slot = weight_slots.find(stmt.op_type());
+    if (slot == weight_slots.end() || !op_info->HasAttr("weight_quant_type") ||
+        op_info->GetAttr<std::string>("weight_quant_type").empty()) {
+      continue;
+    }
+    auto name = op_info->Input(slot->second).front();
+    auto* var = stmt.op()->scope()->FindVar(name);
+    if (var && var->GetMutable<lite::Tensor>()->precision() ==
+                   PRECISION(kInt16)) {
+      continue;
+    }
+    LOG(WARNING) << "The weight " << name << " of " << stmt.op_type()
+                 << " is shared with other ops or quant types, or not "
+                    "supported, keep it in float.";
+    cpp::OpDesc op_desc = *op_info;
+    op_desc.SetAttr<std::string>("weight_quant_type", "");
+    stmt.ResetOp(op_desc, graph->valid_places());
+  }
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_MIR_PASS(weight_half_quantization_pass,
+                  paddle::lite::mir::WeightHalfQuantizationPass)
+    .BindTargets({TARGET(kX86)});
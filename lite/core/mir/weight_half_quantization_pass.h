@@ -0,0 +1,46 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <memory>
+#include <string>
+#include "lite/core/mir/pass.h"
+#include "lite/core/op_registry.h"
+#include "lite/core/tensor.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+/*
+ * WeightHalfQuantizationPass stores the weights of the fc, mul, matmul,
+ * conv2d and depthwise_conv2d ops marked with the "weight_quant_type"
+ * attribute by the predictor in 16 bits:
+ *  - "fp16": IEEE half precision.
+ *  - "bf16": bfloat16, the high half of the float.
+ * Both are stored as int16 tensors, which halves the size of the optimized
+ * model and the weight bandwidth of the x86 kernels, which convert them back
+ * to float on the fly. A weight also read by other ops, the weights of the
+ * int8 ops and the batched Y of matmul are left untouched.
+ */
+class WeightHalfQuantizationPass : public ProgramPass {
+ public:
+  void Apply(const std::unique_ptr<SSAGraph>& graph) override;
+
+  static void QuantizeWeight(const std::string& quant_type,
+                             lite::Tensor* weight);
+};
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
@@ -65,6 +65,11 @@ class OpLite : public Registry {
   virtual bool CheckShape() const { return true; }
   // Inference the outputs' shape.
   virtual bool InferShape() const { return true; }
+  // Indicate whether the outputs' shape is decided by the inputs' shape and
+  // lod only, then the shape inferred at the last run can be reused when the
+  // inputs of the program are unchanged. The ops whose InferShape reads the
+  // data of inputs should return false.
+  virtual bool infer_shape_cacheable() const { return true; }
   // Run this operator.
   virtual bool Run();
   // Indicate whether the Op runs only once or not
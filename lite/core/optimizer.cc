@@ -14,6 +14,7 @@
 
 #include "lite/core/optimizer.h"
 #include <fstream>
+#include "lite/core/mir/kernel_tune_pass.h"
 #include "lite/core/mir/static_kernel_pick_pass.h"
 #include "lite/core/mir/type_target_cast_pass.h"
 #include "lite/model_parser/model_parser.h"
@@ -30,5 +31,15 @@ void Optimizer::SpecifyKernelPickTactic(core::KernelPickFactor factor) {
   *pass->mutable_kernel_pick_factors() = factor;
 }
 
+void Optimizer::SpecifyKernelTune() {
+  auto* pass = mir::PassManager::Global().LookUp<mir::KernelTunePass>(
+      "kernel_tune_pass");
+  if (!pass) {
+    CHECK(!kernel_tune_) << "kernel_tune_pass is not linked";
+    return;
+  }
+  pass->SetTuning(kernel_tune_, kernel_tune_cache_file_);
+}
+
 }  // namespace lite
 }  // namespace paddle
@@ -51,6 +51,7 @@ class Optimizer {
     graph_->SetValidPlaces(valid_places);
 
     SpecifyKernelPickTactic(kernel_pick_factor);
+    SpecifyKernelTune();
     InitTargetTypeTransformPass();
 
     if (passes.empty() || passes.size() == 1) {
@@ -70,6 +71,9 @@ class Optimizer {
            "lite_interpolate_fuse_pass",                  //
            "identity_scale_eliminate_pass",               //
            "elementwise_mul_constant_eliminate_pass",     //
+           "lite_embedding_seq_pool_fuse_pass",           //
+           "lite_attention_fuse_pass",                    //
+           "lite_add_layer_norm_fuse_pass",               //
            "lite_sequence_pool_concat_fuse_pass",         //
 #if (defined LITE_WITH_LIGHT_WEIGHT_FRAMEWORK) || (defined LITE_WITH_CUDA) || \
     (defined LITE_WITH_ARM)
@@ -78,7 +82,11 @@ class Optimizer {
            "npu_subgraph_pass",
            "xpu_subgraph_pass",
            "bm_subgraph_pass",
+           "x86_subgraph_pass",  // after the other fusions
+           "embedding_quantization_pass",    // after the embedding fusions
+           "weight_half_quantization_pass",  // after the fc and conv fusions
            "static_kernel_pick_pass",        // pick original kernel from graph
+           "kernel_tune_pass",               // time the candidates if enabled
            "variable_place_inference_pass",  // inference arg/var's
            // info(target/precision/layout/device)
            // using kernel info
@@ -124,6 +132,13 @@ class Optimizer {
 
   const lite::Scope* exec_scope() const { return exec_scope_; }
 
+  // Time the candidate kernels of the ops to pick the fastest ones, with the
+  // tuning cache file if not empty, see mir::KernelTunePass.
+  void set_kernel_tune(bool enabled, const std::string& cache_file) {
+    kernel_tune_ = enabled;
+    kernel_tune_cache_file_ = cache_file;
+  }
+
   // Generate a new program based on the mir graph.
   std::unique_ptr<RuntimeProgram> GenRuntimeProgram() {
     auto pass = mir::PassManager::Global().LookUp<mir::GenerateProgramPass>(
@@ -161,6 +176,7 @@ class Optimizer {
 
  protected:
   void SpecifyKernelPickTactic(core::KernelPickFactor factor);
+  void SpecifyKernelTune();
 
   // Specify the passes and run them.
   void RunPasses(const std::vector<std::string>& passes) {
@@ -192,6 +208,8 @@ class Optimizer {
   std::vector<Place> valid_places_;
   lite::Scope* exec_scope_{};
   Program* program_{};
+  bool kernel_tune_{false};
+  std::string kernel_tune_cache_file_;
 };
 
 }  // namespace lite
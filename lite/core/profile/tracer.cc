@@ -0,0 +1,295 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/profile/tracer.h"
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <utility>
+
+namespace paddle {
+namespace lite {
+namespace profile {
+
+namespace {
+
+const Tensor* FindTensor(OpLite* op, const std::string& name) {
+  auto* var = op->scope()->FindVar(name);
+  if (!var || !var->IsType<Tensor>()) return nullptr;
+  return &var->Get<Tensor>();
+}
+
+const Tensor* FindInput(OpLite* op, const std::string& slot) {
+  if (!op->op_info()->HasInput(slot)) return nullptr;
+  auto names = op->op_info()->Input(slot);
+  return names.empty() ? nullptr : FindTensor(op, names.front());
+}
+
+// The shapes of the tensors of the slots, and add their bytes to `bytes`.
+std::string PrintShapes(OpLite* op,
+                        const std::vector<std::string>& slots,
+                        bool is_input,
+                        double* bytes) {
+  std::stringstream ss;
+  const auto* op_info = op->op_info();
+  for (const auto& slot : slots) {
+    for (const auto& name :
+         is_input ? op_info->Input(slot) : op_info->Output(slot)) {
+      const auto* tensor = FindTensor(op, name);
+      if (!tensor) continue;
+      ss << (ss.tellp() > 0 ? " " : "") << slot << ":"
+         << tensor->dims().repr();
+      *bytes += tensor->memory_size();
+    }
+  }
+  return ss.str();
+}
+
+std::string Escape(const std::string& str) {
+  std::string res;
+  for (char c : str) {
+    if (c == '"' || c == '\\') res.push_back('\\');
+    res.push_back(c);
+  }
+  return res;
+}
+
+}  // namespace
+
+double EstimateFlops(OpLite* op) {
+  const auto* op_info = op->op_info();
+  const auto type = op_info->Type();
+  double out_numel = 0;
+  for (const auto& name : op_info->output_names()) {
+    const auto* tensor = FindTensor(op, name);
+    if (tensor) out_numel += tensor->numel();
+  }
+  if (type == "conv2d" || type == "depthwise_conv2d") {
+    // Every output accumulates ic / groups * kh * kw products.
+    const auto* filter = FindInput(op, "Filter");
+    if (filter && filter->dims().size() == 4 && filter->dims()[0] > 0) {
+      return 2. * out_numel * filter->numel() / filter->dims()[0];
+    }
+  } else if (type == "fc") {
+    const auto* w = FindInput(op, "W");
+    if (w && w->dims().size() == 2) {
+      return 2. * out_numel * w->dims()[0];
+    }
+  } else if (type == "mul") {
+    const auto* y = FindInput(op, "Y");
+    const auto* out = FindTensor(op, op_info->output_names().front());
+    if (y && out && out->dims().size() > 0) {
+      int64_t n = out->dims()[out->dims().size() - 1];
+      if (n > 0) return 2. * out_numel * y->numel() / n;
+    }
+  } else if (type == "matmul") {
+    const auto* x = FindInput(op, "X");
+    if (x && x->dims().size() >= 2) {
+      bool trans_x = op_info->HasAttr("transpose_X") &&
+                     op_info->GetAttr<bool>("transpose_X");
+      const auto& dims = x->dims();
+      return 2. * out_numel *
+             (trans_x ? dims[dims.size() - 2] : dims[dims.size() - 1]);
+    }
+  } else if (type == "pool2d") {
+    // Every output reduces a window.
+    const auto* x = FindInput(op, "X");
+    if (op_info->HasAttr("global_pooling") &&
+        op_info->GetAttr<bool>("global_pooling")) {
+      if (x && x->dims().size() == 4) {
+        return static_cast<double>(x->numel());
+      }
+    } else if (op_info->HasAttr("ksize")) {
+      auto ksize = op_info->GetAttr<std::vector<int>>("ksize");
+      double window = 1;
+      for (int k : ksize) window *= k;
+      return out_numel * window;
+    }
+  }
+  return out_numel;
+}
+
+void Tracer::Record(int instruction,
+                    OpLite* op,
+                    const KernelBase& kernel,
+                    int64_t start_us,
+                    int64_t infer_shape_end_us,
+                    bool shape_inferred) {
+  TraceEvent event;
+  event.end_us = NowUs();
+  event.instruction = instruction;
+  event.op_type = op->op_info()->Type();
+  event.kernel = kernel.name() + "/" + kernel.alias();
+  if (!kernel.algorithm().empty()) {
+    event.kernel += "/" + kernel.algorithm();
+  }
+  event.start_us = start_us;
+  event.infer_shape_end_us = infer_shape_end_us;
+  event.shape_inferred = shape_inferred;
+  event.inputs = PrintShapes(
+      op, op->op_info()->input_argnames(), true, &event.bytes);
+  event.outputs = PrintShapes(
+      op, op->op_info()->output_argnames(), false, &event.bytes);
+  event.flops = EstimateFlops(op);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto thread =
+      threads_.emplace(std::this_thread::get_id(), threads_.size()).first;
+  event.thread = thread->second;
+  if (events_.size() < capacity_) {
+    events_.push_back(std::move(event));
+  } else {
+    events_[next_] = std::move(event);
+    dropped_++;
+  }
+  next_ = (next_ + 1) % capacity_;
+}
+
+std::vector<TraceEvent> Tracer::events() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (events_.size() < capacity_) return events_;
+  std::vector<TraceEvent> events(events_.begin() + next_, events_.end());
+  events.insert(events.end(), events_.begin(), events_.begin() + next_);
+  return events;
+}
+
+size_t Tracer::dropped() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return dropped_;
+}
+
+void Tracer::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  events_.clear();
+  next_ = 0;
+  dropped_ = 0;
+}
+
+std::string Tracer::ChromeTrace() const {
+  auto events = this->events();
+  std::stringstream ss;
+  ss << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  bool first = true;
+  auto add = [&](const std::string& name,
+                 const std::string& cat,
+                 int tid,
+                 int64_t begin,
+                 int64_t end,
+                 const std::string& args) {
+    ss << (first ? "" : ",") << "\n{\"name\":\"" << Escape(name)
+       << "\",\"cat\":\"" << cat << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << tid
+       << ",\"ts\":" << begin << ",\"dur\":" << std::max<int64_t>(end - begin, 0)
+       << ",\"args\":{" << args << "}}";
+    first = false;
+  };
+  for (const auto& event : events) {
+    std::stringstream args;
+    args << "\"instruction\":" << event.instruction << ",\"kernel\":\""
+         << Escape(event.kernel) << "\",\"inputs\":\"" << Escape(event.inputs)
+         << "\",\"outputs\":\"" << Escape(event.outputs)
+         << "\",\"flops\":" << event.flops << ",\"bytes\":" << event.bytes;
+    add(event.op_type,
+        "op",
+        event.thread,
+        event.start_us,
+        event.end_us,
+        args.str());
+    add(event.shape_inferred ? "InferShape" : "RestoreShape",
+        "infer_shape",
+        event.thread,
+        event.start_us,
+        event.infer_shape_end_us,
+        "");
+    add(event.kernel,
+        "kernel",
+        event.thread,
+        event.infer_shape_end_us,
+        event.end_us,
+        "");
+  }
+  ss << "\n]}\n";
+  return ss.str();
+}
+
+bool Tracer::SaveChromeTrace(const std::string& path) const {
+  std::ofstream file(path);
+  if (!file.is_open()) {
+    LOG(ERROR) << "Failed to open " << path;
+    return false;
+  }
+  file << ChromeTrace();
+  return file.good();
+}
+
+std::string Tracer::Summary() const {
+  struct Stat {
+    int calls{0};
+    double total_ms{0};
+    double infer_shape_ms{0};
+    double flops{0};
+  };
+  std::map<std::string, Stat> stats;
+  double total_ms = 0;
+  auto events = this->events();
+  for (const auto& event : events) {
+    auto& stat = stats[event.op_type];
+    double ms = (event.end_us - event.start_us) / 1000.;
+    stat.calls++;
+    stat.total_ms += ms;
+    stat.infer_shape_ms += (event.infer_shape_end_us - event.start_us) / 1000.;
+    stat.flops += event.flops;
+    total_ms += ms;
+  }
+  // The most time consuming op types first.
+  std::vector<std::pair<std::string, Stat>> sorted(stats.begin(), stats.end());
+  std::sort(sorted.begin(),
+            sorted.end(),
+            [](const std::pair<std::string, Stat>& a,
+               const std::pair<std::string, Stat>& b) {
+              return a.second.total_ms > b.second.total_ms;
+            });
+
+  using std::setw;
+  using std::left;
+  std::stringstream ss;
+  size_t dropped = this->dropped();
+  if (dropped > 0) {
+    ss << "The " << dropped << " oldest records are dropped, the last "
+       << events.size() << " are summarized." << std::endl;
+  }
+  ss << std::fixed << std::setprecision(3);
+  ss << setw(25) << left << "Operator Type"
+     << " " << setw(8) << left << "Calls"
+     << " " << setw(12) << left << "Total (ms)"
+     << " " << setw(12) << left << "Avg (ms)"
+     << " " << setw(16) << left << "InferShape (ms)"
+     << " " << setw(8) << left << "Ratio"
+     << " " << setw(12) << left << "GFLOPS" << std::endl;
+  for (const auto& item : sorted) {
+    const auto& stat = item.second;
+    ss << setw(25) << left << item.first << " " << setw(8) << left
+       << stat.calls << " " << setw(12) << left << stat.total_ms << " "
+       << setw(12) << left << stat.total_ms / stat.calls << " " << setw(16)
+       << left << stat.infer_shape_ms << " " << setw(8) << left
+       << (total_ms > 0 ? stat.total_ms / total_ms : 0.) << " " << setw(12)
+       << left << (stat.total_ms > 0 ? stat.flops / stat.total_ms / 1e6 : 0.)
+       << std::endl;
+  }
+  return ss.str();
+}
+
+}  // namespace profile
+}  // namespace lite
+}  // namespace paddle
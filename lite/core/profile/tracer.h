@@ -0,0 +1,123 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <stdint.h>
+#include <chrono>  // NOLINT
+#include <map>
+#include <mutex>  // NOLINT
+#include <string>
+#include <thread>  // NOLINT
+#include <vector>
+#include "lite/core/kernel.h"
+#include "lite/core/op_lite.h"
+
+namespace paddle {
+namespace lite {
+namespace profile {
+
+// The run of an instruction.
+struct TraceEvent {
+  // The index of the instruction in the program.
+  int instruction{-1};
+  std::string op_type;
+  std::string kernel;
+  // The small id of the thread, in the order of their first records.
+  int thread{0};
+  // The microseconds since the tracer is created. The output shapes are
+  // restored from the last run instead of inferred if `shape_inferred` is
+  // false.
+  int64_t start_us{0};
+  int64_t infer_shape_end_us{0};
+  int64_t end_us{0};
+  bool shape_inferred{true};
+  // The shapes of the input and output tensors, "X:[1,3,224,224] ...".
+  std::string inputs;
+  std::string outputs;
+  // The rough estimations of the floating point operations, and the bytes of
+  // the input and output tensors.
+  double flops{0};
+  double bytes{0};
+};
+
+/*
+ * Tracer records the runs of the instructions of a RuntimeProgram, unlike the
+ * Profiler, it is built in all the builds and switched on at runtime by
+ * `RuntimeProgram::set_tracing`, it costs nothing when off. The records are
+ * exported as the Chrome trace events, which can be opened in
+ * chrome://tracing or https://ui.perfetto.dev, or summarized by op type.
+ * `Record` is thread safe, the instructions run in parallel are recorded with
+ * the threads running them. The records are kept in a ring buffer of
+ * `capacity` events, the oldest ones are dropped once it is full.
+ */
+class Tracer {
+ public:
+  // About 650 runs of a program of 100 instructions.
+  static const size_t kDefaultCapacity = 1 << 16;
+
+  explicit Tracer(size_t capacity = kDefaultCapacity)
+      : origin_(std::chrono::steady_clock::now()), capacity_(capacity) {
+    CHECK_GT(capacity_, 0UL);
+  }
+
+  int64_t NowUs() const {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now() - origin_)
+        .count();
+  }
+
+  // Record the run of the `instruction`-th instruction which has just
+  // finished, the end time is now.
+  void Record(int instruction,
+              OpLite* op,
+              const KernelBase& kernel,
+              int64_t start_us,
+              int64_t infer_shape_end_us,
+              bool shape_inferred);
+
+  // The records kept, the oldest first.
+  std::vector<TraceEvent> events() const;
+  // The number of the records dropped since the last Clear.
+  size_t dropped() const;
+  size_t capacity() const { return capacity_; }
+  void Clear();
+
+  // The Chrome trace event JSON, an event per run with its infer shape and
+  // kernel parts nested.
+  std::string ChromeTrace() const;
+  bool SaveChromeTrace(const std::string& path) const;
+
+  // The table of the calls, the total, average and infer shape times, the
+  // ratio of the total time and the GFLOPS of every op type.
+  std::string Summary() const;
+
+ private:
+  const std::chrono::steady_clock::time_point origin_;
+  const size_t capacity_;
+  mutable std::mutex mutex_;
+  // The ring buffer, `next_` is the place of the next record, which is the
+  // oldest one once the buffer is full.
+  std::vector<TraceEvent> events_;
+  size_t next_{0};
+  size_t dropped_{0};
+  std::map<std::thread::id, int> threads_;
+};
+
+// The rough FLOPs of the op at its current shapes, e.g. 2 * M * N * K for the
+// GEMMs, the number of the output elements for the ops unknown.
+double EstimateFlops(OpLite* op);
+
+}  // namespace profile
+}  // namespace lite
+}  // namespace paddle
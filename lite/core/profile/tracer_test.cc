@@ -0,0 +1,104 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/profile/tracer.h"
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>  // NOLINT
+
+namespace paddle {
+namespace lite {
+namespace profile {
+
+class FakeOp : public OpLite {
+ public:
+  explicit FakeOp(const std::string& type) : OpLite(type) {}
+  std::string DebugString() const override { return "fake"; }
+  void AttachKernel(KernelBase* kernel) override {}
+
+ protected:
+  bool AttachImpl(const cpp::OpDesc& opdesc, lite::Scope* scope) override {
+    return true;
+  }
+};
+
+class FakeKernel : public KernelLite<TARGET(kHost), PRECISION(kFloat)> {
+ public:
+  void Run() override {}
+};
+
+void AddTensor(Scope* scope, const std::string& name, const DDim& dims) {
+  auto* tensor = scope->Var(name)->GetMutable<Tensor>();
+  tensor->Resize(dims);
+  tensor->mutable_data<float>();
+}
+
+TEST(Tracer, mul) {
+  Scope scope;
+  AddTensor(&scope, "x", DDim({4, 8}));
+  AddTensor(&scope, "y", DDim({8, 16}));
+  AddTensor(&scope, "out", DDim({4, 16}));
+  cpp::OpDesc desc;
+  desc.SetType("mul");
+  desc.SetInput("X", {"x"});
+  desc.SetInput("Y", {"y"});
+  desc.SetOutput("Out", {"out"});
+  FakeOp op("mul");
+  op.Attach(desc, &scope);
+  EXPECT_EQ(EstimateFlops(&op), 2. * 4 * 8 * 16);
+
+  FakeKernel kernel;
+  kernel.set_op_type("mul");
+  kernel.set_alias("def");
+  Tracer tracer;
+  tracer.Record(0, &op, kernel, 1, 2, true);
+  std::thread([&] { tracer.Record(1, &op, kernel, 3, 3, false); }).join();
+
+  auto events = tracer.events();
+  ASSERT_EQ(events.size(), 2UL);
+  EXPECT_EQ(events[0].op_type, "mul");
+  EXPECT_EQ(events[0].kernel, "mul:host/float/NCHW/def");
+  EXPECT_EQ(events[0].inputs, "X:{4,8} Y:{8,16}");
+  EXPECT_EQ(events[0].outputs, "Out:{4,16}");
+  EXPECT_EQ(events[0].bytes, (4 * 8 + 8 * 16 + 4 * 16) * sizeof(float));
+  EXPECT_EQ(events[0].thread, 0);
+  EXPECT_EQ(events[1].thread, 1);
+  EXPECT_GE(events[1].end_us, events[1].infer_shape_end_us);
+
+  auto trace = tracer.ChromeTrace();
+  EXPECT_NE(trace.find("\"traceEvents\""), std::string::npos);
+  EXPECT_NE(trace.find("\"name\":\"InferShape\""), std::string::npos);
+  EXPECT_NE(trace.find("\"name\":\"RestoreShape\""), std::string::npos);
+  EXPECT_NE(tracer.Summary().find("mul"), std::string::npos);
+
+  tracer.Clear();
+  EXPECT_TRUE(tracer.events().empty());
+
+  // Only the last records are kept.
+  Tracer ring(3);
+  for (int i = 0; i < 5; i++) {
+    ring.Record(i, &op, kernel, i, i, true);
+  }
+  events = ring.events();
+  ASSERT_EQ(events.size(), 3UL);
+  for (int i = 0; i < 3; i++) {
+    EXPECT_EQ(events[i].instruction, i + 2);
+  }
+  EXPECT_EQ(ring.dropped(), 2UL);
+  EXPECT_NE(ring.Summary().find("2 oldest"), std::string::npos);
+}
+
+}  // namespace profile
+}  // namespace lite
+}  // namespace paddle
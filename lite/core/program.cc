@@ -13,7 +13,12 @@
 // limitations under the License.
 
 #include "lite/core/program.h"
+#include <algorithm>
+#include <set>
 #include <unordered_map>
+#ifdef LITE_WITH_X86
+#include "lite/backends/x86/parallel.h"
+#endif
 #include "lite/model_parser/cpp/block_desc.h"
 #include "lite/model_parser/cpp/op_desc.h"
 #include "lite/model_parser/cpp/var_desc.h"
@@ -27,7 +32,59 @@
 namespace paddle {
 namespace lite {
 
-void RuntimeProgram::SaveOpInfosToProgram(cpp::ProgramDesc* desc) {
+RuntimeProgram::RuntimeProgram(const cpp::ProgramDesc& desc,
+                               const std::shared_ptr<Scope>& scope) {
+  // Create the ops first.
+  Program program(desc, scope, {});
+  // Create the kernels of the target places, and filter out the specific
+  // kernel with the target alias.
+  for (auto& op : program.ops()) {
+    auto kernel_type = op->op_info()->GetAttr<std::string>(kKernelTypeAttr);
+    std::string op_type, alias;
+    Place place;
+    KernelBase::ParseKernelType(kernel_type, &op_type, &alias, &place);
+    auto kernels = op->CreateKernels({place});
+    auto it = std::find_if(
+        kernels.begin(), kernels.end(), [&](std::unique_ptr<KernelBase>& it) {
+          return it->alias() == alias;
+        });
+    CHECK(it != kernels.end());
+    if (op->op_info()->HasAttr(kKernelAlgorithmAttr)) {
+      (*it)->set_algorithm(
+          op->op_info()->GetAttr<std::string>(kKernelAlgorithmAttr));
+    }
+    (*it)->SetContext(ContextScheduler::Global().NewContext((*it)->target()));
+    instructions_.emplace_back(op, std::move(*it));
+  }
+  CHECK(program.exec_scope());
+  exec_scope_ = program.exec_scope();
+  Init();
+}
+
+void RuntimeProgram::Init() {
+  if (instructions_.empty()) {
+    LOG(FATAL) << "no instructions";
+  }
+  for (auto& inst : instructions_) {
+    if (inst.op()->op_info()->Type() == "feed") {
+      input_names_.push_back(inst.op()->op_info()->Output("Out").front());
+    }
+  }
+#ifdef LITE_WITH_PROFILE
+  set_profiler();
+#endif
+}
+
+void RuntimeProgram::ShareWeightsFrom(const RuntimeProgram& other) {
+  CHECK_EQ(instructions_.size(), other.instructions_.size());
+  for (size_t i = 0; i < instructions_.size(); i++) {
+    instructions_[i].mutable_kernel()->ShareWeightsFrom(
+        *other.instructions_[i].kernel());
+    instructions_[i].ShareRunOnceFrom(other.instructions_[i]);
+  }
+}
+
+void RuntimeProgram::SaveOpInfosToProgram(cpp::ProgramDesc* desc) const {
   CHECK(desc);
   // NOTE: RuntimeProgram do not has all meta info, so save model just update
   // upon origin model
@@ -35,31 +92,28 @@ void RuntimeProgram::SaveOpInfosToProgram(cpp::ProgramDesc* desc) {
   auto main_block = desc->GetBlock<cpp::BlockDesc>(0);
   main_block->ClearOps();
   for (auto& node : instructions_) {
-    auto op_type = node.op()->op_info()->Type();
-    if (op_type == "subgraph") {
-      auto subgraph_op = const_cast<operators::SubgraphOp*>(
-          static_cast<const operators::SubgraphOp*>(node.op()));
-      int sub_block_idx = subgraph_op->op_info()->GetAttr<int32_t>("sub_block");
-      if (sub_block_idx < 0) {
-        // It's a new subgraph op when its sub_block_idx < 0, Now we add its
-        // subblock desc to the program desc, Then update its sub_block_idx to
-        // the index of block desc of the program desc.
-        sub_block_idx = desc->BlocksSize();
-        auto sub_block_desc = subgraph_op->GetSubBlock();
-        CHECK(sub_block_desc);
-        auto new_block_desc = desc->AddBlock<cpp::BlockDesc>();
-        *new_block_desc = *sub_block_desc;
-        delete sub_block_desc;
-        subgraph_op->mutable_op_info()->SetAttr<int32_t>("sub_block",
-                                                         sub_block_idx);
-        subgraph_op->SetSubBlock(new_block_desc);
-        // Update main block desc after a new subblock desc is added
-        main_block = desc->GetBlock<cpp::BlockDesc>(0);
-      }
+    cpp::OpDesc op_desc = *node.op()->op_info();
+    if (op_desc.Type() == "subgraph" &&
+        op_desc.GetAttr<int32_t>("sub_block") < 0) {
+      // It's a new subgraph op when its sub_block_idx < 0, Now we add a copy
+      // of its subblock desc to the program desc and let the saved op refer
+      // to it. The op and its kernel keep using their own subblock desc.
+      auto subgraph_op = static_cast<const operators::SubgraphOp*>(node.op());
+      auto sub_block_desc = subgraph_op->GetSubBlock();
+      CHECK(sub_block_desc);
+      op_desc.SetAttr<int32_t>("sub_block",
+                               static_cast<int32_t>(desc->BlocksSize()));
+      *desc->AddBlock<cpp::BlockDesc>() = *sub_block_desc;
+      // Update main block desc after a new subblock desc is added
+      main_block = desc->GetBlock<cpp::BlockDesc>(0);
     }
     auto op = main_block->AddOp<cpp::OpDesc>();
-    *op = *node.op()->op_info();
+    *op = op_desc;
     op->SetAttr(kKernelTypeAttr, node.kernel()->SerializedKernelType());
+    if (!node.kernel()->algorithm().empty() ||
+        op->HasAttr(kKernelAlgorithmAttr)) {
+      op->SetAttr(kKernelAlgorithmAttr, node.kernel()->algorithm());
+    }
   }
 }
 
@@ -92,6 +146,7 @@ void RuntimeProgram::UpdateVarsOfProgram(cpp::ProgramDesc* desc) {
         v->SetName((it->second).Name());
         v->SetType((it->second).GetType());
         v->SetPersistable((it->second).Persistable());
+        v->SetShape((it->second).GetShape());
       } else {
         // New created vars must be LOD_TENSOR
         auto* v = main_block.AddVar<cpp::VarDesc>();
@@ -116,6 +171,7 @@ void RuntimeProgram::UpdateVarsOfProgram(cpp::ProgramDesc* desc) {
         v->SetName((it->second).Name());
         v->SetType((it->second).GetType());
         v->SetPersistable((it->second).Persistable());
+        v->SetShape((it->second).GetShape());
       } else {
         // New created vars must be LOD_TENSOR
         auto* v = main_block.AddVar<cpp::VarDesc>();
@@ -135,23 +191,257 @@ void RuntimeProgram::UpdateVarsOfProgram(cpp::ProgramDesc* desc) {
   }
 }
 
+bool RuntimeProgram::InputShapesUnchanged() {
+#ifdef LITE_WITH_FPGA
+  // The inputs are passed through the feed list and copied by the feed ops.
+  return false;
+#else
+  if (!exec_scope_) return false;
+  bool unchanged = input_dims_.size() == input_names_.size();
+  input_dims_.resize(input_names_.size());
+  input_lods_.resize(input_names_.size());
+  for (size_t i = 0; i < input_names_.size(); i++) {
+    auto* var = exec_scope_->FindVar(input_names_[i]);
+    if (!var || !var->IsType<Tensor>()) return false;
+    const auto& tensor = var->Get<Tensor>();
+    if (unchanged && input_dims_[i] == tensor.dims() &&
+        input_lods_[i] == tensor.lod()) {
+      continue;
+    }
+    unchanged = false;
+    input_dims_[i] = tensor.dims();
+    input_lods_[i] = tensor.lod();
+  }
+  return unchanged;
+#endif
+}
+
+void RuntimeProgram::set_inter_op_threads(int threads) {
+  threads = std::max(threads, 1);
+#if defined(LITE_WITH_PROFILE) || defined(LITE_WITH_FPGA) || \
+    defined(LITE_WITH_CUDA) || defined(LITE_WITH_OPENCL)
+  if (threads > 1) {
+    LOG(WARNING) << "The inter-op parallel execution is not supported in this "
+                    "build, the instructions will run serially.";
+    threads = 1;
+  }
+#endif
+  if (threads == inter_op_threads_) return;
+  inter_op_threads_ = threads;
+  thread_pool_.reset();
+  if (inter_op_threads_ == 1) return;
+  if (successors_.empty()) {
+    BuildDependencies();
+  }
+  std::function<void(int)> worker_init;
+#ifdef LITE_WITH_ARM
+  // The power mode and the arch of ARM are thread local, the workers follow
+  // the ones of the thread creating them.
+  auto mode = DeviceInfo::Global().mode();
+  auto arch = DeviceInfo::Global().arch();
+  int intra_op_threads = DeviceInfo::Global().threads();
+  worker_init = [=](int) {
+    DeviceInfo::Global().SetRunMode(mode, intra_op_threads);
+    DeviceInfo::Global().SetArch(arch);
+  };
+#endif
+#ifdef LITE_WITH_X86
+  // So are the pool of RunParallelFor and the number of OpenMP threads.
+  int intra_op_threads = x86::GetMaxThreads();
+#ifdef PADDLE_WITH_MKLML
+  int math_threads = omp_get_max_threads();
+#endif
+  worker_init = [=](int) {
+    x86::SetParallelForThreads(intra_op_threads);
+#ifdef PADDLE_WITH_MKLML
+    omp_set_num_threads(math_threads);
+#endif
+  };
+#endif
+  thread_pool_.reset(new ThreadPool(inter_op_threads_, worker_init));
+}
+
+void RuntimeProgram::set_tracing(bool enabled, size_t capacity) {
+  tracing_ = enabled;
+  if (enabled) {
+    tracer_.reset(new profile::Tracer(capacity));
+  }
+  for (size_t i = 0; i < instructions_.size(); i++) {
+    instructions_[i].set_tracer(enabled ? tracer_.get() : nullptr, i);
+  }
+}
+
+void RuntimeProgram::BuildDependencies() {
+  const size_t num = instructions_.size();
+  std::vector<std::set<size_t>> deps(num);
+  // The last instruction writing each variable, and the instructions reading
+  // it since then.
+  std::unordered_map<std::string, size_t> last_writer;
+  std::unordered_map<std::string, std::vector<size_t>> readers;
+  // The ops running a sub-block may access any variable of the scope, so they
+  // are executed as barriers.
+  size_t last_barrier = 0;
+  bool has_barrier = false;
+  for (size_t i = 0; i < num; i++) {
+    auto* op_info = instructions_[i].op()->op_info();
+    auto op_type = op_info->Type();
+    if (op_type == "while" || op_type == "conditional_block" ||
+        op_type == "subgraph") {
+      for (size_t j = last_barrier; j < i; j++) {
+        deps[i].insert(j);
+      }
+      last_barrier = i;
+      has_barrier = true;
+      last_writer.clear();
+      readers.clear();
+      continue;
+    }
+    if (has_barrier) {
+      deps[i].insert(last_barrier);
+    }
+    // read after write
+    for (auto& name : op_info->input_names()) {
+      auto it = last_writer.find(name);
+      if (it != last_writer.end()) deps[i].insert(it->second);
+      readers[name].push_back(i);
+    }
+    for (auto& name : op_info->output_names()) {
+      // write after write
+      auto it = last_writer.find(name);
+      if (it != last_writer.end()) deps[i].insert(it->second);
+      // write after read, the variables may be shared by the memory reuse.
+      for (auto reader : readers[name]) {
+        deps[i].insert(reader);
+      }
+      readers[name].clear();
+      last_writer[name] = i;
+    }
+    deps[i].erase(i);
+  }
+
+  predecessors_.assign(num, {});
+  successors_.assign(num, {});
+  for (size_t i = 0; i < num; i++) {
+    predecessors_[i].assign(deps[i].begin(), deps[i].end());
+    for (auto pred : deps[i]) {
+      successors_[pred].push_back(i);
+    }
+  }
+  remaining_deps_.reset(new std::atomic<int>[num]);
+  shape_changed_.assign(num, 0);
+}
+
+void RuntimeProgram::RunInstruction(size_t id) {
+  auto& inst = instructions_[id];
+  // The feed and fetch ops are skipped as the serial execution does, the
+  // parallel one is never enabled with FPGA.
+  if (!inst.is_feed_fetch_op()) {
+    bool reuse_shapes = parallel_reuse_shapes_;
+    for (auto pred : predecessors_[id]) {
+      if (shape_changed_[pred]) reuse_shapes = false;
+    }
+    shape_changed_[id] = !inst.Run(reuse_shapes);
+  }
+  for (auto succ : successors_[id]) {
+    if (remaining_deps_[succ].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      thread_pool_->Submit([this, succ] { RunInstruction(succ); });
+    }
+  }
+}
+
+void RuntimeProgram::RunParallel(bool reuse_shapes) {
+  // Unlike the serial execution, only the instructions depending on the ones
+  // whose output shapes changed will infer the shapes again.
+  parallel_reuse_shapes_ = reuse_shapes;
+  for (size_t i = 0; i < instructions_.size(); i++) {
+    remaining_deps_[i].store(static_cast<int>(predecessors_[i].size()),
+                             std::memory_order_relaxed);
+    shape_changed_[i] = 0;
+  }
+  for (size_t i = 0; i < instructions_.size(); i++) {
+    if (predecessors_[i].empty()) {
+      thread_pool_->Submit([this, i] { RunInstruction(i); });
+    }
+  }
+  thread_pool_->Wait();
+}
+
+void RuntimeProgram::BindOutput(const std::string& name,
+                                void* data,
+                                size_t memory_size,
+                                TargetType target) {
+  CHECK(exec_scope_);
+  auto* var = exec_scope_->FindVar(name);
+  CHECK(var) << "no output variable " << name << " in exec_scope";
+  auto* tensor = var->GetMutable<Tensor>();
+  // The memory allocated by TargetMalloc is aligned to 64 bytes, which the
+  // kernels may rely on.
+  CHECK_EQ(reinterpret_cast<uintptr_t>(data) % 64, 0UL)
+      << "The output buffer should be aligned to 64 bytes";
+  auto it = bound_outputs_.find(name);
+  if (it != bound_outputs_.end()) {
+    // Stop writing to the former buffer, which may be released by the caller.
+    if (tensor->raw_data() == it->second.data) tensor->clear();
+    bound_outputs_.erase(it);
+  }
+  if (!data) return;
+  std::shared_ptr<void> holder(data, [](void*) {});
+  bound_outputs_[name] = BoundOutput{data, memory_size, target, holder};
+}
+
+void RuntimeProgram::PrepareBoundOutputs() {
+  for (auto& item : bound_outputs_) {
+    const auto& bound = item.second;
+    auto* tensor = exec_scope_->FindVar(item.first)->GetMutable<Tensor>();
+    if (tensor->raw_data() == bound.data) continue;
+    tensor->ShareExternalMemory(
+        bound.data, bound.memory_size, bound.target, bound.holder, true);
+  }
+}
+
+void RuntimeProgram::FinishBoundOutputs() {
+  for (auto& item : bound_outputs_) {
+    const auto& bound = item.second;
+    auto* tensor = exec_scope_->FindVar(item.first)->GetMutable<Tensor>();
+    if (tensor->raw_data() == bound.data) continue;
+    size_t size = tensor->memory_size();
+    CHECK_LE(size, bound.memory_size)
+        << "The output " << item.first << " needs " << size
+        << " bytes, more than the " << bound.memory_size << " bytes bound";
+    TargetCopy(bound.target, bound.data, tensor->raw_data(), size);
+    tensor->ShareExternalMemory(
+        bound.data, bound.memory_size, bound.target, bound.holder, true);
+    tensor->mutable_data(bound.target, size);
+  }
+}
+
 void RuntimeProgram::Run() {
-  for (auto& inst : instructions_) {
+  PrepareBoundOutputs();
+  bool reuse_shapes = reuse_shapes_ && InputShapesUnchanged();
+  if (thread_pool_) {
+    RunParallel(reuse_shapes);
+  } else {
+    for (auto& inst : instructions_) {
 #ifndef LITE_WITH_FPGA
-    if (inst.is_feed_fetch_op()) continue;
+      if (inst.is_feed_fetch_op()) continue;
 #endif
-    inst.Run();
+      // Once the output shapes of an instruction change, for example, the
+      // ones decided by the data in kernel, the shapes of all the following
+      // instructions have to be inferred again.
+      if (!inst.Run(reuse_shapes)) reuse_shapes = false;
 #ifdef LITE_WITH_PROFILE
 #ifdef LITE_WITH_PRECISION_PROFILE
 #ifndef LITE_WITH_FPGA
-    LITE_PRECISION_PROFILE(inst)
+      LITE_PRECISION_PROFILE(inst)
 #endif
 #endif  // LITE_WITH_PRECISION_PROFILE
 #endif  // LITE_WITH_PROFILE
+    }
   }
 #ifdef LITE_WITH_CUDA
   TargetWrapperCuda::DeviceSync();
 #endif
+  FinishBoundOutputs();
 #ifdef LITE_WITH_PROFILE
   LOG(INFO) << "\n" << profiler_.Summary(profile::Type::kDispatch, false, 0);
 #endif  // LITE_WITH_PROFILE
@@ -240,6 +530,10 @@ void Program::PrepareWorkspace(const cpp::ProgramDesc& prog) {
           var_data_type_[var_desc.Name()] =
               VarPrecision2KernlPrecision(var_desc.GetDataType());
         }
+        if (var_desc.GetType() == lite::VarDescAPI::Type::LOD_TENSOR &&
+            !var_desc.GetShape().empty()) {
+          var_shape_[var_desc.Name()] = var_desc.GetShape();
+        }
         tmp_vars_.push_back(var_desc.Name());
         VLOG(4) << "var name: " << var_desc.Name() << " type is "
                 << static_cast<int>(var_desc.GetType()) << " data type is "
@@ -257,7 +551,30 @@ void Program::PrepareWorkspace(const cpp::ProgramDesc& prog) {
   }
 }
 
-void Instruction::Run() {
+bool Instruction::CacheOutputShapes() {
+  bool unchanged = true;
+  for (size_t i = 0; i < output_tensors_.size(); i++) {
+    auto* tensor = output_tensors_[i];
+    if (output_dims_[i] != tensor->dims()) {
+      output_dims_[i] = tensor->dims();
+      unchanged = false;
+    }
+    if (output_lods_[i] != tensor->lod()) {
+      output_lods_[i] = tensor->lod();
+      unchanged = false;
+    }
+  }
+  return unchanged;
+}
+
+void Instruction::RestoreOutputShapes() {
+  for (size_t i = 0; i < output_tensors_.size(); i++) {
+    output_tensors_[i]->Resize(output_dims_[i]);
+    output_tensors_[i]->set_lod(output_lods_[i]);
+  }
+}
+
+bool Instruction::Run(bool reuse_shapes) {
 #ifdef LITE_WITH_PROFILE
   CHECK(profiler_) << "Profiler pointer of kernel can not be nullptr. "
                       "When LITE_WITH_PROFILE is defined, please set a "
@@ -271,15 +588,65 @@ void Instruction::Run() {
   if (first_epoch_) {
     first_epoch_ = false;
     CHECK(op_->CheckShape());
+    auto* scope = op_->scope();
+    for (auto& name : op_->op_info()->output_names()) {
+      auto* var = scope->FindVar(name);
+      if (var && var->IsType<Tensor>()) {
+        output_tensors_.push_back(var->GetMutable<Tensor>());
+      }
+    }
+    output_dims_.resize(output_tensors_.size());
+    output_lods_.resize(output_tensors_.size());
   }
 
   if (op_->run_once() && has_run_) {
-    return;
+    return true;
   }
+  if (run_once_flag_) {
+    // The outputs are shared with the clones of the program, the first one to
+    // get here runs it for all, the others wait for it.
+    bool unchanged = true;
+    std::call_once(*run_once_flag_,
+                   [&]() { unchanged = RunKernel(reuse_shapes); });
+    has_run_ = true;
+    return unchanged;
+  }
+  return RunKernel(reuse_shapes);
+}
 
-  op_->InferShape();
-  kernel_->Launch();
+bool Instruction::WritesRootScope() const {
+  auto* scope = op_->scope();
+  if (!scope) return false;
+  for (auto& name : op_->op_info()->output_names()) {
+    if (!scope->FindLocalVar(name) && scope->FindVar(name)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool Instruction::RunKernel(bool reuse_shapes) {
+  int64_t start_us = tracer_ ? tracer_->NowUs() : 0;
+  bool shape_cached =
+      reuse_shapes && has_run_ && op_->infer_shape_cacheable();
+  if (shape_cached) {
+    RestoreOutputShapes();
+  } else {
+    op_->InferShape();
+  }
+  int64_t infer_shape_end_us = tracer_ ? tracer_->NowUs() : 0;
+  kernel_->Launch(!shape_cached);
   has_run_ = true;
+  bool unchanged = CacheOutputShapes();
+  if (tracer_) {
+    tracer_->Record(trace_id_,
+                    op_.get(),
+                    *kernel_,
+                    start_us,
+                    infer_shape_end_us,
+                    !shape_cached);
+  }
+  return unchanged;
 }
 
 STL::ostream& operator<<(STL::ostream& os, const Instruction& other) {
@@ -13,8 +13,11 @@
 // limitations under the License.
 
 #pragma once
+#include <atomic>
 #include <list>
+#include <map>
 #include <memory>
+#include <mutex>  // NOLINT
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -22,12 +25,16 @@
 #include "lite/core/kernel.h"
 #include "lite/core/op_lite.h"
 #include "lite/core/op_registry.h"
+#include "lite/core/profile/tracer.h"
+#include "lite/core/thread_pool.h"
 #include "lite/model_parser/cpp/program_desc.h"
 
 namespace paddle {
 namespace lite {
 
 static const char kKernelTypeAttr[] = "__@kernel_type_attr@__";
+// The algorithm forced on the kernel by the kernel_tune_pass, if any.
+static const char kKernelAlgorithmAttr[] = "__@kernel_algorithm_attr@__";
 
 // A program is used to represent a code program, in Paddle, a code program
 // contains:
@@ -68,6 +75,11 @@ struct Program {
     return var_data_type_;
   }
 
+  const std::unordered_map<std::string, std::vector<int64_t>>& var_shape()
+      const {
+    return var_shape_;
+  }
+
  private:
   // Build from a program and scope.
   void Build(const cpp::ProgramDesc& program);
@@ -76,6 +88,9 @@ struct Program {
 
  private:
   std::unordered_map<std::string, PrecisionType> var_data_type_;
+  // The static shapes recorded in the model's var descs, which are used to
+  // estimate the memory footprint of temporary vars.
+  std::unordered_map<std::string, std::vector<int64_t>> var_shape_;
   std::list<std::string> tmp_vars_;
   std::list<std::string> weights_;
   std::list<std::shared_ptr<OpLite>> ops_;
@@ -95,10 +110,25 @@ struct Instruction {
     if (op_type == "feed" || op_type == "fetch") {
       is_feed_fetch_op_ = true;
     }
+    if (op->run_once() && WritesRootScope()) {
+      run_once_flag_ = std::make_shared<std::once_flag>();
+    }
   }
 
-  // Run the instruction.
-  void Run();
+  // Run the run_once op writing the persistable vars of the root scope only
+  // once for both `other` and this instruction, the same instruction of a
+  // program sharing that scope.
+  void ShareRunOnceFrom(const Instruction& other) {
+    if (run_once_flag_ && other.run_once_flag_) {
+      run_once_flag_ = other.run_once_flag_;
+    }
+  }
+
+  // Run the instruction. If `reuse_shapes` is true, the output shapes and lods
+  // cached at the last run are restored instead of calling InferShape. It
+  // returns false if the output shapes differ from the last run, which means
+  // the shapes of the following instructions should be inferred again.
+  bool Run(bool reuse_shapes = false);
 
   friend STL::ostream& operator<<(STL::ostream& os, const Instruction& other);
 
@@ -108,6 +138,12 @@ struct Instruction {
 
   bool is_feed_fetch_op() const { return is_feed_fetch_op_; }
 
+  // Record the runs as the `id`-th instruction to `tracer`, nullptr to stop.
+  void set_tracer(profile::Tracer* tracer, int id) {
+    tracer_ = tracer;
+    trace_id_ = id;
+  }
+
 #ifdef LITE_WITH_PROFILE
   void set_profiler(profile::Profiler* profiler) {
     profiler_ = profiler;
@@ -123,11 +159,31 @@ struct Instruction {
 #endif
 
  private:
+  // Infer the shapes and launch the kernel, see `Run`.
+  bool RunKernel(bool reuse_shapes);
+  // Whether some outputs are not local to the exec scope of the op, i.e. they
+  // are persistable vars shared by the clones of the program.
+  bool WritesRootScope() const;
+  // Cache the output shapes and lods, return false if they changed.
+  bool CacheOutputShapes();
+  void RestoreOutputShapes();
+
   std::shared_ptr<OpLite> op_;
   std::unique_ptr<KernelBase> kernel_;
   bool is_feed_fetch_op_{false};
   bool first_epoch_{true};
   bool has_run_{false};
+  // Shared with the clones if the op is run_once and writes the root scope,
+  // see `ShareRunOnceFrom`.
+  std::shared_ptr<std::once_flag> run_once_flag_;
+
+  // The output tensors and their shapes and lods at the last run.
+  std::vector<Tensor*> output_tensors_;
+  std::vector<DDim> output_dims_;
+  std::vector<LoD> output_lods_;
+
+  profile::Tracer* tracer_{nullptr};
+  int trace_id_{-1};
 
 #ifdef LITE_WITH_PROFILE
   profile::Profiler* profiler_;
@@ -142,13 +198,13 @@ class LITE_API RuntimeProgram {
  public:
   explicit RuntimeProgram(std::vector<Instruction>&& insts)
       : instructions_(std::move(insts)) {
-    if (instructions_.empty()) {
-      LOG(FATAL) << "no instructions";
-    }
-#ifdef LITE_WITH_PROFILE
-    set_profiler();
-#endif
+    Init();
   }
+  // Create the instructions of an optimized program whose ops hold the types
+  // of their kernels in kKernelTypeAttr, as the saved models do. The exec
+  // scope is created under `scope`, which holds the weights.
+  RuntimeProgram(const cpp::ProgramDesc& desc,
+                 const std::shared_ptr<Scope>& scope);
   ~RuntimeProgram() {
 #ifdef LITE_WITH_PROFILE
     LOG(INFO) << "\n" << profiler_.Summary(profile::Type::kCreate);
@@ -158,6 +214,41 @@ class LITE_API RuntimeProgram {
 
   void Run();
 
+  // Skip the shape inference of all the instructions if the shapes and lods of
+  // the inputs are the same as the last run.
+  void set_reuse_shapes(bool x) { reuse_shapes_ = x; }
+  bool reuse_shapes() const { return reuse_shapes_; }
+
+  // Run the independent instructions concurrently on `threads` threads. The
+  // dependencies are built from the variables read and written by each
+  // instruction, so the ones sharing a reused buffer are still ordered. Each
+  // kernel keeps using its own intra-op threads, so the total number of busy
+  // threads can be up to `threads` times of it. 1 means the serial execution.
+  void set_inter_op_threads(int threads);
+  int inter_op_threads() const { return inter_op_threads_; }
+
+  // Record the runs of the instructions, with their times, threads, shapes
+  // and estimated FLOPs, see profile::Tracer. Enabling it drops the former
+  // records, disabling it keeps them for `tracer()`. At most `capacity`
+  // records are kept, the oldest ones are dropped.
+  void set_tracing(bool enabled,
+                   size_t capacity = profile::Tracer::kDefaultCapacity);
+  bool tracing() const { return tracing_; }
+  // The records, nullptr if the tracing has never been enabled.
+  const profile::Tracer* tracer() const { return tracer_.get(); }
+
+  // Bind the caller owned `data` of `memory_size` bytes to the output var
+  // `name`, the kernel producing it writes into `data` in place instead of an
+  // allocated buffer, nullptr unbinds it. If the kernel shares another buffer
+  // instead, such as the inplace reshape, the output is copied to `data`
+  // after the run. It fails if the output needs more than `memory_size`
+  // bytes. The vars read by fetch are never reused by the memory optimizer,
+  // so `data` is not written by the other instructions.
+  void BindOutput(const std::string& name,
+                  void* data,
+                  size_t memory_size,
+                  TargetType target = TARGET(kHost));
+
   void set_exec_scope(lite::Scope* x) { exec_scope_ = x; }
   lite::Scope* exec_scope() { return exec_scope_; }
 
@@ -165,9 +256,15 @@ class LITE_API RuntimeProgram {
 
   const std::vector<Instruction>& instructions() const { return instructions_; }
 
+  // Reuse the weights prepared by the kernels of `other`, a program of the
+  // same ops running on the same weights, see KernelBase::ShareWeightsFrom.
+  // The run_once ops writing these weights run once for both programs.
+  void ShareWeightsFrom(const RuntimeProgram& other);
+
   // `SaveOpInfosToProgram` will update the op list(ops_) of the block 0
-  // in ProgramDesc.
-  void SaveOpInfosToProgram(cpp::ProgramDesc* desc);
+  // in ProgramDesc. The subblocks of the new subgraph ops are copied into
+  // `desc`, the ops themselves are left untouched.
+  void SaveOpInfosToProgram(cpp::ProgramDesc* desc) const;
 
   // `UpdateVarsOfProgram` will update the var list(vars_) of the block 0 in
   // ProgramDesc. Namely, if a new var created in some passes, its var_desc will
@@ -176,9 +273,50 @@ class LITE_API RuntimeProgram {
 
  private:
   RuntimeProgram(const RuntimeProgram&) = delete;
+  void Init();
+  // Check the shapes and lods of the inputs against the last run, and cache
+  // the current ones.
+  bool InputShapesUnchanged();
+  // Build the dependency graph of the instructions for the parallel execution.
+  void BuildDependencies();
+  void RunParallel(bool reuse_shapes);
+  // Run the `id`-th instruction and schedule its ready successors.
+  void RunInstruction(size_t id);
+  // Point the bound output tensors to the caller's buffers before a run, and
+  // copy the outputs written elsewhere to them after it.
+  void PrepareBoundOutputs();
+  void FinishBoundOutputs();
+
   std::vector<Instruction> instructions_;
   lite::Scope* exec_scope_{};
 
+  bool reuse_shapes_{true};
+  std::vector<std::string> input_names_;
+  std::vector<DDim> input_dims_;
+  std::vector<LoD> input_lods_;
+
+  int inter_op_threads_{1};
+  std::unique_ptr<ThreadPool> thread_pool_;
+  std::vector<std::vector<size_t>> predecessors_;
+  std::vector<std::vector<size_t>> successors_;
+  // The states of the current parallel run: the number of unfinished
+  // predecessors and whether the output shapes changed of every instruction.
+  std::unique_ptr<std::atomic<int>[]> remaining_deps_;
+  std::vector<char> shape_changed_;
+  bool parallel_reuse_shapes_{false};
+
+  bool tracing_{false};
+  std::unique_ptr<profile::Tracer> tracer_;
+
+  struct BoundOutput {
+    void* data;
+    size_t memory_size;
+    TargetType target;
+    // Never frees `data`, the external buffers require a holder.
+    std::shared_ptr<void> holder;
+  };
+  std::map<std::string, BoundOutput> bound_outputs_;
+
 #ifdef LITE_WITH_PROFILE
   profile::Profiler profiler_;
   void set_profiler() {
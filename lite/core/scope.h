@@ -15,6 +15,7 @@
 #pragma once
 #include <list>
 #include <memory>
+#include <mutex>  // NOLINT
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -37,6 +38,9 @@ class Scope final {
 
   Scope& NewScope() const;
 
+  // Delete a kid scope created by NewScope, with all its variables.
+  void DeleteScope(const Scope* scope) const;
+
   Variable* Var(const std::string& name);
 
   Variable* FindVar(const std::string& name) const;
@@ -69,8 +73,10 @@ class Scope final {
   }
 
  private:
-  // Scope in `kids_` are owned by this class.
+  // Scope in `kids_` are owned by this class. The kids may be created and
+  // deleted concurrently by the predictors sharing this scope.
   mutable std::list<Scope*> kids_;
+  mutable std::mutex kids_mutex_;
   const Scope* parent_{nullptr};
   std::unordered_map<std::string, std::unique_ptr<Variable>> vars_;
 };
@@ -77,6 +77,19 @@ void TensorLite::ShareDataWith(const TensorLite &other) {
   memory_size_ = other.memory_size_;
 }
 
+void TensorLite::ShareExternalMemory(const void *data,
+                                     size_t memory_size,
+                                     TargetType target,
+                                     std::shared_ptr<void> holder,
+                                     bool writable) {
+  CHECK(holder);
+  target_ = target;
+  memory_size_ = memory_size;
+  offset_ = 0;
+  buffer_ = std::make_shared<Buffer>();
+  buffer_->ResetFromExternal(target, data, memory_size, holder, writable);
+}
+
 void TensorLite::CopyDataFrom(const TensorLite &other) {
   dims_ = other.dims_;
   target_ = other.target_;
@@ -193,6 +193,16 @@ class TensorLite {
   // Other share data to this.
   void ShareDataWith(const TensorLite &other);
 
+  // Reference readonly memory owned by `holder` instead of allocating, the
+  // data is copied on the first mutable_data call. The `writable` memory is
+  // written in place by mutable_data if it is large enough. The tensor stops
+  // sharing its former buffer with the other tensors.
+  void ShareExternalMemory(const void *data,
+                           size_t memory_size,
+                           TargetType target,
+                           std::shared_ptr<void> holder,
+                           bool writable = false);
+
   void CopyDataFrom(const TensorLite &other);
 
   TargetType target() const { return target_; }
@@ -0,0 +1,129 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/thread_pool.h"
+#include <utility>
+#include "lite/utils/cp_logging.h"
+
+namespace paddle {
+namespace lite {
+
+namespace {
+// The pool and the id of the worker running in the current thread.
+thread_local ThreadPool* current_pool = nullptr;
+thread_local int current_worker_id = -1;
+}  // namespace
+
+ThreadPool::ThreadPool(int num_threads,
+                       const std::function<void(int)>& worker_init)
+    : worker_init_(worker_init) {
+  CHECK_GT(num_threads, 0) << "invalid number of threads: " << num_threads;
+  for (int i = 0; i < num_threads; ++i) {
+    queues_.emplace_back(new TaskQueue);
+  }
+  for (int i = 0; i < num_threads; ++i) {
+    workers_.emplace_back([this, i] { WorkerLoop(i); });
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  Wait();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  task_cv_.notify_all();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+void ThreadPool::Submit(Task task) {
+  int id;
+  if (current_pool == this) {
+    id = current_worker_id;
+  } else {
+    id = next_queue_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+  }
+  {
+    std::lock_guard<std::mutex> lock(queues_[id]->mutex);
+    queues_[id]->tasks.push_back(std::move(task));
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++num_queued_;
+    ++num_pending_;
+  }
+  task_cv_.notify_one();
+}
+
+void ThreadPool::Wait() {
+  CHECK(current_pool != this) << "can not wait in a task of the same pool";
+  std::unique_lock<std::mutex> lock(mutex_);
+  done_cv_.wait(lock, [this] { return num_pending_ == 0; });
+}
+
+bool ThreadPool::PopTask(int id, Task* task) {
+  {
+    auto& queue = *queues_[id];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (!queue.tasks.empty()) {
+      *task = std::move(queue.tasks.back());
+      queue.tasks.pop_back();
+      return true;
+    }
+  }
+  for (size_t i = 1; i < queues_.size(); ++i) {
+    auto& queue = *queues_[(id + i) % queues_.size()];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (!queue.tasks.empty()) {
+      *task = std::move(queue.tasks.front());
+      queue.tasks.pop_front();
+      return true;
+    }
+  }
+  return false;
+}
+
+void ThreadPool::WorkerLoop(int id) {
+  current_pool = this;
+  current_worker_id = id;
+  if (worker_init_) {
+    worker_init_(id);
+  }
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      task_cv_.wait(lock, [this] { return stop_ || num_queued_ > 0; });
+      if (num_queued_ == 0) return;
+      // Claim a task, it is pushed to a queue before being counted, so the
+      // claimed one must be found by the loop below.
+      --num_queued_;
+    }
+    Task task;
+    while (!PopTask(id, &task)) {
+      std::this_thread::yield();
+    }
+    task();
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (--num_pending_ == 0) {
+        done_cv_.notify_all();
+      }
+    }
+  }
+}
+
+}  // namespace lite
+}  // namespace paddle
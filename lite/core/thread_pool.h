@@ -0,0 +1,82 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <atomic>
+#include <condition_variable>  // NOLINT
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>   // NOLINT
+#include <thread>  // NOLINT
+#include <vector>
+
+namespace paddle {
+namespace lite {
+
+/*
+ * A work-stealing thread pool. Every worker owns a task queue, the tasks
+ * submitted by a worker are pushed to its own queue and popped in LIFO order,
+ * so that the successors of a finished task tend to run on the same core with
+ * hot caches. An idle worker steals the oldest task of the other queues.
+ */
+class ThreadPool {
+ public:
+  using Task = std::function<void()>;
+
+  // `worker_init` is called once in every worker thread before running any
+  // task, it can be used to set up the thread local states, e.g. the power
+  // mode of ARM.
+  explicit ThreadPool(int num_threads,
+                      const std::function<void(int)>& worker_init = nullptr);
+  ~ThreadPool();
+
+  // Submit a task, it is safe to call it in a task of this pool.
+  void Submit(Task task);
+
+  // Block until all the submitted tasks have finished.
+  void Wait();
+
+  int num_threads() const { return static_cast<int>(workers_.size()); }
+
+ private:
+  struct TaskQueue {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+
+  void WorkerLoop(int id);
+  // Pop a task from the queue of worker `id`, or steal one from the others.
+  bool PopTask(int id, Task* task);
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  std::vector<std::unique_ptr<TaskQueue>> queues_;
+  std::vector<std::thread> workers_;
+  std::function<void(int)> worker_init_;
+
+  std::mutex mutex_;
+  std::condition_variable task_cv_;
+  std::condition_variable done_cv_;
+  // The number of tasks in the queues which are not claimed by any worker.
+  int num_queued_{0};
+  // The number of tasks which are submitted but not finished.
+  int num_pending_{0};
+  bool stop_{false};
+  std::atomic<unsigned> next_queue_{0};
+};
+
+}  // namespace lite
+}  // namespace paddle
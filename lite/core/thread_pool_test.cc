@@ -0,0 +1,57 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/thread_pool.h"
+#include <gtest/gtest.h>
+#include <atomic>
+
+namespace paddle {
+namespace lite {
+
+TEST(ThreadPool, Submit) {
+  ThreadPool pool(4);
+  std::atomic<int> sum{0};
+  for (int i = 0; i < 1000; ++i) {
+    pool.Submit([&sum, i] { sum += i; });
+  }
+  pool.Wait();
+  ASSERT_EQ(sum.load(), 999 * 1000 / 2);
+}
+
+TEST(ThreadPool, SubmitInTask) {
+  ThreadPool pool(3);
+  std::atomic<int> count{0};
+  for (int i = 0; i < 10; ++i) {
+    pool.Submit([&pool, &count] {
+      for (int j = 0; j < 10; ++j) {
+        pool.Submit([&count] { ++count; });
+      }
+    });
+  }
+  pool.Wait();
+  ASSERT_EQ(count.load(), 100);
+}
+
+TEST(ThreadPool, WorkerInit) {
+  std::atomic<int> inited{0};
+  {
+    ThreadPool pool(4, [&inited](int id) { inited |= 1 << id; });
+    ASSERT_EQ(pool.num_threads(), 4);
+    pool.Submit([] {});
+  }
+  ASSERT_EQ(inited.load(), 0xf);
+}
+
+}  // namespace lite
+}  // namespace paddle
@@ -14,13 +14,153 @@
 
 #include "lite/gen_code/gen_code.h"
 #include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
+#include "lite/core/context.h"
+#include "lite/core/op_registry.h"
 
 namespace paddle {
 namespace lite {
 namespace gencode {
 
+namespace {
+
+// The ops which run sub-blocks or whose output shapes depend on the values of
+// their inputs, the shapes recorded by a run don't hold for the others.
+const std::set<std::string> kDynamicShapeOps{"while",
+                                             "conditional_block",
+                                             "conditional_block_infer",
+                                             "merge_lod_tensor",
+                                             "merge_lod_tensor_infer",
+                                             "split_lod_tensor",
+                                             "multiclass_nms"};
+
+// The variables of these ops are left out of the static memory plan, they are
+// either skipped by MemoryOptimizePass or might share the buffers of the
+// other variables.
+const std::set<std::string> kUnplannedOps{"feed",
+                                          "fetch",
+                                          "while",
+                                          "conditional_block",
+                                          "conditional_block_infer",
+                                          "merge_lod_tensor",
+                                          "merge_lod_tensor_infer",
+                                          "equal",
+                                          "lod_reset",
+                                          "concat",
+                                          "yolo_box",
+                                          "subgraph",
+                                          "reshape",
+                                          "reshape2",
+                                          "flatten",
+                                          "flatten2",
+                                          "squeeze",
+                                          "squeeze2",
+                                          "unsqueeze",
+                                          "unsqueeze2"};
+
+template <typename T>
+std::string ElemRepr(T x) {
+  return std::to_string(x);
+}
+
+template <>
+std::string ElemRepr<float>(float x) {
+  if (std::isnan(x)) return "std::numeric_limits<float>::quiet_NaN()";
+  if (std::isinf(x)) {
+    return x > 0 ? "std::numeric_limits<float>::infinity()"
+                 : "-std::numeric_limits<float>::infinity()";
+  }
+  // 9 significant digits restore a float exactly.
+  STL::stringstream ss;
+  ss << std::setprecision(9) << x;
+  return ss.str();
+}
+
+template <typename T>
+std::string ElemsRepr(const std::string &raw_data, int elems_per_line) {
+  const T *raw = reinterpret_cast<const T *>(raw_data.c_str());
+  int num_elems = raw_data.size() / sizeof(T);
+  STL::stringstream ss;
+  for (int i = 0; i < num_elems; i++) {
+    if (i > 0) {
+      ss << ((elems_per_line > 0 && i % elems_per_line == 0) ? ",\n" : ",");
+    }
+    ss << ElemRepr(raw[i]);
+  }
+  return ss.str();
+}
+
+// Fill the tensor with ones of the data type of the variable.
+void FillOnes(const framework::proto::VarDesc &var,
+              const std::vector<int64_t> &shape,
+              lite::Tensor *tensor) {
+  tensor->Resize(shape);
+  auto numel = tensor->numel();
+  switch (var.type().lod_tensor().tensor().data_type()) {
+    case framework::proto::VarType::INT32:
+      std::fill_n(tensor->mutable_data<int32_t>(), numel, 1);
+      break;
+    case framework::proto::VarType::INT64:
+      std::fill_n(tensor->mutable_data<int64_t>(), numel, 1);
+      break;
+    case framework::proto::VarType::BOOL:
+    case framework::proto::VarType::UINT8:
+    case framework::proto::VarType::INT8:
+      std::fill_n(tensor->mutable_data<int8_t>(), numel, 1);
+      break;
+    default:
+      std::fill_n(tensor->mutable_data<float>(), numel, 1.f);
+  }
+}
+
+}  // namespace
+
+size_t PlanStaticMemory(std::vector<StaticVar> *vars, size_t alignment) {
+  CHECK(vars);
+  CHECK_GT(alignment, 0UL);
+  auto align = [=](size_t x) {
+    return (x + alignment - 1) / alignment * alignment;
+  };
+  std::vector<StaticVar *> order;
+  for (auto &var : *vars) order.push_back(&var);
+  std::stable_sort(order.begin(),
+                   order.end(),
+                   [](const StaticVar *a, const StaticVar *b) {
+                     return a->size > b->size;
+                   });
+
+  size_t arena_size = 0;
+  std::vector<StaticVar *> placed;
+  for (auto *var : order) {
+    // The placed variables alive together with this one, by their offsets.
+    std::vector<StaticVar *> alive;
+    for (auto *other : placed) {
+      if (other->begin <= var->end && var->begin <= other->end) {
+        alive.push_back(other);
+      }
+    }
+    std::sort(alive.begin(),
+              alive.end(),
+              [](const StaticVar *a, const StaticVar *b) {
+                return a->offset < b->offset;
+              });
+    size_t offset = 0;
+    for (auto *other : alive) {
+      if (offset + var->size <= other->offset) break;
+      offset = std::max(offset, align(other->offset + other->size));
+    }
+    var->offset = offset;
+    arena_size = std::max(arena_size, offset + var->size);
+    placed.push_back(var);
+  }
+  return arena_size;
+}
+
 void Module::AddWeight(const std::string &name, const TensorRepr &tensor) {
   auto w_name = WeightUniqueName();
   Line(string_format("// Create weight: %s", name.c_str()));
@@ -50,8 +190,89 @@ void Module::AddWeight(const std::string &name, const TensorRepr &tensor) {
   Line("");
 }
 
+std::string Module::AddWeightData(const TensorRepr &tensor) {
+  auto w_name = WeightUniqueName();
+  if (tensor.num_bytes == 0) return w_name;
+  Line(string_format("alignas(64) static const %s %s_data[] = {",
+                     PrecisionToStr(tensor.dtype).c_str(),
+                     w_name.c_str()));
+  stream() << DataRepr(std::string(static_cast<const char *>(tensor.raw_data),
+                                   tensor.num_bytes),
+                       tensor.dtype,
+                       16)
+           << "};\n";
+  Line("");
+  return w_name;
+}
+
+void Module::AddEmbeddedWeight(const std::string &name,
+                               const std::string &w_name,
+                               const TensorRepr &tensor) {
+  Line(string_format("// Create weight: %s", name.c_str()));
+  Line(string_format("auto* %s = scope->Var(%s)->GetMutable<lite::Tensor>();",
+                     w_name.c_str(),
+                     Repr(name).c_str()));
+  Line(string_format("%s->Resize(std::vector<int64_t>(%s));",
+                     w_name.c_str(),
+                     tensor.ddim.repr().c_str()));
+  Line(string_format("%s->set_precision(PRECISION(%s));",
+                     w_name.c_str(),
+                     PrecisionRepr(tensor.dtype).c_str()));
+  if (tensor.num_bytes > 0) {
+    // clang-format off
+    Line(string_format("%s->ShareExternalMemory(%s_data, sizeof(%s_data), TARGET(kX86), static_holder);",  // NOLINT
+                       w_name.c_str(),
+                       w_name.c_str(),
+                       w_name.c_str()));
+    // clang-format on
+  }
+  Line("");
+}
+
+void Module::AddStaticMemory(const std::vector<StaticVar> &vars,
+                             size_t arena_size) {
+  Line(string_format("// Static memory plan: %d variables in %s bytes",
+                     static_cast<int>(vars.size()),
+                     std::to_string(arena_size).c_str()));
+  // clang-format off
+  Line("auto* arena = exec_scope->Var(\"__static_memory_arena__\")->GetMutable<lite::Tensor>();");  // NOLINT
+  Line(string_format("arena->Resize(std::vector<int64_t>({%s}));", std::to_string(arena_size).c_str()));  // NOLINT
+  Line("auto* arena_data = arena->mutable_data<int8_t>(TARGET(kX86));");
+  for (auto &var : vars) {
+    Line(string_format("exec_scope->Var(%s)->GetMutable<lite::Tensor>()->ShareExternalMemory(arena_data + %s, %s, TARGET(kX86), static_holder, true);",  // NOLINT
+                       Repr(var.name).c_str(),
+                       std::to_string(var.offset).c_str(),
+                       std::to_string(var.size).c_str()));
+  }
+  // clang-format on
+  Line("");
+}
+
+void Module::AddStaticShapes(int op_idx,
+                             const std::map<std::string, DDim> &shapes) {
+  for (auto &item : shapes) {
+    Line(string_format("AddStaticShape(%d, %s, %s);",
+                       op_idx,
+                       Repr(item.first).c_str(),
+                       item.second.repr().c_str()));
+  }
+  if (!shapes.empty()) Line("");
+}
+
+void Module::AddStaticInputShapes(
+    const std::vector<std::vector<int64_t>> &shapes) {
+  for (size_t i = 0; i < shapes.size(); i++) {
+    Line(string_format("AddStaticInputShape(%d, %s);",
+                       static_cast<int>(i),
+                       DDim(shapes[i]).repr().c_str()));
+  }
+  Line("");
+}
+
 void Module::AddHeaderIncludeGenCode() {
   Line("");
+  Line("#include <limits>");
+  Line("#include <memory>");
   Line("#include <string>");
   Line("#include <vector>");
   Line("#include \"lite/core/tensor.h\"");
@@ -64,24 +285,24 @@ void Module::AddHeaderIncludeGenCode() {
   Line("");
 }
 
-std::string Module::DataRepr(const std::string &raw_data, PrecisionType dtype) {
-  STL::stringstream ss;
+std::string Module::DataRepr(const std::string &raw_data,
+                             PrecisionType dtype,
+                             int elems_per_line) {
   switch (dtype) {
-    case PRECISION(kFloat): {
-      const float *raw = reinterpret_cast<const float *>(raw_data.c_str());
-      int num_elems = raw_data.size() / sizeof(float);
-      if (num_elems) {
-        for (int i = 0; i < num_elems - 1; i++) {
-          ss << raw[i] << ",";
-        }
-        ss << raw[num_elems - 1];
-      }
-    } break;
-
+    case PRECISION(kFloat):
+      return ElemsRepr<float>(raw_data, elems_per_line);
+    case PRECISION(kInt8):
+      return ElemsRepr<int8_t>(raw_data, elems_per_line);
+    case PRECISION(kInt16):
+      return ElemsRepr<int16_t>(raw_data, elems_per_line);
+    case PRECISION(kInt32):
+      return ElemsRepr<int32_t>(raw_data, elems_per_line);
+    case PRECISION(kInt64):
+      return ElemsRepr<int64_t>(raw_data, elems_per_line);
     default:
       LOG(FATAL) << "Unsupported type " << PrecisionToStr(dtype);
   }
-  return ss.str();
+  return "";
 }
 
 void Module::AddOpDescHelper(const std::string &op_id,
@@ -218,6 +439,108 @@ void Module::AddOp(const cpp::OpDesc &op) {
   op_kinds_.insert(op.Type());
   kernel_kinds_.insert(kernel_type);
 }
+
+void ProgramCodeGenerator::RecordStaticShapes() {
+  const auto &block = program_.blocks(0);
+  std::map<std::string, const framework::proto::VarDesc *> var_descs;
+  // The weights are copied from the exec scope, the kernels repacking them in
+  // place on the run (e.g. conv2d_transpose on ARM) must not change the data
+  // embedded by AddWeightsData.
+  lite::Scope scope;
+  for (auto &var : block.vars()) {
+    var_descs[var.name()] = &var;
+    if (var.name() == "feed" || var.name() == "fetch") {
+      scope.Var(var.name())->GetMutable<std::vector<lite::Tensor>>();
+    } else if (var.persistable()) {
+      const auto &weight = exec_scope_.FindVar(var.name())->Get<lite::Tensor>();
+      scope.Var(var.name())->GetMutable<lite::Tensor>()->CopyDataFrom(weight);
+    } else if (var.type().type() == framework::proto::VarType::LOD_TENSOR) {
+      scope.Var(var.name())->GetMutable<lite::Tensor>();
+    }
+  }
+
+  auto descs = OpDescs();
+  std::vector<Place> valid_places(
+      {Place{TARGET(kX86), PRECISION(kFloat), DATALAYOUT(kNCHW)}});
+  static_shapes_.assign(descs.size(), {});
+  std::map<std::string, StaticVar> lifetimes;
+  std::set<std::string> unplanned;
+  for (size_t i = 0; i < descs.size(); i++) {
+    auto &desc = descs[i];
+    const auto &type = desc.Type();
+    CHECK(!kDynamicShapeOps.count(type))
+        << "the shapes of " << type << " can't be fixed ahead of time";
+    if (type == "feed") {
+      int col = desc.GetAttr<int>("col");
+      CHECK_LT(col, static_cast<int>(input_shapes_.size()))
+          << "no shape of the input " << col;
+      auto *feed_list =
+          scope.FindVar("feed")->GetMutable<std::vector<lite::Tensor>>();
+      if (feed_list->size() <= static_cast<size_t>(col)) {
+        feed_list->resize(col + 1);
+      }
+      FillOnes(*var_descs.at(desc.Output("Out").front()),
+               input_shapes_[col],
+               &feed_list->at(col));
+    }
+
+    auto op = LiteOpRegistry::Global().Create(type);
+    CHECK(op) << "no op " << type;
+    op->Attach(desc, &scope);
+    auto kernel = std::move(op->CreateKernels(
+        valid_places, desc.GetAttr<std::string>(kKernelTypeAttr))[0]);
+    kernel->SetContext(ContextScheduler::Global().NewContext(kernel->target()));
+    CHECK(op->CheckShape()) << "check shape of " << type << " failed";
+    CHECK(op->InferShape()) << "infer shape of " << type << " failed";
+    kernel->Launch();
+
+    bool with_lod = false;
+    auto vars = desc.input_vars();
+    auto output_vars = desc.output_vars();
+    vars.insert(vars.end(), output_vars.begin(), output_vars.end());
+    for (auto &name : vars) {
+      auto it = var_descs.find(name);
+      if (it != var_descs.end() &&
+          it->second->type().lod_tensor().lod_level() > 0) {
+        with_lod = true;
+      }
+    }
+
+    auto mark = [&](const std::string &name) {
+      auto it = var_descs.find(name);
+      if (it == var_descs.end() || it->second->persistable() ||
+          it->second->type().type() != framework::proto::VarType::LOD_TENSOR) {
+        return;
+      }
+      if (kUnplannedOps.count(type) || with_lod) unplanned.insert(name);
+      auto &var = lifetimes[name];
+      if (var.name.empty()) {
+        var.name = name;
+        var.begin = i;
+      }
+      var.end = i;
+    };
+    for (auto &name : desc.input_vars()) mark(name);
+    for (auto &name : desc.output_vars()) {
+      mark(name);
+      if (type == "feed" || type == "fetch" || with_lod ||
+          !lifetimes.count(name)) {
+        continue;
+      }
+      const auto &tensor = scope.FindVar(name)->Get<lite::Tensor>();
+      static_shapes_[i][name] = tensor.dims();
+      auto &var = lifetimes[name];
+      var.size = std::max(var.size, tensor.memory_size());
+    }
+  }
+
+  static_vars_.clear();
+  for (auto &item : lifetimes) {
+    if (unplanned.count(item.first) || item.second.size == 0) continue;
+    static_vars_.push_back(item.second);
+  }
+}
+
 }  // namespace gencode
 }  // namespace lite
 }  // namespace paddle
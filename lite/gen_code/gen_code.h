@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #pragma once
+#include <map>
 #include <set>
 #include <string>
 #include <vector>
@@ -44,6 +45,21 @@ struct TensorRepr {
   size_t num_bytes{};
 };
 
+// A temporary variable of the static memory plan, which is used by the ops
+// from `begin` to `end` inclusively and placed at `offset` of the arena.
+struct StaticVar {
+  std::string name;
+  size_t size{};
+  int begin{};
+  int end{};
+  size_t offset{};
+};
+
+// Place the variables in one arena, the ones alive at the same time never
+// overlap. The largest ones are placed first, each at the lowest offset
+// aligned to `alignment` which fits. Returns the size of the arena.
+size_t PlanStaticMemory(std::vector<StaticVar> *vars, size_t alignment = 64);
+
 class Module {
   std::vector<cpp::OpDesc> ops;
   std::vector<TensorRepr> weights;
@@ -98,6 +114,9 @@ class Module {
     // Create feed and fetch in exec_scope.
     Line(string_format("exec_scope->Var(%s);", Repr("feed").c_str()));
     Line(string_format("exec_scope->Var(%s);", Repr("fetch").c_str()));
+
+    // The embedded weights and the arena are never freed by the tensors.
+    Line("std::shared_ptr<void> static_holder(raw_scope_, [](void *) {});");
   }
 
   void AddValidPlaceDecl() {
@@ -117,6 +136,23 @@ class Module {
 
   void AddWeight(const std::string &name, const TensorRepr &tensor);
 
+  // Embed the data of a weight as a 64 bytes aligned static const array out
+  // of any function, which goes to .rodata. Returns the name of the weight.
+  std::string AddWeightData(const TensorRepr &tensor);
+  // Create the weight referencing its embedded data without any copy.
+  void AddEmbeddedWeight(const std::string &name,
+                         const std::string &w_name,
+                         const TensorRepr &tensor);
+
+  // Allocate the arena once and bind the temporary variables to their places.
+  void AddStaticMemory(const std::vector<StaticVar> &vars, size_t arena_size);
+
+  // The output shapes of the `op_idx`-th op, which are set instead of running
+  // its InferShape.
+  void AddStaticShapes(int op_idx, const std::map<std::string, DDim> &shapes);
+  // The shapes of the inputs, which the generated Run checks.
+  void AddStaticInputShapes(const std::vector<std::vector<int64_t>> &shapes);
+
   void AddTmpVar(const std::string &x) {
     Line(string_format("// Create temporary variable: %s", x.c_str()));
     Line(string_format("exec_scope->Var(%s);", Repr(x).c_str()));
@@ -165,7 +201,11 @@ class Module {
     return "kernel_" + std::to_string(kernel_counter_++);
   }
 
-  std::string DataRepr(const std::string &raw_data, PrecisionType dtype);
+  // The comma separated elements, with a line break every `elems_per_line`
+  // elements if it is positive.
+  std::string DataRepr(const std::string &raw_data,
+                       PrecisionType dtype,
+                       int elems_per_line = 0);
 
   void IncIndent() { line_indent_++; }
   void DecIndent() { line_indent_--; }
@@ -182,16 +222,33 @@ class Module {
   mutable int kernel_counter_{};
 };
 
+/*
+ * ProgramCodeGenerator generates the code of a PaddlePredictor running an
+ * optimized program. The weights are embedded as static arrays. If the shapes
+ * of the inputs are given, the program is run once on the inputs filled with
+ * ones to record the shapes of all the tensors, the generated code resizes the
+ * outputs of every op instead of running InferShape, and places the temporary
+ * variables in an arena by a static memory plan. The generated predictor only
+ * accepts the inputs of these shapes then.
+ */
 class ProgramCodeGenerator {
  public:
-  ProgramCodeGenerator(const framework::proto::ProgramDesc &program,
-                       const lite::Scope &exec_scope)
-      : program_(program), exec_scope_(exec_scope) {}
+  ProgramCodeGenerator(
+      const framework::proto::ProgramDesc &program,
+      const lite::Scope &exec_scope,
+      const std::vector<std::vector<int64_t>> &input_shapes = {})
+      : program_(program),
+        exec_scope_(exec_scope),
+        input_shapes_(input_shapes) {}
 
   std::string GenCode() {
     Module m;
     m.AddHeaderIncludeGenCode();
     m.AddNamespaceBegin();
+    if (!input_shapes_.empty()) {
+      RecordStaticShapes();
+    }
+    AddWeightsData(&m);
     m.AddInitFuncBegin();
     m.AddMemberCast();
     m.AddScopeDecl();
@@ -199,6 +256,7 @@ class ProgramCodeGenerator {
 
     AddWeights(&m);
     AddTmpVars(&m);
+    AddStaticMemory(&m);
     AddOps(&m);
 
     m.AddInitFuncEnd();
@@ -210,6 +268,18 @@ class ProgramCodeGenerator {
     return m.stream().str();
   }
 
+  void AddWeightsData(Module *m) {
+    for (auto &var : program_.blocks(0).vars()) {
+      if (var.persistable()) {
+        auto name = var.name();
+        if (name == "feed" || name == "fetch") continue;
+        const auto &tensor = exec_scope_.FindVar(name)->Get<lite::Tensor>();
+        TensorRepr repr;
+        TensorToRepr(tensor, &repr);
+        weight_names_[name] = m->AddWeightData(repr);
+      }
+    }
+  }
   void AddWeights(Module *m) {
     for (auto &var : program_.blocks(0).vars()) {
       if (var.persistable()) {
@@ -218,7 +288,7 @@ class ProgramCodeGenerator {
         const auto &tensor = exec_scope_.FindVar(name)->Get<lite::Tensor>();
         TensorRepr repr;
         TensorToRepr(tensor, &repr);
-        m->AddWeight(name, repr);
+        m->AddEmbeddedWeight(name, weight_names_.at(name), repr);
       }
     }
   }
@@ -229,28 +299,78 @@ class ProgramCodeGenerator {
       }
     }
   }
+  void AddStaticMemory(Module *m) {
+    if (static_vars_.empty()) return;
+    size_t arena_size = PlanStaticMemory(&static_vars_);
+    m->AddStaticMemory(static_vars_, arena_size);
+  }
   void AddOps(Module *m) {
+    auto descs = OpDescs();
+    if (!static_shapes_.empty()) {
+      m->AddStaticInputShapes(input_shapes_);
+    }
+    for (size_t i = 0; i < descs.size(); i++) {
+      m->AddOp(descs[i]);
+      if (!static_shapes_.empty()) {
+        m->AddStaticShapes(i, static_shapes_[i]);
+      }
+    }
+  }
+
+ private:
+  std::vector<cpp::OpDesc> OpDescs() const {
+    std::vector<cpp::OpDesc> descs;
     for (auto &pb_op : program_.blocks(0).ops()) {
       auto op = pb_op;
       lite::pb::OpDesc pb_desc(&op);
       lite::cpp::OpDesc cpp_desc;
       TransformOpDescAnyToCpp(pb_desc, &cpp_desc);
-      m->AddOp(cpp_desc);
+      descs.push_back(cpp_desc);
     }
+    return descs;
   }
 
- private:
+  // Run the program on the inputs of `input_shapes_` to record the output
+  // shapes of every op and the lifetimes and sizes of the temporary variables.
+  // The ops touching variables with LoD are left to InferShape, which
+  // propagates the LoD, and their variables out of the memory plan.
+  void RecordStaticShapes();
+
   void TensorToRepr(const lite::Tensor &tensor, TensorRepr *repr) {
     repr->ddim = tensor.dims();
-    // TODO(Superjomn) support other types.
-    repr->dtype = PRECISION(kFloat);
-    repr->raw_data = tensor.data<float>();
-    repr->num_bytes = repr->ddim.production() * sizeof(float);
+    repr->dtype = tensor.precision();
+    switch (repr->dtype) {
+      case PRECISION(kInt8):
+        repr->raw_data = tensor.data<int8_t>();
+        repr->num_bytes = repr->ddim.production() * sizeof(int8_t);
+        break;
+      case PRECISION(kInt16):
+        repr->raw_data = tensor.data<int16_t>();
+        repr->num_bytes = repr->ddim.production() * sizeof(int16_t);
+        break;
+      case PRECISION(kInt32):
+        repr->raw_data = tensor.data<int32_t>();
+        repr->num_bytes = repr->ddim.production() * sizeof(int32_t);
+        break;
+      case PRECISION(kInt64):
+        repr->raw_data = tensor.data<int64_t>();
+        repr->num_bytes = repr->ddim.production() * sizeof(int64_t);
+        break;
+      default:
+        repr->dtype = PRECISION(kFloat);
+        repr->raw_data = tensor.data<float>();
+        repr->num_bytes = repr->ddim.production() * sizeof(float);
+    }
   }
 
  private:
   const framework::proto::ProgramDesc &program_;
   const lite::Scope &exec_scope_;
+  const std::vector<std::vector<int64_t>> input_shapes_;
+  std::map<std::string, std::string> weight_names_;
+  // The output shapes of every op, empty if the input shapes are unknown.
+  std::vector<std::map<std::string, DDim>> static_shapes_;
+  std::vector<StaticVar> static_vars_;
 };
 
 }  // namespace gencode
@@ -131,10 +131,13 @@ TEST(gen_code, auto_gen) {
 
   module.AddWeight("w0", w0);
   module.AddWeight("w1", w1);
+  module.AddEmbeddedWeight("w1", module.AddWeightData(w1), w1);
   module.AddTmpVar("a");
   module.AddTmpVar("b");
 
+  module.AddStaticInputShapes({{2, 2}});
   module.AddOp(op0);
+  module.AddStaticShapes(0, {{"out0", DDim(std::vector<int64_t>({2, 2}))}});
 
   module.AddInitFuncEnd();
   module.AddNamespaceEnd();
@@ -142,6 +145,37 @@ TEST(gen_code, auto_gen) {
   LOG(INFO) << module.stream().str();
 }
 
+TEST(gen_code, static_memory_plan) {
+  std::vector<StaticVar> vars;
+  auto add_var = [&](const std::string &name, size_t size, int begin, int end) {
+    StaticVar var;
+    var.name = name;
+    var.size = size;
+    var.begin = begin;
+    var.end = end;
+    vars.push_back(var);
+  };
+  add_var("a", 100, 0, 1);
+  add_var("b", 200, 1, 2);
+  add_var("c", 100, 2, 3);
+  add_var("d", 50, 3, 4);
+  EXPECT_EQ(PlanStaticMemory(&vars), 356UL);
+  EXPECT_EQ(vars[0].offset, 256UL);
+  EXPECT_EQ(vars[1].offset, 0UL);
+  EXPECT_EQ(vars[2].offset, 256UL);
+  EXPECT_EQ(vars[3].offset, 0UL);
+
+  // The variables alive at the same time never overlap.
+  for (auto &x : vars) {
+    EXPECT_EQ(x.offset % 64, 0UL);
+    for (auto &y : vars) {
+      if (&x == &y || x.end < y.begin || y.end < x.begin) continue;
+      EXPECT_TRUE(x.offset + x.size <= y.offset ||
+                  y.offset + y.size <= x.offset);
+    }
+  }
+}
+
 TEST(gen_code, optimized_program) {
   lite::Scope scope;
   cpp::ProgramDesc cpp_desc;
@@ -13,18 +13,42 @@
 // limitations under the License.
 
 #include <gflags/gflags.h>
+#include <string>
+#include <vector>
+#include "lite/api/paddle_use_kernels.h"
+#include "lite/api/paddle_use_ops.h"
 #include "lite/gen_code/gen_code.h"
 #include "lite/model_parser/model_parser.h"
 #include "lite/model_parser/pb/program_desc.h"
+#include "lite/utils/string.h"
 
 DEFINE_string(optimized_model, "", "");
 DEFINE_string(generated_code_file, "__generated_code__.cc", "");
+DEFINE_string(input_shapes,
+              "",
+              "the fixed input shapes separated by colon and comma, such as "
+              "1,3,224,224:1,10, the shapes of all the tensors and the static "
+              "memory plan are generated if they are set.");
 
 namespace paddle {
 namespace lite {
 namespace gencode {
 
-void GenCode(const std::string& model_dir, const std::string& out_file) {
+std::vector<std::vector<int64_t>> ParseShapes(const std::string& str) {
+  std::vector<std::vector<int64_t>> shapes;
+  for (auto& shape_str : Split(str, ":")) {
+    std::vector<int64_t> shape;
+    for (auto& dim : Split(shape_str, ",")) {
+      shape.push_back(std::stoll(dim));
+    }
+    shapes.push_back(shape);
+  }
+  return shapes;
+}
+
+void GenCode(const std::string& model_dir,
+             const std::string& out_file,
+             const std::vector<std::vector<int64_t>>& input_shapes) {
   lite::Scope scope;
   cpp::ProgramDesc cpp_desc;
   std::string model_file = model_dir + "/model";
@@ -35,7 +59,7 @@ void GenCode(const std::string& model_dir, const std::string& out_file) {
   lite::pb::ProgramDesc pb_desc(&pb_proto_desc);
   TransformProgramDescCppToAny(cpp_desc, &pb_desc);
 
-  ProgramCodeGenerator codegen(pb_proto_desc, scope);
+  ProgramCodeGenerator codegen(pb_proto_desc, scope, input_shapes);
 
   std::ofstream file(out_file);
 
@@ -50,7 +74,9 @@ void GenCode(const std::string& model_dir, const std::string& out_file) {
 
 int main(int argc, char** argv) {
   gflags::ParseCommandLineFlags(&argc, &argv, false);
-  paddle::lite::gencode::GenCode(FLAGS_optimized_model,
-                                 FLAGS_generated_code_file);
+  paddle::lite::gencode::GenCode(
+      FLAGS_optimized_model,
+      FLAGS_generated_code_file,
+      paddle::lite::gencode::ParseShapes(FLAGS_input_shapes));
   return 0;
 }
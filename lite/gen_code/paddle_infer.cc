@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "lite/gen_code/paddle_infer.h"
+#include <utility>
 #include "lite/core/op_lite.h"
 #include "lite/core/tensor.h"
 
@@ -57,9 +58,17 @@ FOR_EACH_TYPE(IMPL_DATA);
 FOR_EACH_TYPE(IMPL_MUTABLE_DATA);
 #undef IMPL_MUTABLE_DATA
 
+// The shapes of the inputs the code was generated with, and the output
+// tensors of every op and their shapes.
+struct static_shapes_t {
+  std::vector<lite::DDim> inputs;
+  std::vector<std::vector<std::pair<lite::Tensor *, lite::DDim>>> outputs;
+};
+
 PaddlePredictor::PaddlePredictor() {
   raw_ops_ = new std::vector<std::shared_ptr<lite::OpLite>>;
   raw_kernels_ = new std::vector<std::unique_ptr<lite::KernelBase>>;
+  raw_static_shapes_ = new static_shapes_t;
   raw_scope_ = new lite::Scope;
   raw_exe_scope_ = &(static_cast<lite::Scope *>(raw_scope_)->NewScope());
 }
@@ -88,11 +97,14 @@ std::unique_ptr<Tensor> PaddlePredictor::GetMutableTensor(
       static_cast<std::vector<std::unique_ptr<lite::KernelBase>> *>( \
           raw_kernels_);
 #define CAST_SCOPE auto *scope = static_cast<lite::Scope *>(raw_scope_);
+#define CAST_STATIC_SHAPES \
+  auto *static_shapes = static_cast<static_shapes_t *>(raw_static_shapes_);
 
 PaddlePredictor::~PaddlePredictor() {
   CAST_OPS
   CAST_KERNELS
   CAST_SCOPE
+  CAST_STATIC_SHAPES
 
   if (ops) {
     delete ops;
@@ -100,22 +112,72 @@ PaddlePredictor::~PaddlePredictor() {
   if (kernels) {
     delete kernels;
   }
+  if (static_shapes) {
+    delete static_shapes;
+  }
   if (scope) {
     delete scope;
   }
 }
 
+void PaddlePredictor::AddStaticShape(size_t op_idx,
+                                     const std::string &var,
+                                     const std::vector<int64_t> &shape) {
+  CAST_STATIC_SHAPES
+  auto *exec_scope = static_cast<lite::Scope *>(raw_exe_scope_);
+  auto *tensor = exec_scope->Var(var)->GetMutable<lite::Tensor>();
+  auto &outputs = static_shapes->outputs;
+  if (outputs.size() <= op_idx) {
+    outputs.resize(op_idx + 1);
+  }
+  outputs.at(op_idx).emplace_back(tensor, lite::DDim(shape));
+}
+
+void PaddlePredictor::AddStaticInputShape(size_t offset,
+                                          const std::vector<int64_t> &shape) {
+  CAST_STATIC_SHAPES
+  auto &inputs = static_shapes->inputs;
+  if (inputs.size() <= offset) {
+    inputs.resize(offset + 1);
+  }
+  inputs.at(offset) = lite::DDim(shape);
+}
+
 void PaddlePredictor::Run() {
   CAST_OPS
   CAST_KERNELS
+  CAST_STATIC_SHAPES
 
   CHECK(ops);
   CHECK(kernels);
   CHECK_EQ(ops->size(), kernels->size());
 
+  // The static shapes and the memory plan only hold for the input shapes the
+  // code was generated with.
+  if (!static_shapes->inputs.empty()) {
+    auto *exec_scope = static_cast<lite::Scope *>(raw_exe_scope_);
+    const auto &feed_list =
+        exec_scope->FindVar("feed")->Get<std::vector<lite::Tensor>>();
+    CHECK_EQ(feed_list.size(), static_shapes->inputs.size())
+        << "the number of inputs differs from --input_shapes";
+    for (size_t i = 0; i < feed_list.size(); i++) {
+      CHECK(feed_list[i].dims() == static_shapes->inputs[i])
+          << "the shape of the input " << i << " is "
+          << feed_list[i].dims().repr() << ", but the code was generated with "
+          << static_shapes->inputs[i].repr();
+    }
+  }
+
+  const auto &outputs = static_shapes->outputs;
   for (size_t i = 0; i < ops->size(); i++) {
-    LOG(INFO) << "Running the " << i << "-th operator";
-    ops->at(i)->InferShape();
+    VLOG(4) << "Running the " << i << "-th operator";
+    if (i < outputs.size() && !outputs[i].empty()) {
+      for (auto &item : outputs[i]) {
+        item.first->Resize(item.second);
+      }
+    } else {
+      ops->at(i)->InferShape();
+    }
     kernels->at(i)->Launch();
   }
 }
@@ -62,8 +62,19 @@ class PaddlePredictor {
   ~PaddlePredictor();
 
  private:
+  // Set the shape of the output `var` of the `op_idx`-th op when it runs
+  // instead of running the InferShape of the op, which is called by the code
+  // generated with the input shapes given.
+  void AddStaticShape(size_t op_idx,
+                      const std::string &var,
+                      const std::vector<int64_t> &shape);
+  // Set the shape of the `offset`-th input the code was generated with, Run
+  // checks the inputs have it.
+  void AddStaticInputShape(size_t offset, const std::vector<int64_t> &shape);
+
   void *raw_ops_;
   void *raw_kernels_;
+  void *raw_static_shapes_;
   void *raw_scope_{};
   void *raw_exe_scope_{};  // raw_exe_scope is not owned.
 };
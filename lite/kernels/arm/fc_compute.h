@@ -115,6 +115,28 @@ class FcCompute : public KernelLite<TARGET(kARM), PType> {
 
   ~FcCompute() = default;
 
+ protected:
+  bool ShareWeights(const KernelBase& other) override {
+    const auto& src = static_cast<const FcCompute&>(other);
+    last_shape_ = src.last_shape_;
+    m_ = src.m_;
+    n_ = src.n_;
+    k_ = src.k_;
+    flag_gemm_ = src.flag_gemm_;
+    // The weights not transposed yet are transposed by this kernel on demand
+    // instead of writing to the shared ones.
+    if (src.flag_trans_weights_) {
+      weights_.ShareDataWith(src.weights_);
+      flag_trans_weights_ = true;
+    }
+    if (src.flag_trans_bias_) {
+      bias_.ShareDataWith(src.bias_);
+      flag_trans_bias_ = true;
+    }
+    scale_ = src.scale_;
+    return true;
+  }
+
  private:
   DDim last_shape_;
   Tensor weights_;
@@ -0,0 +1,87 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/kernels/x86/calib_compute.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "lite/core/op_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace x86 {
+
+TEST(calib_x86, retrive_op) {
+  auto calib =
+      KernelRegistry::Global()
+          .Create<TARGET(kX86), PRECISION(kInt8), DATALAYOUT(kNCHW)>("calib");
+  ASSERT_EQ(calib.size(), 2U);
+  ASSERT_TRUE(calib.front());
+}
+
+TEST(calib_x86, fp32_to_int8_to_fp32) {
+  lite::Tensor x, x_int8, out;
+  // cover both the SIMD loop and the tail
+  x.Resize({2, 3, 5, 7});
+  auto* x_data = x.mutable_data<float>();
+  for (int64_t i = 0; i < x.numel(); i++) {
+    x_data[i] = static_cast<float>(i % 29) * 0.37f - 5.f;
+  }
+  const float scale = 0.04f;
+
+  CalibComputeFp32ToInt8 quant;
+  operators::CalibParam quant_param;
+  quant_param.input = &x;
+  quant_param.output = &x_int8;
+  quant_param.scale = scale;
+  x_int8.Resize(x.dims());
+  std::unique_ptr<KernelContext> ctx(new KernelContext);
+  ctx->As<X86Context>();
+  quant.SetContext(std::move(ctx));
+  quant.SetParam(quant_param);
+  quant.Run();
+
+  CalibComputeInt8ToFp32 dequant;
+  operators::CalibParam dequant_param;
+  dequant_param.input = &x_int8;
+  dequant_param.output = &out;
+  dequant_param.scale = scale;
+  out.Resize(x.dims());
+  std::unique_ptr<KernelContext> ctx1(new KernelContext);
+  ctx1->As<X86Context>();
+  dequant.SetContext(std::move(ctx1));
+  dequant.SetParam(dequant_param);
+  dequant.Run();
+
+  auto* q_data = x_int8.data<int8_t>();
+  auto* out_data = out.data<float>();
+  for (int64_t i = 0; i < x.numel(); i++) {
+    float q = std::round(x_data[i] / scale);
+    q = std::min(std::max(q, -127.f), 127.f);
+    EXPECT_EQ(q_data[i], static_cast<int8_t>(q));
+    EXPECT_NEAR(out_data[i], q * scale, 1e-5);
+  }
+}
+
+}  // namespace x86
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
+
+USE_LITE_KERNEL(calib, kX86, kInt8, kNCHW, fp32_to_int8);
+USE_LITE_KERNEL(calib, kX86, kInt8, kNCHW, int8_to_fp32);
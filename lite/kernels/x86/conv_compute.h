@@ -14,11 +14,18 @@
 #pragma once
 
 #include <Eigen/Core>
+#include <algorithm>
 #include <string>
+#include <type_traits>
 #include <vector>
 #include "lite/backends/x86/math/blas.h"
+#include "lite/backends/x86/math/conv_direct.h"
+#include "lite/backends/x86/math/conv_winograd.h"
+#include "lite/backends/x86/math/gemm_s8.h"
+#include "lite/backends/x86/math/gemm_w16.h"
 #include "lite/backends/x86/math/im2col.h"
 #include "lite/backends/x86/math/vol2col.h"
+#include "lite/backends/x86/parallel.h"
 #include "lite/core/kernel.h"
 #include "lite/core/op_registry.h"
 #include "lite/core/types.h"
@@ -48,106 +55,597 @@ template <typename T>
 class Conv2dCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
  public:
   using param_t = operators::ConvParam;
+
+  void PrepareForRun() override {
+    auto& param = *param_.get_mutable<operators::ConvParam>();
+    impl_ = ChooseImpl(param);
+    const auto& filter_dims = param.filter->dims();
+    const int oc = static_cast<int>(filter_dims[0]);
+    const int ic = static_cast<int>(filter_dims[1]);
+    if (!param.weight_quant_type.empty()) {
+      DequantizeFilter(param);
+    }
+    const float* filter_data = FilterData(param);
+    // The weights are transformed only once, the filter must be persistable.
+    if (impl_ == kWinograd) {
+      const auto& out_dims = param.output->dims();
+      // F(6, 3) saves more multiplications but has more transform overhead
+      // and padding waste on the small images.
+      winograd_m_ = (out_dims[2] >= 24 && out_dims[3] >= 24) ? 6 : 4;
+      if (algorithm_ == "winograd_f4" || algorithm_ == "winograd_f6") {
+        winograd_m_ = algorithm_ == "winograd_f4" ? 4 : 6;
+      }
+      trans_weights_.Resize({static_cast<int64_t>(
+          lite::x86::math::conv_winograd_weights_size(oc, ic, winograd_m_))});
+      lite::x86::math::conv_winograd_transform_weights(
+          filter_data,
+          oc,
+          ic,
+          winograd_m_,
+          trans_weights_.mutable_data<float>());
+    } else if (impl_ == kDirect) {
+      const int kh = static_cast<int>(filter_dims[2]);
+      const int kw = static_cast<int>(filter_dims[3]);
+      trans_weights_.Resize({static_cast<int64_t>(
+          lite::x86::math::conv_direct_packed_weights_size(oc, ic, kh, kw))});
+      lite::x86::math::conv_direct_pack_weights(
+          filter_data, oc, ic, kh, kw, trans_weights_.mutable_data<float>());
+    }
+    // The transformed weights are all the winograd and direct ones read.
+    if (impl_ == kWinograd || impl_ == kDirect) {
+      float_filter_.clear();
+    }
+  }
+
   void Run() override {
-    auto& context = ctx_->As<X86Context>();
     auto& param = *param_.get_mutable<operators::ConvParam>();
-    lite::Tensor filter = *param.filter;
-    param.output->mutable_data<T>();
-    const int batch_size = static_cast<int>(param.x->dims()[0]);
+    switch (impl_) {
+      case kWinograd:
+        RunWinograd(param);
+        break;
+      case kDirect:
+        RunDirect(param);
+        break;
+      case kDepthwiseS1:
+        RunDepthwiseS1(param);
+        break;
+      case kDepthwise:
+        RunDepthwise(param);
+        break;
+      default:
+        RunGemm(param);
+        break;
+    }
+  }
+
+  // "winograd_f4" and "winograd_f6" are the winograd convolutions F(4, 3) and
+  // F(6, 3).
+  std::vector<std::string> Algorithms() const override {
+    const auto& param = *param_.get_mutable<operators::ConvParam>();
+    const auto& filter_dims = param.filter->dims();
+    if (filter_dims.size() != 4U) {
+      return {};
+    }
+    const int ic = static_cast<int>(param.x->dims()[1]);
+    const auto& dilations = *param.dilations;
+    const auto& strides = param.strides;
+    const bool no_dilation = dilations[0] == 1 && dilations[1] == 1;
+    const bool stride_1 = strides[0] == 1 && strides[1] == 1;
+    std::vector<std::string> algorithms{"gemm"};
+    if (ic / param.groups == 1) {
+      algorithms.push_back("depthwise");
+      if (stride_1 && no_dilation) {
+        algorithms.push_back("depthwise_s1");
+      }
+    } else if (param.groups == 1 && no_dilation) {
+      if (filter_dims[2] == 3 && filter_dims[3] == 3 && stride_1) {
+        algorithms.push_back("winograd_f4");
+        algorithms.push_back("winograd_f6");
+      }
+      if (lite::x86::math::conv_direct_block() > 1) {
+        algorithms.push_back("direct");
+      }
+    }
+    return algorithms;
+  }
+
+  virtual ~Conv2dCompute() = default;
+
+ protected:
+  bool ShareWeights(const KernelBase& other) override {
+    const auto& src = static_cast<const Conv2dCompute&>(other);
+    impl_ = src.impl_;
+    winograd_m_ = src.winograd_m_;
+    trans_weights_.ShareDataWith(src.trans_weights_);
+    float_filter_.ShareDataWith(src.float_filter_);
+    return true;
+  }
+
+ private:
+  enum ConvImpl { kGemm, kDepthwise, kDepthwiseS1, kDirect, kWinograd };
+
+  // Convert the filter stored in 16 bits by the weight_half_quantization_pass
+  // into float_filter_ once.
+  void DequantizeFilter(const operators::ConvParam& param) {
+    CHECK(param.filter->precision() == PRECISION(kInt16));
+    float_filter_.Resize(param.filter->dims());
+    lite::x86::math::w16_to_float(
+        lite::x86::math::GetW16Type(param.weight_quant_type),
+        reinterpret_cast<const uint16_t*>(param.filter->data<int16_t>()),
+        static_cast<int>(float_filter_.numel()),
+        float_filter_.mutable_data<float>());
+  }
+
+  const float* FilterData(const operators::ConvParam& param) const {
+    return param.weight_quant_type.empty() ? param.filter->data<float>()
+                                           : float_filter_.data<float>();
+  }
 
-    std::vector<int64_t> filter_shape_vec(filter.dims().Vectorize());
-    std::vector<int64_t> output_shape_vec(param.output->dims().Vectorize());
+  ConvImpl ChooseImpl(const operators::ConvParam& param) {
+    if (!algorithm_.empty()) {
+      auto algorithms = Algorithms();
+      if (std::find(algorithms.begin(), algorithms.end(), algorithm_) !=
+          algorithms.end()) {
+        if (algorithm_ == "depthwise") return kDepthwise;
+        if (algorithm_ == "depthwise_s1") return kDepthwiseS1;
+        if (algorithm_ == "direct") return kDirect;
+        if (algorithm_ != "gemm") return kWinograd;
+        return kGemm;
+      }
+      // e.g. the direct convolution tuned with SIMD running on a CPU without.
+      LOG(WARNING) << "The conv2d algorithm " << algorithm_
+                   << " is not supported here, use the default one.";
+    }
+    const auto& x_dims = param.x->dims();
+    const auto& filter_dims = param.filter->dims();
+    if (filter_dims.size() != 4U) {
+      return kGemm;
+    }
+    const int ic = static_cast<int>(x_dims[1]);
+    const int oc = static_cast<int>(filter_dims[0]);
+    const int kh = static_cast<int>(filter_dims[2]);
+    const int kw = static_cast<int>(filter_dims[3]);
+    const auto& dilations = *param.dilations;
+    const auto& strides = param.strides;
+    const bool no_dilation = dilations[0] == 1 && dilations[1] == 1;
+    const bool stride_1 = strides[0] == 1 && strides[1] == 1;
+    // Every output channel of the depthwise convolutions only depends on one
+    // input channel, the tiny GEMMs are much slower than the direct loops.
+    if (ic / param.groups == 1) {
+      return stride_1 && no_dilation ? kDepthwiseS1 : kDepthwise;
+    }
+    if (param.groups != 1 || !no_dilation) {
+      return kGemm;
+    }
+    // The transforms of the winograd and the direct convolutions use the same
+    // vectors, they are slower than the GEMMs without SIMD.
+    const bool simd = lite::x86::math::conv_direct_block() > 1;
+    if (simd && kh == 3 && kw == 3 && stride_1 && ic >= 8 && oc >= 8) {
+      return kWinograd;
+    }
+    // The direct convolutions avoid the im2col of the small channels, where
+    // the GEMMs are memory bound.
+    const int64_t image = x_dims[2] * x_dims[3];
+    const bool stride_2 = strides[0] == 2 && strides[1] == 2;
+    if (simd && kh == 3 && kw == 3 &&
+        (stride_1 || (stride_2 && ic * oc < 4 * image))) {
+      return kDirect;
+    }
+    return kGemm;
+  }
+
+  void RunWinograd(const operators::ConvParam& param) {
+    auto& context = ctx_->As<X86Context>();
+    const auto& x_dims = param.x->dims();
+    const auto& out_dims = param.output->dims();
+    const int ic = static_cast<int>(x_dims[1]);
+    const int oc = static_cast<int>(out_dims[1]);
+    workspace_.Resize({static_cast<int64_t>(
+        lite::x86::math::conv_winograd_workspace_size(oc, ic, winograd_m_))});
+    lite::x86::math::conv_winograd_fp32(param.x->data<float>(),
+                                        param.output->mutable_data<float>(),
+                                        x_dims[0],
+                                        oc,
+                                        out_dims[2],
+                                        out_dims[3],
+                                        ic,
+                                        x_dims[2],
+                                        x_dims[3],
+                                        trans_weights_.data<float>(),
+                                        winograd_m_,
+                                        (*param.paddings)[0],
+                                        (*param.paddings)[2],
+                                        workspace_.mutable_data<float>(),
+                                        context);
+  }
+
+  void RunDirect(const operators::ConvParam& param) {
+    const auto& x_dims = param.x->dims();
+    const auto& out_dims = param.output->dims();
+    workspace_.Resize({static_cast<int64_t>(
+        lite::x86::math::conv_direct_workspace_size(param))});
+    lite::x86::math::conv_direct_fp32(param.x->data<float>(),
+                                      param.output->mutable_data<float>(),
+                                      x_dims[0],
+                                      out_dims[1],
+                                      out_dims[2],
+                                      out_dims[3],
+                                      x_dims[1],
+                                      x_dims[2],
+                                      x_dims[3],
+                                      trans_weights_.data<float>(),
+                                      param,
+                                      workspace_.mutable_data<float>());
+  }
+
+  void RunDepthwiseS1(const operators::ConvParam& param) {
+    const auto& x_dims = param.x->dims();
+    const auto& out_dims = param.output->dims();
+    lite::x86::math::conv_depthwise_s1_fp32(param.x->data<float>(),
+                                            param.output->mutable_data<float>(),
+                                            x_dims[0],
+                                            out_dims[1],
+                                            out_dims[2],
+                                            out_dims[3],
+                                            x_dims[1],
+                                            x_dims[2],
+                                            x_dims[3],
+                                            FilterData(param),
+                                            param);
+  }
+
+  void RunGemm(const operators::ConvParam& param) {
+    auto& context = ctx_->As<X86Context>();
+    const auto& x_dims = param.x->dims();
+    const auto& out_dims = param.output->dims();
+    const int batch_size = static_cast<int>(x_dims[0]);
+    const int groups = param.groups;
+
+    std::vector<int64_t> filter_shape_vec(param.filter->dims().Vectorize());
+    std::vector<int64_t> output_shape_vec(out_dims.Vectorize());
     size_t data_dim = filter_shape_vec.size() - 2;
     std::vector<int64_t> col_shape_vec(1 + 2 * data_dim);
-    col_shape_vec[0] = param.x->dims()[1] / param.groups;
+    col_shape_vec[0] = x_dims[1] / groups;
     for (size_t j = 0; j < data_dim; ++j) {
       col_shape_vec[j + 1] = filter_shape_vec[j + 2];
       col_shape_vec[j + 1 + data_dim] = output_shape_vec[j + 2];
     }
     lite::DDim col_shape(col_shape_vec);
-    lite::DDim col_matrix_shape = col_shape.Flatten2D(data_dim + 1);
     bool is_expand = IsExpand(
         filter_shape_vec, param.strides, *param.paddings, *param.dilations);
-    lite::Tensor col;
-    lite::Tensor col_matrix;
+    lite::DDim input_shape = x_dims.Slice(1, x_dims.size());
+
+    const int in_step = static_cast<int>(x_dims[1]) / groups;
+    const int out_step = static_cast<int>(out_dims[1]) / groups;
+    // The GEMM of every group is [out_step, k] x [k, n].
+    const int k = static_cast<int>(param.filter->dims().production() /
+                                   param.filter->dims()[0]);
+    const int n = static_cast<int>(out_dims.production() /
+                                   (out_dims[0] * out_dims[1]));
+    const T* filter_data = FilterData(param);
+    T* out_data = param.output->mutable_data<T>();
+
+    // Run the (batch, group) pairs in parallel if there are enough of them,
+    // otherwise the output channels of each pair are split among threads.
+    const int num_items = batch_size * groups;
+    const int num_threads = static_cast<int>(lite::x86::GetMaxThreads());
+    const int num_tasks = num_items >= num_threads ? num_threads : 1;
     if (is_expand) {
+      // Every task owns a slice of the scratch, which is only reallocated when
+      // it grows.
+      col_buffer_.Resize({num_tasks, col_shape.production()});
+      col_buffer_.mutable_data<T>();
+    }
+
+    auto im2col = [&](int item, int task) -> const T* {
+      int b = item / groups;
+      int g = item % groups;
+      lite::Tensor in_batch = param.x->Slice<T>(b, b + 1);
+      in_batch.Resize(input_shape);
+      lite::Tensor in_slice =
+          in_batch.Slice<T>(static_cast<int64_t>(g * in_step),
+                            static_cast<int64_t>((g + 1) * in_step));
+      if (!is_expand) {
+        return in_slice.data<T>();
+      }
+      lite::Tensor col = col_buffer_.Slice<T>(task, task + 1);
       col.Resize(col_shape);
-      col.mutable_data<T>();
-      col_matrix.ShareDataWith(col);
-      col_matrix.Resize(col_matrix_shape);
-    }
-    lite::DDim input_shape = param.x->dims().Slice(1, param.x->dims().size());
-    lite::DDim filter_matrix_shape(std::vector<int64_t>{
-        filter.dims()[0], filter.dims().production() / filter.dims()[0]});
-    filter.Resize(filter_matrix_shape);
-    lite::DDim output_matrix_shape(std::vector<int64_t>{
-        param.output->dims()[1],
-        param.output->dims().production() /
-            (param.output->dims()[0] * param.output->dims()[1])});
-    int in_step = static_cast<int>(param.x->dims()[1]) / param.groups;
-    int out_step = static_cast<int>(param.output->dims()[1]) / param.groups;
-    paddle::lite::x86::math::Vol2ColFunctor<lite::TargetType::kX86, T> vol2col;
-    paddle::lite::x86::math::Im2ColFunctor<
-        paddle::lite::x86::math::ColFormat::kCFO,
-        lite::TargetType::kX86,
-        T>
-        im2col;
+      const auto& paddings = *param.paddings;
+      if (data_dim == 2U) {
+        paddle::lite::x86::math::Im2ColFunctor<
+            paddle::lite::x86::math::ColFormat::kCFO,
+            lite::TargetType::kX86,
+            T>
+            im2col_func;
+        im2col_func(context,
+                    in_slice,
+                    *param.dilations,
+                    param.strides,
+                    std::vector<int>{
+                        paddings[0], paddings[2], paddings[0], paddings[2]},
+                    &col);
+      } else if (data_dim == 3U) {
+        paddle::lite::x86::math::Vol2ColFunctor<lite::TargetType::kX86, T>
+            vol2col_func;
+        vol2col_func(context,
+                     in_slice,
+                     *param.dilations,
+                     param.strides,
+                     paddings,
+                     &col);
+      }
+      return col.data<T>();
+    };
     auto blas =
         paddle::lite::x86::math::GetBlas<lite::TargetType::kX86, T>(context);
-    for (int i = 0; i < batch_size; i++) {
-      lite::Tensor in_batch = param.x->Slice<T>(i, i + 1);
-      in_batch.Resize(input_shape);
-      lite::Tensor out_batch = param.output->Slice<T>(i, i + 1);
-      out_batch.Resize(output_matrix_shape);
-      for (int g = 0; g < param.groups; g++) {
-        lite::Tensor in_slice =
-            in_batch.Slice<T>(static_cast<int64_t>(g * in_step),
-                              static_cast<int64_t>((g + 1) * in_step));
-        auto paddings = *param.paddings;
-        if (!is_expand) {
-          col.ShareDataWith(in_slice);
-          col_matrix.ShareDataWith(col);
-          col_matrix.Resize(col_matrix_shape);
-        } else if (data_dim == 2U) {
-          // im2col
-          im2col(context,
-                 in_slice,
-                 *param.dilations,
-                 param.strides,
-                 std::vector<int>{
-                     paddings[0], paddings[2], paddings[0], paddings[2]},
-                 &(col));
-        } else if (data_dim == 3U) {
-          // vol2col
-          vol2col(context,
-                  in_slice,
-                  *param.dilations,
-                  param.strides,
-                  *param.paddings,
-                  &(col));
-        }
+    auto gemm = [&](int item, const T* col_data, int oc_begin, int oc_end) {
+      int b = item / groups;
+      int g = item % groups;
+      int oc = g * out_step + oc_begin;
+      blas.GEMM(false,
+                false,
+                oc_end - oc_begin,
+                n,
+                k,
+                T(1.0),
+                filter_data + oc * k,
+                k,
+                col_data,
+                n,
+                T(0.0),
+                out_data + (b * out_dims[1] + oc) * n,
+                n);
+    };
 
-        // gemm
-        lite::Tensor out_slice;
-        out_slice =
-            out_batch.Slice<T>(static_cast<int64_t>(g * out_step),
-                               static_cast<int64_t>((g + 1) * out_step));
-        lite::Tensor filter_slice;
-        filter_slice =
-            filter.Slice<T>(static_cast<int64_t>(g * out_step),
-                            static_cast<int64_t>((g + 1) * out_step));
-        blas.MatMul(filter_slice,
-                    false,
-                    col_matrix,
-                    false,
-                    T(1.0),
-                    &(out_slice),
-                    T(0.0));
+    if (num_tasks > 1) {
+      int items_per_task = (num_items + num_tasks - 1) / num_tasks;
+      lite::x86::RunParallelFor(
+          0, num_tasks, [&](int64_t begin, int64_t end) {
+            for (int64_t task = begin; task < end; ++task) {
+              int item_end = std::min(num_items,
+                                      static_cast<int>(task + 1) *
+                                          items_per_task);
+              for (int item = task * items_per_task; item < item_end;
+                   ++item) {
+                gemm(item, im2col(item, task), 0, out_step);
+              }
+            }
+          });
+    } else {
+      for (int item = 0; item < num_items; ++item) {
+        const T* col_data = im2col(item, 0);
+        lite::x86::RunParallelFor(
+            0, out_step, [&](int64_t begin, int64_t end) {
+              gemm(item, col_data, begin, end);
+            });
       }
     }
   }
 
-  virtual ~Conv2dCompute() = default;
+  void RunDepthwise(const operators::ConvParam& param) {
+    const auto& x_dims = param.x->dims();
+    const auto& out_dims = param.output->dims();
+    const auto& filter_dims = param.filter->dims();
+    const int channels = static_cast<int>(x_dims[1]);
+    const int ih = static_cast<int>(x_dims[2]);
+    const int iw = static_cast<int>(x_dims[3]);
+    const int out_channels = static_cast<int>(out_dims[1]);
+    const int oh = static_cast<int>(out_dims[2]);
+    const int ow = static_cast<int>(out_dims[3]);
+    const int kh = static_cast<int>(filter_dims[2]);
+    const int kw = static_cast<int>(filter_dims[3]);
+    // The output channels of an input channel when the multiplier is not 1.
+    const int multiplier = out_channels / channels;
+    const int stride_h = param.strides[0];
+    const int stride_w = param.strides[1];
+    const int pad_top = (*param.paddings)[0];
+    const int pad_left = (*param.paddings)[2];
+    const int dilation_h = (*param.dilations)[0];
+    const int dilation_w = (*param.dilations)[1];
+
+    const T* x_data = param.x->data<T>();
+    const T* filter_data = FilterData(param);
+    T* out_data = param.output->mutable_data<T>();
+    lite::x86::RunParallelFor(
+        0, x_dims[0] * out_channels, [&](int64_t begin, int64_t end) {
+          for (int64_t idx = begin; idx < end; ++idx) {
+            int64_t b = idx / out_channels;
+            int c = static_cast<int>(idx % out_channels) / multiplier;
+            const T* in = x_data + (b * channels + c) * ih * iw;
+            const T* w = filter_data + (idx % out_channels) * kh * kw;
+            T* out = out_data + idx * oh * ow;
+            for (int h = 0; h < oh; ++h) {
+              for (int x = 0; x < ow; ++x) {
+                T sum = T(0);
+                for (int i = 0; i < kh; ++i) {
+                  int in_h = h * stride_h - pad_top + i * dilation_h;
+                  if (in_h < 0 || in_h >= ih) continue;
+                  for (int j = 0; j < kw; ++j) {
+                    int in_w = x * stride_w - pad_left + j * dilation_w;
+                    if (in_w < 0 || in_w >= iw) continue;
+                    sum += in[in_h * iw + in_w] * w[i * kw + j];
+                  }
+                }
+                out[h * ow + x] = sum;
+              }
+            }
+          }
+        });
+  }
+
+  ConvImpl impl_{kGemm};
+  int winograd_m_{4};
+  // The winograd transformed or the packed weights of the direct convolution.
+  lite::Tensor trans_weights_;
+  // The zero padded input or the winograd transformed tiles.
+  lite::Tensor workspace_;
+  // The im2col scratch of the tasks running in parallel.
+  lite::Tensor col_buffer_;
+  // The float filter of the gemm and depthwise convolutions if it is stored in
+  // 16 bits.
+  lite::Tensor float_filter_;
+};
+
+/// The int8 convolution, the input and the filter are int8 and the output is
+/// dequantized to float, or requantized to int8 with the output scale.
+template <PrecisionType OutType>
+class Conv2dInt8Compute : public KernelLite<TARGET(kX86), PRECISION(kInt8)> {
+ public:
+  using param_t = operators::ConvParam;
+  using out_t = typename std::
+      conditional<OutType == PRECISION(kInt8), int8_t, float>::type;
+
+  void PrepareForRun() override {
+    auto& param = *param_.get_mutable<operators::ConvParam>();
+    const int oc = static_cast<int>(param.filter->dims()[0]);
+    scale_ = param.weight_scale;
+    CHECK(scale_.size() == 1U || static_cast<int>(scale_.size()) == oc)
+        << "weights scale size must equal to filter size";
+    scale_.resize(oc, scale_[0]);
+    float out_scale = OutType == PRECISION(kInt8) ? param.output_scale : 1.f;
+    for (auto& ws : scale_) {
+      ws = ws * param.input_scale / out_scale;
+    }
+    if (param.bias) {
+      bias_.resize(param.bias->numel());
+      const float* bias_data = param.bias->data<float>();
+      for (size_t i = 0; i < bias_.size(); ++i) {
+        bias_[i] = bias_data[i] / out_scale;
+      }
+    }
+  }
+
+  void Run() override {
+    auto& param = *param_.get_mutable<operators::ConvParam>();
+    const auto& x_dims = param.x->dims();
+    const auto& out_dims = param.output->dims();
+    const auto& filter_dims = param.filter->dims();
+    const int groups = param.groups;
+    const int in_step = static_cast<int>(x_dims[1]) / groups;
+    const int out_step = static_cast<int>(out_dims[1]) / groups;
+    const int k = in_step * static_cast<int>(filter_dims[2] * filter_dims[3]);
+    const int n = static_cast<int>(out_dims[2] * out_dims[3]);
+    const int in_size = static_cast<int>(x_dims[2] * x_dims[3]);
+    const bool is_relu = param.fuse_relu ||
+                         (param.activation_param.has_active &&
+                          param.activation_param.active_type ==
+                              lite_api::ActivationType::kRelu);
+    const int8_t* x_data = param.x->data<int8_t>();
+    const int8_t* filter_data = param.filter->data<int8_t>();
+    out_t* out_data = param.output->mutable_data<out_t>();
+
+    // Like the float kernel, the (batch, group) pairs run in parallel if
+    // there are enough of them, otherwise the GEMM is split among threads.
+    const int num_items = static_cast<int>(x_dims[0]) * groups;
+    const int num_threads = static_cast<int>(lite::x86::GetMaxThreads());
+    const int num_tasks = num_items >= num_threads ? num_threads : 1;
+    col_buffer_.Resize({num_tasks, n * k});
+    int8_t* col_data = col_buffer_.mutable_data<int8_t>();
+
+    auto compute = [&](int item, int task) {
+      int b = item / groups;
+      int g = item % groups;
+      int8_t* col = col_data + task * n * k;
+      Im2ColNK(x_data + (b * groups + g) * in_step * in_size,
+               in_step,
+               x_dims[2],
+               x_dims[3],
+               out_dims[2],
+               out_dims[3],
+               filter_dims[2],
+               filter_dims[3],
+               param,
+               col,
+               num_tasks == 1);
+      int oc = g * out_step;
+      lite::x86::math::gemm_s8<out_t>(
+          out_step,
+          n,
+          k,
+          filter_data + oc * k,
+          k,
+          col,
+          k,
+          out_data + (b * out_dims[1] + oc) * n,
+          n,
+          scale_.data() + oc,
+          bias_.empty() ? nullptr : bias_.data() + oc,
+          true,
+          is_relu);
+    };
+    if (num_tasks > 1) {
+      int items_per_task = (num_items + num_tasks - 1) / num_tasks;
+      lite::x86::RunParallelFor(
+          0, num_tasks, [&](int64_t begin, int64_t end) {
+            for (int64_t task = begin; task < end; ++task) {
+              int item_end = std::min(
+                  num_items, static_cast<int>(task + 1) * items_per_task);
+              for (int item = task * items_per_task; item < item_end;
+                   ++item) {
+                compute(item, task);
+              }
+            }
+          });
+    } else {
+      for (int item = 0; item < num_items; ++item) {
+        compute(item, 0);
+      }
+    }
+  }
+
+  virtual ~Conv2dInt8Compute() = default;
+
+ private:
+  // im2col to [oh * ow, channels * kh * kw], the K contiguous layout of the
+  // int8 GEMM.
+  static void Im2ColNK(const int8_t* in,
+                       int channels,
+                       int ih,
+                       int iw,
+                       int oh,
+                       int ow,
+                       int kh,
+                       int kw,
+                       const operators::ConvParam& param,
+                       int8_t* col,
+                       bool parallel) {
+    const int stride_h = param.strides[0];
+    const int stride_w = param.strides[1];
+    const int pad_top = (*param.paddings)[0];
+    const int pad_left = (*param.paddings)[2];
+    const int dilation_h = (*param.dilations)[0];
+    const int dilation_w = (*param.dilations)[1];
+    const int k = channels * kh * kw;
+    auto fill_rows = [&](int64_t begin, int64_t end) {
+      for (int64_t h = begin; h < end; ++h) {
+        for (int w = 0; w < ow; ++w) {
+          int8_t* dst = col + (h * ow + w) * k;
+          for (int c = 0; c < channels; ++c) {
+            const int8_t* src = in + c * ih * iw;
+            for (int i = 0; i < kh; ++i) {
+              int y = h * stride_h - pad_top + i * dilation_h;
+              for (int j = 0; j < kw; ++j) {
+                int x = w * stride_w - pad_left + j * dilation_w;
+                *(dst++) = (y < 0 || y >= ih || x < 0 || x >= iw)
+                               ? 0
+                               : src[y * iw + x];
+              }
+            }
+          }
+        }
+      }
+    };
+    if (parallel) {
+      lite::x86::RunParallelFor(0, oh, fill_rows);
+    } else {
+      fill_rows(0, oh);
+    }
+  }
+
+  std::vector<float> scale_;
+  std::vector<float> bias_;
+  // The im2col scratch of the tasks running in parallel.
+  lite::Tensor col_buffer_;
 };
 
 }  // namespace x86
@@ -14,10 +14,15 @@
 
 #include "lite/kernels/x86/conv_compute.h"
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
+#include "lite/backends/x86/parallel.h"
 #include "lite/core/op_registry.h"
+#include "lite/utils/half.h"
 
 namespace paddle {
 namespace lite {
@@ -92,6 +97,364 @@ TEST(conv2d_x86, run_test) {
   }
 }
 
+static void conv2d_ref(const lite::Tensor& x,
+                       const lite::Tensor& filter,
+                       int groups,
+                       const std::vector<int>& strides,
+                       const std::vector<int>& paddings,
+                       const std::vector<int>& dilations,
+                       lite::Tensor* out) {
+  auto x_dims = x.dims();
+  auto w_dims = filter.dims();
+  auto out_dims = out->dims();
+  int in_step = x_dims[1] / groups;
+  int out_step = out_dims[1] / groups;
+  const float* x_data = x.data<float>();
+  const float* w_data = filter.data<float>();
+  float* out_data = out->mutable_data<float>();
+  for (int n = 0; n < out_dims[0]; n++) {
+    for (int oc = 0; oc < out_dims[1]; oc++) {
+      int g = oc / out_step;
+      for (int oh = 0; oh < out_dims[2]; oh++) {
+        for (int ow = 0; ow < out_dims[3]; ow++) {
+          float sum = 0.f;
+          for (int ic = 0; ic < in_step; ic++) {
+            for (int kh = 0; kh < w_dims[2]; kh++) {
+              for (int kw = 0; kw < w_dims[3]; kw++) {
+                int ih = oh * strides[0] - paddings[0] + kh * dilations[0];
+                int iw = ow * strides[1] - paddings[2] + kw * dilations[1];
+                if (ih < 0 || ih >= x_dims[2] || iw < 0 || iw >= x_dims[3]) {
+                  continue;
+                }
+                int c = g * in_step + ic;
+                sum += x_data[((n * x_dims[1] + c) * x_dims[2] + ih) *
+                                  x_dims[3] +
+                              iw] *
+                       w_data[((oc * in_step + ic) * w_dims[2] + kh) *
+                                  w_dims[3] +
+                              kw];
+              }
+            }
+          }
+          out_data[((n * out_dims[1] + oc) * out_dims[2] + oh) * out_dims[3] +
+                   ow] = sum;
+        }
+      }
+    }
+  }
+}
+
+static void test_conv2d(int batch_size,
+                        int ic,
+                        int oc,
+                        int groups,
+                        int ksize,
+                        int stride,
+                        int pad,
+                        int dilation,
+                        int ih = 9,
+                        int iw = 7,
+                        const std::string& weight_quant_type = "",
+                        const std::string& algorithm = "") {
+  int oh = (ih + 2 * pad - dilation * (ksize - 1) - 1) / stride + 1;
+  int ow = (iw + 2 * pad - dilation * (ksize - 1) - 1) / stride + 1;
+  lite::Tensor x, filter, out, out_ref;
+  x.Resize({batch_size, ic, ih, iw});
+  filter.Resize({oc, ic / groups, ksize, ksize});
+  out.Resize({batch_size, oc, oh, ow});
+  out_ref.Resize({batch_size, oc, oh, ow});
+  auto x_data = x.mutable_data<float>();
+  auto filter_data = filter.mutable_data<float>();
+  for (int64_t i = 0; i < x.numel(); i++) {
+    x_data[i] = static_cast<float>(i % 13) * 0.1f - 0.5f;
+  }
+  for (int64_t i = 0; i < filter.numel(); i++) {
+    filter_data[i] = static_cast<float>(i % 7) * 0.2f - 0.6f;
+  }
+  // The filter in 16 bits, the reference uses its float values.
+  lite::Tensor filter_w16;
+  if (!weight_quant_type.empty()) {
+    filter_w16.Resize(filter.dims());
+    auto w16_data = filter_w16.mutable_data<int16_t>();
+    for (int64_t i = 0; i < filter.numel(); i++) {
+      if (weight_quant_type == "fp16") {
+        w16_data[i] = static_cast<int16_t>(FloatToHalf(filter_data[i]));
+        filter_data[i] = HalfToFloat(static_cast<uint16_t>(w16_data[i]));
+      } else {
+        w16_data[i] = static_cast<int16_t>(FloatToBFloat16(filter_data[i]));
+        filter_data[i] = BFloat16ToFloat(static_cast<uint16_t>(w16_data[i]));
+      }
+    }
+    filter_w16.set_precision(PRECISION(kInt16));
+  }
+
+  operators::ConvParam param;
+  param.x = &x;
+  param.filter = weight_quant_type.empty() ? &filter : &filter_w16;
+  param.weight_quant_type = weight_quant_type;
+  param.output = &out;
+  param.strides = {stride, stride};
+  std::vector<int> paddings = {pad, pad, pad, pad};
+  std::vector<int> dilations = {dilation, dilation};
+  param.groups = groups;
+  param.paddings = std::make_shared<std::vector<int>>(paddings);
+  param.dilations = std::make_shared<std::vector<int>>(dilations);
+
+  Conv2dCompute<float> conv2d;
+  std::unique_ptr<KernelContext> ctx(new KernelContext);
+  ctx->As<X86Context>();
+  conv2d.SetContext(std::move(ctx));
+  conv2d.SetParam(param);
+  conv2d.set_algorithm(algorithm);
+  conv2d.PrepareForRun();
+  // The filter in 16 bits is only dequantized by PrepareForRun.
+  if (!weight_quant_type.empty()) {
+    std::fill_n(filter_w16.mutable_data<int16_t>(), filter_w16.numel(), 0);
+  }
+  // Run twice to check the reuse of the scratch.
+  conv2d.Run();
+  conv2d.Run();
+
+  conv2d_ref(x, filter, groups, param.strides, paddings, dilations, &out_ref);
+  auto out_data = out.data<float>();
+  auto out_ref_data = out_ref.data<float>();
+  // The winograd transforms lose some precision on the large sums.
+  for (int64_t i = 0; i < out.numel(); i++) {
+    EXPECT_NEAR(out_data[i],
+                out_ref_data[i],
+                1e-4 * std::max(1.f, std::abs(out_ref_data[i]) * 10.f));
+  }
+}
+
+TEST(conv2d_x86, parallel) {
+  lite::x86::SetNumThreads(4);
+  for (int batch_size : {1, 5}) {
+    // split the output channels or the (batch, group) pairs among threads
+    test_conv2d(batch_size, 4, 8, 1, 3, 1, 1, 1);
+    test_conv2d(batch_size, 4, 6, 2, 3, 2, 0, 1);
+    test_conv2d(batch_size, 6, 9, 3, 1, 1, 0, 1);
+    // depthwise
+    test_conv2d(batch_size, 4, 4, 4, 3, 1, 1, 1);
+    test_conv2d(batch_size, 4, 8, 4, 3, 2, 1, 2);
+  }
+  lite::x86::SetNumThreads(1);
+}
+
+TEST(conv2d_x86, winograd) {
+  lite::x86::SetNumThreads(2);
+  for (int batch_size : {1, 2}) {
+    // F(4, 3) on the small images, the tiles cross the borders
+    test_conv2d(batch_size, 8, 8, 1, 3, 1, 1, 1);
+    test_conv2d(batch_size, 16, 12, 1, 3, 1, 0, 1, 11, 13);
+    // F(6, 3) with more tiles than a block
+    test_conv2d(batch_size, 8, 16, 1, 3, 1, 1, 1, 70, 30);
+  }
+  lite::x86::SetNumThreads(1);
+}
+
+TEST(conv2d_x86, half_weights) {
+  for (std::string quant_type : {"fp16", "bf16"}) {
+    // gemm, depthwise, depthwise of stride 1, winograd and direct
+    test_conv2d(1, 4, 6, 2, 3, 2, 0, 1, 9, 7, quant_type);
+    test_conv2d(1, 4, 8, 4, 3, 2, 1, 2, 9, 7, quant_type);
+    test_conv2d(1, 5, 10, 5, 5, 1, 2, 1, 16, 21, quant_type);
+    test_conv2d(1, 8, 8, 1, 3, 1, 1, 1, 9, 7, quant_type);
+    test_conv2d(1, 3, 20, 1, 3, 1, 1, 1, 15, 17, quant_type);
+  }
+}
+
+TEST(conv2d_x86, algorithms) {
+  // {ic, oc, groups, ksize, stride, pad}
+  std::vector<std::vector<int>> cases = {{8, 8, 1, 3, 1, 1},
+                                         {3, 16, 1, 3, 2, 1},
+                                         {4, 8, 4, 3, 1, 1},
+                                         {6, 12, 6, 5, 2, 2}};
+  for (const auto& c : cases) {
+    lite::Tensor x, filter;
+    x.Resize({1, c[0], 12, 10});
+    filter.Resize({c[1], c[0] / c[2], c[3], c[3]});
+    operators::ConvParam param;
+    param.x = &x;
+    param.filter = &filter;
+    param.strides = {c[4], c[4]};
+    param.groups = c[2];
+    param.dilations = std::make_shared<std::vector<int>>(2, 1);
+    Conv2dCompute<float> conv2d;
+    conv2d.SetParam(param);
+    auto algorithms = conv2d.Algorithms();
+    ASSERT_FALSE(algorithms.empty());
+    EXPECT_EQ(algorithms.front(), "gemm");
+    // Every algorithm forced by the kernel_tune_pass computes the same.
+    for (const auto& algorithm : algorithms) {
+      test_conv2d(
+          1, c[0], c[1], c[2], c[3], c[4], c[5], 1, 12, 10, "", algorithm);
+    }
+  }
+}
+
+TEST(conv2d_x86, share_weights) {
+  // winograd, direct and gemm
+  for (int ksize : {3, 5, 1}) {
+    const int ic = 4, oc = 8, ih = 26, iw = 26;
+    lite::Tensor x, filter, out, cloned_out;
+    x.Resize({1, ic, ih, iw});
+    filter.Resize({oc, ic, ksize, ksize});
+    out.Resize({1, oc, ih, iw});
+    cloned_out.Resize({1, oc, ih, iw});
+    auto x_data = x.mutable_data<float>();
+    auto filter_data = filter.mutable_data<float>();
+    for (int64_t i = 0; i < x.numel(); i++) {
+      x_data[i] = static_cast<float>(i % 13) * 0.1f - 0.5f;
+    }
+    for (int64_t i = 0; i < filter.numel(); i++) {
+      filter_data[i] = static_cast<float>(i % 7) * 0.2f - 0.6f;
+    }
+
+    operators::ConvParam param;
+    param.x = &x;
+    param.filter = &filter;
+    param.output = &out;
+    param.strides = {1, 1};
+    int pad = ksize / 2;
+    param.paddings = std::make_shared<std::vector<int>>(
+        std::vector<int>{pad, pad, pad, pad});
+    param.dilations = std::make_shared<std::vector<int>>(std::vector<int>{1, 1});
+
+    Conv2dCompute<float> conv2d, cloned_conv2d;
+    std::unique_ptr<KernelContext> ctx(new KernelContext);
+    ctx->As<X86Context>();
+    conv2d.SetContext(std::move(ctx));
+    conv2d.SetParam(param);
+    conv2d.Launch();
+
+    param.output = &cloned_out;
+    std::unique_ptr<KernelContext> cloned_ctx(new KernelContext);
+    cloned_ctx->As<X86Context>();
+    cloned_conv2d.SetContext(std::move(cloned_ctx));
+    cloned_conv2d.SetParam(param);
+    cloned_conv2d.ShareWeightsFrom(conv2d);
+    cloned_conv2d.Launch();
+
+    auto out_data = out.data<float>();
+    auto cloned_out_data = cloned_out.data<float>();
+    for (int64_t i = 0; i < out.numel(); i++) {
+      EXPECT_EQ(out_data[i], cloned_out_data[i]);
+    }
+  }
+}
+
+template <PrecisionType OutType>
+static void test_conv2d_int8(int batch_size,
+                             int ic,
+                             int oc,
+                             int groups,
+                             int ksize,
+                             int stride,
+                             int pad,
+                             bool relu) {
+  typedef typename Conv2dInt8Compute<OutType>::out_t out_t;
+  int ih = 11, iw = 21;
+  int oh = (ih + 2 * pad - ksize) / stride + 1;
+  int ow = (iw + 2 * pad - ksize) / stride + 1;
+  lite::Tensor x, filter, bias, out, x_fp32, filter_fp32, out_ref;
+  x.Resize({batch_size, ic, ih, iw});
+  filter.Resize({oc, ic / groups, ksize, ksize});
+  bias.Resize({oc});
+  out.Resize({batch_size, oc, oh, ow});
+  x_fp32.Resize(x.dims());
+  filter_fp32.Resize(filter.dims());
+  out_ref.Resize(out.dims());
+  auto x_data = x.mutable_data<int8_t>();
+  auto filter_data = filter.mutable_data<int8_t>();
+  auto bias_data = bias.mutable_data<float>();
+  for (int64_t i = 0; i < x.numel(); i++) {
+    x_data[i] = static_cast<int8_t>(i % 255 - 127);
+    x_fp32.mutable_data<float>()[i] = x_data[i];
+  }
+  for (int64_t i = 0; i < filter.numel(); i++) {
+    filter_data[i] = static_cast<int8_t>((i * 7) % 255 - 127);
+    filter_fp32.mutable_data<float>()[i] = filter_data[i];
+  }
+  std::vector<float> weight_scale(oc);
+  for (int i = 0; i < oc; i++) {
+    bias_data[i] = i * 0.5f - 2.f;
+    weight_scale[i] = 0.001f * (i % 3 + 1);
+  }
+
+  operators::ConvParam param;
+  param.x = &x;
+  param.filter = &filter;
+  param.bias = &bias;
+  param.output = &out;
+  param.strides = {stride, stride};
+  std::vector<int> paddings = {pad, pad, pad, pad};
+  std::vector<int> dilations = {1, 1};
+  param.groups = groups;
+  param.paddings = std::make_shared<std::vector<int>>(paddings);
+  param.dilations = std::make_shared<std::vector<int>>(dilations);
+  param.fuse_relu = relu;
+  param.input_scale = 0.02f;
+  param.weight_scale = weight_scale;
+  param.output_scale = 0.05f;
+
+  Conv2dInt8Compute<OutType> conv2d;
+  std::unique_ptr<KernelContext> ctx(new KernelContext);
+  ctx->As<X86Context>();
+  conv2d.SetContext(std::move(ctx));
+  conv2d.SetParam(param);
+  conv2d.PrepareForRun();
+  conv2d.Run();
+
+  conv2d_ref(
+      x_fp32, filter_fp32, groups, param.strides, paddings, dilations, &out_ref);
+  auto out_data = out.data<out_t>();
+  auto out_ref_data = out_ref.data<float>();
+  const int64_t size = oh * ow;
+  for (int64_t i = 0; i < out.numel(); i++) {
+    int c = (i / size) % oc;
+    float ref = out_ref_data[i] * param.input_scale * weight_scale[c] +
+                bias_data[c];
+    if (relu) ref = std::max(ref, 0.f);
+    if (OutType == PRECISION(kInt8)) {
+      ref = std::min(std::max(std::round(ref / param.output_scale), -127.f),
+                     127.f);
+    }
+    // the requantized values may round the other way at the halves
+    float eps = OutType == PRECISION(kInt8)
+                    ? 1.f
+                    : 1e-3f * std::max(1.f, std::abs(ref));
+    EXPECT_NEAR(out_data[i], ref, eps);
+  }
+}
+
+TEST(conv2d_x86, int8) {
+  lite::x86::SetNumThreads(2);
+  for (int batch_size : {1, 3}) {
+    for (bool relu : {false, true}) {
+      // K is long enough for the SIMD loops and has a tail
+      test_conv2d_int8<PRECISION(kFloat)>(batch_size, 16, 10, 1, 3, 1, 1, relu);
+      test_conv2d_int8<PRECISION(kInt8)>(batch_size, 16, 10, 1, 3, 1, 1, relu);
+      test_conv2d_int8<PRECISION(kFloat)>(batch_size, 12, 6, 3, 1, 2, 0, relu);
+      // depthwise
+      test_conv2d_int8<PRECISION(kInt8)>(batch_size, 8, 8, 8, 3, 2, 1, relu);
+    }
+  }
+  lite::x86::SetNumThreads(1);
+}
+
+TEST(conv2d_x86, direct) {
+  lite::x86::SetNumThreads(2);
+  for (int batch_size : {1, 3}) {
+    // the output channels are not a multiple of the SIMD width
+    test_conv2d(batch_size, 3, 20, 1, 3, 1, 1, 1, 15, 17);
+    test_conv2d(batch_size, 3, 16, 1, 3, 2, 1, 1, 32, 33);
+    // depthwise of stride 1 with a channel multiplier
+    test_conv2d(batch_size, 5, 10, 5, 5, 1, 2, 1, 16, 21);
+    test_conv2d(batch_size, 8, 8, 8, 3, 1, 0, 1, 12, 30);
+  }
+  lite::x86::SetNumThreads(1);
+}
+
 }  // namespace x86
 }  // namespace kernels
 }  // namespace lite
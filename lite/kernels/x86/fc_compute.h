@@ -14,11 +14,14 @@
 
 #pragma once
 
+#include <type_traits>
 #include <vector>
 #include "lite/backends/x86/jit/helper.h"
 #include "lite/backends/x86/jit/kernel_base.h"
 #include "lite/backends/x86/jit/kernels.h"
 #include "lite/backends/x86/math/blas.h"
+#include "lite/backends/x86/math/gemm_s8.h"
+#include "lite/backends/x86/math/gemm_w16.h"
 #include "lite/backends/x86/parallel.h"
 #include "lite/core/kernel.h"
 #include "lite/core/op_lite.h"
@@ -118,6 +121,37 @@ class FCFunctor {
       lite::x86::RunParallelFor(0, M, parallel_compute);
     }
   }
+
+  // The weights [K, N] with the leading dimension `ldw` are stored in 16 bits
+  // by the weight_half_quantization_pass.
+  void operator()(const lite::X86Context& context,
+                  const int M,
+                  const int N,
+                  const int K,
+                  const T* X,
+                  const uint16_t* W,
+                  const int ldw,
+                  lite::x86::math::W16Type w_type,
+                  T* Y,
+                  const T* B = nullptr,
+                  bool relu = false) {
+    lite::x86::math::gemm_w16(
+        context, w_type, false, M, N, K, 1.f, X, K, W, ldw, 0.f, Y, N);
+    if (!B) {
+      return;
+    }
+    auto compute =
+        relu
+            ? jit::KernelFuncs<jit::VAddReluTuple<T>, fluid::CPUPlace>::Cache()
+                  .At(N)
+            : jit::KernelFuncs<jit::VAddTuple<T>, fluid::CPUPlace>::Cache().At(
+                  N);
+    lite::x86::RunParallelFor(0, M, [&](int64_t begin, int64_t end) {
+      for (int64_t i = begin; i < end; i++) {
+        compute(B, Y + i * N, Y + i * N, N);
+      }
+    });
+  }
 };
 
 template <typename T>
@@ -141,11 +175,27 @@ class FcCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
     int M = output->dims().production() / w_dims1;
 
     const T* input_data = input->data<T>();
-    const T* w_data = w->data<T>();
     T* output_data = output->mutable_data<T>();
 
     auto& context = ctx_->As<X86Context>();
     FCFunctor<lite::TargetType::kX86, T> fc;
+    if (!param.weight_quant_type.empty()) {
+      CHECK(w->precision() == PRECISION(kInt16));
+      fc(context,
+         M,
+         w_dims1,
+         w_dims0,
+         input_data,
+         reinterpret_cast<const uint16_t*>(w->data<int16_t>()),
+         w_dims[1],
+         lite::x86::math::GetW16Type(param.weight_quant_type),
+         output_data,
+         bias ? bias->data<T>() : NULL,
+         with_relu);
+      return;
+    }
+
+    const T* w_data = w->data<T>();
     fc(context,
        M,
        w_dims1,
@@ -161,6 +211,90 @@ class FcCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
   virtual ~FcCompute() = default;
 };
 
+/// The int8 fc with the per output channel weight scales, the output is
+/// dequantized to float, or requantized to int8 with the output scale.
+template <PrecisionType OutType>
+class FcInt8Compute : public KernelLite<TARGET(kX86), PRECISION(kInt8)> {
+ public:
+  using param_t = operators::FcParam;
+  using out_t = typename std::
+      conditional<OutType == PRECISION(kInt8), int8_t, float>::type;
+
+  void PrepareForRun() override {
+    auto& param = *param_.get_mutable<param_t>();
+    const auto& w_dims = param.w->dims();
+    k_ = param.padding_weights ? w_dims[0] - 4 : w_dims[0];
+    n_ = param.padding_weights ? w_dims[1] - 4 : w_dims[1];
+    // The weights [K, N] are transposed once to [N, K].
+    weights_.Resize({n_, k_});
+    lite::x86::math::transpose_s8(param.w->data<int8_t>(),
+                                  k_,
+                                  n_,
+                                  w_dims[1],
+                                  weights_.mutable_data<int8_t>());
+    comp_ = lite::x86::math::gemm_s8_compensation(
+        n_, k_, weights_.data<int8_t>(), k_);
+
+    scale_ = param.weight_scale;
+    CHECK(scale_.size() == 1U || static_cast<int>(scale_.size()) == n_)
+        << "weights scale size must equal to the output channels";
+    scale_.resize(n_, scale_[0]);
+    float out_scale = OutType == PRECISION(kInt8) ? param.output_scale : 1.f;
+    for (auto& ws : scale_) {
+      ws = ws * param.input_scale / out_scale;
+    }
+    if (param.bias) {
+      bias_.resize(param.bias->numel());
+      const float* bias_data = param.bias->data<float>();
+      for (size_t i = 0; i < bias_.size(); ++i) {
+        bias_[i] = bias_data[i] / out_scale;
+      }
+    }
+  }
+
+  void Run() override {
+    auto& param = *param_.get_mutable<param_t>();
+    int m = param.output->dims().production() / n_;
+    lite::x86::math::gemm_s8<out_t>(m,
+                                    n_,
+                                    k_,
+                                    param.input->data<int8_t>(),
+                                    k_,
+                                    weights_.data<int8_t>(),
+                                    k_,
+                                    param.output->mutable_data<out_t>(),
+                                    n_,
+                                    scale_.data(),
+                                    bias_.empty() ? nullptr : bias_.data(),
+                                    false,
+                                    param.activation_type == "relu",
+                                    comp_.empty() ? nullptr : comp_.data());
+  }
+
+  virtual ~FcInt8Compute() = default;
+
+ protected:
+  bool ShareWeights(const KernelBase& other) override {
+    const auto& src = static_cast<const FcInt8Compute&>(other);
+    k_ = src.k_;
+    n_ = src.n_;
+    weights_.ShareDataWith(src.weights_);
+    comp_ = src.comp_;
+    scale_ = src.scale_;
+    bias_ = src.bias_;
+    return true;
+  }
+
+ private:
+  int k_{0};
+  int n_{0};
+  lite::Tensor weights_;
+  // The compensation of the weights for gemm_s8.
+  std::vector<int32_t> comp_;
+  std::vector<float> scale_;
+  std::vector<float> bias_;
+};
+
 }  // namespace x86
 }  // namespace kernels
 }  // namespace lite
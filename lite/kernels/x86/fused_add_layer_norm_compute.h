@@ -0,0 +1,97 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <vector>
+#include "lite/backends/x86/jit/helper.h"
+#include "lite/backends/x86/jit/kernel_base.h"
+#include "lite/backends/x86/jit/kernels.h"
+#include "lite/backends/x86/parallel.h"
+#include "lite/core/kernel.h"
+#include "lite/core/op_lite.h"
+#include "lite/core/op_registry.h"
+#include "lite/core/type_system.h"
+#include "lite/operators/fused_add_layer_norm_op.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace x86 {
+
+// The sum is computed over blocks of rows (at most kBlockSize elements) and
+// normalized while it is still in the cache.
+template <typename T>
+class FusedAddLayerNormCompute
+    : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
+ public:
+  using param_t = operators::FusedAddLayerNormParam;
+  static constexpr int kBlockSize = 16384;
+
+  void Run() override {
+    auto &param = *param_.get_mutable<param_t>();
+    auto matrix_dim = param.X->dims().Flatten2D(param.begin_norm_axis);
+    int left = static_cast<int>(matrix_dim[0]);
+    int right = static_cast<int>(matrix_dim[1]);
+    const T *x = param.X->data<T>();
+    const T *y = param.Y->data<T>();
+    const T *scale = param.Scale->data<T>();
+    const T *bias = param.Bias->data<T>();
+    T *out = param.Out->mutable_data<T>();
+    float epsilon = param.epsilon;
+
+    int block_rows = std::max(1, std::min(left, kBlockSize / right));
+    int num_blocks = (left + block_rows - 1) / block_rows;
+    auto add =
+        jit::KernelFuncs<jit::VAddTuple<T>, fluid::CPUPlace>::Cache().At(right);
+    auto layer_norm =
+        jit::KernelFuncs<jit::LayerNormTuple<T>, fluid::CPUPlace>::Cache().At(
+            right);
+
+    auto compute = [&](int64_t begin, int64_t end) {
+      std::vector<T> sum(block_rows * right);
+      std::vector<T> mean(block_rows);
+      std::vector<T> var(block_rows);
+      for (int64_t block = begin; block < end; block++) {
+        int row_begin = static_cast<int>(block) * block_rows;
+        int rows = std::min(block_rows, left - row_begin);
+        int64_t offset = static_cast<int64_t>(row_begin) * right;
+        for (int i = 0; i < rows; i++) {
+          add(x + offset + i * right,
+              y + offset + i * right,
+              sum.data() + i * right,
+              right);
+        }
+        layer_norm(sum.data(),
+                   out + offset,
+                   mean.data(),
+                   var.data(),
+                   scale,
+                   bias,
+                   rows,
+                   epsilon,
+                   right);
+      }
+    };
+    lite::x86::RunParallelFor(0, num_blocks, compute);
+  }
+
+  virtual ~FusedAddLayerNormCompute() = default;
+};
+
+}  // namespace x86
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
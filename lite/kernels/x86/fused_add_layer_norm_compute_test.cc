@@ -0,0 +1,119 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/kernels/x86/fused_add_layer_norm_compute.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+#include "lite/core/op_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace x86 {
+
+// elementwise_add followed by layer_norm.
+static void fused_add_layer_norm_ref(const lite::Tensor& x,
+                                     const lite::Tensor& y,
+                                     const lite::Tensor& scale,
+                                     const lite::Tensor& bias,
+                                     int begin_norm_axis,
+                                     float epsilon,
+                                     lite::Tensor* out) {
+  auto matrix_dim = x.dims().Flatten2D(begin_norm_axis);
+  int left = matrix_dim[0], right = matrix_dim[1];
+  auto* out_data = out->mutable_data<float>();
+  std::vector<float> sum(right);
+  for (int i = 0; i < left; i++) {
+    float mean = 0.f, var = 0.f;
+    for (int j = 0; j < right; j++) {
+      sum[j] = x.data<float>()[i * right + j] + y.data<float>()[i * right + j];
+      mean += sum[j];
+    }
+    mean /= right;
+    for (int j = 0; j < right; j++) {
+      var += (sum[j] - mean) * (sum[j] - mean);
+    }
+    var /= right;
+    for (int j = 0; j < right; j++) {
+      out_data[i * right + j] = (sum[j] - mean) / std::sqrt(var + epsilon) *
+                                    scale.data<float>()[j] +
+                                bias.data<float>()[j];
+    }
+  }
+}
+
+TEST(fused_add_layer_norm_x86, retrive_op) {
+  auto kernel =
+      KernelRegistry::Global().Create<TARGET(kX86), PRECISION(kFloat)>(
+          "fused_add_layer_norm");
+  ASSERT_FALSE(kernel.empty());
+  ASSERT_TRUE(kernel.front());
+}
+
+TEST(fused_add_layer_norm_x86, compute) {
+  // The second case is split into several blocks of rows.
+  std::vector<std::vector<int64_t>> shapes{{3, 70, 40}, {600, 13}, {2, 4, 3}};
+  std::vector<int> begin_norm_axes{2, 1, 1};
+  for (size_t n = 0; n < shapes.size(); n++) {
+    lite::Tensor x, y, scale, bias, out, out_ref;
+    x.Resize(shapes[n]);
+    y.Resize(shapes[n]);
+    out.Resize(shapes[n]);
+    out_ref.Resize(shapes[n]);
+    int right = x.dims().Flatten2D(begin_norm_axes[n])[1];
+    scale.Resize({right});
+    bias.Resize({right});
+
+    auto* x_data = x.mutable_data<float>();
+    auto* y_data = y.mutable_data<float>();
+    for (int i = 0; i < x.numel(); i++) {
+      x_data[i] = std::sin(static_cast<float>(i)) * 2.f;
+      y_data[i] = std::cos(static_cast<float>(i) * 0.3f) + 0.5f;
+    }
+    auto* scale_data = scale.mutable_data<float>();
+    auto* bias_data = bias.mutable_data<float>();
+    for (int i = 0; i < right; i++) {
+      scale_data[i] = 1.f + 0.01f * i;
+      bias_data[i] = 0.1f * (i % 5);
+    }
+
+    FusedAddLayerNormCompute<float> fused_add_layer_norm;
+    operators::FusedAddLayerNormParam param;
+    param.X = &x;
+    param.Y = &y;
+    param.Scale = &scale;
+    param.Bias = &bias;
+    param.Out = &out;
+    param.begin_norm_axis = begin_norm_axes[n];
+    param.epsilon = 1e-5f;
+    fused_add_layer_norm.SetParam(param);
+    fused_add_layer_norm.Run();
+
+    fused_add_layer_norm_ref(
+        x, y, scale, bias, begin_norm_axes[n], param.epsilon, &out_ref);
+    auto* out_data = out.data<float>();
+    auto* out_ref_data = out_ref.data<float>();
+    for (int i = 0; i < out.numel(); i++) {
+      EXPECT_NEAR(out_data[i], out_ref_data[i], 1e-4);
+    }
+  }
+}
+
+}  // namespace x86
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
+
+USE_LITE_KERNEL(fused_add_layer_norm, kX86, kFloat, kNCHW, def);
@@ -0,0 +1,154 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <vector>
+#include "lite/backends/x86/jit/helper.h"
+#include "lite/backends/x86/jit/kernel_base.h"
+#include "lite/backends/x86/jit/kernels.h"
+#include "lite/backends/x86/math/blas.h"
+#include "lite/backends/x86/parallel.h"
+#include "lite/core/kernel.h"
+#include "lite/core/op_lite.h"
+#include "lite/core/op_registry.h"
+#include "lite/core/type_system.h"
+#include "lite/operators/fused_attention_op.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace x86 {
+
+// The attention of each head is computed over blocks of query rows, the
+// scores of a block (at most kScoresBlockSize elements) are masked,
+// normalized and multiplied by V while they are still in the cache.
+template <typename T>
+class FusedAttentionCompute
+    : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
+ public:
+  using param_t = operators::FusedAttentionParam;
+  static constexpr int kScoresBlockSize = 16384;
+
+  void Run() override {
+    auto &param = *param_.get_mutable<param_t>();
+    auto &context = ctx_->As<X86Context>();
+    const auto &q_dims = param.Q->dims();
+    int rank = static_cast<int>(q_dims.size());
+    int64_t batch = q_dims.count(0, rank - 2);
+    int seq_q = static_cast<int>(q_dims[rank - 2]);
+    int size = static_cast<int>(q_dims[rank - 1]);
+    int seq_k = static_cast<int>(param.K->dims()[rank - 2]);
+    int size_v = static_cast<int>(param.V->dims()[rank - 1]);
+    int heads = param.transpose_out ? static_cast<int>(q_dims[1]) : 1;
+
+    const T *q = param.Q->data<T>();
+    const T *k = param.K->data<T>();
+    const T *v = param.V->data<T>();
+    T *out = param.Out->mutable_data<T>();
+
+    // The strides of the mask broadcast to the scores, 0 along the
+    // broadcast dims.
+    const T *mask = param.Mask ? param.Mask->data<T>() : nullptr;
+    std::vector<int64_t> mask_strides(rank, 0);
+    if (mask) {
+      const auto &mask_dims = param.Mask->dims();
+      int offset = rank - static_cast<int>(mask_dims.size());
+      int64_t stride = 1;
+      for (int i = static_cast<int>(mask_dims.size()) - 1; i >= 0; i--) {
+        mask_strides[i + offset] = mask_dims[i] == 1 ? 0 : stride;
+        stride *= mask_dims[i];
+      }
+    }
+
+    int block_rows = std::max(1, std::min(seq_q, kScoresBlockSize / seq_k));
+    int num_blocks = (seq_q + block_rows - 1) / block_rows;
+    auto blas = lite::x86::math::GetBlas<lite::TargetType::kX86, T>(context);
+    auto softmax = jit::KernelFuncs<jit::SoftmaxTuple<T>, fluid::CPUPlace>::
+                       Cache()
+                           .At(seq_k);
+
+    auto compute = [&](int64_t begin, int64_t end) {
+      std::vector<T> scores(block_rows * seq_k);
+      for (int64_t item = begin; item < end; item++) {
+        int64_t b = item / num_blocks;
+        int row_begin = static_cast<int>(item % num_blocks) * block_rows;
+        int rows = std::min(block_rows, seq_q - row_begin);
+
+        blas.GEMM(false,
+                  true,
+                  rows,
+                  seq_k,
+                  size,
+                  static_cast<T>(param.alpha),
+                  q + (b * seq_q + row_begin) * size,
+                  size,
+                  k + b * seq_k * size,
+                  size,
+                  T(0),
+                  scores.data(),
+                  seq_k);
+
+        if (mask) {
+          int64_t mask_offset = 0;
+          int64_t index = b;
+          for (int i = rank - 3; i >= 0; i--) {
+            mask_offset += (index % q_dims[i]) * mask_strides[i];
+            index /= q_dims[i];
+          }
+          for (int i = 0; i < rows; i++) {
+            const T *mask_row = mask + mask_offset +
+                                (row_begin + i) * mask_strides[rank - 2];
+            T *scores_row = scores.data() + i * seq_k;
+            if (mask_strides[rank - 1] == 0) {
+              for (int j = 0; j < seq_k; j++) scores_row[j] += mask_row[0];
+            } else {
+              for (int j = 0; j < seq_k; j++) scores_row[j] += mask_row[j];
+            }
+          }
+        }
+        softmax(scores.data(), scores.data(), seq_k, rows, 1);
+
+        // With transpose_out, the rows of a head are strided by the heads.
+        T *out_block = param.transpose_out
+                           ? out + (((b / heads) * seq_q + row_begin) * heads +
+                                    b % heads) *
+                                       size_v
+                           : out + (b * seq_q + row_begin) * size_v;
+        blas.GEMM(false,
+                  false,
+                  rows,
+                  size_v,
+                  seq_k,
+                  T(1),
+                  scores.data(),
+                  seq_k,
+                  v + b * seq_k * size_v,
+                  size_v,
+                  T(0),
+                  out_block,
+                  heads * size_v);
+      }
+    };
+    lite::x86::RunParallelFor(0, batch * num_blocks, compute);
+  }
+
+  virtual ~FusedAttentionCompute() = default;
+};
+
+}  // namespace x86
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
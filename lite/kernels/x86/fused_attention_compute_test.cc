@@ -0,0 +1,158 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/kernels/x86/fused_attention_compute.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "lite/core/op_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace x86 {
+
+// softmax(alpha * Q * K^T + Mask) * V for Q, K, V of [batch, heads, seq, size]
+// and Mask of [mask_batch, mask_heads, mask_rows, seq_k].
+static void fused_attention_ref(const lite::Tensor& q,
+                                const lite::Tensor& k,
+                                const lite::Tensor& v,
+                                const lite::Tensor* mask,
+                                float alpha,
+                                bool transpose_out,
+                                lite::Tensor* out) {
+  auto q_dims = q.dims();
+  int batch = q_dims[0], heads = q_dims[1], seq_q = q_dims[2], size = q_dims[3];
+  int seq_k = k.dims()[2];
+  int size_v = v.dims()[3];
+  auto* out_data = out->mutable_data<float>();
+  std::vector<float> scores(seq_k);
+  for (int b = 0; b < batch; b++) {
+    for (int h = 0; h < heads; h++) {
+      const float* q_data = q.data<float>() + (b * heads + h) * seq_q * size;
+      const float* k_data = k.data<float>() + (b * heads + h) * seq_k * size;
+      const float* v_data = v.data<float>() + (b * heads + h) * seq_k * size_v;
+      for (int i = 0; i < seq_q; i++) {
+        float max_score = -1e30f;
+        for (int j = 0; j < seq_k; j++) {
+          float s = 0.f;
+          for (int d = 0; d < size; d++) {
+            s += q_data[i * size + d] * k_data[j * size + d];
+          }
+          s *= alpha;
+          if (mask) {
+            auto m = mask->dims();
+            int mb = m[0] == 1 ? 0 : b;
+            int mh = m[1] == 1 ? 0 : h;
+            int mi = m[2] == 1 ? 0 : i;
+            s += mask->data<float>()[((mb * m[1] + mh) * m[2] + mi) * m[3] + j];
+          }
+          scores[j] = s;
+          max_score = std::max(max_score, s);
+        }
+        float sum = 0.f;
+        for (int j = 0; j < seq_k; j++) {
+          scores[j] = std::exp(scores[j] - max_score);
+          sum += scores[j];
+        }
+        for (int d = 0; d < size_v; d++) {
+          float o = 0.f;
+          for (int j = 0; j < seq_k; j++) {
+            o += scores[j] / sum * v_data[j * size_v + d];
+          }
+          int row = transpose_out ? (b * seq_q + i) * heads + h
+                                  : (b * heads + h) * seq_q + i;
+          out_data[row * size_v + d] = o;
+        }
+      }
+    }
+  }
+}
+
+static void fill_data(lite::Tensor* x, float scale) {
+  auto* data = x->mutable_data<float>();
+  for (int i = 0; i < x->numel(); i++) {
+    data[i] = std::sin(static_cast<float>(i) * 0.37f) * scale;
+  }
+}
+
+TEST(fused_attention_x86, retrive_op) {
+  auto kernel =
+      KernelRegistry::Global().Create<TARGET(kX86), PRECISION(kFloat)>(
+          "fused_attention");
+  ASSERT_FALSE(kernel.empty());
+  ASSERT_TRUE(kernel.front());
+}
+
+TEST(fused_attention_x86, compute) {
+  int batch = 2, heads = 3, size = 8, size_v = 6;
+  // The last case is split into several blocks of query rows.
+  std::vector<std::pair<int, int>> seqs{{5, 7}, {1, 9}, {40, 1000}};
+  for (auto seq : seqs) {
+    int seq_q = seq.first, seq_k = seq.second;
+    std::vector<std::vector<int64_t>> mask_shapes{
+        {}, {batch, 1, 1, seq_k}, {batch, heads, seq_q, seq_k}};
+    for (auto& mask_shape : mask_shapes) {
+      for (bool transpose_out : {false, true}) {
+        lite::Tensor q, k, v, mask, out, out_ref;
+        q.Resize({batch, heads, seq_q, size});
+        k.Resize({batch, heads, seq_k, size});
+        v.Resize({batch, heads, seq_k, size_v});
+        fill_data(&q, 1.f);
+        fill_data(&k, 0.5f);
+        fill_data(&v, 2.f);
+        if (!mask_shape.empty()) {
+          mask.Resize(mask_shape);
+          fill_data(&mask, 3.f);
+        }
+        std::vector<int64_t> out_shape{batch, heads, seq_q, size_v};
+        if (transpose_out) std::swap(out_shape[1], out_shape[2]);
+        out.Resize(out_shape);
+        out_ref.Resize(out_shape);
+
+        FusedAttentionCompute<float> fused_attention;
+        operators::FusedAttentionParam param;
+        param.Q = &q;
+        param.K = &k;
+        param.V = &v;
+        param.Mask = mask_shape.empty() ? nullptr : &mask;
+        param.Out = &out;
+        param.alpha = 1.f / std::sqrt(static_cast<float>(size));
+        param.transpose_out = transpose_out;
+        std::unique_ptr<KernelContext> ctx(new KernelContext);
+        ctx->As<X86Context>();
+        fused_attention.SetContext(std::move(ctx));
+        fused_attention.SetParam(param);
+        fused_attention.Run();
+
+        fused_attention_ref(
+            q, k, v, param.Mask, param.alpha, transpose_out, &out_ref);
+        auto* out_data = out.data<float>();
+        auto* out_ref_data = out_ref.data<float>();
+        for (int i = 0; i < out.numel(); i++) {
+          EXPECT_NEAR(out_data[i], out_ref_data[i], 1e-4);
+        }
+      }
+    }
+  }
+}
+
+}  // namespace x86
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
+
+USE_LITE_KERNEL(fused_attention, kX86, kFloat, kNCHW, def);
@@ -0,0 +1,129 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#pragma once
+
+#include <cmath>
+#include <cstring>
+#include "lite/backends/x86/jit/helper.h"
+#include "lite/backends/x86/jit/kernel_base.h"
+#include "lite/backends/x86/jit/kernels.h"
+#include "lite/core/kernel.h"
+#include "lite/core/op_registry.h"
+#include "lite/kernels/x86/lookup_table_compute.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace x86 {
+
+template <typename T>
+class FusedEmbeddingSeqPoolCompute
+    : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
+ public:
+  using param_t = operators::FusedEmbeddingSeqPoolParam;
+
+  void Run() override {
+    auto &param = *param_.get_mutable<operators::FusedEmbeddingSeqPoolParam>();
+    auto *table_t = param.W;
+    auto *ids_t = param.Ids;
+    auto *output_t = param.Out;
+    int64_t padding_idx = param.padding_idx;
+
+    int64_t row_number = table_t->dims()[0];
+    int64_t row_width = table_t->dims()[1];
+    bool quantized = !param.embedding_quant_type.empty();
+    if (param.embedding_quant_type == "int8") {
+      row_width -= sizeof(float);
+    }
+    auto lod = ids_t->lod()[0];
+    // The ids of a row, which are pooled separately.
+    int64_t idx_width = ids_t->numel() / ids_t->dims()[0];
+    int64_t out_width = idx_width * row_width;
+
+    const T *table = quantized ? nullptr : table_t->data<T>();
+    const int64_t *ids = ids_t->data<int64_t>();
+    T *output = output_t->mutable_data<T>();
+
+    jit::emb_seq_pool_attr_t attr(row_number,
+                                  row_width,
+                                  0,
+                                  idx_width,
+                                  out_width,
+                                  jit::SeqPoolType::kSum);
+    auto emb_seq_pool =
+        jit::KernelFuncs<jit::EmbSeqPoolTuple<T>, fluid::CPUPlace>::Cache().At(
+            attr);
+    auto vadd = jit::KernelFuncs<jit::VAddTuple<T>, fluid::CPUPlace>::Cache().At(
+        row_width);
+    auto vscal =
+        jit::KernelFuncs<jit::VScalTuple<T>, fluid::CPUPlace>::Cache().At(
+            out_width);
+
+    for (size_t i = 0; i + 1 < lod.size(); ++i) {
+      int64_t h = static_cast<int64_t>(lod[i + 1] - lod[i]);
+      const int64_t *seq_ids = ids + lod[i] * idx_width;
+      T *out = output + i * out_width;
+      if (h == 0) {
+        memset(out, 0, out_width * sizeof(T));
+        continue;
+      }
+      if (quantized) {
+        // Only the gathered rows are dequantized.
+        memset(out, 0, out_width * sizeof(T));
+        for (int64_t j = 0; j < h * idx_width; ++j) {
+          if (padding_idx != -1 && seq_ids[j] == padding_idx) continue;
+          CHECK_LT(seq_ids[j], row_number);
+          CHECK_GE(seq_ids[j], 0);
+          DequantEmbeddingRow(*table_t,
+                              param.embedding_quant_type,
+                              seq_ids[j],
+                              row_width,
+                              true,
+                              out + (j % idx_width) * row_width);
+        }
+      } else if (padding_idx == -1) {
+        for (int64_t j = 0; j < h * idx_width; ++j) {
+          CHECK_LT(seq_ids[j], row_number);
+          CHECK_GE(seq_ids[j], 0);
+        }
+        attr.index_height = h;
+        emb_seq_pool(table, seq_ids, out, &attr);
+      } else {
+        // The padding ids are looked up as zero rows, skip them.
+        memset(out, 0, out_width * sizeof(T));
+        for (int64_t j = 0; j < h * idx_width; ++j) {
+          if (seq_ids[j] == padding_idx) continue;
+          CHECK_LT(seq_ids[j], row_number);
+          CHECK_GE(seq_ids[j], 0);
+          T *out_j = out + (j % idx_width) * row_width;
+          vadd(table + seq_ids[j] * row_width, out_j, out_j, row_width);
+        }
+      }
+      if (param.combiner == "average") {
+        T scalar = static_cast<T>(1) / static_cast<T>(h);
+        vscal(&scalar, out, out, out_width);
+      } else if (param.combiner == "sqrt") {
+        T scalar = static_cast<T>(1) / std::sqrt(static_cast<T>(h));
+        vscal(&scalar, out, out, out_width);
+      }
+    }
+  }
+
+  virtual ~FusedEmbeddingSeqPoolCompute() = default;
+};
+
+}  // namespace x86
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
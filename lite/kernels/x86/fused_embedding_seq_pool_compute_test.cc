@@ -0,0 +1,161 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/kernels/x86/fused_embedding_seq_pool_compute.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "lite/core/op_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace x86 {
+
+// lookup_table followed by sequence_pool.
+static void fused_embedding_seq_pool_ref(const lite::Tensor& w,
+                                         const lite::Tensor& ids,
+                                         const std::string& combiner,
+                                         int64_t padding_idx,
+                                         lite::Tensor* out) {
+  int64_t emb_size = w.dims()[1];
+  auto lod = ids.lod()[0];
+  auto* w_data = w.data<float>();
+  auto* ids_data = ids.data<int64_t>();
+  auto* out_data = out->mutable_data<float>();
+  for (size_t i = 0; i + 1 < lod.size(); i++) {
+    int64_t h = lod[i + 1] - lod[i];
+    for (int64_t k = 0; k < emb_size; k++) {
+      float sum = 0.f;
+      for (auto j = lod[i]; j < lod[i + 1]; j++) {
+        if (ids_data[j] != padding_idx) {
+          sum += w_data[ids_data[j] * emb_size + k];
+        }
+      }
+      if (h > 0 && combiner == "average") {
+        sum /= h;
+      } else if (h > 0 && combiner == "sqrt") {
+        sum /= std::sqrt(static_cast<float>(h));
+      }
+      out_data[i * emb_size + k] = sum;
+    }
+  }
+}
+
+TEST(fused_embedding_seq_pool_x86, retrive_op) {
+  auto kernel =
+      KernelRegistry::Global().Create<TARGET(kX86), PRECISION(kFloat)>(
+          "fused_embedding_seq_pool");
+  ASSERT_FALSE(kernel.empty());
+  ASSERT_TRUE(kernel.front());
+}
+
+TEST(fused_embedding_seq_pool_x86, compute) {
+  int vocab_size = 40;
+  std::vector<uint64_t> offsets{0, 3, 3, 10, 11, 20};
+  int ids_h = offsets.back();
+  for (int emb_size : {16, 7}) {
+    for (std::string combiner : {"sum", "average", "sqrt"}) {
+      for (int64_t padding_idx : {-1, 5}) {
+        FusedEmbeddingSeqPoolCompute<float> fused_embedding_seq_pool;
+        operators::FusedEmbeddingSeqPoolParam param;
+        lite::Tensor w, ids, out, out_ref;
+
+        int seq_num = offsets.size() - 1;
+        w.Resize({vocab_size, emb_size});
+        ids.Resize({ids_h, 1});
+        ids.set_lod({offsets});
+        out.Resize({seq_num, emb_size});
+        out_ref.Resize({seq_num, emb_size});
+
+        auto* w_data = w.mutable_data<float>();
+        auto* ids_data = ids.mutable_data<int64_t>();
+        for (int i = 0; i < w.numel(); i++) {
+          w_data[i] = static_cast<float>(i % 17) * 0.1f - 0.8f;
+        }
+        for (int i = 0; i < ids_h; i++) {
+          ids_data[i] = (i * 7) % vocab_size;
+        }
+
+        param.W = &w;
+        param.Ids = &ids;
+        param.Out = &out;
+        param.combiner = combiner;
+        param.padding_idx = padding_idx;
+        fused_embedding_seq_pool.SetParam(param);
+        fused_embedding_seq_pool.Run();
+
+        fused_embedding_seq_pool_ref(w, ids, combiner, padding_idx, &out_ref);
+        auto* out_data = out.data<float>();
+        auto* out_ref_data = out_ref.data<float>();
+        for (int i = 0; i < out.numel(); i++) {
+          EXPECT_NEAR(out_data[i], out_ref_data[i], 1e-5);
+        }
+      }
+    }
+  }
+}
+
+TEST(fused_embedding_seq_pool_x86, fp16_table) {
+  int vocab_size = 40;
+  int emb_size = 16;
+  std::vector<uint64_t> offsets{0, 3, 3, 10};
+  int ids_h = offsets.back();
+  lite::Tensor w, w_fp16, ids, out, out_ref;
+  w.Resize({vocab_size, emb_size});
+  w_fp16.Resize({vocab_size, emb_size});
+  ids.Resize({ids_h, 1});
+  ids.set_lod({offsets});
+  out.Resize({3, emb_size});
+  out_ref.Resize({3, emb_size});
+
+  auto* w_data = w.mutable_data<float>();
+  auto* w_fp16_data = w_fp16.mutable_data<int16_t>();
+  for (int i = 0; i < w.numel(); i++) {
+    w_data[i] = static_cast<float>(i % 17) * 0.1f - 0.8f;
+    fluid::float16 h(w_data[i]);
+    std::memcpy(w_fp16_data + i, &h, sizeof(h));
+  }
+  auto* ids_data = ids.mutable_data<int64_t>();
+  for (int i = 0; i < ids_h; i++) {
+    ids_data[i] = (i * 7) % vocab_size;
+  }
+
+  FusedEmbeddingSeqPoolCompute<float> fused_embedding_seq_pool;
+  operators::FusedEmbeddingSeqPoolParam param;
+  param.W = &w_fp16;
+  param.Ids = &ids;
+  param.Out = &out;
+  param.combiner = "average";
+  param.padding_idx = 5;
+  param.embedding_quant_type = "fp16";
+  fused_embedding_seq_pool.SetParam(param);
+  fused_embedding_seq_pool.Run();
+
+  fused_embedding_seq_pool_ref(w, ids, "average", 5, &out_ref);
+  auto* out_data = out.data<float>();
+  auto* out_ref_data = out_ref.data<float>();
+  for (int i = 0; i < out.numel(); i++) {
+    EXPECT_NEAR(out_data[i], out_ref_data[i], 1e-3);
+  }
+}
+
+}  // namespace x86
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
+
+USE_LITE_KERNEL(fused_embedding_seq_pool, kX86, kFloat, kNCHW, def);
@@ -13,16 +13,48 @@
 // limitations under the License.
 #pragma once
 
+#include <cstring>
+#include <string>
 #include <vector>
 #include "lite/core/kernel.h"
 #include "lite/core/op_registry.h"
 #include "lite/fluid/eigen.h"
+#include "lite/fluid/float16.h"
 
 namespace paddle {
 namespace lite {
 namespace kernels {
 namespace x86 {
 
+// Dequantize the `id`-th row of an embedding table quantized by the
+// embedding_quantization_pass, and add it to `out` if `accumulate`.
+inline void DequantEmbeddingRow(const lite::Tensor &table,
+                                const std::string &quant_type,
+                                int64_t id,
+                                int64_t width,
+                                bool accumulate,
+                                float *out) {
+  if (quant_type == "int8") {
+    CHECK(table.precision() == PRECISION(kInt8));
+    const int8_t *row = table.data<int8_t>() + id * table.dims()[1];
+    float scale;
+    std::memcpy(&scale, row + width, sizeof(float));
+    for (int64_t k = 0; k < width; ++k) {
+      out[k] = (accumulate ? out[k] : 0.f) + row[k] * scale;
+    }
+  } else if (quant_type == "fp16") {
+    CHECK(table.precision() == PRECISION(kInt16));
+    const auto *row =
+        reinterpret_cast<const fluid::float16 *>(table.data<int16_t>()) +
+        id * width;
+    for (int64_t k = 0; k < width; ++k) {
+      out[k] = (accumulate ? out[k] : 0.f) + static_cast<float>(row[k]);
+    }
+  } else {
+    LOG(FATAL) << "Unsupported embedding quant type: " << quant_type;
+  }
+}
+
 template <typename T>
 class LookupTableCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
  public:
@@ -38,11 +70,27 @@ class LookupTableCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
 
     auto *table_t = param.W;
     int64_t row_number = table_t->dims()[0];
-    int64_t row_width = table_t->dims()[1];
+    int64_t row_width = output_t->dims()[output_t->dims().size() - 1];
 
-    const T *table = table_t->data<T>();
     T *output = output_t->mutable_data<T>();
     memset(output, 0, output_t->dims().production() * sizeof(T));
+    if (!param.embedding_quant_type.empty()) {
+      // Only the gathered rows are dequantized.
+      for (int64_t i = 0; i < ids_numel; ++i) {
+        if (padding_idx != -1 && ids[i] == padding_idx) continue;
+        CHECK_LT(ids[i], row_number);
+        CHECK_GE(ids[i], 0);
+        DequantEmbeddingRow(*table_t,
+                            param.embedding_quant_type,
+                            ids[i],
+                            row_width,
+                            false,
+                            output + i * row_width);
+      }
+      return;
+    }
+
+    const T *table = table_t->data<T>();
     for (int64_t i = 0; i < ids_numel; ++i) {
       if (padding_idx != -1 && ids[i] == padding_idx) {
         memset(output + i * row_width, 0, row_width * sizeof(T));
@@ -14,7 +14,9 @@
 
 #include "lite/kernels/x86/lookup_table_compute.h"
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <string>
 #include <vector>
 #include "lite/core/op_registry.h"
@@ -74,6 +76,77 @@ TEST(lookup_table_x86, compute) {
   }
 }
 
+TEST(lookup_table_x86, quantized_table) {
+  const int vocab_size = 16;
+  const int emb_size = 24;
+  const int64_t padding_idx = 3;
+  std::vector<float> w_ref(vocab_size * emb_size);
+  for (size_t i = 0; i < w_ref.size(); i++) {
+    w_ref[i] = std::sin(static_cast<float>(i)) * (i / emb_size + 1);
+  }
+  lite::Tensor ids;
+  ids.Resize({10, 1});
+  auto* ids_data = ids.mutable_data<int64_t>();
+  for (int i = 0; i < 10; i++) {
+    ids_data[i] = (i * 7) % vocab_size;
+  }
+
+  for (std::string quant_type : {"int8", "fp16"}) {
+    lite::Tensor w, out;
+    // Quantize the table in the formats of the embedding_quantization_pass.
+    if (quant_type == "int8") {
+      int stride = emb_size + sizeof(float);
+      w.Resize({vocab_size, stride});
+      auto* w_data = w.mutable_data<int8_t>();
+      for (int i = 0; i < vocab_size; i++) {
+        const float* row = w_ref.data() + i * emb_size;
+        float absmax = 0.f;
+        for (int k = 0; k < emb_size; k++) {
+          absmax = std::max(absmax, std::abs(row[k]));
+        }
+        float scale = absmax / 127.f;
+        for (int k = 0; k < emb_size; k++) {
+          w_data[i * stride + k] =
+              static_cast<int8_t>(std::round(row[k] / scale));
+        }
+        std::memcpy(w_data + i * stride + emb_size, &scale, sizeof(float));
+      }
+    } else {
+      w.Resize({vocab_size, emb_size});
+      auto* w_data = w.mutable_data<int16_t>();
+      for (size_t i = 0; i < w_ref.size(); i++) {
+        fluid::float16 h(w_ref[i]);
+        std::memcpy(w_data + i, &h, sizeof(h));
+      }
+    }
+    out.Resize({10, 1, emb_size});
+
+    LookupTableCompute<float> lookup_table;
+    operators::LookupTableParam param;
+    param.W = &w;
+    param.Ids = &ids;
+    param.Out = &out;
+    param.padding_idx = padding_idx;
+    param.embedding_quant_type = quant_type;
+    lookup_table.SetParam(param);
+    lookup_table.Run();
+
+    auto* out_data = out.data<float>();
+    for (int i = 0; i < 10; i++) {
+      for (int k = 0; k < emb_size; k++) {
+        float ref = ids_data[i] == padding_idx
+                        ? 0.f
+                        : w_ref[ids_data[i] * emb_size + k];
+        // Half of the quantization step of the row or of the half precision.
+        float tol = quant_type == "int8"
+                        ? (ids_data[i] + 1) / 254.f + 1e-5f
+                        : std::abs(ref) / 1024.f + 1e-5f;
+        EXPECT_NEAR(out_data[i * emb_size + k], ref, tol);
+      }
+    }
+  }
+}
+
 }  // namespace x86
 }  // namespace kernels
 }  // namespace lite
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "lite/kernels/x86/match_matrix_tensor_compute.h"
+#include <algorithm>
 #include <vector>
 
 namespace paddle {
@@ -68,29 +69,53 @@ void MatchMatrixTensorCompute<T>::Run() {
             bottom_l_trans_data,
             dim_t * dim_in);
 
+  // the dim_t matrices of a sample are computed by one GEMM, the left rows
+  // transformed by all the dim_t slices of w are contiguous in
+  // bottom_l_trans_data, the (l, t) rows of the result are then reordered to
+  // the (t, l) rows of the output.
+  int64_t max_match_size = 0;
   for (size_t b = 0; b < x->lod()[0].size() - 1; b++) {
-    for (int t = 0; t < dim_t; t++) {
-      int len_l = offset_l[b + 1] - offset_l[b];
-      int len_r = offset_r[b + 1] - offset_r[b];
-      auto* top_data = out_data + top_offset[b] + t * len_l * len_r;
-      const auto* l_t_data =
-          bottom_l_trans_data + offset_l[b] * dim_t * dim_in + t * dim_in;
-      const auto* r_data = bottom_r_data + offset_r[b] * dim_in;
-
-      auto blas = lite::x86::math::GetBlas<TARGET(kX86), T>(context);
-      blas.GEMM(CblasNoTrans,
-                CblasTrans,
-                len_l,
-                len_r,
-                dim_in,
-                1.0f,
-                l_t_data,
-                dim_t * dim_in,
-                r_data,
-                dim_in,
-                0.0f,
-                top_data,
-                len_r);
+    int64_t len_l = offset_l[b + 1] - offset_l[b];
+    int64_t len_r = offset_r[b + 1] - offset_r[b];
+    max_match_size = std::max(max_match_size, len_l * len_r);
+  }
+  T* match_data = nullptr;
+  if (dim_t > 1 && max_match_size > 0) {
+    match_buffer_.Resize({max_match_size * dim_t, 1});
+    match_data = match_buffer_.template mutable_data<T>();
+  }
+
+  for (size_t b = 0; b < x->lod()[0].size() - 1; b++) {
+    int len_l = offset_l[b + 1] - offset_l[b];
+    int len_r = offset_r[b + 1] - offset_r[b];
+    if (len_l == 0 || len_r == 0) {
+      continue;
+    }
+    auto* top_data = out_data + top_offset[b];
+    const auto* l_t_data = bottom_l_trans_data + offset_l[b] * dim_t * dim_in;
+    const auto* r_data = bottom_r_data + offset_r[b] * dim_in;
+
+    blas.GEMM(CblasNoTrans,
+              CblasTrans,
+              len_l * dim_t,
+              len_r,
+              dim_in,
+              1.0f,
+              l_t_data,
+              dim_in,
+              r_data,
+              dim_in,
+              0.0f,
+              dim_t > 1 ? match_data : top_data,
+              len_r);
+    if (dim_t > 1) {
+      for (int l = 0; l < len_l; l++) {
+        for (int t = 0; t < dim_t; t++) {
+          memcpy(top_data + (t * len_l + l) * len_r,
+                 match_data + (l * dim_t + t) * len_r,
+                 len_r * sizeof(T));
+        }
+      }
     }
   }
 
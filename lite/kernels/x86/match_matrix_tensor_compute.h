@@ -34,6 +34,10 @@ class MatchMatrixTensorCompute
   void Run() override;
 
   virtual ~MatchMatrixTensorCompute() = default;
+
+ private:
+  // The [len_l, dim_t, len_r] matches of a sample before reordered.
+  Tensor match_buffer_;
 };
 
 }  // namespace x86
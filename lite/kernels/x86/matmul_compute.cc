@@ -24,3 +24,22 @@ REGISTER_LITE_KERNEL(matmul,
     .BindInput("Y", {LiteType::GetTensorTy(TARGET(kX86))})
     .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kX86))})
     .Finalize();
+
+typedef paddle::lite::kernels::x86::MatMulInt8Compute<PRECISION(kInt8)>
+    MatMulCompute_int8_int8;
+typedef paddle::lite::kernels::x86::MatMulInt8Compute<PRECISION(kFloat)>
+    MatMulCompute_int8_fp32;
+
+REGISTER_LITE_KERNEL(
+    matmul, kX86, kInt8, kNCHW, MatMulCompute_int8_int8, int8out)
+    .BindInput("X", {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt8))})
+    .BindInput("Y", {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt8))})
+    .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt8))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(
+    matmul, kX86, kInt8, kNCHW, MatMulCompute_int8_fp32, fp32out)
+    .BindInput("X", {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt8))})
+    .BindInput("Y", {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt8))})
+    .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kFloat))})
+    .Finalize();
@@ -13,7 +13,11 @@
 // limitations under the License.
 #pragma once
 
+#include <type_traits>
+#include <vector>
 #include "lite/backends/x86/math/blas.h"
+#include "lite/backends/x86/math/gemm_s8.h"
+#include "lite/backends/x86/math/gemm_w16.h"
 #include "lite/core/kernel.h"
 #include "lite/core/op_registry.h"
 #include "lite/core/types.h"
@@ -58,6 +62,34 @@ class MatMulCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
     auto *out = param.Out;
     out->mutable_data<T>();
 
+    if (!param.weight_quant_type.empty()) {
+      // The 2-D Y is stored in 16 bits by the weight_half_quantization_pass,
+      // the batches of X are computed as the rows of a matrix.
+      CHECK(y->precision() == PRECISION(kInt16));
+      CHECK_EQ(y->dims().size(), 2UL);
+      CHECK(!param.transpose_X);
+      const int k = x->dims()[x->dims().size() - 1];
+      const int m = x->dims().production() / k;
+      const int n = y->dims()[param.transpose_Y ? 0 : 1];
+      CHECK_EQ(k, y->dims()[param.transpose_Y ? 1 : 0]);
+      lite::x86::math::gemm_w16(
+          context,
+          lite::x86::math::GetW16Type(param.weight_quant_type),
+          param.transpose_Y,
+          m,
+          n,
+          k,
+          param.alpha,
+          x->data<float>(),
+          k,
+          reinterpret_cast<const uint16_t *>(y->data<int16_t>()),
+          y->dims()[1],
+          0.f,
+          out->mutable_data<float>(),
+          n);
+      return;
+    }
+
     auto blas = lite::x86::math::GetBlas<lite::TargetType::kX86, T>(context);
     auto mat_dim_a = lite::x86::math::CreateMatrixDescriptor(
         RowMatrixFromVector(x->dims()), 0, param.transpose_X);
@@ -70,6 +102,114 @@ class MatMulCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
   virtual ~MatMulCompute() = default;
 };
 
+/// The int8 matmul with the per tensor scales, `input_scale` of X and
+/// `weight_scale[0]` of Y. Y is broadcast if it has no batch.
+template <PrecisionType OutType>
+class MatMulInt8Compute : public KernelLite<TARGET(kX86), PRECISION(kInt8)> {
+ public:
+  using param_t = operators::MatMulParam;
+  using out_t = typename std::
+      conditional<OutType == PRECISION(kInt8), int8_t, float>::type;
+
+  void PrepareForRun() override {
+    auto &param = *param_.get_mutable<operators::MatMulParam>();
+    // A constant Y is transposed to the [N, K] operands once.
+    y_transposed_ = param.Y->persistable() && !param.transpose_Y;
+    y_comp_.clear();
+    if (!y_transposed_) return;
+    auto y_dims = ColumnMatrixFromVector(param.Y->dims());
+    const int rank_y = y_dims.size();
+    const int k = y_dims[rank_y - 2];
+    const int n = y_dims[rank_y - 1];
+    const int batch_y = y_dims.count(0, rank_y - 2);
+    y_trans_.Resize({batch_y, n, k});
+    const int8_t *y_data = param.Y->data<int8_t>();
+    int8_t *y_trans_data = y_trans_.mutable_data<int8_t>();
+    for (int b = 0; b < batch_y; ++b) {
+      lite::x86::math::transpose_s8(
+          y_data + b * k * n, k, n, n, y_trans_data + b * k * n);
+      auto comp = lite::x86::math::gemm_s8_compensation(
+          n, k, y_trans_data + b * k * n, k);
+      y_comp_.insert(y_comp_.end(), comp.begin(), comp.end());
+    }
+  }
+
+  void Run() override {
+    auto &param = *param_.get_mutable<operators::MatMulParam>();
+    CHECK(!param.weight_scale.empty()) << "int8 matmul needs the scale of Y";
+    auto x_dims = RowMatrixFromVector(param.X->dims());
+    auto y_dims = ColumnMatrixFromVector(param.Y->dims());
+    const int rank_x = x_dims.size();
+    const int rank_y = y_dims.size();
+    const int m = x_dims[param.transpose_X ? rank_x - 1 : rank_x - 2];
+    const int k = x_dims[param.transpose_X ? rank_x - 2 : rank_x - 1];
+    const int n = y_dims[param.transpose_Y ? rank_y - 2 : rank_y - 1];
+    CHECK_EQ(k, y_dims[param.transpose_Y ? rank_y - 1 : rank_y - 2]);
+    const int batch_x = x_dims.count(0, rank_x - 2);
+    const int batch_y = y_dims.count(0, rank_y - 2);
+    CHECK(batch_y == 1 || batch_y == batch_x)
+        << "the batch of Y must be 1 or equal to the batch of X";
+
+    float out_scale = OutType == PRECISION(kInt8) ? param.output_scale : 1.f;
+    scale_.assign(
+        m, param.alpha * param.input_scale * param.weight_scale[0] / out_scale);
+    const int8_t *x_data = param.X->data<int8_t>();
+    const int8_t *y_data = param.Y->data<int8_t>();
+    out_t *out_data = param.Out->mutable_data<out_t>();
+    // The operands of gemm_s8 are [M, K] and [N, K].
+    if (param.transpose_X) {
+      x_trans_.Resize({batch_x, m, k});
+    }
+    if (!param.transpose_Y && !y_transposed_) {
+      y_trans_.Resize({batch_y, n, k});
+    }
+    for (int b = 0; b < batch_x; ++b) {
+      const int8_t *a = x_data + b * m * k;
+      if (param.transpose_X) {
+        int8_t *a_trans = x_trans_.mutable_data<int8_t>() + b * m * k;
+        lite::x86::math::transpose_s8(a, k, m, m, a_trans);
+        a = a_trans;
+      }
+      const int by = batch_y == 1 ? 0 : b;
+      const int8_t *w = y_data + by * k * n;
+      if (!param.transpose_Y) {
+        int8_t *w_trans = y_trans_.mutable_data<int8_t>() + by * k * n;
+        if (b == by && !y_transposed_) {
+          lite::x86::math::transpose_s8(w, k, n, n, w_trans);
+        }
+        w = w_trans;
+      }
+      lite::x86::math::gemm_s8<out_t>(m,
+                                      n,
+                                      k,
+                                      a,
+                                      k,
+                                      w,
+                                      k,
+                                      out_data + b * m * n,
+                                      n,
+                                      scale_.data(),
+                                      nullptr,
+                                      true,
+                                      false,
+                                      y_comp_.empty()
+                                          ? nullptr
+                                          : y_comp_.data() + by * n);
+    }
+  }
+
+  virtual ~MatMulInt8Compute() = default;
+
+ private:
+  std::vector<float> scale_;
+  lite::Tensor x_trans_;
+  lite::Tensor y_trans_;
+  // Whether y_trans_ holds the constant Y transposed in PrepareForRun.
+  bool y_transposed_{false};
+  // The compensation of the constant Y for gemm_s8.
+  std::vector<int32_t> y_comp_;
+};
+
 }  // namespace x86
 }  // namespace kernels
 }  // namespace lite
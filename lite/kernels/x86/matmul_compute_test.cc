@@ -14,11 +14,14 @@
 
 #include "lite/kernels/x86/matmul_compute.h"
 #include <gtest/gtest.h>
+#include <cmath>
 #include <iostream>
 #include <memory>
 #include <utility>
 #include <vector>
+#include "lite/backends/x86/parallel.h"
 #include "lite/core/op_registry.h"
+#include "lite/utils/half.h"
 namespace paddle {
 namespace lite {
 namespace kernels {
@@ -79,6 +82,106 @@ TEST(matmul_x86, run_test) {
   }
 }
 
+TEST(matmul_x86, int8) {
+  // X: [2, 3, 40] transposed to [2, 40, 3], Y: [40, 4] broadcast, a constant
+  // Y is transposed once in PrepareForRun.
+  for (bool persistable : {false, true}) {
+    lite::Tensor x, y, out;
+    x.Resize({2, 40, 3});
+    y.Resize({40, 4});
+    y.set_persistable(persistable);
+    out.Resize({2, 3, 4});
+    auto x_data = x.mutable_data<int8_t>();
+    auto y_data = y.mutable_data<int8_t>();
+    for (int64_t i = 0; i < x.numel(); i++) {
+      x_data[i] = static_cast<int8_t>((i * 3) % 255 - 127);
+    }
+    for (int64_t i = 0; i < y.numel(); i++) {
+      y_data[i] = static_cast<int8_t>((i * 11) % 255 - 127);
+    }
+    MatMulInt8Compute<PRECISION(kFloat)> matmul;
+    operators::MatMulParam param;
+    param.X = &x;
+    param.Y = &y;
+    param.Out = &out;
+    param.transpose_X = true;
+    param.alpha = 2.f;
+    param.input_scale = 0.1f;
+    param.weight_scale = {0.01f};
+
+    std::unique_ptr<KernelContext> ctx(new KernelContext);
+    ctx->As<X86Context>();
+    matmul.SetContext(std::move(ctx));
+    matmul.SetParam(param);
+    matmul.PrepareForRun();
+    for (int run = 0; run < 2; run++) {
+      matmul.Run();
+
+      auto out_data = out.data<float>();
+      for (int b = 0; b < 2; b++) {
+        for (int i = 0; i < 3; i++) {
+          for (int j = 0; j < 4; j++) {
+            int sum = 0;
+            for (int k = 0; k < 40; k++) {
+              sum += x_data[(b * 40 + k) * 3 + i] * y_data[k * 4 + j];
+            }
+            float ref = sum * 2.f * 0.1f * 0.01f;
+            EXPECT_NEAR(out_data[(b * 3 + i) * 4 + j],
+                        ref,
+                        1e-3 * std::abs(ref) + 1e-5);
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST(matmul_x86, half_weights) {
+  // X: [2, 3, 40], Y: [70, 40] in bf16 transposed and broadcast
+  lite::x86::SetNumThreads(2);
+  lite::Tensor x, y, out;
+  x.Resize({2, 3, 40});
+  y.Resize({70, 40});
+  out.Resize({2, 3, 70});
+  auto x_data = x.mutable_data<float>();
+  for (int64_t i = 0; i < x.numel(); i++) {
+    x_data[i] = static_cast<float>(i % 11) * 0.1f - 0.5f;
+  }
+  auto y_data = y.mutable_data<int16_t>();
+  for (int64_t i = 0; i < y.numel(); i++) {
+    float v = static_cast<float>(i % 9) * 0.07f - 0.3f;
+    y_data[i] = static_cast<int16_t>(FloatToBFloat16(v));
+  }
+  y.set_precision(PRECISION(kInt16));
+  MatMulCompute<float> matmul;
+  operators::MatMulParam param;
+  param.X = &x;
+  param.Y = &y;
+  param.Out = &out;
+  param.transpose_Y = true;
+  param.alpha = 2.f;
+  param.weight_quant_type = "bf16";
+
+  std::unique_ptr<KernelContext> ctx(new KernelContext);
+  ctx->As<X86Context>();
+  matmul.SetContext(std::move(ctx));
+  matmul.SetParam(param);
+  matmul.Run();
+
+  auto out_data = out.data<float>();
+  for (int i = 0; i < 6; i++) {
+    for (int j = 0; j < 70; j++) {
+      float ref = 0.f;
+      for (int k = 0; k < 40; k++) {
+        ref += x_data[i * 40 + k] *
+               BFloat16ToFloat(static_cast<uint16_t>(y_data[j * 40 + k]));
+      }
+      EXPECT_NEAR(out_data[i * 70 + j], ref * 2.f, 1e-4);
+    }
+  }
+  lite::x86::SetNumThreads(1);
+}
+
 }  // namespace x86
 }  // namespace kernels
 }  // namespace lite
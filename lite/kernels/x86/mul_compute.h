@@ -13,7 +13,11 @@
 // limitations under the License.
 #pragma once
 
+#include <type_traits>
+#include <vector>
 #include "lite/backends/x86/math/blas.h"
+#include "lite/backends/x86/math/gemm_s8.h"
+#include "lite/backends/x86/math/gemm_w16.h"
 #include "lite/core/kernel.h"
 #include "lite/core/op_registry.h"
 #include "lite/core/types.h"
@@ -49,6 +53,33 @@ class MulCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
     auto* x = param.x;
     auto* y = param.y;
 
+    if (!param.weight_quant_type.empty()) {
+      // Y is stored in 16 bits by the weight_half_quantization_pass.
+      CHECK(y->precision() == PRECISION(kInt16));
+      auto x_dims = x->dims().Flatten2D(param.x_num_col_dims);
+      auto y_dims = y->dims().Flatten2D(param.y_num_col_dims);
+      int m = x_dims[0];
+      int k = x_dims[1];
+      int n = y_dims[1];
+      CHECK_EQ(k, y_dims[0]);
+      lite::x86::math::gemm_w16(
+          context,
+          lite::x86::math::GetW16Type(param.weight_quant_type),
+          false,
+          m,
+          n,
+          k,
+          1.f,
+          x->data<float>(),
+          k,
+          reinterpret_cast<const uint16_t*>(y->data<int16_t>()),
+          n,
+          0.f,
+          z->mutable_data<float>(),
+          n);
+      return;
+    }
+
     Tensor x_matrix, y_matrix;
 
     if (x->dims().size() > 2) {
@@ -81,6 +112,78 @@ class MulCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
   virtual ~MulCompute() = default;
 };
 
+/// The int8 mul of the quantized models, Y is the weights with the per output
+/// channel scales.
+template <PrecisionType OutType>
+class MulInt8Compute : public KernelLite<TARGET(kX86), PRECISION(kInt8)> {
+ public:
+  using param_t = operators::MulParam;
+  using out_t = typename std::
+      conditional<OutType == PRECISION(kInt8), int8_t, float>::type;
+
+  void PrepareForRun() override {
+    auto& param = *param_.get_mutable<operators::MulParam>();
+    auto y_dims = param.y->dims().Flatten2D(param.y_num_col_dims);
+    k_ = y_dims[0];
+    n_ = y_dims[1];
+    // The weights [K, N] are transposed once to [N, K].
+    weights_.Resize({n_, k_});
+    lite::x86::math::transpose_s8(
+        param.y->data<int8_t>(), k_, n_, n_, weights_.mutable_data<int8_t>());
+    comp_ = lite::x86::math::gemm_s8_compensation(
+        n_, k_, weights_.data<int8_t>(), k_);
+
+    scale_ = param.weight_scale;
+    CHECK(scale_.size() == 1U || static_cast<int>(scale_.size()) == n_)
+        << "weights scale size must equal to the output channels";
+    scale_.resize(n_, scale_[0]);
+    float out_scale = OutType == PRECISION(kInt8) ? param.output_scale : 1.f;
+    for (auto& ws : scale_) {
+      ws = ws * param.input_scale / out_scale;
+    }
+  }
+
+  void Run() override {
+    auto& param = *param_.get_mutable<operators::MulParam>();
+    int m = param.x->dims().Flatten2D(param.x_num_col_dims)[0];
+    lite::x86::math::gemm_s8<out_t>(m,
+                                    n_,
+                                    k_,
+                                    param.x->data<int8_t>(),
+                                    k_,
+                                    weights_.data<int8_t>(),
+                                    k_,
+                                    param.output->mutable_data<out_t>(),
+                                    n_,
+                                    scale_.data(),
+                                    nullptr,
+                                    false,
+                                    false,
+                                    comp_.empty() ? nullptr : comp_.data());
+  }
+
+  virtual ~MulInt8Compute() = default;
+
+ protected:
+  bool ShareWeights(const KernelBase& other) override {
+    const auto& src = static_cast<const MulInt8Compute&>(other);
+    k_ = src.k_;
+    n_ = src.n_;
+    weights_.ShareDataWith(src.weights_);
+    comp_ = src.comp_;
+    scale_ = src.scale_;
+    return true;
+  }
+
+ private:
+  int k_{0};
+  int n_{0};
+  lite::Tensor weights_;
+  // The compensation of the weights for gemm_s8.
+  std::vector<int32_t> comp_;
+  std::vector<float> scale_;
+};
+
 }  // namespace x86
 }  // namespace kernels
 }  // namespace lite
@@ -14,11 +14,14 @@
 
 #include "lite/kernels/x86/mul_compute.h"
 #include <gtest/gtest.h>
+#include <cmath>
 #include <iostream>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 #include "lite/core/op_registry.h"
+#include "lite/utils/half.h"
 namespace paddle {
 namespace lite {
 namespace kernels {
@@ -78,6 +81,98 @@ TEST(mul_x86, run_test) {
   }
 }
 
+TEST(mul_x86, int8) {
+  // M = 3, K = 70, N = 5, the scales are per output channel
+  lite::Tensor x, y, out;
+  x.Resize({3, 70});
+  y.Resize({70, 5});
+  out.Resize({3, 5});
+  auto x_data = x.mutable_data<int8_t>();
+  auto y_data = y.mutable_data<int8_t>();
+  for (int64_t i = 0; i < x.numel(); i++) {
+    x_data[i] = static_cast<int8_t>(i % 255 - 127);
+  }
+  for (int64_t i = 0; i < y.numel(); i++) {
+    y_data[i] = static_cast<int8_t>((i * 5) % 255 - 127);
+  }
+  MulInt8Compute<PRECISION(kFloat)> mul;
+  operators::MulParam param;
+  param.x = &x;
+  param.y = &y;
+  param.output = &out;
+  param.input_scale = 0.5f;
+  param.weight_scale = {0.01f, 0.02f, 0.03f, 0.04f, 0.05f};
+
+  std::unique_ptr<KernelContext> ctx(new KernelContext);
+  ctx->As<X86Context>();
+  mul.SetContext(std::move(ctx));
+  mul.SetParam(param);
+  mul.PrepareForRun();
+  mul.Run();
+
+  auto out_data = out.data<float>();
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 5; j++) {
+      int sum = 0;
+      for (int k = 0; k < 70; k++) {
+        sum += x_data[i * 70 + k] * y_data[k * 5 + j];
+      }
+      float ref = sum * param.input_scale * param.weight_scale[j];
+      EXPECT_NEAR(out_data[i * 5 + j], ref, 1e-3 * std::abs(ref) + 1e-5);
+    }
+  }
+}
+
+TEST(mul_x86, half_weights) {
+  // K and N cover several panels of the 16 bits weights and their tails.
+  const int m = 3, k = 1100, n = 70;
+  for (std::string quant_type : {"fp16", "bf16"}) {
+    lite::Tensor x, y, out;
+    x.Resize({m, k});
+    y.Resize({k, n});
+    out.Resize({m, n});
+    auto x_data = x.mutable_data<float>();
+    for (int64_t i = 0; i < x.numel(); i++) {
+      x_data[i] = static_cast<float>(i % 13) * 0.1f - 0.6f;
+    }
+    auto y_data = y.mutable_data<int16_t>();
+    std::vector<float> y_ref(y.numel());
+    for (int64_t i = 0; i < y.numel(); i++) {
+      float v = static_cast<float>(i % 17) * 0.03f - 0.25f;
+      uint16_t bits =
+          quant_type == "fp16" ? FloatToHalf(v) : FloatToBFloat16(v);
+      y_data[i] = static_cast<int16_t>(bits);
+      y_ref[i] = quant_type == "fp16" ? HalfToFloat(bits)
+                                      : BFloat16ToFloat(bits);
+    }
+    y.set_precision(PRECISION(kInt16));
+
+    MulCompute<float> mul;
+    operators::MulParam param;
+    param.x = &x;
+    param.y = &y;
+    param.output = &out;
+    param.weight_quant_type = quant_type;
+
+    std::unique_ptr<KernelContext> ctx(new KernelContext);
+    ctx->As<X86Context>();
+    mul.SetContext(std::move(ctx));
+    mul.SetParam(param);
+    mul.Run();
+
+    auto out_data = out.data<float>();
+    for (int i = 0; i < m; i++) {
+      for (int j = 0; j < n; j++) {
+        float ref = 0.f;
+        for (int l = 0; l < k; l++) {
+          ref += x_data[i * k + l] * y_ref[l * n + j];
+        }
+        EXPECT_NEAR(out_data[i * n + j], ref, 1e-3 * std::abs(ref) + 1e-3);
+      }
+    }
+  }
+}
+
 }  // namespace x86
 }  // namespace kernels
 }  // namespace lite
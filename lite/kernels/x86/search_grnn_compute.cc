@@ -16,6 +16,7 @@
 #include <algorithm>
 #include <vector>
 #include "lite/backends/x86/math/blas.h"
+#include "lite/backends/x86/math/sequence_layout.h"
 
 namespace paddle {
 namespace lite {
@@ -63,53 +64,17 @@ void SearchGrnnCompute<T>::PrepareLayout(const Tensor* input_blob) {
   int batch = _input->lod()[0].size() - 1;
   auto& offset = _input->lod()[0];
 
-  Tensor _width;
-  _width.Resize({batch});
+  // the sequences sorted by width (descending) and the time major offsets,
+  // shared with the other sequence kernels running on the same lod
+  auto layout = lite::x86::math::GetSequenceLayout(offset);
   _idx_sorted_by_width->Resize({batch});
-  int* width_data = _width.template mutable_data<int>();
   int* idx_sorted_by_width_data =
       _idx_sorted_by_width->template mutable_data<int>();
-  // sort sequence by width (descending) and find the largest width in the
-  // batch
-  for (int i = 0; i < batch; i++) {
-    width_data[i] = offset[i + 1] - offset[i];
-    idx_sorted_by_width_data[i] = i;
-  }
-  std::sort(idx_sorted_by_width_data,
-            idx_sorted_by_width_data + batch,
-            [&_width](int a, int b) {
-              return _width.template data<int>()[a] >
-                     _width.template data<int>()[b];
-            });
-  int max_width = width_data[idx_sorted_by_width_data[0]];
-
-  // start of reorganizing the input
-  std::vector<size_t> new_offset;
-  new_offset.resize(max_width + 1);
-
-  new_offset[0] = 0;
-  int j = batch - 1;
-  int last_width = 0;
-  int sub_row = 0;
-  int sub_col = 0;
-
-  for (int i = 1; i <= max_width;) {
-    for (int k = j; k >= 0; --k) {
-      if (width_data[idx_sorted_by_width_data[k]] > last_width) {
-        sub_row = width_data[idx_sorted_by_width_data[k]] - last_width;
-        sub_col = k + 1;
-
-        for (int s = 0; s < sub_row; s++) {
-          new_offset[i] = new_offset[i - 1] + sub_col;
-          i++;
-        }
-        // move on
-        last_width = width_data[idx_sorted_by_width_data[k]];
-        j = k - 1;
-        break;
-      }
-    }
-  }
+  std::copy(layout->sorted_idx.begin(),
+            layout->sorted_idx.end(),
+            idx_sorted_by_width_data);
+  int max_width = layout->max_length;
+  const auto& new_offset = layout->step_offset;
 
   // copying to the reorganized buffer
   if (_input->dims().size() == 1) {
@@ -170,7 +135,6 @@ void SearchGrnnCompute<T>::Run() {
   int _cap_e = param.num_input;
 
   int _cap_l = bottom->dims()[0];
-  int batch = bottom->lod()[0].size() - 1;
 
   const auto& offset = bottom->lod()[0];
   LoD top_lod;
@@ -183,13 +147,6 @@ void SearchGrnnCompute<T>::Run() {
   const auto* dense_e2h = wi->template data<T>();
   const auto* dense_h2h = wh->template data<T>();
 
-  const auto* e2h = dense_e2h;
-  const auto* e2hr = dense_e2h + 1 * _cap_e * _cap_h;
-  const auto* e2hz = dense_e2h + 2 * _cap_e * _cap_h;
-  const auto* h2h = dense_h2h;
-  const auto* h2hr = dense_h2h + 1 * _cap_h * _cap_h;
-  const auto* h2hz = dense_h2h + 2 * _cap_h * _cap_h;
-
   PrepareLayout(bottom);
 
   auto* _layout_input = param.layout_input;
@@ -201,58 +158,41 @@ void SearchGrnnCompute<T>::Run() {
   // buffer also needed in bp, so make it larger
   _buffer->Resize({20, _cap_l, _cap_h});
   auto* buffer_data = _buffer->template mutable_data<T>();
-  auto* w_x_e = buffer_data + 0 * _cap_l * _cap_h;
-  auto* wr_x_e = buffer_data + 1 * _cap_l * _cap_h;
-  auto* wz_x_e = buffer_data + 2 * _cap_l * _cap_h;
+  // the projections of the three gates are computed together, a row of
+  // x_e (u_x_h) is [w_x_e, wr_x_e, wz_x_e] ([u_x_h, ur_x_h, uz_x_h])
+  int _cap_g = 3 * _cap_h;
+  auto* x_e = buffer_data + 0 * _cap_l * _cap_h;
   auto* u_x_h = buffer_data + 3 * _cap_l * _cap_h;
-  auto* ur_x_h = buffer_data + 4 * _cap_l * _cap_h;
-  auto* uz_x_h = buffer_data + 5 * _cap_l * _cap_h;
   auto* r = buffer_data + 6 * _cap_l * _cap_h;
   auto* z = buffer_data + 7 * _cap_l * _cap_h;
   auto* tilde = buffer_data + 8 * _cap_l * _cap_h;
   // the internal hidden
   auto* hidden = buffer_data + 19 * _cap_l * _cap_h;
 
+  // wi (wh) is [3, cap_h, cap_e] ([3, cap_h, cap_h]), i.e. the weights of the
+  // three gates stacked as [3 * cap_h, cap_e] ([3 * cap_h, cap_h])
   auto blas = lite::x86::math::GetBlas<TARGET(kX86), T>(context);
   CallGemm(blas,
            CblasNoTrans,
            CblasTrans,
            _cap_l,
-           _cap_h,
-           _cap_e,
-           1.0f,
-           new_emb,
-           e2h,
-           0.0f,
-           w_x_e);
-  CallGemm(blas,
-           CblasNoTrans,
-           CblasTrans,
-           _cap_l,
-           _cap_h,
-           _cap_e,
-           1.0f,
-           new_emb,
-           e2hr,
-           0.0f,
-           wr_x_e);
-  CallGemm(blas,
-           CblasNoTrans,
-           CblasTrans,
-           _cap_l,
-           _cap_h,
+           _cap_g,
            _cap_e,
            1.0f,
            new_emb,
-           e2hz,
+           dense_e2h,
            0.0f,
-           wz_x_e);
+           x_e);
 
   // precompute hidden0
-  for (int i = 0; i < batch * _cap_h; i++) {
-    tilde[i] = std::tanh(w_x_e[i]);
-    z[i] = sigmoid<T>(wz_x_e[i]);
-    hidden[i] = (1. - z[i]) * tilde[i];
+  for (size_t row = 0; row < new_offset[1]; row++) {
+    const auto* xe_row = x_e + row * _cap_g;
+    for (int c = 0; c < _cap_h; c++) {
+      int j = row * _cap_h + c;
+      tilde[j] = std::tanh(xe_row[c]);
+      z[j] = sigmoid<T>(xe_row[2 * _cap_h + c]);
+      hidden[j] = (1. - z[j]) * tilde[j];
+    }
   }
 
   // recurrence
@@ -267,43 +207,26 @@ void SearchGrnnCompute<T>::Run() {
              CblasNoTrans,
              CblasTrans,
              w,
-             _cap_h,
+             _cap_g,
              _cap_h,
              1.0f,
              htm1,
-             h2h,
+             dense_h2h,
              0.0f,
-             u_x_h + new_offset[i] * _cap_h);
-    CallGemm(blas,
-             CblasNoTrans,
-             CblasTrans,
-             w,
-             _cap_h,
-             _cap_h,
-             1.0f,
-             htm1,
-             h2hr,
-             0.0f,
-             ur_x_h + new_offset[i] * _cap_h);
-    CallGemm(blas,
-             CblasNoTrans,
-             CblasTrans,
-             w,
-             _cap_h,
-             _cap_h,
-             1.0f,
-             htm1,
-             h2hz,
-             0.0f,
-             uz_x_h + new_offset[i] * _cap_h);
+             u_x_h + new_offset[i] * _cap_g);
 
     // compute the gate and hidden
-    for (size_t j = new_offset[i] * _cap_h; j < (new_offset[i] + w) * _cap_h;
-         j++) {
-      r[j] = sigmoid(wr_x_e[j] + ur_x_h[j]);
-      z[j] = sigmoid(wz_x_e[j] + uz_x_h[j]);
-      tilde[j] = std::tanh(w_x_e[j] + r[j] * u_x_h[j]);
-      hidden[j] = z[j] * hidden[j - _cap_h * w_tm1] + (1.0 - z[j]) * tilde[j];
+    for (size_t row = new_offset[i]; row < new_offset[i] + w; row++) {
+      const auto* xe_row = x_e + row * _cap_g;
+      const auto* uh_row = u_x_h + row * _cap_g;
+      for (int c = 0; c < _cap_h; c++) {
+        int j = row * _cap_h + c;
+        r[j] = sigmoid(xe_row[_cap_h + c] + uh_row[_cap_h + c]);
+        z[j] = sigmoid(xe_row[2 * _cap_h + c] + uh_row[2 * _cap_h + c]);
+        tilde[j] = std::tanh(xe_row[c] + r[j] * uh_row[c]);
+        hidden[j] =
+            z[j] * hidden[j - _cap_h * w_tm1] + (1.0 - z[j]) * tilde[j];
+      }
     }
   }
 
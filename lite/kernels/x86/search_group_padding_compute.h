@@ -14,6 +14,7 @@
 #pragma once
 
 #include <vector>
+#include "lite/backends/x86/math/sequence_layout.h"
 #include "lite/core/kernel.h"
 #include "lite/core/op_registry.h"
 
@@ -43,12 +44,7 @@ class SearchGroupPaddingCompute
     int dim1 = bottom0->dims()[1];
 
     const auto offset = bottom0->lod()[0];
-    int max_seq = 0;
-    for (int i = 0; i < batch; ++i) {
-      if (offset[i + 1] - offset[i] > max_seq) {
-        max_seq = offset[i + 1] - offset[i];
-      }
-    }
+    int max_seq = lite::x86::math::GetSequenceLayout(offset)->max_length;
 
     std::vector<size_t> new_offset;
     new_offset.resize(batch + 1);
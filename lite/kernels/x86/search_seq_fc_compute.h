@@ -14,6 +14,7 @@
 #pragma once
 
 #include "lite/backends/x86/math/blas.h"
+#include "lite/backends/x86/parallel.h"
 #include "lite/core/kernel.h"
 #include "lite/core/op_registry.h"
 #include "lite/core/types.h"
@@ -57,10 +58,13 @@ class SearchSeqFcCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
       CHECK_EQ(b_dims[0], w_dims[0]) << "Wrong shape: b_dims[0] != w_dims[0]";
       int M = x_dims[0];
       int N = w_dims[0];
-      for (int i = 0; i < M; i++) {
-        blas.AXPY(
-            N, static_cast<T>(1), b->data<T>(), out->mutable_data<T>() + i * N);
-      }
+      const T* b_data = b->data<T>();
+      T* out_data = out->mutable_data<T>();
+      lite::x86::RunParallelFor(0, M, [&](int64_t begin, int64_t end) {
+        for (int64_t i = begin; i < end; i++) {
+          blas.AXPY(N, static_cast<T>(1), b_data, out_data + i * N);
+        }
+      });
     }
   }
 
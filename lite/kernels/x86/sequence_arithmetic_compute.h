@@ -15,6 +15,7 @@
 #pragma once
 #include <algorithm>
 #include <cstring>
+#include "lite/backends/x86/parallel.h"
 #include "lite/core/kernel.h"
 #include "lite/core/op_registry.h"
 
@@ -47,59 +48,38 @@ class SequenceArithmeticCompute
     int seq_num = x_seq_offset.size() - 1;
     int inner_size = (x->numel()) / (x->dims()[0]);
 
-    // sum
-    if (op_type == 1) {
-      for (int i = 0; i < seq_num; i++) {
-        int len_x = (x_seq_offset[i + 1] - x_seq_offset[i]) * inner_size;
-        int len_y = (y_seq_offset[i + 1] - y_seq_offset[i]) * inner_size;
-        auto input_x = x_data + x_seq_offset[i] * inner_size;
-        auto input_y = y_data + y_seq_offset[i] * inner_size;
-        auto t_out = out_data + x_seq_offset[i] * inner_size;
-        int len = std::min(len_x, len_y);
-        for (int j = 0; j < len; j++) {
-          t_out[j] = input_x[j] + input_y[j];
-        }
-        if (len_x > len) {
-          memcpy(t_out + len, input_x + len, sizeof(T) * (len_x - len));
-        }
-      }
-    }
-
-    // sub
-    if (op_type == 2) {
-      for (int i = 0; i < seq_num; i++) {
-        int len_x = (x_seq_offset[i + 1] - x_seq_offset[i]) * inner_size;
-        int len_y = (y_seq_offset[i + 1] - y_seq_offset[i]) * inner_size;
-        auto input_x = x_data + x_seq_offset[i] * inner_size;
-        auto input_y = y_data + y_seq_offset[i] * inner_size;
-        auto t_out = out_data + x_seq_offset[i] * inner_size;
-        int len = std::min(len_x, len_y);
-        for (int j = 0; j < len; j++) {
-          t_out[j] = input_x[j] - input_y[j];
-        }
-        if (len_x > len) {
-          memcpy(t_out + len, input_x + len, sizeof(T) * (len_x - len));
-        }
-      }
-    }
-
-    // mul
-    if (op_type == 3) {
-      for (int i = 0; i < seq_num; i++) {
-        int len_x = (x_seq_offset[i + 1] - x_seq_offset[i]) * inner_size;
-        int len_y = (y_seq_offset[i + 1] - y_seq_offset[i]) * inner_size;
-        auto input_x = x_data + x_seq_offset[i] * inner_size;
-        auto input_y = y_data + y_seq_offset[i] * inner_size;
-        auto t_out = out_data + x_seq_offset[i] * inner_size;
-        int len = std::min(len_x, len_y);
-        for (int j = 0; j < len; j++) {
-          t_out[j] = input_x[j] * input_y[j];
-        }
-        if (len_x > len) {
-          memcpy(t_out + len, input_x + len, sizeof(T) * (len_x - len));
-        }
-      }
-    }
+    lite::x86::RunParallelForSegments(
+        x_seq_offset, [&](int64_t begin, int64_t end) {
+          for (int64_t i = begin; i < end; i++) {
+            int len_x = (x_seq_offset[i + 1] - x_seq_offset[i]) * inner_size;
+            int len_y = (y_seq_offset[i + 1] - y_seq_offset[i]) * inner_size;
+            auto input_x = x_data + x_seq_offset[i] * inner_size;
+            auto input_y = y_data + y_seq_offset[i] * inner_size;
+            auto t_out = out_data + x_seq_offset[i] * inner_size;
+            int len = std::min(len_x, len_y);
+            // sum
+            if (op_type == 1) {
+              for (int j = 0; j < len; j++) {
+                t_out[j] = input_x[j] + input_y[j];
+              }
+            }
+            // sub
+            if (op_type == 2) {
+              for (int j = 0; j < len; j++) {
+                t_out[j] = input_x[j] - input_y[j];
+              }
+            }
+            // mul
+            if (op_type == 3) {
+              for (int j = 0; j < len; j++) {
+                t_out[j] = input_x[j] * input_y[j];
+              }
+            }
+            if (op_type >= 1 && op_type <= 3 && len_x > len) {
+              memcpy(t_out + len, input_x + len, sizeof(T) * (len_x - len));
+            }
+          }
+        });
   }
 
   virtual ~SequenceArithmeticCompute() = default;
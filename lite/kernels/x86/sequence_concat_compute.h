@@ -14,6 +14,7 @@
 #pragma once
 
 #include <vector>
+#include "lite/backends/x86/parallel.h"
 #include "lite/core/kernel.h"
 #include "lite/core/op_registry.h"
 
@@ -88,13 +89,19 @@ class SequenceConcatCompute
       input_cols[i] = x_in_order[i].numel() / out_rows;
     }
 
-    int col_idx = 0;
+    // the output offsets of the sequences in order
+    std::vector<int64_t> col_offset(num + 1, 0);
     for (int j = 0; j < num; ++j) {
-      int col_len = input_cols[j];
-      auto input_data = x_in_order[j].data<T>();
-      memcpy(dout + col_idx, input_data, sizeof(T) * col_len);
-      col_idx += col_len;
+      col_offset[j + 1] = col_offset[j] + input_cols[j];
     }
+    lite::x86::RunParallelForSegments(
+        col_offset, [&](int64_t begin, int64_t end) {
+          for (int64_t j = begin; j < end; ++j) {
+            memcpy(dout + col_offset[j],
+                   x_in_order[j].data<T>(),
+                   sizeof(T) * input_cols[j]);
+          }
+        });
   }
 
   virtual ~SequenceConcatCompute() = default;
@@ -15,6 +15,7 @@
 
 #include <string>
 #include <vector>
+#include "lite/backends/x86/parallel.h"
 #include "lite/core/kernel.h"
 #include "lite/core/op_registry.h"
 #include "lite/core/types.h"
@@ -38,18 +39,22 @@ struct SequenceExpandFunctor {
     const T *in_data = x.data<T>();
     T *out_data = out->mutable_data<T, T>();
 
-    for (int h_id = 0; h_id < hight; ++h_id) {
-      size_t span = ref_lod[h_id + 1] - ref_lod[h_id];
-      if (span == 0) continue;
-      const T *src = in_data + h_id * width;
-      for (int64_t w_id = 0; w_id < width; ++w_id) {
-        T ele = src[w_id];
-        size_t offset = ref_lod[h_id] * width;
-        for (size_t k = 0; k < span; ++k) {
-          out_data[offset + k * width + w_id] = ele;
-        }
-      }
-    }
+    CHECK_EQ(ref_lod.size(), static_cast<size_t>(hight + 1));
+    lite::x86::RunParallelForSegments(
+        ref_lod, [&](int64_t begin, int64_t end) {
+          for (int64_t h_id = begin; h_id < end; ++h_id) {
+            size_t span = ref_lod[h_id + 1] - ref_lod[h_id];
+            if (span == 0) continue;
+            const T *src = in_data + h_id * width;
+            for (int64_t w_id = 0; w_id < width; ++w_id) {
+              T ele = src[w_id];
+              size_t offset = ref_lod[h_id] * width;
+              for (size_t k = 0; k < span; ++k) {
+                out_data[offset + k * width + w_id] = ele;
+              }
+            }
+          }
+        });
   }
 };
 
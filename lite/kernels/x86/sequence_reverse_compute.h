@@ -14,6 +14,7 @@
 #pragma once
 
 #include <vector>
+#include "lite/backends/x86/parallel.h"
 #include "lite/core/kernel.h"
 #include "lite/core/op_registry.h"
 
@@ -36,21 +37,22 @@ class SequenceReverseCompute : public KernelLite<TARGET(kX86), Ptype> {
     CHECK_NE(din, dout)
         << "SequenceReverse Op does not support in-place operation";
     const auto lod = param.X->lod()[param.X->lod().size() - 1];
-    const size_t lod_count = lod.size();
 
     size_t limit = static_cast<size_t>(param.X->numel());
     size_t row_numel = static_cast<size_t>(limit / param.X->dims()[0]);
 
-    for (size_t idx = 0; idx < lod_count - 1; ++idx) {
-      auto start_pos = lod[idx];
-      auto end_pos = lod[idx + 1];
-      for (auto pos = start_pos; pos < end_pos; ++pos) {
-        auto cur_pos = end_pos - pos - 1 + start_pos;
-        std::memcpy(dout + pos * row_numel,
-                    din + cur_pos * row_numel,
-                    row_numel * sizeof(T));
+    lite::x86::RunParallelForSegments(lod, [&](int64_t begin, int64_t end) {
+      for (int64_t idx = begin; idx < end; ++idx) {
+        auto start_pos = lod[idx];
+        auto end_pos = lod[idx + 1];
+        for (auto pos = start_pos; pos < end_pos; ++pos) {
+          auto cur_pos = end_pos - pos - 1 + start_pos;
+          std::memcpy(dout + pos * row_numel,
+                      din + cur_pos * row_numel,
+                      row_numel * sizeof(T));
+        }
       }
-    }
+    });
     output->set_lod(param.X->lod());
   }
 
@@ -0,0 +1,359 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/kernels/x86/subgraph_compute.h"
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <set>
+#include <utility>
+#include "lite/backends/x86/jit/helper.h"
+#include "lite/backends/x86/jit/kernels.h"
+#include "lite/backends/x86/parallel.h"
+#include "lite/core/framework.pb.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace x86 {
+
+namespace {
+
+using fused_attr_t = jit::fused_elementwise_attr_t;
+
+// The elements computed by a thread at a time.
+constexpr int64_t kElementsPerTask = 4096;
+
+bool GetFusedType(const cpp::OpDesc& op_desc,
+                  jit::FusedElementwiseType* type) {
+  static const std::map<std::string, jit::FusedElementwiseType> types{
+      {"elementwise_add", jit::kFusedAdd},
+      {"elementwise_sub", jit::kFusedSub},
+      {"elementwise_mul", jit::kFusedMul},
+      {"elementwise_div", jit::kFusedDiv},
+      {"elementwise_max", jit::kFusedMax},
+      {"elementwise_min", jit::kFusedMin},
+      {"scale", jit::kFusedScale},
+      {"relu", jit::kFusedRelu},
+      {"exp", jit::kFusedExp},
+      {"sigmoid", jit::kFusedSigmoid},
+      {"tanh", jit::kFusedTanh},
+      {"square", jit::kFusedSquare},
+      {"cast", jit::kFusedIdentity}};
+  auto it = types.find(op_desc.Type());
+  if (it == types.end()) return false;
+  if (op_desc.Type() == "cast") {
+    // Only the casts from float to float, which are copies.
+    const int kFP32 = framework::proto::VarType::FP32;
+    if (op_desc.GetAttr<int>("in_dtype") != kFP32 ||
+        op_desc.GetAttr<int>("out_dtype") != kFP32) {
+      return false;
+    }
+  }
+  *type = it->second;
+  return true;
+}
+
+// The view of y broadcasted to x by an elementwise op, the same as
+// ElementwiseComputeEx except the middle broadcasting, which is not
+// supported.
+bool BroadcastView(const DDim& x_dims,
+                   const DDim& y_dims,
+                   int axis,
+                   int64_t* period,
+                   int64_t* post) {
+  const int x_size = x_dims.size();
+  int y_size = y_dims.size();
+  if (x_size < y_size) return false;
+  axis = axis == -1 ? x_size - y_size : axis;
+  if (axis < 0 || axis >= x_size) return false;
+  // Remove the trailing dimensions of size 1.
+  while (y_size > 0 && y_dims[y_size - 1] == 1) {
+    y_size--;
+  }
+  if (axis + y_size > x_size) return false;
+  *period = 1;
+  *post = 1;
+  for (int i = 0; i < y_size; ++i) {
+    if (y_dims[i] != x_dims[axis + i]) return false;
+    *period *= y_dims[i];
+  }
+  for (int i = axis + y_size; i < x_size; ++i) {
+    *post *= x_dims[i];
+  }
+  if (*period == 1) {
+    *post = 1;
+  }
+  return true;
+}
+
+int64_t GCD(int64_t a, int64_t b) {
+  while (b != 0) {
+    int64_t r = a % b;
+    a = b;
+    b = r;
+  }
+  return a;
+}
+
+}  // namespace
+
+bool SubgraphCompute::BuildSteps() {
+  auto& param = this->Param<param_t>();
+  auto* block_desc = param.sub_block_desc;
+  CHECK(block_desc);
+  const int num_ops = block_desc->OpsSize();
+  if (num_ops == 0 || num_ops > fused_attr_t::kMaxSteps) return false;
+
+  attr_ = fused_attr_t();
+  inputs_.clear();
+  outputs_.clear();
+  axis_.assign(num_ops, -1);
+  auto find_tensor = [&](const std::string& name) {
+    auto* var = param.scope->FindVar(name);
+    CHECK(var) << "Can not find the var " << name;
+    return var->GetMutable<Tensor>();
+  };
+
+  // The inputs are the vars read before written in the sub block.
+  std::map<std::string, int> values;
+  std::set<std::string> written;
+  for (int i = 0; i < num_ops; ++i) {
+    auto* op_desc = block_desc->GetOp<cpp::OpDesc>(i);
+    jit::FusedElementwiseType type;
+    if (!GetFusedType(*op_desc, &type)) return false;
+    std::vector<std::string> args{"X"};
+    if (jit::IsBinaryFusedElementwise(type)) {
+      args.push_back("Y");
+    }
+    for (auto& arg : args) {
+      auto names = op_desc->Input(arg);
+      if (names.size() != 1) return false;
+      if (written.count(names[0]) || values.count(names[0])) continue;
+      if (attr_.num_inputs >= fused_attr_t::kMaxInputs) return false;
+      values[names[0]] = attr_.num_inputs++;
+      inputs_.push_back(find_tensor(names[0]));
+    }
+    if (op_desc->Output("Out").size() != 1) return false;
+    written.insert(op_desc->Output("Out").front());
+  }
+
+  for (int i = 0; i < num_ops; ++i) {
+    auto* op_desc = block_desc->GetOp<cpp::OpDesc>(i);
+    auto& step = attr_.steps[i];
+    GetFusedType(*op_desc, &step.type);
+    step.x = values.at(op_desc->Input("X").front());
+    step.y = step.x;
+    step.alpha = 1.f;
+    step.beta = 0.f;
+    if (jit::IsBinaryFusedElementwise(step.type)) {
+      step.y = values.at(op_desc->Input("Y").front());
+      if (op_desc->HasAttr("axis")) {
+        axis_[i] = op_desc->GetAttr<int>("axis");
+      }
+    } else if (step.type == jit::kFusedScale) {
+      float scale = op_desc->GetAttr<float>("scale");
+      float bias = op_desc->GetAttr<float>("bias");
+      step.alpha = scale;
+      step.beta = op_desc->GetAttr<bool>("bias_after_scale") ? bias
+                                                               : bias * scale;
+    }
+    values[op_desc->Output("Out").front()] = attr_.num_inputs + i;
+  }
+  attr_.num_steps = num_ops;
+
+  for (auto& name : param.output_data_names) {
+    auto it = values.find(name);
+    if (it == values.end() || it->second < attr_.num_inputs ||
+        attr_.num_outputs >= fused_attr_t::kMaxOutputs) {
+      return false;
+    }
+    attr_.outputs[attr_.num_outputs++] = it->second;
+    outputs_.push_back(find_tensor(name));
+  }
+  return attr_.num_outputs > 0;
+}
+
+bool SubgraphCompute::PrepareViews() {
+  const int num_inputs = attr_.num_inputs;
+  bool changed = last_dims_.size() != inputs_.size();
+  for (size_t k = 0; !changed && k < inputs_.size(); ++k) {
+    changed = last_dims_[k] != inputs_[k]->dims();
+  }
+  if (!changed) return last_fusable_;
+  last_dims_.clear();
+  for (auto* input : inputs_) {
+    last_dims_.push_back(input->dims());
+  }
+  last_fusable_ = false;
+
+  // All of the steps run on the shape of the outputs, only the inputs can be
+  // broadcasted by the binary steps.
+  auto value_dims = [&](int value) {
+    return value < num_inputs ? last_dims_[value] : out_dims_;
+  };
+  out_dims_ = value_dims(attr_.steps[0].x);
+  const int64_t numel = out_dims_.production();
+  views_.assign(num_inputs, InputView());
+  auto set_view = [&](int value, int64_t period, int64_t post) {
+    if (value >= num_inputs) return true;
+    auto& view = views_[value];
+    if (view.period == 0) {
+      view.period = period;
+      view.post = post;
+    }
+    return view.period == period && view.post == post;
+  };
+  for (int s = 0; s < attr_.num_steps; ++s) {
+    const auto& step = attr_.steps[s];
+    if (value_dims(step.x) != out_dims_ || !set_view(step.x, numel, 1)) {
+      return false;
+    }
+    if (!jit::IsBinaryFusedElementwise(step.type)) continue;
+    int64_t period = numel;
+    int64_t post = 1;
+    const auto y_dims = value_dims(step.y);
+    if (y_dims != out_dims_ &&
+        (step.y >= num_inputs ||
+         !BroadcastView(out_dims_, y_dims, axis_[s], &period, &post))) {
+      return false;
+    }
+    if (!set_view(step.y, period, post)) return false;
+  }
+
+  // A row is contiguous in every input read by elements, and reads a single
+  // element of the others.
+  row_size_ = std::max<int64_t>(numel, 1);
+  attr_.scalar_mask = 0;
+  lod_input_ = -1;
+  for (int k = 0; k < num_inputs; ++k) {
+    const auto& view = views_[k];
+    if (view.period == numel && lod_input_ < 0) {
+      lod_input_ = k;
+    }
+    if (view.period == 1 || view.post > 1) {
+      attr_.scalar_mask |= 1 << k;
+    }
+    if (view.period > 1) {
+      row_size_ = GCD(row_size_, view.post > 1 ? view.post : view.period);
+    }
+  }
+  last_fusable_ = true;
+  return true;
+}
+
+void SubgraphCompute::RunFused() {
+  const int num_inputs = attr_.num_inputs;
+  const int num_outputs = attr_.num_outputs;
+  const int64_t numel = out_dims_.production();
+  std::vector<const float*> in_data(num_inputs);
+  std::vector<float*> out_data(num_outputs);
+  for (int k = 0; k < num_inputs; ++k) {
+    in_data[k] = inputs_[k]->data<float>();
+  }
+  for (int k = 0; k < num_outputs; ++k) {
+    outputs_[k]->Resize(out_dims_);
+    if (lod_input_ >= 0) {
+      outputs_[k]->set_lod(inputs_[lod_input_]->lod());
+    }
+    out_data[k] = outputs_[k]->mutable_data<float>();
+  }
+
+  auto compute =
+      jit::KernelFuncs<jit::FusedElementwiseTuple<float>, fluid::CPUPlace>::
+          Cache()
+              .At(attr_);
+  const int64_t num_tasks = (numel + kElementsPerTask - 1) / kElementsPerTask;
+  lite::x86::RunParallelFor(0, num_tasks, [&](int64_t begin, int64_t end) {
+    const float* x[fused_attr_t::kMaxInputs];
+    float* out[fused_attr_t::kMaxOutputs];
+    int64_t e = begin * kElementsPerTask;
+    const int64_t e_end = std::min(numel, end * kElementsPerTask);
+    while (e < e_end) {
+      const int64_t row_end = std::min(e_end, (e / row_size_ + 1) * row_size_);
+      for (int k = 0; k < num_inputs; ++k) {
+        const auto& view = views_[k];
+        x[k] = in_data[k] + (e / view.post) % view.period;
+      }
+      for (int k = 0; k < num_outputs; ++k) {
+        out[k] = out_data[k] + e;
+      }
+      compute(x, out, static_cast<int>(row_end - e), &attr_);
+      e = row_end;
+    }
+  });
+}
+
+void SubgraphCompute::RunOriginProgram() {
+  if (origin_program_.empty()) {
+    auto& param = this->Param<param_t>();
+    auto* block_desc = param.sub_block_desc;
+    for (int i = 0; i < block_desc->OpsSize(); ++i) {
+      auto* op_desc = block_desc->GetOp<cpp::OpDesc>(i);
+      auto op = LiteOpRegistry::Global().Create(op_desc->Type());
+      CHECK(op) << "No op found for " << op_desc->Type();
+      op->Attach(*op_desc, param.scope);
+      // The subgraph only holds float ops, but CreateKernels also returns
+      // the kernels of any precision, so pick the float one explicitly.
+      auto kernels =
+          op->CreateKernels({Place{TARGET(kX86), PRECISION(kFloat)}});
+      auto it = std::find_if(
+          kernels.begin(),
+          kernels.end(),
+          [](const std::unique_ptr<KernelBase>& kernel) {
+            return kernel->target() == TARGET(kX86) &&
+                   kernel->precision() == PRECISION(kFloat);
+          });
+      CHECK(it != kernels.end()) << "No x86 float kernel found for "
+                                 << op_desc->Type();
+      auto kernel = std::move(*it);
+      kernel->SetContext(
+          ContextScheduler::Global().NewContext(kernel->target()));
+      origin_program_.emplace_back(std::move(op), std::move(kernel));
+    }
+  }
+  for (auto& inst : origin_program_) {
+    inst.Run();
+  }
+}
+
+void SubgraphCompute::PrepareForRun() {
+  fused_ = BuildSteps();
+  if (!fused_) {
+    VLOG(3) << "Run the original ops of the subgraph one by one";
+  }
+}
+
+void SubgraphCompute::Run() {
+  if (fused_ && PrepareViews()) {
+    RunFused();
+  } else {
+    RunOriginProgram();
+  }
+}
+
+}  // namespace x86
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_LITE_KERNEL(subgraph,
+                     kX86,
+                     kFloat,
+                     kNCHW,
+                     paddle::lite::kernels::x86::SubgraphCompute,
+                     def)
+    .BindInput("Inputs", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindOutput("Outputs", {LiteType::GetTensorTy(TARGET(kX86))})
+    .Finalize();
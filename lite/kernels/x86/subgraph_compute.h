@@ -0,0 +1,90 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include "lite/backends/x86/jit/kernel_base.h"
+#include "lite/core/kernel.h"
+#include "lite/core/op_registry.h"
+#include "lite/core/program.h"
+#include "lite/operators/op_params.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace x86 {
+
+/*
+ * The x86 subgraphs are the chains of the elementwise ops, scales,
+ * activations and casts grouped by the x86_subgraph_pass. A chain is
+ * compiled into the steps of the jit kernel kFusedElementwise, which computes
+ * all of the ops in one pass over the elements, so the intermediate results
+ * never go through the memory. The inputs broadcasted by an elementwise op
+ * are read in place, as a vector repeated every row or as a value for the
+ * whole row. The original ops are run one by one instead if the chain or the
+ * shapes can not be fused this way.
+ */
+class SubgraphCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
+ public:
+  using param_t = operators::SubgraphParam;
+
+  void PrepareForRun() override;
+
+  void Run() override;
+
+  virtual ~SubgraphCompute() = default;
+
+ private:
+  // How an input is read by the element e of the outputs, i.e. the element
+  // (e / post) % period of the input.
+  struct InputView {
+    int64_t period{0};
+    int64_t post{1};
+  };
+
+  // Compile the ops of the sub block into attr_, false if any of them is not
+  // supported.
+  bool BuildSteps();
+  // Infer the shape of the outputs and the views of the inputs from the
+  // current input shapes, false if they can not be fused.
+  bool PrepareViews();
+  void RunFused();
+  void RunOriginProgram();
+
+  bool fused_{false};
+  jit::fused_elementwise_attr_t attr_;
+  std::vector<const Tensor*> inputs_;
+  std::vector<Tensor*> outputs_;
+  // The axis of the binary steps, unused by the others.
+  std::vector<int> axis_;
+
+  // The views of the inputs for the input shapes of the last run, the
+  // elements are computed in rows of row_size_ elements.
+  std::vector<DDim> last_dims_;
+  bool last_fusable_{false};
+  DDim out_dims_;
+  // The input whose LoD is copied to the outputs, -1 if none.
+  int lod_input_{-1};
+  std::vector<InputView> views_;
+  int64_t row_size_{0};
+
+  std::vector<Instruction> origin_program_;
+};
+
+}  // namespace x86
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,160 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/kernels/x86/subgraph_compute.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "lite/core/op_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace x86 {
+
+void AddOp(cpp::BlockDesc* block_desc,
+           const std::string& type,
+           const std::vector<std::string>& inputs,
+           const std::string& output) {
+  auto* op_desc = block_desc->AddOp<cpp::OpDesc>();
+  op_desc->SetType(type);
+  op_desc->SetInput("X", {inputs[0]});
+  if (inputs.size() > 1) {
+    op_desc->SetInput("Y", {inputs[1]});
+    op_desc->SetAttr<int>("axis", -1);
+  }
+  op_desc->SetOutput("Out", {output});
+}
+
+void FillTensor(Scope* scope,
+                const std::string& name,
+                const std::vector<int64_t>& shape) {
+  auto* tensor = scope->Var(name)->GetMutable<Tensor>();
+  tensor->Resize(shape);
+  auto* data = tensor->mutable_data<float>();
+  for (int64_t i = 0; i < tensor->numel(); ++i) {
+    data[i] = static_cast<float>((i * 7) % 13) / 6.5f - 1.f;
+  }
+}
+
+void RunSubgraph(Scope* scope,
+                 cpp::BlockDesc* block_desc,
+                 const std::vector<std::string>& input_names,
+                 const std::vector<std::string>& output_names,
+                 SubgraphCompute* subgraph) {
+  for (int i = 0; i < block_desc->OpsSize(); ++i) {
+    scope->Var(block_desc->GetOp<cpp::OpDesc>(i)->Output("Out").front())
+        ->GetMutable<Tensor>();
+  }
+  operators::SubgraphParam param;
+  param.input_data_names = input_names;
+  param.output_data_names = output_names;
+  param.sub_block_desc = block_desc;
+  param.scope = scope;
+  std::unique_ptr<KernelContext> ctx(new KernelContext);
+  ctx->As<X86Context>();
+  subgraph->SetParam(param);
+  subgraph->SetContext(std::move(ctx));
+  subgraph->Launch();
+}
+
+TEST(subgraph_x86, retrive_op) {
+  auto subgraph =
+      KernelRegistry::Global().Create<TARGET(kX86), PRECISION(kFloat)>(
+          "subgraph");
+  ASSERT_FALSE(subgraph.empty());
+  ASSERT_TRUE(subgraph.front());
+}
+
+TEST(subgraph_x86, fused_chain) {
+  // out0 = relu((x + b) * 2 + 1), out1 = tanh(out0 - w) * s, where b is
+  // broadcasted along the channels, w along the rows and s is a scalar.
+  cpp::BlockDesc block_desc;
+  AddOp(&block_desc, "elementwise_add", {"x", "b"}, "t0");
+  block_desc.GetOp<cpp::OpDesc>(0)->SetAttr<int>("axis", 1);
+  AddOp(&block_desc, "scale", {"t0"}, "t1");
+  auto* scale_desc = block_desc.GetOp<cpp::OpDesc>(1);
+  scale_desc->SetAttr<float>("scale", 2.f);
+  scale_desc->SetAttr<float>("bias", 0.5f);
+  scale_desc->SetAttr<bool>("bias_after_scale", false);
+  AddOp(&block_desc, "relu", {"t1"}, "out0");
+  AddOp(&block_desc, "elementwise_sub", {"out0", "w"}, "t2");
+  AddOp(&block_desc, "tanh", {"t2"}, "t3");
+  AddOp(&block_desc, "elementwise_mul", {"t3", "s"}, "out1");
+
+  for (int64_t batch : {2, 3}) {
+    Scope scope;
+    const int64_t c = 3, h = 4, w = 13;
+    FillTensor(&scope, "x", {batch, c, h, w});
+    FillTensor(&scope, "b", {c});
+    FillTensor(&scope, "w", {w});
+    FillTensor(&scope, "s", {1});
+    SubgraphCompute subgraph;
+    RunSubgraph(&scope,
+                &block_desc,
+                {"x", "b", "w", "s"},
+                {"out0", "out1"},
+                &subgraph);
+
+    auto* x = scope.FindVar("x")->GetMutable<Tensor>()->data<float>();
+    auto* b = scope.FindVar("b")->GetMutable<Tensor>()->data<float>();
+    auto* wd = scope.FindVar("w")->GetMutable<Tensor>()->data<float>();
+    float s = scope.FindVar("s")->GetMutable<Tensor>()->data<float>()[0];
+    auto* out0 = scope.FindVar("out0")->GetMutable<Tensor>();
+    auto* out1 = scope.FindVar("out1")->GetMutable<Tensor>();
+    ASSERT_EQ(out0->dims(), DDim({batch, c, h, w}));
+    ASSERT_EQ(out1->dims(), DDim({batch, c, h, w}));
+    for (int64_t i = 0; i < out0->numel(); ++i) {
+      float ref0 = std::max((x[i] + b[(i / (h * w)) % c] + 0.5f) * 2.f, 0.f);
+      float ref1 = std::tanh(ref0 - wd[i % w]) * s;
+      EXPECT_NEAR(out0->data<float>()[i], ref0, 1e-5);
+      EXPECT_NEAR(out1->data<float>()[i], ref1, 1e-5);
+    }
+  }
+}
+
+TEST(subgraph_x86, origin_program) {
+  // The broadcasted relu(b) is not an input, the original ops are run.
+  cpp::BlockDesc block_desc;
+  AddOp(&block_desc, "relu", {"b"}, "t0");
+  AddOp(&block_desc, "elementwise_add", {"x", "t0"}, "out");
+
+  Scope scope;
+  FillTensor(&scope, "x", {2, 3, 5});
+  FillTensor(&scope, "b", {5});
+  SubgraphCompute subgraph;
+  RunSubgraph(&scope, &block_desc, {"x", "b"}, {"out"}, &subgraph);
+
+  auto* x = scope.FindVar("x")->GetMutable<Tensor>()->data<float>();
+  auto* b = scope.FindVar("b")->GetMutable<Tensor>()->data<float>();
+  auto* out = scope.FindVar("out")->GetMutable<Tensor>();
+  ASSERT_EQ(out->dims(), DDim({2, 3, 5}));
+  for (int64_t i = 0; i < out->numel(); ++i) {
+    EXPECT_NEAR(out->data<float>()[i], x[i] + std::max(b[i % 5], 0.f), 1e-5);
+  }
+}
+
+}  // namespace x86
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
+
+USE_LITE_KERNEL(subgraph, kX86, kFloat, kNCHW, def);
+USE_LITE_OP(relu);
+USE_LITE_OP(elementwise_add);
+USE_LITE_KERNEL(relu, kX86, kFloat, kNCHW, def);
+USE_LITE_KERNEL(elementwise_add, kX86, kFloat, kNCHW, def);
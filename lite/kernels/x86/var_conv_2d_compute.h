@@ -15,6 +15,7 @@
 
 #include <vector>
 #include "lite/backends/x86/math/blas.h"
+#include "lite/backends/x86/math/sequence_layout.h"
 #include "lite/core/kernel.h"
 #include "lite/core/op_registry.h"
 #include "lite/core/tensor.h"
@@ -182,30 +183,86 @@ class VarConv2DCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
     const auto* w_data = w->data<T>();
     const auto* col_data = col->data<T>();
 
-    auto blas = lite::x86::math::GetBlas<lite::TargetType::kX86, T>(context);
+    // the samples of the same output size are bucketed, the small ones of a
+    // bucket are computed by one GEMM on their gathered columns instead of a
+    // thin GEMM per sample.
+    std::vector<int> top_im_sizes(batch);
     for (int b = 0; b < batch; ++b) {
-      int top_im_size = (top_offset[b + 1] - top_offset[b]) / output_channel;
+      top_im_sizes[b] = (top_offset[b + 1] - top_offset[b]) / output_channel;
+    }
+    auto layout = lite::x86::math::GetSequenceLayout(top_im_sizes);
+    int col_rows = input_channel * kernel_h * kernel_w;
+    auto blas = lite::x86::math::GetBlas<lite::TargetType::kX86, T>(context);
+    for (const auto& bucket : layout->buckets) {
+      int top_im_size = bucket.length;
       if (top_im_size == 0) {
         continue;
       }
+      int bucket_size = bucket.seqs.size();
+      if (bucket_size == 1 || top_im_size >= kMaxBucketedImageSize) {
+        for (int b : bucket.seqs) {
+          blas.GEMM(false,
+                    false,
+                    output_channel,
+                    top_im_size,
+                    col_rows,
+                    1.0,
+                    w_data,
+                    col_rows,
+                    col_data + col_offset[b],
+                    top_im_size,
+                    0.0,
+                    top_data + top_offset[b],
+                    top_im_size);
+        }
+        continue;
+      }
 
+      int bucket_cols = bucket_size * top_im_size;
+      bucket_col_.Resize({col_rows, bucket_cols});
+      bucket_top_.Resize({output_channel, bucket_cols});
+      auto* bucket_col_data = bucket_col_.mutable_data<T>();
+      auto* bucket_top_data = bucket_top_.mutable_data<T>();
+      for (int i = 0; i < bucket_size; ++i) {
+        const auto* sample_col = col_data + col_offset[bucket.seqs[i]];
+        for (int r = 0; r < col_rows; ++r) {
+          memcpy(bucket_col_data + r * bucket_cols + i * top_im_size,
+                 sample_col + r * top_im_size,
+                 top_im_size * sizeof(T));
+        }
+      }
       blas.GEMM(false,
                 false,
                 output_channel,
-                top_im_size,
-                input_channel * kernel_h * kernel_w,
+                bucket_cols,
+                col_rows,
                 1.0,
                 w_data,
-                input_channel * kernel_h * kernel_w,
-                col_data + col_offset[b],
-                top_im_size,
+                col_rows,
+                bucket_col_data,
+                bucket_cols,
                 0.0,
-                top_data + top_offset[b],
-                top_im_size);
+                bucket_top_data,
+                bucket_cols);
+      for (int i = 0; i < bucket_size; ++i) {
+        auto* sample_top = top_data + top_offset[bucket.seqs[i]];
+        for (int o = 0; o < output_channel; ++o) {
+          memcpy(sample_top + o * top_im_size,
+                 bucket_top_data + o * bucket_cols + i * top_im_size,
+                 top_im_size * sizeof(T));
+        }
+      }
     }
   }
 
   virtual ~VarConv2DCompute() = default;
+
+ private:
+  // The GEMMs of the larger images are dense enough by themselves.
+  static constexpr int kMaxBucketedImageSize = 256;
+  // The gathered columns and outputs of a bucket.
+  lite::Tensor bucket_col_;
+  lite::Tensor bucket_top_;
 };
 
 }  // namespace x86
@@ -238,12 +238,12 @@ TEST(var_conv_2d_x86, run_test) {
     w_data[i] = i - 1.f;
   }
 
-  std::vector<uint64_t> row_lod_vec{0, 10, 20};
+  std::vector<uint64_t> row_lod_vec{0, 10, 20, 24};
   LoD row_lod;
   row_lod.push_back(row_lod_vec);
   ROW.set_lod(row_lod);
 
-  std::vector<uint64_t> column_lod_vec{0, 10, 20};
+  std::vector<uint64_t> column_lod_vec{0, 10, 20, 23};
   LoD column_lod;
   column_lod.push_back(column_lod_vec);
   COLUMN.set_lod(column_lod);
@@ -254,7 +254,7 @@ TEST(var_conv_2d_x86, run_test) {
   for (size_t i = 0; i < row_lod_vec.size() - 1; ++i) {
     int height = row_lod_vec[i + 1] - row_lod_vec[i];
     int width = column_lod_vec[i + 1] - column_lod_vec[i];
-    x_lod_vec.push_back(height * width * input_channel);
+    x_lod_vec.push_back(x_lod_vec.back() + height * width * input_channel);
     x_size += height * width * input_channel;
   }
   std::vector<int64_t> x_dims_vec{x_size, 1};
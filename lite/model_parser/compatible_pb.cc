@@ -37,6 +37,10 @@ namespace lite {
     any_desc->SetName(cpp_desc.Name());                          \
     any_desc->SetType(cpp_desc.GetType());                       \
     any_desc->SetPersistable(cpp_desc.Persistable());            \
+    if (cpp_desc.GetType() == VarDescAPI::Type::LOD_TENSOR &&    \
+        !cpp_desc.GetShape().empty()) {                          \
+      any_desc->SetShape(cpp_desc.GetShape());                   \
+    }                                                            \
   }
 
 #ifndef LITE_ON_TINY_PUBLISH
@@ -47,6 +51,9 @@ void TransformVarDescAnyToCpp<pb::VarDesc>(const pb::VarDesc &any_desc,
   cpp_desc->SetType(any_desc.GetType());
   cpp_desc->SetPersistable(any_desc.Persistable());
   cpp_desc->SetDataType(any_desc.GetDataType());
+  if (any_desc.GetType() == VarDescAPI::Type::LOD_TENSOR) {
+    cpp_desc->SetShape(any_desc.GetShape());
+  }
 }
 #endif
 
@@ -56,6 +63,9 @@ void TransformVarDescAnyToCpp<naive_buffer::VarDesc>(
   cpp_desc->SetName(any_desc.Name());
   cpp_desc->SetType(any_desc.GetType());
   cpp_desc->SetPersistable(any_desc.Persistable());
+  if (any_desc.GetType() == VarDescAPI::Type::LOD_TENSOR) {
+    cpp_desc->SetShape(any_desc.GetShape());
+  }
 }
 
 /// For OpDesc transform
@@ -14,6 +14,7 @@
 
 #pragma once
 #include <string>
+#include <vector>
 #include "lite/model_parser/desc_apis.h"
 
 namespace paddle {
@@ -46,11 +47,18 @@ class VarDesc : public VarDescAPI {
 
   void SetDataType(Type data_type) { data_type_ = data_type; }
 
+  // The static shape recorded in the model, -1 marks a dim that is only known
+  // at runtime(e.g. the batch size). It is empty if no shape was recorded.
+  const std::vector<int64_t>& GetShape() const { return shape_; }
+
+  void SetShape(const std::vector<int64_t>& shape) { shape_ = shape; }
+
  private:
   std::string name_;
   Type type_;
   Type data_type_;
   bool persistable_;
+  std::vector<int64_t> shape_;
 };
 
 }  // namespace cpp
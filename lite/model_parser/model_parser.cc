@@ -521,8 +521,10 @@ void SaveParamNaive(const std::string &path,
 
 void SaveCombinedParamsNaive(const std::string &path,
                              const lite::Scope &exec_scope,
-                             const cpp::ProgramDesc &cpp_prog) {
+                             const cpp::ProgramDesc &cpp_prog,
+                             size_t alignment) {
   naive_buffer::BinaryTable table;
+  table.set_alignment(alignment);
   naive_buffer::proto::CombinedParamsDesc pt_desc(&table);
   naive_buffer::CombinedParamsDesc desc(&pt_desc);
 
@@ -543,7 +545,8 @@ void SaveCombinedParamsNaive(const std::string &path,
 void SaveModelNaive(const std::string &model_dir,
                     const Scope &exec_scope,
                     const cpp::ProgramDesc &cpp_prog,
-                    bool combined) {
+                    bool combined,
+                    bool aligned) {
   // Save program
   const std::string prog_path = model_dir + ".nb";
   naive_buffer::BinaryTable table;
@@ -551,11 +554,25 @@ void SaveModelNaive(const std::string &model_dir,
   naive_buffer::ProgramDesc nb_prog(&nb_proto_prog);
   TransformProgramDescCppToAny(cpp_prog, &nb_prog);
   nb_proto_prog.Save();
+  // Pad topo_data so that param_data starts at an aligned offset of the file,
+  // the trailing bytes are ignored when the topology is loaded.
+  const size_t alignment = aligned ? kNaiveBufferParamAlignment : 0;
+  const size_t header_size =
+      sizeof(uint16_t) + 16 * sizeof(char) + sizeof(uint64_t);
+  size_t padding =
+      aligned ? (alignment - (header_size + table.size()) % alignment) %
+                    alignment
+              : 0;
+  if (padding > 0) {
+    table.Require(padding);
+    memset(table.cursor(), 0, padding);
+    table.Consume(padding);
+  }
 
   // Save meta_version(uint16) into file
   naive_buffer::BinaryTable meta_version_table;
   meta_version_table.Require(sizeof(uint16_t));
-  uint16_t meta_version = 0;
+  uint16_t meta_version = aligned ? kNaiveBufferMetaVersion : 0;
   memcpy(meta_version_table.cursor(), &meta_version, sizeof(uint16_t));
   meta_version_table.Consume(sizeof(uint16_t));
   meta_version_table.SaveToFile(prog_path);
@@ -583,7 +600,7 @@ void SaveModelNaive(const std::string &model_dir,
   // save topology data into model file
   table.AppendToFile(prog_path);
   // Save Params
-  SaveCombinedParamsNaive(prog_path, exec_scope, cpp_prog);
+  SaveCombinedParamsNaive(prog_path, exec_scope, cpp_prog, alignment);
 
   LOG(INFO) << "Save naive buffer model in '" << model_dir
             << ".nb' successfully";
@@ -599,9 +616,12 @@ void SetTensorDataNaive(T *out, size_t size, const std::vector<T> &src) {
   }
 }
 
+// `mapping` is set if desc is loaded from a mapped file, aligned param data
+// is then shared with the mapped pages rather than copied.
 void GetParamInfoNaive(const naive_buffer::ParamDesc &desc,
                        lite::Scope *scope,
-                       const std::string &name) {
+                       const std::string &name,
+                       const std::shared_ptr<void> &mapping = nullptr) {
   CHECK(scope);
   CHECK_EQ(desc.Name(), name)
       << "Var name not equal: ParamDesc.name=" << desc.Name()
@@ -621,12 +641,22 @@ void GetParamInfoNaive(const naive_buffer::ParamDesc &desc,
   tensor->Resize(lite::DDim(desc.Dim()));
 
   // Load data
+  const char *raw_data = desc.RawData();
+  bool share_data = mapping && reinterpret_cast<uintptr_t>(raw_data) %
+                                       kNaiveBufferParamAlignment ==
+                                   0;
   switch (desc.GetDataType()) {
-#define SET_TENSOR(data_type__, T, precision)                            \
-  case VarDescAPI::VarDataType::data_type__:                             \
-    SetTensorDataNaive<T>(                                               \
-        tensor->mutable_data<T>(), tensor->data_size(), desc.Data<T>()); \
-    tensor->set_precision(precision);                                    \
+#define SET_TENSOR(data_type__, T, precision)                              \
+  case VarDescAPI::VarDataType::data_type__:                               \
+    if (share_data) {                                                      \
+      CHECK_EQ(desc.RawDataSize(), tensor->data_size() * sizeof(T));       \
+      tensor->ShareExternalMemory(                                         \
+          raw_data, desc.RawDataSize(), TARGET(kHost), mapping);           \
+    } else {                                                               \
+      SetTensorDataNaive<T>(                                               \
+          tensor->mutable_data<T>(), tensor->data_size(), desc.Data<T>()); \
+    }                                                                      \
+    tensor->set_precision(precision);                                      \
     break
 
     // SET_TENSOR(BOOL, bool, PRECISION(kBool));
@@ -654,14 +684,21 @@ void LoadParamNaive(const std::string &path,
   GetParamInfoNaive(desc, scope, name);
 }
 
+// `alignment` is the padding of the param data in the file, see
+// SaveCombinedParamsNaive.
 void LoadCombinedParamsNaive(const std::string &path,
                              const uint64_t &offset,
                              lite::Scope *scope,
                              const cpp::ProgramDesc &cpp_prog,
-                             bool params_from_memory) {
+                             bool params_from_memory,
+                             size_t alignment = 0,
+                             bool use_mmap = false) {
   naive_buffer::BinaryTable table;
+  table.set_alignment(alignment);
   if (params_from_memory) {
     table.LoadFromMemory(path.c_str() + offset, path.length() - offset);
+  } else if (use_mmap) {
+    table.LoadFromFileMapped(path, offset, 0);
   } else {
     table.LoadFromFile(path, offset, 0);
   }
@@ -672,7 +709,7 @@ void LoadCombinedParamsNaive(const std::string &path,
   std::set<std::string> param_names;
   for (size_t i = 0; i < desc.ParamsSize(); ++i) {
     naive_buffer::ParamDesc param_desc(desc.GetParam(i));
-    GetParamInfoNaive(param_desc, scope, param_desc.Name());
+    GetParamInfoNaive(param_desc, scope, param_desc.Name(), table.mapping());
     param_names.insert(param_desc.Name());
   }
 
@@ -754,13 +791,23 @@ void LoadModelNaive(const std::string &model_dir,
  * |   5   |  param_data     |   char[]    |                |
  * ----------------------------------------------------------
  *  Meaning of each part:
- *      meta_version: meata_version, 0 default.
+ *      meta_version: meata_version, 0 default, 1 for aligned param_data.
  *      opt_version:  lite_version of opt tool that transformed this model.
  *      topo_size:    length of `topo_data`.
- *      topo_data:    contains model's topology data.
- *      param_data:   contains model's params data.
+ *      topo_data:    contains model's topology data, since meta_version 1 it
+ *                    is zero-padded to make param_data start at a multiple of
+ *                    kNaiveBufferParamAlignment.
+ *      param_data:   contains model's params data, since meta_version 1 the
+ *                    data of every param is aligned in the same way.
 */
 
+// Padding of param_data in a model.nb of the given meta version.
+size_t ParamAlignmentOf(uint16_t meta_version) {
+  CHECK_LE(meta_version, kNaiveBufferMetaVersion)
+      << "Unsupported meta version of naive buffer model: " << meta_version;
+  return meta_version >= 1 ? kNaiveBufferParamAlignment : 0;
+}
+
 // usage: LoadModelNaiveFromFile is used for loading model from file.
 template <typename T>
 void ReadModelDataFromFile(T *data,
@@ -775,7 +822,8 @@ void ReadModelDataFromFile(T *data,
 
 void LoadModelNaiveFromFile(const std::string &filename,
                             Scope *scope,
-                            cpp::ProgramDesc *cpp_prog) {
+                            cpp::ProgramDesc *cpp_prog,
+                            bool use_mmap) {
   CHECK(cpp_prog);
   CHECK(scope);
   cpp_prog->ClearBlocks();
@@ -826,7 +874,13 @@ void LoadModelNaiveFromFile(const std::string &filename,
   TransformProgramDescAnyToCpp(nb_prog, cpp_prog);
 
   // (5)Load Params
-  LoadCombinedParamsNaive(prog_path, offset, scope, *cpp_prog, false);
+  LoadCombinedParamsNaive(prog_path,
+                          offset,
+                          scope,
+                          *cpp_prog,
+                          false,
+                          ParamAlignmentOf(meta_version),
+                          use_mmap);
 
   VLOG(4) << "Load naive buffer model in '" << filename << "' successfully";
 }
@@ -913,7 +967,12 @@ void LoadModelNaiveFromMemory(const std::string &model_buffer,
   // Load Params
   // NOTE: Only main block be used now.
   // only combined Params are supported in Loading Model from memory
-  LoadCombinedParamsNaive(model_buffer, offset, scope, *cpp_prog, true);
+  LoadCombinedParamsNaive(model_buffer,
+                          offset,
+                          scope,
+                          *cpp_prog,
+                          true,
+                          ParamAlignmentOf(meta_version));
 
   VLOG(4) << "Load model from naive buffer memory successfully";
 }
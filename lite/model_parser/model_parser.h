@@ -30,6 +30,13 @@
 namespace paddle {
 namespace lite {
 
+// Meta version of the combined naive buffer format (model.nb). Since version 1
+// param_data starts at an aligned file offset and the data of every param is
+// padded to kNaiveBufferParamAlignment bytes, which SaveModelNaive only writes
+// if asked, as the runtimes before it can't load it.
+const uint16_t kNaiveBufferMetaVersion = 1;
+const size_t kNaiveBufferParamAlignment = 64;
+
 #ifndef LITE_ON_TINY_PUBLISH
 // Read a __model__ file.
 std::unique_ptr<framework::proto::ProgramDesc> LoadProgram(
@@ -80,14 +87,20 @@ void SaveParamNaive(const std::string& path,
                     const lite::Scope& exec_scope,
                     const std::string& var_name);
 
+// `alignment` pads the data of every param to that boundary, relative to the
+// start of the params, 0 for the packed layout.
 void SaveCombinedParamsNaive(const std::string& path,
                              const lite::Scope& exec_scope,
-                             const cpp::ProgramDesc& cpp_prog);
+                             const cpp::ProgramDesc& cpp_prog,
+                             size_t alignment = 0);
 
+// Save the model of meta version 0, or 1 with the aligned params if `aligned`,
+// which are loaded without copy by the mmap loading.
 void SaveModelNaive(const std::string& model_dir,
                     const Scope& exec_scope,
                     const cpp::ProgramDesc& cpp_prog,
-                    bool combined = true);
+                    bool combined = true,
+                    bool aligned = false);
 #endif
 
 void LoadParamNaive(const std::string& path,
@@ -100,9 +113,12 @@ void LoadModelNaive(const std::string& model_dir,
                     lite::Scope* scope,
                     cpp::ProgramDesc* prog,
                     bool combined = true);
+// `use_mmap` maps the model file instead of reading it, the aligned params of
+// a model saved with meta version 1 then reference the mapped pages directly.
 void LoadModelNaiveFromFile(const std::string& filename,
                             lite::Scope* scope,
-                            cpp::ProgramDesc* prog);
+                            cpp::ProgramDesc* prog,
+                            bool use_mmap = false);
 void LoadModelNaiveFromMemory(const std::string& model_buffer,
                               const std::string& param_buffer,
                               lite::Scope* scope,
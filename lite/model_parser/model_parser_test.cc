@@ -15,6 +15,7 @@
 #include "lite/model_parser/model_parser.h"
 #include <gflags/gflags.h>
 #include <gtest/gtest.h>
+#include <fstream>
 #include "lite/core/scope.h"
 
 DEFINE_string(model_dir, "", "");
@@ -118,7 +119,20 @@ TEST(ModelParser, SaveModelNaive) {
   Scope scope;
   LoadModelPb(FLAGS_model_dir, "", "", &scope, &prog);
   const std::string save_pb_model_path = FLAGS_model_dir + ".saved.naive";
-  SaveModelNaive(save_pb_model_path, scope, prog);
+  SaveModelNaive(save_pb_model_path, scope, prog, true, true);
+
+  // The models are saved in the format of meta version 0 by default, which
+  // the older runtimes load.
+  const std::string packed_path = FLAGS_model_dir + ".saved.packed";
+  SaveModelNaive(packed_path, scope, prog);
+  uint16_t meta_version = 1;
+  std::ifstream packed(packed_path + ".nb", std::ios::binary);
+  packed.read(reinterpret_cast<char*>(&meta_version), sizeof(meta_version));
+  EXPECT_EQ(meta_version, 0);
+  cpp::ProgramDesc packed_prog;
+  Scope packed_scope;
+  LoadModelNaiveFromFile(packed_path + ".nb", &packed_scope, &packed_prog);
+  EXPECT_EQ(packed_prog.BlocksSize(), prog.BlocksSize());
 }
 
 TEST(ModelParser, LoadModelNaiveFromFile) {
@@ -130,6 +144,31 @@ TEST(ModelParser, LoadModelNaiveFromFile) {
   LoadModelNaiveFromFile(model_path, &scope, &prog);
 }
 
+TEST(ModelParser, LoadModelNaiveFromFileMmap) {
+  CHECK(!FLAGS_model_dir.empty());
+  auto model_path = std::string(FLAGS_model_dir) + ".saved.naive.nb";
+  cpp::ProgramDesc prog, mapped_prog;
+  Scope scope, mapped_scope;
+  LoadModelNaiveFromFile(model_path, &scope, &prog);
+  LoadModelNaiveFromFile(model_path, &mapped_scope, &mapped_prog, true);
+
+  for (auto& name : scope.LocalVarNames()) {
+    auto& tensor = scope.FindVar(name)->Get<lite::Tensor>();
+    auto* mapped_var = mapped_scope.FindVar(name);
+    ASSERT_TRUE(mapped_var);
+    auto& mapped_tensor = mapped_var->Get<lite::Tensor>();
+    ASSERT_EQ(mapped_tensor.dims(), tensor.dims());
+    ASSERT_EQ(mapped_tensor.memory_size(), tensor.memory_size());
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(mapped_tensor.raw_data()) %
+                  kNaiveBufferParamAlignment,
+              0U);
+    EXPECT_EQ(memcmp(mapped_tensor.raw_data(),
+                     tensor.raw_data(),
+                     tensor.memory_size()),
+              0);
+  }
+}
+
 TEST(ModelParser, LoadModelNaiveFromMemory) {
   CHECK(!FLAGS_model_dir.empty());
   cpp::ProgramDesc prog;
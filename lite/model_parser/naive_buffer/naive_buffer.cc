@@ -14,6 +14,12 @@
 
 #include "lite/model_parser/naive_buffer/naive_buffer.h"
 #include <stdio.h>
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif  // !_WIN32
 
 namespace paddle {
 namespace lite {
@@ -34,6 +40,17 @@ void BinaryTable::Consume(size_t bytes) {
   // cursor, so we don't check mutable mode here.
 }
 
+void BinaryTable::Align() {
+  if (alignment_ == 0) return;
+  size_t padding = (alignment_ - cursor_ % alignment_) % alignment_;
+  if (padding == 0) return;
+  if (is_mutable_mode_) {
+    Require(padding);
+    memset(cursor(), 0, padding);
+  }
+  Consume(padding);
+}
+
 void BinaryTable::SaveToFile(const std::string &filename) const {
   FILE *fp = fopen(filename.c_str(), "wb");
   CHECK(fp) << "Unable to open file: " << filename;
@@ -79,6 +96,34 @@ void BinaryTable::LoadFromFile(const std::string &filename,
   is_mutable_mode_ = false;
 }
 
+void BinaryTable::LoadFromFileMapped(const std::string &filename,
+                                     const size_t &offset,
+                                     const size_t &size) {
+#if !defined(_WIN32)
+  int fd = open(filename.c_str(), O_RDONLY);
+  CHECK_GE(fd, 0) << "Unable to open file: " << filename;
+  struct stat st;
+  CHECK_EQ(fstat(fd, &st), 0) << "Unable to stat file: " << filename;
+  size_t file_size = static_cast<size_t>(st.st_size);
+  CHECK_LE(offset + size, file_size) << "Read file error: " << filename;
+  // The whole file is mapped so that the view keeps the alignment of its
+  // offset in the file, mmap itself only takes page-aligned offsets.
+  void *addr = mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  CHECK(addr != MAP_FAILED) << "Unable to mmap file: " << filename;
+  mapping_ = std::shared_ptr<void>(
+      addr, [file_size](void *p) { munmap(p, file_size); });
+  view_ = static_cast<byte_t *>(addr) + offset;
+  view_size_ = size == 0 ? file_size - offset : size;
+  bytes_.clear();
+  cursor_ = 0;
+  // Set readonly.
+  is_mutable_mode_ = false;
+#else
+  LoadFromFile(filename, offset, size);
+#endif  // !_WIN32
+}
+
 void BinaryTable::LoadFromMemory(const char *buffer, size_t buffer_size) {
   // get buffer
   bytes_.resize(buffer_size);
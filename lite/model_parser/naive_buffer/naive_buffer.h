@@ -45,6 +45,12 @@ struct BinaryTable {
   std::vector<byte_t> bytes_;
   size_t cursor_{};
   bool is_mutable_mode_{true};  // true for mutable, false for readonly.
+  // Padding boundary of aligned fields, 0 for the packed layout.
+  size_t alignment_{0};
+  // Readonly view of a memory-mapped file, used instead of `bytes_` if set.
+  std::shared_ptr<void> mapping_;
+  byte_t* view_{nullptr};
+  size_t view_size_{0};
 
  public:
   /// Require free memory of `size` bytes.
@@ -53,11 +59,23 @@ struct BinaryTable {
   /// Consume some memory.
   void Consume(size_t bytes);
 
+  /// Move the cursor to the next multiple of `alignment()`, zero-filling the
+  /// skipped bytes in mutable mode. Offsets are relative to the table start.
+  void Align();
+
   /// The current position of cursor for save or load.
-  byte_t* cursor() { return &bytes_[cursor_]; }
-  const byte_t* data() const { return bytes_.data(); }
-  size_t size() const { return bytes_.size(); }
-  size_t free_size() const { return bytes_.size() - cursor_; }
+  byte_t* cursor() { return mapped() ? view_ + cursor_ : &bytes_[cursor_]; }
+  const byte_t* data() const { return mapped() ? view_ : bytes_.data(); }
+  size_t size() const { return mapped() ? view_size_ : bytes_.size(); }
+  size_t free_size() const { return size() - cursor_; }
+
+  size_t alignment() const { return alignment_; }
+  void set_alignment(size_t alignment) { alignment_ = alignment; }
+
+  /// Whether the table is a view of a memory-mapped file.
+  bool mapped() const { return view_ != nullptr; }
+  /// Keeps the mapped pages alive, data loaded from the table may share it.
+  const std::shared_ptr<void>& mapping() const { return mapping_; }
 
   /// Serialize the table to a binary buffer.
   void SaveToFile(const std::string& filename) const;
@@ -68,6 +86,11 @@ struct BinaryTable {
                     const size_t& offset = 0,
                     const size_t& size = 0);
   void LoadFromMemory(const char* buffer, size_t buffer_size);
+  /// Map the file readonly instead of reading it, falls back to
+  /// `LoadFromFile` where mmap is not available.
+  void LoadFromFileMapped(const std::string& filename,
+                          const size_t& offset = 0,
+                          const size_t& size = 0);
 };
 
 /*
@@ -134,6 +157,7 @@ template <typename Primary>
 class PrimaryListBuilder : public FieldBuilder {
   const Primary* data_{nullptr};
   int size_{0};
+  bool aligned_{false};
 
  public:
   using value_type = Primary;
@@ -142,6 +166,10 @@ class PrimaryListBuilder : public FieldBuilder {
   PrimaryListBuilder(BinaryTable* table, const Primary* val, int size)
       : FieldBuilder(table), data_(val), size_(size) {}
 
+  /// Place the elements at the table's alignment boundary, the padding goes
+  /// between the element count and the elements.
+  void set_aligned(bool x) { aligned_ = x; }
+
   /// Set data.
   void set(const Primary* x, int size) {
     data_ = x;
@@ -392,6 +420,7 @@ void PrimaryListBuilder<Primary>::Load() {
   uint64_t num_elems{};
   memcpy(&num_elems, table()->cursor(), sizeof(uint64_t));
   table()->Consume(sizeof(uint64_t));
+  if (aligned_) table()->Align();
 
   set(reinterpret_cast<Primary*>(table()->cursor()), num_elems);
   table()->Consume(num_elems * sizeof(value_type));
@@ -404,6 +433,7 @@ void PrimaryListBuilder<Primary>::Save() {
   table()->Require(sizeof(uint64_t));
   memcpy(table()->cursor(), &num_elems, sizeof(uint64_t));
   table()->Consume(sizeof(uint64_t));
+  if (aligned_) table()->Align();
 
   table()->Require(num_elems * sizeof(value_type));
   memcpy(table()->cursor(),
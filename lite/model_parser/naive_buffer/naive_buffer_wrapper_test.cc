@@ -137,6 +137,50 @@ TEST(NaiveBufferWrapper, ParamDesc) {
   }
 }
 
+TEST(NaiveBufferWrapper, ParamDescAlignedMapped) {
+  const size_t alignment = 64;
+  BinaryTable table0;
+  table0.set_alignment(alignment);
+  proto::CombinedParamsDesc pt_desc0(&table0);
+  CombinedParamsDesc nb_desc0(&pt_desc0);
+
+  // The builders keep pointers to the data until saved.
+  std::vector<std::vector<float>> datas(3);
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 3 * (i + 1); ++j) {
+      datas[i].push_back(i + j / 10.0);
+    }
+    ParamDesc param(nb_desc0.AddParam());
+    param.SetName("param_" + std::to_string(i));
+    param.SetDim({i + 1, 3});
+    param.SetDataType(VarDescAPI::VarDataType::FP32);
+    param.SetData(datas[i]);
+  }
+  pt_desc0.Save();
+  table0.SaveToFile("7.bf");
+
+  // The mapping starts at a page boundary, so the param data keeps the
+  // alignment it has in the file.
+  BinaryTable table1;
+  table1.set_alignment(alignment);
+  table1.LoadFromFileMapped("7.bf");
+  proto::CombinedParamsDesc pt_desc1(&table1);
+  pt_desc1.Load();
+  CombinedParamsDesc nb_desc1(&pt_desc1);
+
+  ASSERT_EQ(nb_desc1.ParamsSize(), datas.size());
+  for (size_t i = 0; i < datas.size(); ++i) {
+    ParamDesc param(nb_desc1.GetParam(i));
+    ASSERT_EQ(param.Name(), "param_" + std::to_string(i));
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(param.RawData()) % alignment, 0U);
+    ASSERT_EQ(param.RawDataSize(), datas[i].size() * sizeof(float));
+    auto* data = reinterpret_cast<const float*>(param.RawData());
+    for (size_t j = 0; j < datas[i].size(); ++j) {
+      EXPECT_EQ(data[j], datas[i][j]);
+    }
+  }
+}
+
 TEST(NaiveBufferWrapper, CombinedParamsDesc) {
   BinaryTable table0;
   proto::CombinedParamsDesc pt_desc0(&table0);
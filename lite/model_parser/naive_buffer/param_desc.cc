@@ -143,6 +143,14 @@ void ParamDesc::SetDim(const std::vector<int64_t>& dim) {
   VectorToRepeated<int64_t, Int64Builder>(dim, out_builder);
 }
 
+const char* ParamDesc::RawData() const {
+  return desc_->GetField<PrimaryListBuilder<char>>("data").data();
+}
+
+size_t ParamDesc::RawDataSize() const {
+  return desc_->GetField<PrimaryListBuilder<char>>("data").size();
+}
+
 #define GET_DATA_IMPL(T, type__)                                            \
   template <>                                                               \
   std::vector<T> ParamDesc::Data() const {                                  \
@@ -71,6 +71,10 @@ class ParamDesc {
   template <typename T>
   std::vector<T> Data() const;
 
+  // The data in place, it lives as long as the table of the desc.
+  const char *RawData() const;
+  size_t RawDataSize() const;
+
   template <typename T>
   void SetData(const std::vector<T> &data);
 
@@ -191,7 +191,9 @@ class ParamDesc : public StructBuilder {
     New<lod_type>("lod");
     NewUInt32("tensor_version");
     New<TensorDesc>("tensor_desc");
-    New<PrimaryListBuilder<char>>("data");
+    // Padded to the table's alignment so that a mapped model can be used in
+    // place, see `BinaryTable::LoadFromFileMapped`.
+    New<PrimaryListBuilder<char>>("data")->set_aligned(true);
   }
 };
 
@@ -14,6 +14,7 @@
 
 #include "lite/model_parser/naive_buffer/var_desc.h"
 #include <string>
+#include <vector>
 
 namespace paddle {
 namespace lite {
@@ -125,6 +126,37 @@ VarDescAPI::VarDataType VarDesc::GetDataType() const {
 #undef GET_DATA_TYPE_CASE_ITEM
 }
 
+std::vector<int64_t> VarDesc::GetShape() const {
+  using dims_builder_t = ListBuilder<Int64Builder>;
+
+  std::vector<int64_t> res;
+  if (GetType() != VarDescAPI::Type::LOD_TENSOR) return res;
+  auto& dims = GetVarType()
+                   .GetField<proto::LoDTensorDesc>("lod_tensor")
+                   .GetField<proto::TensorDesc>("tensor")
+                   .GetField<dims_builder_t>("dims");
+  for (auto& dim : dims) {
+    res.push_back(dim.data());
+  }
+  return res;
+}
+
+void VarDesc::SetShape(const std::vector<int64_t>& dims) {
+  using dims_builder_t = ListBuilder<Int64Builder>;
+
+  CHECK(GetType() == VarDescAPI::Type::LOD_TENSOR)
+      << "Only LOD_TENSOR var can set shape";
+  auto* builder = GetMutableVarType()
+                      ->GetMutableField<proto::LoDTensorDesc>("lod_tensor")
+                      ->GetMutableField<proto::TensorDesc>("tensor")
+                      ->GetMutableField<dims_builder_t>("dims");
+  CHECK(builder);
+  builder->Clear();
+  for (auto dim : dims) {
+    builder->New()->set(dim);
+  }
+}
+
 proto::VarType* VarDesc::GetMutableVarType() {
   auto* builder = desc_->GetMutableField<proto::VarType>("type");
   CHECK(builder);
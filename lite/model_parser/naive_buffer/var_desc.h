@@ -53,6 +53,10 @@ class VarDesc : public VarDescAPI {
 
   VarDescAPI::VarDataType GetDataType() const;
 
+  std::vector<int64_t> GetShape() const;
+
+  void SetShape(const std::vector<int64_t> &dims);
+
  private:
   const proto::VarType &GetVarType() const;
   proto::VarType *GetMutableVarType();
@@ -32,6 +32,9 @@ class ConcatOpLite : public OpLite {
 
   bool InferShape() const override;
 
+  // The concat axis can be fed by the AxisTensor input at runtime.
+  bool infer_shape_cacheable() const override { return false; }
+
   bool AttachImpl(const cpp::OpDesc &opdesc, lite::Scope *scope) override;
 
   void AttachKernel(KernelBase *kernel) override { kernel->SetParam(param_); }
@@ -103,6 +103,10 @@ class ConvOpLite : public OpLite {
     if (op_desc.HasAttr("padding_algorithm")) {
       padding_algorithm_ = op_desc.GetAttr<std::string>("padding_algorithm");
     }
+    if (op_desc.HasAttr("weight_quant_type")) {
+      param_.weight_quant_type =
+          op_desc.GetAttr<std::string>("weight_quant_type");
+    }
     // For Int8
     if (op_desc.HasAttr("enable_int8")) {
       param_.enable_int8 = op_desc.GetAttr<bool>("enable_int8");
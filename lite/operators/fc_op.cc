@@ -97,6 +97,10 @@ bool FcOpLite::AttachImpl(const cpp::OpDesc& op_desc, lite::Scope* scope) {
   } else {
     param_.padding_weights = false;
   }
+  if (op_desc.HasAttr("weight_quant_type")) {
+    param_.weight_quant_type =
+        op_desc.GetAttr<std::string>("weight_quant_type");
+  }
 
   // For Int8
   if (op_desc.HasAttr("enable_int8")) {
@@ -0,0 +1,67 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/operators/fused_add_layer_norm_op.h"
+#include "lite/core/op_lite.h"
+#include "lite/core/op_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace operators {
+
+bool FusedAddLayerNormOp::CheckShape() const {
+  CHECK_OR_FALSE(param_.X)
+  CHECK_OR_FALSE(param_.Y)
+  CHECK_OR_FALSE(param_.Scale)
+  CHECK_OR_FALSE(param_.Bias)
+  CHECK_OR_FALSE(param_.Out)
+
+  const auto &x_dims = param_.X->dims();
+  CHECK_OR_FALSE(param_.Y->dims() == x_dims)
+  CHECK_GT_OR_FALSE(param_.begin_norm_axis, 0)
+  CHECK_GT_OR_FALSE(static_cast<int>(x_dims.size()), param_.begin_norm_axis)
+  auto right = x_dims.Flatten2D(param_.begin_norm_axis)[1];
+  CHECK_EQ_OR_FALSE(param_.Scale->numel(), right)
+  CHECK_EQ_OR_FALSE(param_.Bias->numel(), right)
+  return true;
+}
+
+bool FusedAddLayerNormOp::InferShape() const {
+  param_.Out->Resize(param_.X->dims());
+  param_.Out->set_lod(param_.X->lod());
+  return true;
+}
+
+bool FusedAddLayerNormOp::AttachImpl(const cpp::OpDesc &op_desc,
+                                     lite::Scope *scope) {
+  param_.X = scope->FindVar(op_desc.Input("X").front())->GetMutable<Tensor>();
+  param_.Y = scope->FindVar(op_desc.Input("Y").front())->GetMutable<Tensor>();
+  param_.Scale =
+      scope->FindVar(op_desc.Input("Scale").front())->GetMutable<Tensor>();
+  param_.Bias =
+      scope->FindVar(op_desc.Input("Bias").front())->GetMutable<Tensor>();
+  param_.Out =
+      scope->FindVar(op_desc.Output("Out").front())->GetMutable<Tensor>();
+
+  param_.begin_norm_axis = op_desc.GetAttr<int>("begin_norm_axis");
+  param_.epsilon = op_desc.GetAttr<float>("epsilon");
+  return true;
+}
+
+}  // namespace operators
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_LITE_OP(fused_add_layer_norm,
+                 paddle::lite::operators::FusedAddLayerNormOp);
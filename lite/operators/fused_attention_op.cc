@@ -0,0 +1,99 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/operators/fused_attention_op.h"
+#include <algorithm>
+#include <vector>
+#include "lite/core/op_lite.h"
+#include "lite/core/op_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace operators {
+
+bool FusedAttentionOp::CheckShape() const {
+  CHECK_OR_FALSE(param_.Q)
+  CHECK_OR_FALSE(param_.K)
+  CHECK_OR_FALSE(param_.V)
+  CHECK_OR_FALSE(param_.Out)
+
+  const auto &q_dims = param_.Q->dims();
+  const auto &k_dims = param_.K->dims();
+  const auto &v_dims = param_.V->dims();
+  size_t rank = q_dims.size();
+  CHECK_GE_OR_FALSE(rank, 2UL)
+  CHECK_EQ_OR_FALSE(k_dims.size(), rank)
+  CHECK_EQ_OR_FALSE(v_dims.size(), rank)
+  for (size_t i = 0; i + 2 < rank; i++) {
+    CHECK_EQ_OR_FALSE(k_dims[i], q_dims[i])
+    CHECK_EQ_OR_FALSE(v_dims[i], q_dims[i])
+  }
+  CHECK_EQ_OR_FALSE(k_dims[rank - 1], q_dims[rank - 1])
+  CHECK_EQ_OR_FALSE(v_dims[rank - 2], k_dims[rank - 2])
+  if (param_.transpose_out) {
+    CHECK_EQ_OR_FALSE(rank, 4UL)
+  }
+
+  if (param_.Mask) {
+    // The mask is broadcast to the scores [..., seq_q, seq_k].
+    std::vector<int64_t> scores_dims = q_dims.Vectorize();
+    scores_dims[rank - 1] = k_dims[rank - 2];
+    const auto &mask_dims = param_.Mask->dims();
+    CHECK_GE_OR_FALSE(rank, mask_dims.size())
+    size_t offset = rank - mask_dims.size();
+    for (size_t i = 0; i < mask_dims.size(); i++) {
+      CHECK_OR_FALSE(mask_dims[i] == 1 ||
+                     mask_dims[i] == scores_dims[i + offset])
+    }
+  }
+  return true;
+}
+
+bool FusedAttentionOp::InferShape() const {
+  const auto &q_dims = param_.Q->dims();
+  size_t rank = q_dims.size();
+  std::vector<int64_t> out_dims = q_dims.Vectorize();
+  out_dims[rank - 1] = param_.V->dims()[rank - 1];
+  if (param_.transpose_out) {
+    std::swap(out_dims[1], out_dims[2]);
+  }
+  param_.Out->Resize(out_dims);
+  return true;
+}
+
+bool FusedAttentionOp::AttachImpl(const cpp::OpDesc &op_desc,
+                                  lite::Scope *scope) {
+  param_.Q = scope->FindVar(op_desc.Input("Q").front())->GetMutable<Tensor>();
+  param_.K = scope->FindVar(op_desc.Input("K").front())->GetMutable<Tensor>();
+  param_.V = scope->FindVar(op_desc.Input("V").front())->GetMutable<Tensor>();
+  param_.Mask = nullptr;
+  if (op_desc.HasInput("Mask") && !op_desc.Input("Mask").empty()) {
+    param_.Mask =
+        scope->FindVar(op_desc.Input("Mask").front())->GetMutable<Tensor>();
+  }
+  param_.Out =
+      scope->FindVar(op_desc.Output("Out").front())->GetMutable<Tensor>();
+
+  param_.alpha = op_desc.GetAttr<float>("alpha");
+  if (op_desc.HasAttr("transpose_out")) {
+    param_.transpose_out = op_desc.GetAttr<bool>("transpose_out");
+  }
+  return true;
+}
+
+}  // namespace operators
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_LITE_OP(fused_attention, paddle::lite::operators::FusedAttentionOp);
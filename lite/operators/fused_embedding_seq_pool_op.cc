@@ -0,0 +1,82 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/operators/fused_embedding_seq_pool_op.h"
+#include "lite/core/op_lite.h"
+#include "lite/core/op_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace operators {
+
+bool FusedEmbeddingSeqPoolOp::CheckShape() const {
+  CHECK_OR_FALSE(param_.W)
+  CHECK_OR_FALSE(param_.Ids)
+  CHECK_OR_FALSE(param_.Out)
+
+  const auto &table_dims = param_.W->dims();
+  const auto &ids_dims = param_.Ids->dims();
+  int ids_rank = ids_dims.size();
+  CHECK_EQ_OR_FALSE(table_dims.size(), 2)
+  CHECK_GE_OR_FALSE(ids_rank, 2)
+  CHECK_EQ_OR_FALSE(ids_dims[ids_rank - 1], 1)
+
+  const auto &lod = param_.Ids->lod();
+  CHECK_EQ_OR_FALSE(lod.size(), 1UL)
+  CHECK_GE_OR_FALSE(ids_dims[0], static_cast<int64_t>(lod[0].size()) - 1)
+  CHECK_OR_FALSE(param_.combiner == "sum" || param_.combiner == "average" ||
+                 param_.combiner == "sqrt")
+  return true;
+}
+
+bool FusedEmbeddingSeqPoolOp::InferShape() const {
+  const auto &table_dims = param_.W->dims();
+  auto out_dims = param_.Ids->dims();
+  out_dims[0] = param_.Ids->lod()[0].size() - 1;
+  out_dims[out_dims.size() - 1] = table_dims[1];
+  if (param_.W->precision() == PRECISION(kInt8)) {
+    // Strip the scale of the rows of the quantized table.
+    out_dims[out_dims.size() - 1] -= sizeof(float);
+  }
+  param_.Out->Resize(out_dims);
+  return true;
+}
+
+bool FusedEmbeddingSeqPoolOp::AttachImpl(const cpp::OpDesc &op_desc,
+                                         lite::Scope *scope) {
+  auto input = op_desc.Input("W").front();
+  auto ids = op_desc.Input("Ids").front();
+  auto out = op_desc.Output("Out").front();
+
+  param_.W = scope->FindVar(input)->GetMutable<lite::Tensor>();
+  param_.Ids = scope->FindVar(ids)->GetMutable<lite::Tensor>();
+  param_.Out = scope->FindVar(out)->GetMutable<lite::Tensor>();
+
+  param_.combiner = op_desc.GetAttr<std::string>("combiner");
+  if (op_desc.HasAttr("padding_idx")) {
+    param_.padding_idx = op_desc.GetAttr<int64_t>("padding_idx");
+  }
+  if (op_desc.HasAttr("embedding_quant_type")) {
+    param_.embedding_quant_type =
+        op_desc.GetAttr<std::string>("embedding_quant_type");
+  }
+  return true;
+}
+
+}  // namespace operators
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_LITE_OP(fused_embedding_seq_pool,
+                 paddle::lite::operators::FusedEmbeddingSeqPoolOp)
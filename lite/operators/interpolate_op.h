@@ -33,6 +33,9 @@ class InterpolateOp : public OpLite {
 
   bool InferShape() const override;
 
+  // The output size can be decided by the OutSize/SizeTensor/Scale inputs.
+  bool infer_shape_cacheable() const override { return false; }
+
   bool AttachImpl(const cpp::OpDesc &opdesc, lite::Scope *scope) override;
 
   void AttachKernel(KernelBase *kernel) override { kernel->SetParam(param_); }
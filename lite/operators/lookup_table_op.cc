@@ -43,6 +43,10 @@ bool LookupTableOpLite::InferShape() const {
   auto out_dims = ids_dims;
   int ids_rank = ids_dims.size();
   out_dims[ids_rank - 1] = table_dims[1];
+  if (param_.W->precision() == PRECISION(kInt8)) {
+    // Strip the scale of the rows of the quantized table.
+    out_dims[ids_rank - 1] -= sizeof(float);
+  }
 
   param_.Out->Resize(out_dims);
   param_.Out->set_lod(param_.Ids->lod());
@@ -60,6 +64,10 @@ bool LookupTableOpLite::AttachImpl(const cpp::OpDesc& op_desc,
   param_.Out = scope->FindVar(out)->GetMutable<lite::Tensor>();
 
   param_.padding_idx = op_desc.GetAttr<int64_t>("padding_idx");
+  if (op_desc.HasAttr("embedding_quant_type")) {
+    param_.embedding_quant_type =
+        op_desc.GetAttr<std::string>("embedding_quant_type");
+  }
 
   return true;
 }
@@ -41,6 +41,10 @@ bool LookupTableV2OpLite::InferShape() const {
     out_dims.push_back(ids_dims[i]);
   }
   out_dims.push_back(table_dims[1]);
+  if (param_.W->precision() == PRECISION(kInt8)) {
+    // Strip the scale of the rows of the quantized table.
+    out_dims.back() -= sizeof(float);
+  }
   param_.Out->Resize(lite::DDim{out_dims});
   param_.Out->set_lod(param_.Ids->lod());
   return true;
@@ -57,6 +61,10 @@ bool LookupTableV2OpLite::AttachImpl(const cpp::OpDesc &op_desc,
   param_.Out = scope->FindVar(out)->GetMutable<lite::Tensor>();
 
   param_.padding_idx = op_desc.GetAttr<int64_t>("padding_idx");
+  if (op_desc.HasAttr("embedding_quant_type")) {
+    param_.embedding_quant_type =
+        op_desc.GetAttr<std::string>("embedding_quant_type");
+  }
 
   return true;
 }
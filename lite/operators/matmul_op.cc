@@ -155,6 +155,20 @@ bool MatMulOpLite::AttachImpl(const cpp::OpDesc &op_desc, lite::Scope *scope) {
   param_.transpose_X = op_desc.GetAttr<bool>("transpose_X");
   param_.transpose_Y = op_desc.GetAttr<bool>("transpose_Y");
   param_.alpha = op_desc.GetAttr<float>("alpha");
+  if (op_desc.HasAttr("weight_quant_type")) {
+    param_.weight_quant_type =
+        op_desc.GetAttr<std::string>("weight_quant_type");
+  }
+  // For Int8
+  if (op_desc.HasAttr("enable_int8")) {
+    param_.enable_int8 = op_desc.GetAttr<bool>("enable_int8");
+    if (op_desc.HasAttr("input_scale"))
+      param_.input_scale = op_desc.GetAttr<float>("input_scale");
+    if (op_desc.HasAttr("weight_scale"))
+      param_.weight_scale = op_desc.GetAttr<std::vector<float>>("weight_scale");
+    if (op_desc.HasAttr("output_scale"))
+      param_.output_scale = op_desc.GetAttr<float>("output_scale");
+  }
   return true;
 }
 
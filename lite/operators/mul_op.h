@@ -56,6 +56,21 @@ class MulOpLite : public OpLite {
     param_.output = var->GetMutable<Tensor>();
     param_.x_num_col_dims = op_desc.GetAttr<int>("x_num_col_dims");
     param_.y_num_col_dims = op_desc.GetAttr<int>("y_num_col_dims");
+    if (op_desc.HasAttr("weight_quant_type")) {
+      param_.weight_quant_type =
+          op_desc.GetAttr<std::string>("weight_quant_type");
+    }
+    // For Int8
+    if (op_desc.HasAttr("enable_int8")) {
+      param_.enable_int8 = op_desc.GetAttr<bool>("enable_int8");
+      if (op_desc.HasAttr("input_scale"))
+        param_.input_scale = op_desc.GetAttr<float>("input_scale");
+      if (op_desc.HasAttr("weight_scale"))
+        param_.weight_scale =
+            op_desc.GetAttr<std::vector<float>>("weight_scale");
+      if (op_desc.HasAttr("output_scale"))
+        param_.output_scale = op_desc.GetAttr<float>("output_scale");
+    }
 
     return true;
   }
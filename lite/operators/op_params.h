@@ -92,6 +92,9 @@ struct FcParam {
   int in_num_col_dims{1};
   std::string activation_type{""};
   bool padding_weights{false};
+  // "fp16" or "bf16" if the weights are stored in 16 bits by the
+  // weight_half_quantization_pass.
+  std::string weight_quant_type{};
   // for int8
   WITH_INT8_CONFIG
 };
@@ -129,6 +132,9 @@ struct MulParam {
 
   int x_num_col_dims{1};
   int y_num_col_dims{1};
+  // "fp16" or "bf16" if the weights are stored in 16 bits by the
+  // weight_half_quantization_pass.
+  std::string weight_quant_type{};
   // for int8
   WITH_INT8_CONFIG
 };
@@ -291,6 +297,9 @@ struct ConvParam {
   bool var_length{false};
   // only used in conv_transpose.
   std::vector<int> output_size;
+  // "fp16" or "bf16" if the weights are stored in 16 bits by the
+  // weight_half_quantization_pass.
+  std::string weight_quant_type{};
   // for int8
   WITH_INT8_CONFIG
 };
@@ -662,11 +671,15 @@ struct BeamSearchDecodeParam {
 };
 
 /// ----------------------- LookupTable operators ----------------------f
+// The embedding tables quantized by the embedding_quantization_pass, "int8"
+// tables store each row as its int8 values followed by the float scale of the
+// row, "fp16" tables store the half precision bits in an int16 tensor.
 struct LookupTableParam {
   lite::Tensor* W{nullptr};
   lite::Tensor* Ids{nullptr};
   lite::Tensor* Out{nullptr};
   int64_t padding_idx{-1};
+  std::string embedding_quant_type{};
 };
 
 struct Im2SequenceParam {
@@ -779,6 +792,41 @@ struct SequencePoolConcatParam {
   std::vector<std::string> pool_type{};
 };
 
+struct FusedEmbeddingSeqPoolParam {
+  const lite::Tensor* W{};
+  const lite::Tensor* Ids{};
+  lite::Tensor* Out{};
+  std::string combiner{"sum"};
+  int64_t padding_idx{-1};
+  std::string embedding_quant_type{};
+};
+
+// softmax(alpha * Q * K^T + Mask) * V, the batch dims of Q, K and V are the
+// leading ones, e.g. [batch, heads, seq, size], and Mask is broadcast to the
+// [..., seq_q, seq_k] scores.
+struct FusedAttentionParam {
+  const lite::Tensor* Q{};
+  const lite::Tensor* K{};
+  const lite::Tensor* V{};
+  const lite::Tensor* Mask{};
+  lite::Tensor* Out{};
+  float alpha{1.f};
+  // Output [batch, seq, heads, size] instead of [batch, heads, seq, size],
+  // which is the attention followed by transpose2 with axis {0, 2, 1, 3}.
+  bool transpose_out{false};
+};
+
+// layer_norm(X + Y), X and Y have the same shape.
+struct FusedAddLayerNormParam {
+  const lite::Tensor* X{};
+  const lite::Tensor* Y{};
+  const lite::Tensor* Scale{};
+  const lite::Tensor* Bias{};
+  lite::Tensor* Out{};
+  int begin_norm_axis{1};
+  float epsilon{1e-5};
+};
+
 struct SearchGroupPaddingParam {
   lite::Tensor* x{};
   lite::Tensor* out_emb_padding{};
@@ -976,6 +1024,11 @@ struct MatMulParam {
   bool transpose_X{false};
   bool transpose_Y{false};
   float alpha{1.0f};
+  // "fp16" or "bf16" if the weights are stored in 16 bits by the
+  // weight_half_quantization_pass.
+  std::string weight_quant_type{};
+  // for int8
+  WITH_INT8_CONFIG
 };
 
 struct GatherParam {
@@ -31,6 +31,9 @@ class RangeOpLite : public OpLite {
 
   bool InferShape() const override;
 
+  // The output length is computed from the values of Start, End and Step.
+  bool infer_shape_cacheable() const override { return false; }
+
   bool AttachImpl(const cpp::OpDesc &opdesc, lite::Scope *scope) override;
 
   void AttachKernel(KernelBase *kernel) override { kernel->SetParam(param_); }
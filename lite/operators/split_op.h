@@ -32,6 +32,9 @@ class SplitOp : public OpLite {
 
   bool InferShape() const override;
 
+  // The axis and sections can be fed by tensors at runtime.
+  bool infer_shape_cacheable() const override { return false; }
+
   bool AttachImpl(const cpp::OpDesc &opdesc, lite::Scope *scope) override;
 
   void AttachKernel(KernelBase *kernel) override { kernel->SetParam(param_); }
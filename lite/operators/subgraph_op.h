@@ -14,7 +14,9 @@
 
 #pragma once
 
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 #include "lite/core/kernel.h"
 #include "lite/core/op_lite.h"
@@ -44,10 +46,18 @@ class SubgraphOp : public OpLite {
   std::string DebugString() const override { return "subgraph"; }
 
   void SetSubBlock(cpp::BlockDesc *desc) { param_.sub_block_desc = desc; }
+  // The subblock desc of a new subgraph op, which is not in any program desc,
+  // is owned by the op.
+  void SetSubBlock(std::unique_ptr<cpp::BlockDesc> &&desc) {
+    own_sub_block_desc_ = std::move(desc);
+    param_.sub_block_desc = own_sub_block_desc_.get();
+  }
   cpp::BlockDesc *GetSubBlock() { return param_.sub_block_desc; }
+  const cpp::BlockDesc *GetSubBlock() const { return param_.sub_block_desc; }
 
  private:
   mutable SubgraphParam param_;
+  std::unique_ptr<cpp::BlockDesc> own_sub_block_desc_;
 };
 
 }  // namespace operators
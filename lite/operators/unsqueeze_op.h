@@ -32,6 +32,9 @@ class UnsqueezeOp : public OpLite {
 
   bool InferShape() const override;
 
+  // The axes can be fed by the AxesTensor inputs at runtime.
+  bool infer_shape_cacheable() const override { return false; }
+
   bool AttachImpl(const cpp::OpDesc &opdesc, lite::Scope *scope) override;
 
   void AttachKernel(KernelBase *kernel) override { kernel->SetParam(param_); }
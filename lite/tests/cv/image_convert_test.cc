@@ -88,7 +88,7 @@ void print_ff(const float* ptr, int size, int width) {
   printf("\n");
 }
 
-#ifdef LITE_WITH_ARM
+#if defined(LITE_WITH_ARM) || defined(LITE_WITH_X86)
 void test_img(const std::vector<int>& cluster_id,
               const std::vector<int>& thread_num,
               int srcw,
@@ -106,10 +106,12 @@ void test_img(const std::vector<int>& cluster_id,
 #endif
   for (auto& cls : cluster_id) {
     for (auto& th : thread_num) {
+#ifdef LITE_WITH_ARM
       std::unique_ptr<paddle::lite::KernelContext> ctx1(
           new paddle::lite::KernelContext);
       auto& ctx = ctx1->As<paddle::lite::ARMContext>();
       ctx.SetRunMode(static_cast<paddle::lite_api::PowerMode>(cls), th);
+#endif
       LOG(INFO) << "cluster: " << cls << ", threads: " << th;
 
       LOG(INFO) << " input tensor size, num= " << 1 << ", channel= " << 1
@@ -273,6 +275,7 @@ void test_img(const std::vector<int>& cluster_id,
       Timer t_flip;
       Timer t_rotate;
       Timer t_tensor;
+      Timer t_fuse;
 
       LOG(INFO) << "saber cv compute";
       TransParam tparam;
@@ -343,6 +346,22 @@ void test_img(const std::vector<int>& cluster_id,
         t_tensor.Stop();
         t1.Stop();
       }
+      // convert, resize and image2Tensor in one pass
+      bool src_nv =
+          srcFormat == ImageFormat::NV12 || srcFormat == ImageFormat::NV21;
+      bool fuse = dstFormat != ImageFormat::NV12 &&
+                  dstFormat != ImageFormat::NV21 &&
+                  !(src_nv && dstFormat == ImageFormat::GRAY);
+      Tensor tensor_fuse;
+      tensor_fuse.Resize(shape_out);
+      tensor_fuse.set_precision(PRECISION(kFloat));
+      Tensor_api dst_tensor_fuse(&tensor_fuse);
+      for (int i = 0; fuse && i < test_iter; ++i) {
+        t_fuse.Start();
+        image_preprocess.imageConvertResize2Tensor(
+            src, &dst_tensor_fuse, layout, means, scales);
+        t_fuse.Stop();
+      }
       LOG(INFO) << "image convert avg time : " << t_convert.LapTimes().Avg()
                 << ", min time: " << t_convert.LapTimes().Min()
                 << ", max time: " << t_convert.LapTimes().Max();
@@ -358,6 +377,11 @@ void test_img(const std::vector<int>& cluster_id,
       LOG(INFO) << "image tensor avg time : " << t_tensor.LapTimes().Avg()
                 << ", min time: " << t_tensor.LapTimes().Min()
                 << ", max time: " << t_tensor.LapTimes().Max();
+      if (fuse) {
+        LOG(INFO) << "image fuse avg time : " << t_fuse.LapTimes().Avg()
+                  << ", min time: " << t_fuse.LapTimes().Min()
+                  << ", max time: " << t_fuse.LapTimes().Max();
+      }
       LOG(INFO) << "image trans total avg time : " << t1.LapTimes().Avg()
                 << ", min time: " << t1.LapTimes().Min()
                 << ", max time: " << t1.LapTimes().Max();
@@ -555,6 +579,16 @@ void test_img(const std::vector<int>& cluster_id,
         CHECK_EQ(rst, true) << "compute result error";
         LOG(INFO) << "iamge to tensor end";
       }
+      if (FLAGS_check_result && fuse) {
+        // the same computations as the steps, so the results are equal
+        const float* ptr_a = tensor_fuse.data<float>();
+        const float* ptr_b = tensor.data<float>();
+        int64_t size = dsth * dstw * (dstFormat == ImageFormat::GRAY ? 1 : 3);
+        for (int64_t i = 0; i < size; i++) {
+          CHECK_EQ(ptr_a[i], ptr_b[i]) << "image fuse result error at " << i;
+        }
+        LOG(INFO) << "image fuse end";
+      }
     }
   }
 }
@@ -651,5 +651,25 @@ TEST(Activation_gelu, precision) {
   }
 }
 
+TEST(Activation_relu, benchmark) {
+  arena::RunBenchmarks(
+      {DDim({1, 32, 56, 56}), DDim({1, 128, 28, 28}), DDim({16, 1024})},
+      [](const Place& place, const DDim& dims) {
+        arena::BenchmarkCases cases;
+        cases.emplace_back("relu",
+                           std::unique_ptr<arena::TestCase>(
+                               new ActivationComputeTester(place,
+                                                           "def",
+                                                           0.01,
+                                                           6.,
+                                                           "all",
+                                                           0.,
+                                                           dims,
+                                                           "relu",
+                                                           RELU)));
+        return cases;
+      });
+}
+
 }  // namespace lite
 }  // namespace paddle
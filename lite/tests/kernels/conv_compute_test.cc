@@ -427,5 +427,36 @@ TEST(Conv2d, precision) {
   TestConvAct(place, abs_error);
 }
 
+TEST(Conv2d, benchmark) {
+  arena::RunBenchmarks(
+      {DDim({1, 32, 56, 56}), DDim({1, 64, 28, 28}), DDim({1, 128, 14, 14})},
+      [](const Place& place, const DDim& dims) {
+        arena::BenchmarkCases cases;
+        int channels = dims[1];
+        for (int ksize : {1, 3}) {
+          for (int stride : {1, 2}) {
+            for (int groups : {1, channels}) {
+              if (groups > 1 && ksize == 1) continue;
+              int pad = ksize / 2;
+              cases.emplace_back(
+                  "oc" + std::to_string(channels) + "_k" +
+                      std::to_string(ksize) + "_s" + std::to_string(stride) +
+                      "_g" + std::to_string(groups),
+                  std::unique_ptr<arena::TestCase>(
+                      new ConvComputeTester(place,
+                                            "def",
+                                            dims,
+                                            channels,
+                                            ksize,
+                                            {stride, stride},
+                                            {pad, pad},
+                                            groups)));
+            }
+          }
+        }
+        return cases;
+      });
+}
+
 }  // namespace lite
 }  // namespace paddle
@@ -239,5 +239,24 @@ TEST(Elementwise, precision) {
   TestEltFuseAct(place, abs_error);
 }
 
+TEST(Elementwise, benchmark) {
+  arena::RunBenchmarks(
+      {DDim({1, 32, 56, 56}), DDim({1, 128, 28, 28}), DDim({16, 1024})},
+      [](const Place& place, const DDim& dims) {
+        arena::BenchmarkCases cases;
+        auto x_shape = dims.Vectorize();
+        // The same shape, and a broadcast along the channels.
+        cases.emplace_back("add",
+                           std::unique_ptr<arena::TestCase>(
+                               new ElementwiseComputeTester(
+                                   place, "def", "add", x_shape, x_shape, 0)));
+        cases.emplace_back(
+            "add_bcast_channel",
+            std::unique_ptr<arena::TestCase>(new ElementwiseComputeTester(
+                place, "def", "add", x_shape, {x_shape[1]}, 1)));
+        return cases;
+      });
+}
+
 }  // namespace lite
 }  // namespace paddle
@@ -296,5 +296,28 @@ TEST(FcOP, padding_and_parallel) {
 }
 #endif
 
+TEST(FcOP, benchmark) {
+  // The input shapes are [m, k], n is the output size.
+  arena::RunBenchmarks(
+      {DDim({1, 256}), DDim({1, 1024}), DDim({16, 256}), DDim({16, 1024})},
+      [](const Place& place, const DDim& dims) {
+        arena::BenchmarkCases cases;
+        for (int64_t n : {256, 1024}) {
+          int64_t k = dims[1];
+          cases.emplace_back("n" + std::to_string(n),
+                             std::unique_ptr<arena::TestCase>(
+                                 new FcOPTest(place,
+                                              "def",
+                                              dims,
+                                              DDim({k, n}),
+                                              DDim({n}),
+                                              1,
+                                              false,
+                                              false)));
+        }
+        return cases;
+      });
+}
+
 }  // namespace lite
 }  // namespace paddle
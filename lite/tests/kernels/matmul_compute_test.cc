@@ -571,5 +571,20 @@ TEST(Matmulnxn, precision) {
   test_matmulnxn_xytranspose(place, abs_error);
 }
 
+TEST(Matmul, benchmark) {
+  // The shapes of X are swept, Y is [k, k] for X of [..., m, k].
+  arena::RunBenchmarks(
+      {DDim({64, 64}), DDim({128, 256}), DDim({8, 64, 64}), DDim({1, 512})},
+      [](const Place& place, const DDim& dims) {
+        arena::BenchmarkCases cases;
+        int64_t k = dims[dims.size() - 1];
+        cases.emplace_back("square_y",
+                           std::unique_ptr<arena::TestCase>(
+                               new MatMulComputeTester(
+                                   place, "def", dims, DDim({k, k}))));
+        return cases;
+      });
+}
+
 }  // namespace lite
 }  // namespace paddle
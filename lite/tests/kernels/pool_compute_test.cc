@@ -363,5 +363,30 @@ TEST(Pool, precision) {
   TestPoolKsize(place, abs_error);
 }
 
+TEST(Pool, benchmark) {
+  arena::RunBenchmarks(
+      {DDim({1, 64, 112, 112}), DDim({1, 256, 28, 28}), DDim({1, 1024, 7, 7})},
+      [](const Place& place, const DDim& dims) {
+        arena::BenchmarkCases cases;
+        for (std::string pooling_type : {"max", "avg"}) {
+          cases.emplace_back(pooling_type + "_k3_s2",
+                             std::unique_ptr<arena::TestCase>(
+                                 new PoolComputeTest(place,
+                                                     "def",
+                                                     dims,
+                                                     pooling_type,
+                                                     false,
+                                                     {2, 2},
+                                                     {1, 1},
+                                                     {3, 3})));
+          cases.emplace_back(
+              pooling_type + "_global",
+              std::unique_ptr<arena::TestCase>(
+                  new PoolComputeTest(place, "def", dims, pooling_type, true)));
+        }
+        return cases;
+      });
+}
+
 }  // namespace lite
 }  // namespace paddle
@@ -121,5 +121,17 @@ TEST(Softmax, precision) {
   }
 }
 
+TEST(Softmax, benchmark) {
+  arena::RunBenchmarks(
+      {DDim({1, 1000}), DDim({64, 1000}), DDim({8, 12, 128, 128})},
+      [](const Place& place, const DDim& dims) {
+        arena::BenchmarkCases cases;
+        cases.emplace_back("last_axis",
+                           std::unique_ptr<arena::TestCase>(
+                               new SoftmaxComputeTest(place, "def", dims, -1)));
+        return cases;
+      });
+}
+
 }  // namespace lite
 }  // namespace paddle
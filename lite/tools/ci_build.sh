@@ -296,6 +296,23 @@ function build_test_train {
 
 }
 
+# Build the python api and run its smoke test on the naive model. This is
+# executed in the CI system.
+function build_test_python {
+    mkdir -p ./build
+    cd ./build
+    export LD_LIBRARY_PATH="$LD_LIBRARY_PATH:$PWD/third_party/install/mklml/lib"
+    prepare_workspace # fake an empty __generated_code__.cc to pass cmake.
+    cmake .. -DWITH_LITE=ON -DWITH_GPU=OFF -DWITH_MKLDNN=OFF -DLITE_WITH_X86=ON -DLITE_WITH_ARM=OFF \
+        -DLITE_WITH_LIGHT_WEIGHT_FRAMEWORK=OFF -DWITH_TESTING=ON -DWITH_MKL=ON -DLITE_WITH_PYTHON=ON
+
+    make lite_pybind extern_lite_download_lite_naive_model_tar_gz -j$NUM_CORES_FOR_COMPILE
+    mkdir -p ./python/lib
+    cp ./lite/api/python/pybind/liblite_pybind.so ./python/lib/lite_core.so
+    python ../lite/tools/python/tensor_numpy_test.py --lib_dir=./python/lib \
+        --model_dir=./third_party/install/lite_naive_model
+}
+
 function cmake_xpu {
     export LD_LIBRARY_PATH="$LD_LIBRARY_PATH:$PWD/third_party/install/mklml/lib"
     prepare_workspace
@@ -1070,6 +1087,10 @@ function main {
                 build_test_train
                 shift
                 ;;
+            build_test_python)
+                build_test_python
+                shift
+                ;;
             build_test_arm)
                 build_test_arm
                 shift
@@ -0,0 +1,48 @@
+#!/bin/bash
+set -e
+
+# Run the benchmarks of the kernel tests, see
+# docs/advanced_user_guides/test_tools.md.
+if [ $# -lt 2 ];
+then
+    echo "Input error"
+    echo "Usage:"
+    echo "  sh op_benchmark.sh build_dir result_filename <baseline_filename> <other flags of the tests>"
+    echo "\ne.g. sh op_benchmark.sh build.lite.x86 result.tsv baseline.tsv --arena_benchmark_repeats=200"
+    exit 1
+fi
+
+BUILD_DIR=$1
+RESULT_FILENAME=$2
+BASELINE_FILENAME=""
+if [ $# -gt 2 ];
+then
+    BASELINE_FILENAME=$3
+fi
+shift $(( $# > 3 ? 3 : $# ))
+
+# --arena_benchmark_all times every case checked by the precision tests too.
+GTEST_FILTER="*benchmark*"
+for arg in "$@"; do
+    case $arg in
+        --arena_benchmark_all|--arena_benchmark_all=true) GTEST_FILTER="*" ;;
+    esac
+done
+
+rm -f $RESULT_FILENAME
+FAILED=0
+for test_bin in $(find $BUILD_DIR/lite/tests/kernels -maxdepth 1 -name "test_kernel_*" -type f -perm -u+x | sort); do
+    echo "Benchmark $(basename $test_bin)"
+    $test_bin --gtest_filter="$GTEST_FILTER" \
+              --arena_benchmark \
+              --arena_benchmark_output=$RESULT_FILENAME \
+              --arena_benchmark_baseline=$BASELINE_FILENAME \
+              "$@" || FAILED=1
+done
+
+if [ $FAILED -ne 0 ];
+then
+    echo "Some benchmarks failed or regressed against $BASELINE_FILENAME"
+    exit 1
+fi
+echo "The results are saved in $RESULT_FILENAME"
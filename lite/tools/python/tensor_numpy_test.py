@@ -0,0 +1,97 @@
+# Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+"""
+Smoke test of Tensor.numpy() and Tensor.from_numpy() of the python api, run
+on the naive model:
+    python tensor_numpy_test.py --lib_dir=<dir of lite_core.so> \
+        --model_dir=<lite_naive_model>
+"""
+
+from __future__ import absolute_import
+from __future__ import division
+from __future__ import print_function
+
+import argparse
+import sys
+import unittest
+
+import numpy as np
+
+parser = argparse.ArgumentParser()
+parser.add_argument("--lib_dir", default="", type=str, help="lite_core.so dir")
+parser.add_argument(
+    "--model_dir", default="", type=str, help="Non-combined Model dir path")
+args, unittest_args = parser.parse_known_args()
+sys.path.append(args.lib_dir)
+
+from lite_core import *
+
+
+def create_predictor():
+    config = CxxConfig()
+    config.set_model_dir(args.model_dir)
+    config.set_valid_places([
+        Place(TargetType.X86, PrecisionType.FP32),
+        Place(TargetType.Host, PrecisionType.FP32)
+    ])
+    return create_paddle_predictor(config)
+
+
+class TensorNumpyTest(unittest.TestCase):
+    def setUp(self):
+        self.predictor = create_predictor()
+        self.data = np.arange(100 * 100, dtype=np.float32).reshape(
+            100, 100) / 10000
+
+    def run_predictor(self, array):
+        input_tensor = self.predictor.get_input(0)
+        input_tensor.from_numpy(array)
+        np.testing.assert_array_equal(input_tensor.numpy(), array)
+        self.predictor.run()
+        output_tensor = self.predictor.get_output(0)
+        output = output_tensor.numpy()
+        self.assertEqual(list(output.shape), output_tensor.shape())
+        np.testing.assert_array_equal(output.flatten(),
+                                      output_tensor.float_data())
+        return output.copy()
+
+    def test_from_numpy(self):
+        expected = self.run_predictor(self.data)
+        # The float32 dtype equal to but not the numpy singleton one.
+        dtype = np.dtype(np.float32).newbyteorder("=")
+        self.assertIsNot(dtype, np.dtype(np.float32))
+        np.testing.assert_array_equal(
+            self.run_predictor(self.data.astype(dtype)), expected)
+        # The arrays not C contiguous are copied.
+        np.testing.assert_array_equal(
+            self.run_predictor(np.asfortranarray(self.data)), expected)
+
+    def test_numpy_is_a_view(self):
+        input_tensor = self.predictor.get_input(0)
+        input_tensor.from_numpy(self.data)
+        view = input_tensor.numpy()
+        self.assertEqual(view.dtype, np.float32)
+        view[0, 0] = 42.
+        self.assertEqual(input_tensor.float_data()[0], 42.)
+
+    def test_unsupported_dtype(self):
+        input_tensor = self.predictor.get_input(0)
+        with self.assertRaises(TypeError):
+            input_tensor.from_numpy(self.data.astype(np.float64))
+        with self.assertRaises(TypeError):
+            input_tensor.from_numpy(self.data.astype(np.uint8))
+
+
+if __name__ == '__main__':
+    unittest.main(argv=sys.argv[:1] + unittest_args)
@@ -0,0 +1,63 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/utils/cv/image_fuse.h"
+#include <vector>
+#include "lite/utils/cv/image2tensor.h"
+#include "lite/utils/cv/image_convert.h"
+#include "lite/utils/cv/image_resize.h"
+namespace paddle {
+namespace lite {
+namespace utils {
+namespace cv {
+// arm runs the steps in order with the intermediate images
+void ImageFuse::choose(const uint8_t* src,
+                       Tensor* dst,
+                       ImageFormat srcFormat,
+                       ImageFormat dstFormat,
+                       LayoutType layout,
+                       int srcw,
+                       int srch,
+                       int dstw,
+                       int dsth,
+                       float* means,
+                       float* scales) {
+  int num = 1;
+  if (dstFormat == BGR || dstFormat == RGB) {
+    num = 3;
+  } else if (dstFormat == BGRA || dstFormat == RGBA) {
+    num = 4;
+  }
+  std::vector<uint8_t> converted;
+  if (srcFormat != dstFormat) {
+    converted.resize(srcw * srch * num);
+    ImageConvert img_convert;
+    img_convert.choose(src, converted.data(), srcFormat, dstFormat, srcw, srch);
+    src = converted.data();
+  }
+  std::vector<uint8_t> resized;
+  if (srcw != dstw || srch != dsth) {
+    resized.resize(dstw * dsth * num);
+    ImageResize img_resize;
+    img_resize.choose(src, resized.data(), dstFormat, srcw, srch, dstw, dsth);
+    src = resized.data();
+  }
+  Image2Tensor img2tensor;
+  img2tensor.choose(src, dst, dstFormat, layout, dstw, dsth, means, scales);
+}
+
+}  // namespace cv
+}  // namespace utils
+}  // namespace lite
+}  // namespace paddle
@@ -19,6 +19,7 @@
 #include "lite/utils/cv/image2tensor.h"
 #include "lite/utils/cv/image_convert.h"
 #include "lite/utils/cv/image_flip.h"
+#include "lite/utils/cv/image_fuse.h"
 #include "lite/utils/cv/image_resize.h"
 #include "lite/utils/cv/image_rotate.h"
 namespace paddle {
@@ -148,6 +149,25 @@ void ImagePreprocess::image2Tensor(const uint8_t* src,
                     scales);
 }
 
+void ImagePreprocess::imageConvertResize2Tensor(const uint8_t* src,
+                                                Tensor* dstTensor,
+                                                LayoutType layout,
+                                                float* means,
+                                                float* scales) {
+  ImageFuse img_fuse;
+  img_fuse.choose(src,
+                  dstTensor,
+                  this->srcFormat_,
+                  this->dstFormat_,
+                  layout,
+                  this->transParam_.iw,
+                  this->transParam_.ih,
+                  this->transParam_.ow,
+                  this->transParam_.oh,
+                  means,
+                  scales);
+}
+
 }  // namespace cv
 }  // namespace utils
 }  // namespace lite
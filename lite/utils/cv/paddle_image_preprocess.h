@@ -210,6 +210,25 @@ class ImagePreprocess {
                     LayoutType layout,
                     float* means,
                     float* scales);
+  /*
+  * image convert, resize and change image data to tensor data in one pass,
+  * the result is the same as imageConvert, imageResize and image2Tensor in
+  * order, but without the intermediate images
+  * it converts srcFormat to dstFormat and resizes (iw, ih) to (ow, oh) of
+  * the init param
+  * the output image format of the conversion must be supported by
+  * image2Tensor: GRAY, BGR(RGB) and BGRA(RGBA)
+  * param src: input image data
+  * param dstTensor: output tensor data
+  * param layout: output tensor layout，support NHWC and NCHW
+  * param means: means of image
+  * param scales: scales of image
+  */
+  void imageConvertResize2Tensor(const uint8_t* src,
+                                 Tensor* dstTensor,
+                                 LayoutType layout,
+                                 float* means,
+                                 float* scales);
 
  private:
   ImageFormat srcFormat_;
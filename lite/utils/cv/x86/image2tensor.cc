@@ -0,0 +1,170 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/utils/cv/image2tensor.h"
+#include <string.h>
+#include "lite/backends/x86/cpu_info.h"
+#include "lite/utils/cv/x86/image_rows.h"
+#include "lite/utils/cv/x86/image_rows_simd.h"
+namespace paddle {
+namespace lite {
+namespace utils {
+namespace cv {
+
+void normalize_row_chw(const uint8_t* src,
+                       float* dst,
+                       int width,
+                       int num,
+                       int channels,
+                       int64_t plane,
+                       const float* means,
+                       const float* scales) {
+  int i = 0;
+#ifdef LITE_CV_WITH_AVX2
+  static const bool avx2 = lite::x86::MayIUse(lite::x86::avx2);
+  if (avx2) {
+    i = normalize_row_chw_avx2(
+        src, dst, width, num, channels, plane, means, scales);
+  }
+#endif
+#ifdef __SSE4_1__
+  for (; i + 4 <= width; i += 4) {
+    __m128i px = load_planar4(src + i * num, num);
+    for (int c = 0; c < channels; c++) {
+      __m128 x = _mm_cvtepi32_ps(_mm_cvtepu8_epi32(px));
+      x = _mm_mul_ps(_mm_sub_ps(x, _mm_set1_ps(means[c])),
+                     _mm_set1_ps(scales[c]));
+      _mm_storeu_ps(dst + c * plane + i, x);
+      px = _mm_srli_si128(px, 4);
+    }
+  }
+#endif
+  for (; i < width; i++) {
+    for (int c = 0; c < channels; c++) {
+      dst[c * plane + i] = (src[i * num + c] - means[c]) * scales[c];
+    }
+  }
+}
+
+void normalize_row_hwc(const uint8_t* src,
+                       float* dst,
+                       int width,
+                       int num,
+                       int channels,
+                       const float* means,
+                       const float* scales) {
+  if (channels == 1) {
+    normalize_row_chw(src, dst, width, num, 1, 0, means, scales);
+    return;
+  }
+  int i = 0;
+#ifdef __SSE4_1__
+  // 4 pixels of 3 channels are 3 vectors, with the means and the scales
+  // rotated for each
+  const __m128i hwc4 =
+      _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+  __m128 vmeans[3];
+  __m128 vscales[3];
+  for (int k = 0; k < 3; k++) {
+    vmeans[k] = _mm_setr_ps(means[k % 3],
+                            means[(k + 1) % 3],
+                            means[(k + 2) % 3],
+                            means[k % 3]);
+    vscales[k] = _mm_setr_ps(scales[k % 3],
+                             scales[(k + 1) % 3],
+                             scales[(k + 2) % 3],
+                             scales[k % 3]);
+  }
+  for (; i + 4 <= width; i += 4) {
+    __m128i px;
+    if (num == 4) {
+      px = _mm_shuffle_epi8(
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4)),
+          hwc4);
+    } else {
+      int32_t hi;
+      memcpy(&hi, src + i * 3 + 8, 4);
+      px = _mm_unpacklo_epi64(
+          _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i * 3)),
+          _mm_cvtsi32_si128(hi));
+    }
+    for (int k = 0; k < 3; k++) {
+      __m128 x = _mm_cvtepi32_ps(_mm_cvtepu8_epi32(px));
+      x = _mm_mul_ps(_mm_sub_ps(x, vmeans[k]), vscales[k]);
+      _mm_storeu_ps(dst + i * 3 + k * 4, x);
+      px = _mm_srli_si128(px, 4);
+    }
+  }
+#endif
+  for (; i < width; i++) {
+    for (int c = 0; c < 3; c++) {
+      dst[i * 3 + c] = (src[i * num + c] - means[c]) * scales[c];
+    }
+  }
+}
+
+/*
+  * change image data to tensor data
+  * support image format is BGR(RGB) and BGRA(RGBA), Data layout is NHWC and
+ * NCHW
+  * param src: input image data
+  * param dstTensor: output tensor data
+  * param srcFormat: input image format, support GRAY, BGR(GRB) and BGRA(RGBA)
+  * param srcw: input image width
+  * param srch: input image height
+  * param layout: output tensor layout，support NHWC and NCHW
+  * param means: means of image
+  * param scales: scales of image
+*/
+void Image2Tensor::choose(const uint8_t* src,
+                          Tensor* dst,
+                          ImageFormat srcFormat,
+                          LayoutType layout,
+                          int srcw,
+                          int srch,
+                          float* means,
+                          float* scales) {
+  if ((layout != LayoutType::kNCHW && layout != LayoutType::kNHWC) ||
+      srcFormat == NV12 || srcFormat == NV21) {
+    printf("this layout: %d or image format: %d not support \n",
+           static_cast<int>(layout),
+           srcFormat);
+    return;
+  }
+  float* output = dst->mutable_data<float>();
+  int num = pixel_bytes(srcFormat);
+  int channels = num == 1 ? 1 : 3;
+  int64_t plane = static_cast<int64_t>(srcw) * srch;
+#pragma omp parallel for
+  for (int i = 0; i < srch; i++) {
+    const uint8_t* row = src + i * srcw * num;
+    if (layout == LayoutType::kNCHW) {
+      normalize_row_chw(
+          row, output + i * srcw, srcw, num, channels, plane, means, scales);
+    } else {
+      normalize_row_hwc(row,
+                        output + i * srcw * channels,
+                        srcw,
+                        num,
+                        channels,
+                        means,
+                        scales);
+    }
+  }
+}
+
+}  // namespace cv
+}  // namespace utils
+}  // namespace lite
+}  // namespace paddle
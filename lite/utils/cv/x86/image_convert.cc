@@ -0,0 +1,334 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/utils/cv/image_convert.h"
+#include <math.h>
+#include <string.h>
+#ifdef __SSSE3__
+#include <immintrin.h>
+#endif
+#include "lite/utils/cv/x86/image_rows.h"
+namespace paddle {
+namespace lite {
+namespace utils {
+namespace cv {
+#ifdef __SSSE3__
+// load and store 4 pixels of 3 channels without touching the bytes after them
+inline __m128i load12(const uint8_t* src) {
+  int32_t hi;
+  memcpy(&hi, src + 8, 4);
+  return _mm_unpacklo_epi64(
+      _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src)),
+      _mm_cvtsi32_si128(hi));
+}
+inline void store12(uint8_t* dst, __m128i v) {
+  _mm_storel_epi64(reinterpret_cast<__m128i*>(dst), v);
+  int32_t hi = _mm_cvtsi128_si32(_mm_srli_si128(v, 8));
+  memcpy(dst + 8, &hi, 4);
+}
+inline __m128i loadu(const uint8_t* src) {
+  return _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+}
+inline void storeu(uint8_t* dst, __m128i v) {
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), v);
+}
+#endif
+
+/*
+nv21(yvu), nv12(yuv) to BGR(BGRA)
+R = Y + 1.402*(V-128);
+G = Y - 0.34414*(U-128) - 0.71414*(V-128);
+B = Y + 1.772*(U-128);
+the same 7 bits fixed point as arm
+ra = 1.402 *128 = 179.456 = 179
+ga = 0.34414 * 128 = 44.3721 = 44
+gb = 0.71414 * 128 = 91.40992 = 91
+ba = 1.772 * 128 = 226.816 = 227
+v_num is the index of v in a vu pair, 0 for nv21 and 1 for nv12
+*/
+inline uint8_t clamp_u8(int x) { return x < 0 ? 0 : (x > 255 ? 255 : x); }
+
+template <int v_num, int num>
+void nv_to_bgr_row(const uint8_t* y, const uint8_t* uv, uint8_t* dst, int w) {
+  int j = 0;
+#ifdef __SSSE3__
+  const __m128i mask = _mm_set1_epi16(0xff);
+  const __m128i bias = _mm_set1_epi16(128);
+  const __m128i vra = _mm_set1_epi16(179);
+  const __m128i vga = _mm_set1_epi16(44);
+  const __m128i vgb = _mm_set1_epi16(91);
+  const __m128i vba = _mm_set1_epi16(227);
+  const __m128i alpha = _mm_set1_epi8(static_cast<char>(255));
+  const __m128i to_hwc3 =
+      _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+  for (; j + 16 <= w; j += 16) {
+    __m128i vy = loadu(y + j);
+    __m128i vuv = loadu(uv + j);
+    // the even and odd pixels share a chroma pair
+    __m128i y0 = _mm_and_si128(vy, mask);
+    __m128i y1 = _mm_srli_epi16(vy, 8);
+    __m128i c0 = _mm_sub_epi16(_mm_and_si128(vuv, mask), bias);
+    __m128i c1 = _mm_sub_epi16(_mm_srli_epi16(vuv, 8), bias);
+    __m128i v = v_num == 0 ? c0 : c1;
+    __m128i u = v_num == 0 ? c1 : c0;
+    __m128i ra = _mm_srai_epi16(_mm_mullo_epi16(v, vra), 7);
+    __m128i ga = _mm_srai_epi16(
+        _mm_add_epi16(_mm_mullo_epi16(u, vga), _mm_mullo_epi16(v, vgb)), 7);
+    __m128i ba = _mm_srai_epi16(_mm_mullo_epi16(u, vba), 7);
+    // saturate to [0, 255] and interleave the even and odd pixels
+    __m128i r0 = _mm_packus_epi16(_mm_add_epi16(y0, ra), _mm_setzero_si128());
+    __m128i r1 = _mm_packus_epi16(_mm_add_epi16(y1, ra), _mm_setzero_si128());
+    __m128i g0 = _mm_packus_epi16(_mm_sub_epi16(y0, ga), _mm_setzero_si128());
+    __m128i g1 = _mm_packus_epi16(_mm_sub_epi16(y1, ga), _mm_setzero_si128());
+    __m128i b0 = _mm_packus_epi16(_mm_add_epi16(y0, ba), _mm_setzero_si128());
+    __m128i b1 = _mm_packus_epi16(_mm_add_epi16(y1, ba), _mm_setzero_si128());
+    __m128i r = _mm_unpacklo_epi8(r0, r1);
+    __m128i g = _mm_unpacklo_epi8(g0, g1);
+    __m128i b = _mm_unpacklo_epi8(b0, b1);
+    __m128i bg_lo = _mm_unpacklo_epi8(b, g);
+    __m128i bg_hi = _mm_unpackhi_epi8(b, g);
+    __m128i ra_lo = _mm_unpacklo_epi8(r, alpha);
+    __m128i ra_hi = _mm_unpackhi_epi8(r, alpha);
+    __m128i p[4] = {_mm_unpacklo_epi16(bg_lo, ra_lo),
+                    _mm_unpackhi_epi16(bg_lo, ra_lo),
+                    _mm_unpacklo_epi16(bg_hi, ra_hi),
+                    _mm_unpackhi_epi16(bg_hi, ra_hi)};
+    uint8_t* out = dst + j * num;
+    for (int k = 0; k < 4; k++) {
+      if (num == 4) {
+        storeu(out + k * 16, p[k]);
+      } else {
+        store12(out + k * 12, _mm_shuffle_epi8(p[k], to_hwc3));
+      }
+    }
+  }
+#endif
+  for (; j < w; j += 2) {
+    int _v = uv[j + v_num] - 128;
+    int _u = uv[j + 1 - v_num] - 128;
+    int ra = (179 * _v) >> 7;
+    int ga = (44 * _u + 91 * _v) >> 7;
+    int ba = (227 * _u) >> 7;
+    for (int k = j; k < j + 2 && k < w; k++) {
+      uint8_t* out = dst + k * num;
+      out[0] = clamp_u8(y[k] + ba);
+      out[1] = clamp_u8(y[k] - ga);
+      out[2] = clamp_u8(y[k] + ra);
+      if (num == 4) {
+        out[3] = 255;
+      }
+    }
+  }
+}
+
+/*
+Gray = 0.1140*B + 0.5870*G + 0.2989*R of bgr and bgra,
+0.1140*R + 0.5870*G + 0.2989*B of rgb and rgba, in 7 bits fixed point
+Gray = (15*B + 75*G + 38*R)/128
+*/
+template <int num>
+void to_gray_row(const uint8_t* src, const uint8_t*, uint8_t* dst, int w) {
+  int j = 0;
+#ifdef __SSSE3__
+  const __m128i weights = _mm_setr_epi8(
+      15, 75, 38, 0, 15, 75, 38, 0, 15, 75, 38, 0, 15, 75, 38, 0);
+  const __m128i to_hwc4 =
+      _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+  for (; j + 8 <= w; j += 8) {
+    const uint8_t* in = src + j * num;
+    __m128i px0 = num == 4 ? loadu(in) : _mm_shuffle_epi8(load12(in), to_hwc4);
+    __m128i px1 = num == 4 ? loadu(in + 16)
+                           : _mm_shuffle_epi8(load12(in + 12), to_hwc4);
+    // the sums are at most 128 * 255, no saturation
+    __m128i sum = _mm_hadd_epi16(_mm_maddubs_epi16(px0, weights),
+                                 _mm_maddubs_epi16(px1, weights));
+    sum = _mm_srli_epi16(sum, 7);
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + j),
+                     _mm_packus_epi16(sum, sum));
+  }
+#endif
+  for (; j < w; j++) {
+    const uint8_t* in = src + j * num;
+    dst[j] = (in[0] * 15 + in[1] * 75 + in[2] * 38) >> 7;
+  }
+}
+
+// gray to bgr(rgb), bgra(rgba)
+template <int num>
+void from_gray_row(const uint8_t* src, const uint8_t*, uint8_t* dst, int w) {
+  int j = 0;
+#ifdef __SSSE3__
+  const __m128i alpha = _mm_set1_epi32(static_cast<int>(0xff000000));
+  const __m128i hwc3[3] = {
+      _mm_setr_epi8(0, 0, 0, 1, 1, 1, 2, 2, 2, 3, 3, 3, 4, 4, 4, 5),
+      _mm_setr_epi8(5, 5, 6, 6, 6, 7, 7, 7, 8, 8, 8, 9, 9, 9, 10, 10),
+      _mm_setr_epi8(
+          10, 11, 11, 11, 12, 12, 12, 13, 13, 13, 14, 14, 14, 15, 15, 15)};
+  const __m128i hwc4 =
+      _mm_setr_epi8(0, 0, 0, -1, 1, 1, 1, -1, 2, 2, 2, -1, 3, 3, 3, -1);
+  for (; j + 16 <= w; j += 16) {
+    __m128i gray = loadu(src + j);
+    uint8_t* out = dst + j * num;
+    if (num == 3) {
+      for (int k = 0; k < 3; k++) {
+        storeu(out + k * 16, _mm_shuffle_epi8(gray, hwc3[k]));
+      }
+    } else {
+      for (int k = 0; k < 4; k++) {
+        __m128i px = _mm_shuffle_epi8(gray, hwc4);
+        storeu(out + k * 16, _mm_or_si128(px, alpha));
+        gray = _mm_srli_si128(gray, 4);
+      }
+    }
+  }
+#endif
+  for (; j < w; j++) {
+    uint8_t* out = dst + j * num;
+    out[0] = src[j];
+    out[1] = src[j];
+    out[2] = src[j];
+    if (num == 4) {
+      out[3] = 255;
+    }
+  }
+}
+
+/*
+the transforms between bgr(rgb) and bgra(rgba) with or without exchanging
+the r and b channels, the alpha is dropped or set to 255
+*/
+template <int num_in, int num_out, bool trans>
+void hwc_trans_row(const uint8_t* src, const uint8_t*, uint8_t* dst, int w) {
+  int j = 0;
+#ifdef __SSSE3__
+  const int b = trans ? 2 : 0;
+  const int r = trans ? 0 : 2;
+  uint8_t index[16];
+  for (int k = 0; k < 4; k++) {
+    index[k * num_out + 0] = k * num_in + b;
+    index[k * num_out + 1] = k * num_in + 1;
+    index[k * num_out + 2] = k * num_in + r;
+    if (num_out == 4) {
+      // keep the alpha of hwc4, or zero it for 255 to be added
+      index[k * num_out + 3] = num_in == 4 ? k * 4 + 3 : 0x80;
+    }
+  }
+  if (num_out == 3) {
+    memset(index + 12, 0x80, 4);
+  }
+  const __m128i shuffle =
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(index));
+  const __m128i alpha = num_in == 3 && num_out == 4
+                            ? _mm_set1_epi32(static_cast<int>(0xff000000))
+                            : _mm_setzero_si128();
+  for (; j + 4 <= w; j += 4) {
+    const uint8_t* in = src + j * num_in;
+    __m128i px = num_in == 4 ? loadu(in) : load12(in);
+    px = _mm_or_si128(_mm_shuffle_epi8(px, shuffle), alpha);
+    if (num_out == 4) {
+      storeu(dst + j * 4, px);
+    } else {
+      store12(dst + j * 3, px);
+    }
+  }
+#endif
+  for (; j < w; j++) {
+    const uint8_t* in = src + j * num_in;
+    uint8_t* out = dst + j * num_out;
+    out[0] = in[trans ? 2 : 0];
+    out[1] = in[1];
+    out[2] = in[trans ? 0 : 2];
+    if (num_out == 4) {
+      out[3] = num_in == 4 ? in[3] : 255;
+    }
+  }
+}
+
+convert_row_func choose_convert_row(ImageFormat srcFormat,
+                                    ImageFormat dstFormat) {
+  bool to_hwc3 = dstFormat == BGR || dstFormat == RGB;
+  bool to_hwc4 = dstFormat == BGRA || dstFormat == RGBA;
+  // the same channel order of bgr and bgra, or rgb and rgba
+  bool same_order = (srcFormat == BGR || srcFormat == BGRA) ==
+                    (dstFormat == BGR || dstFormat == BGRA);
+  // nv12 and nv21 are converted to the bgr order for rgb(a) too, as arm does
+  if (srcFormat == NV12 && to_hwc3) return nv_to_bgr_row<1, 3>;
+  if (srcFormat == NV21 && to_hwc3) return nv_to_bgr_row<0, 3>;
+  if (srcFormat == NV12 && to_hwc4) return nv_to_bgr_row<1, 4>;
+  if (srcFormat == NV21 && to_hwc4) return nv_to_bgr_row<0, 4>;
+  if (srcFormat == GRAY && to_hwc3) return from_gray_row<3>;
+  if (srcFormat == GRAY && to_hwc4) return from_gray_row<4>;
+  if (srcFormat == BGR || srcFormat == RGB) {
+    if (dstFormat == GRAY) return to_gray_row<3>;
+    if (to_hwc3) return same_order ? nullptr : hwc_trans_row<3, 3, true>;
+    if (to_hwc4) {
+      return same_order ? hwc_trans_row<3, 4, false>
+                        : hwc_trans_row<3, 4, true>;
+    }
+  }
+  if (srcFormat == BGRA || srcFormat == RGBA) {
+    if (dstFormat == GRAY) return to_gray_row<4>;
+    if (to_hwc4) return same_order ? nullptr : hwc_trans_row<4, 4, true>;
+    if (to_hwc3) {
+      return same_order ? hwc_trans_row<4, 3, false>
+                        : hwc_trans_row<4, 3, true>;
+    }
+  }
+  return nullptr;
+}
+
+int pixel_bytes(ImageFormat format) {
+  if (format == BGR || format == RGB) {
+    return 3;
+  } else if (format == BGRA || format == RGBA) {
+    return 4;
+  }
+  return 1;
+}
+
+void ImageConvert::choose(const uint8_t* src,
+                          uint8_t* dst,
+                          ImageFormat srcFormat,
+                          ImageFormat dstFormat,
+                          int srcw,
+                          int srch) {
+  if (srcFormat == dstFormat) {
+    // copy
+    int size = srcw * srch * pixel_bytes(srcFormat);
+    if (srcFormat == NV12 || srcFormat == NV21) {
+      size = srcw * (ceil(1.5 * srch));
+    }
+    memcpy(dst, src, sizeof(uint8_t) * size);
+    return;
+  }
+  convert_row_func row = choose_convert_row(srcFormat, dstFormat);
+  if (row == nullptr) {
+    printf("srcFormat: %d, dstFormat: %d does not support! \n",
+           srcFormat,
+           dstFormat);
+    return;
+  }
+  int w_in = srcw * pixel_bytes(srcFormat);
+  int w_out = srcw * pixel_bytes(dstFormat);
+  const uint8_t* uv = src + srcw * srch;
+#pragma omp parallel for
+  for (int i = 0; i < srch; i++) {
+    row(src + i * w_in, uv + (i / 2) * srcw, dst + i * w_out, srcw);
+  }
+}
+
+}  // namespace cv
+}  // namespace utils
+}  // namespace lite
+}  // namespace paddle
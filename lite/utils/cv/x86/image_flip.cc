@@ -0,0 +1,107 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/utils/cv/image_flip.h"
+#include <string.h>
+namespace paddle {
+namespace lite {
+namespace utils {
+namespace cv {
+void ImageFlip::choose(const uint8_t* src,
+                       uint8_t* dst,
+                       ImageFormat srcFormat,
+                       int srcw,
+                       int srch,
+                       FlipParam flip_param) {
+  if (srcFormat == GRAY) {
+    flip_hwc1(src, dst, srcw, srch, flip_param);
+  } else if (srcFormat == BGR || srcFormat == RGB) {
+    flip_hwc3(src, dst, srcw, srch, flip_param);
+  } else if (srcFormat == BGRA || srcFormat == RGBA) {
+    flip_hwc4(src, dst, srcw, srch, flip_param);
+  } else {
+    printf("this srcFormat: %d does not support! \n", srcFormat);
+    return;
+  }
+}
+
+// mirror a row of w_in pixels of num channels, the channels keep their order
+template <int num>
+void mirror_row(const uint8_t* src, uint8_t* dst, int w_in) {
+  const uint8_t* in = src + (w_in - 1) * num;
+  for (int i = 0; i < w_in; i++) {
+    for (int c = 0; c < num; c++) {
+      dst[c] = in[c];
+    }
+    dst += num;
+    in -= num;
+  }
+}
+
+/*
+flip X: the rows are upside down
+flip Y: every row is mirrored
+flip XY: both
+*/
+template <int num>
+void flip_hwc(const uint8_t* src,
+              uint8_t* dst,
+              int srcw,
+              int srch,
+              FlipParam flip_param) {
+  if (flip_param != X && flip_param != Y && flip_param != XY) {
+    printf("its doesn't support Flip: %d \n", static_cast<int>(flip_param));
+    return;
+  }
+  int w = srcw * num;
+#pragma omp parallel for
+  for (int i = 0; i < srch; i++) {
+    const uint8_t* in = src + i * w;
+    uint8_t* out = dst + (flip_param == Y ? i : srch - 1 - i) * w;
+    if (flip_param == X) {
+      memcpy(out, in, w);
+    } else {
+      mirror_row<num>(in, out, srcw);
+    }
+  }
+}
+
+void flip_hwc1(const uint8_t* src,
+               uint8_t* dst,
+               int srcw,
+               int srch,
+               FlipParam flip_param) {
+  flip_hwc<1>(src, dst, srcw, srch, flip_param);
+}
+
+void flip_hwc3(const uint8_t* src,
+               uint8_t* dst,
+               int srcw,
+               int srch,
+               FlipParam flip_param) {
+  flip_hwc<3>(src, dst, srcw, srch, flip_param);
+}
+
+void flip_hwc4(const uint8_t* src,
+               uint8_t* dst,
+               int srcw,
+               int srch,
+               FlipParam flip_param) {
+  flip_hwc<4>(src, dst, srcw, srch, flip_param);
+}
+
+}  // namespace cv
+}  // namespace utils
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,120 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/utils/cv/image_fuse.h"
+#include <algorithm>
+#include <vector>
+#include "lite/utils/cv/x86/image_rows.h"
+namespace paddle {
+namespace lite {
+namespace utils {
+namespace cv {
+/*
+ * the output rows are computed by the bands, a band converts only the input
+ * rows it needs into a row buffer, resizes them with two cached rows and
+ * normalizes every output row into the tensor at once, no intermediate image
+ * is written
+ */
+void ImageFuse::choose(const uint8_t* src,
+                       Tensor* dst,
+                       ImageFormat srcFormat,
+                       ImageFormat dstFormat,
+                       LayoutType layout,
+                       int srcw,
+                       int srch,
+                       int dstw,
+                       int dsth,
+                       float* means,
+                       float* scales) {
+  if ((layout != LayoutType::kNCHW && layout != LayoutType::kNHWC) ||
+      dstFormat == NV12 || dstFormat == NV21) {
+    printf("this layout: %d or image format: %d not support \n",
+           static_cast<int>(layout),
+           dstFormat);
+    return;
+  }
+  convert_row_func convert = nullptr;
+  if (srcFormat != dstFormat) {
+    convert = choose_convert_row(srcFormat, dstFormat);
+    if (convert == nullptr) {
+      printf("srcFormat: %d, dstFormat: %d does not support! \n",
+             srcFormat,
+             dstFormat);
+      return;
+    }
+  }
+  float* output = dst->mutable_data<float>();
+  int w_in = srcw * pixel_bytes(srcFormat);
+  int num = pixel_bytes(dstFormat);
+  int channels = num == 1 ? 1 : 3;
+  int64_t plane = static_cast<int64_t>(dstw) * dsth;
+  const uint8_t* uv = src + srcw * srch;
+  auto normalize = [&](int dy, const uint8_t* row) {
+    if (layout == LayoutType::kNCHW) {
+      normalize_row_chw(
+          row, output + dy * dstw, dstw, num, channels, plane, means, scales);
+    } else {
+      normalize_row_hwc(row,
+                        output + dy * dstw * channels,
+                        dstw,
+                        num,
+                        channels,
+                        means,
+                        scales);
+    }
+  };
+  bool resize = srcw != dstw || srch != dsth;
+  // the same scales as arm
+  BilinearRows resizer(srcw,
+                       srch,
+                       resize ? dstw : 1,
+                       resize ? dsth : 1,
+                       num,
+                       static_cast<double>(srcw / dstw),
+                       static_cast<double>(srch / dsth));
+  int bands = (dsth + kBandRows - 1) / kBandRows;
+#pragma omp parallel for
+  for (int i = 0; i < bands; i++) {
+    int begin = i * kBandRows;
+    int end = std::min(dsth, begin + kBandRows);
+    std::vector<uint8_t> converted(convert ? srcw * num : 0);
+    auto get_row = [&](int sy) -> const uint8_t* {
+      if (!convert) {
+        return src + sy * w_in;
+      }
+      convert(src + sy * w_in,
+              uv + (sy / 2) * srcw,
+              converted.data(),
+              srcw);
+      return converted.data();
+    };
+    if (!resize) {
+      for (int dy = begin; dy < end; dy++) {
+        normalize(dy, get_row(dy));
+      }
+      continue;
+    }
+    std::vector<uint8_t> resized(dstw * num);
+    resizer.Run(begin,
+                end,
+                get_row,
+                [&](int) { return resized.data(); },
+                normalize);
+  }
+}
+
+}  // namespace cv
+}  // namespace utils
+}  // namespace lite
+}  // namespace paddle
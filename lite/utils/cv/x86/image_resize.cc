@@ -0,0 +1,264 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/utils/cv/image_resize.h"
+#include <limits.h>
+#include <math.h>
+#include <string.h>
+#ifdef __SSE2__
+#include <immintrin.h>
+#endif
+#include <algorithm>
+#include "lite/backends/x86/cpu_info.h"
+#include "lite/utils/cv/x86/image_rows.h"
+#include "lite/utils/cv/x86/image_rows_simd.h"
+namespace paddle {
+namespace lite {
+namespace utils {
+namespace cv {
+void ImageResize::choose(const uint8_t* src,
+                         uint8_t* dst,
+                         ImageFormat srcFormat,
+                         int srcw,
+                         int srch,
+                         int dstw,
+                         int dsth) {
+  resize(src, dst, srcFormat, srcw, srch, dstw, dsth);
+}
+
+// resize a plane of num channels by the bands of the output rows
+void resize_plane(const uint8_t* src,
+                  uint8_t* dst,
+                  int srcw,
+                  int srch,
+                  int dstw,
+                  int dsth,
+                  int num,
+                  double scale_x,
+                  double scale_y) {
+  BilinearRows resizer(srcw, srch, dstw, dsth, num, scale_x, scale_y);
+  int w_in = srcw * num;
+  int w_out = dstw * num;
+  int bands = (dsth + kBandRows - 1) / kBandRows;
+#pragma omp parallel for
+  for (int i = 0; i < bands; i++) {
+    resizer.Run(i * kBandRows,
+                std::min(dsth, (i + 1) * kBandRows),
+                [&](int sy) { return src + sy * w_in; },
+                [&](int dy) { return dst + dy * w_out; },
+                [](int, uint8_t*) {});
+  }
+}
+
+// use bilinear method to resize
+void resize(const uint8_t* src,
+            uint8_t* dst,
+            ImageFormat srcFormat,
+            int srcw,
+            int srch,
+            int dstw,
+            int dsth) {
+  int size = srcw * srch;
+  if (srcw == dstw && srch == dsth) {
+    if (srcFormat == NV12 || srcFormat == NV21) {
+      size = srcw * (floor(1.5 * srch));
+    } else {
+      size *= pixel_bytes(srcFormat);
+    }
+    memcpy(dst, src, sizeof(uint8_t) * size);
+    return;
+  }
+  // the same scales as arm
+  double scale_x = static_cast<double>(srcw / dstw);
+  double scale_y = static_cast<double>(srch / dsth);
+  resize_plane(src,
+               dst,
+               srcw,
+               srch,
+               dstw,
+               dsth,
+               pixel_bytes(srcFormat),
+               scale_x,
+               scale_y);
+  if (srcFormat == NV12 || srcFormat == NV21) {
+    // the uv plane is resized as an image of two channels
+    resize_plane(src + srcw * srch,
+                 dst + dstw * dsth,
+                 srcw / 2,
+                 srch / 2,
+                 dstw / 2,
+                 dsth / 2,
+                 2,
+                 scale_x,
+                 scale_y);
+  }
+}
+
+// compute xofs, yofs, alpha, beta
+void compute_xy(int srcw,
+                int srch,
+                int dstw,
+                int dsth,
+                double scale_x,
+                double scale_y,
+                int* xofs,
+                int* yofs,
+                int16_t* ialpha,
+                int16_t* ibeta) {
+  float fy = 0.f;
+  float fx = 0.f;
+  int sy = 0;
+  int sx = 0;
+  const int resize_coef_bits = 11;
+  const int resize_coef_scale = 1 << resize_coef_bits;
+#define SATURATE_CAST_SHORT(X)                                               \
+  (int16_t)::std::min(                                                       \
+      ::std::max(static_cast<int>(X + (X >= 0.f ? 0.5f : -0.5f)), SHRT_MIN), \
+      SHRT_MAX);
+
+  for (int dx = 0; dx < dstw; dx++) {
+    fx = static_cast<float>((dx + 0.5) * scale_x - 0.5);
+    sx = floor(fx);
+    fx -= sx;
+
+    if (sx < 0) {
+      sx = 0;
+      fx = 0.f;
+    }
+    if (sx >= srcw - 1) {
+      sx = srcw - 2;
+      fx = 1.f;
+    }
+
+    xofs[dx] = sx;
+
+    float a0 = (1.f - fx) * resize_coef_scale;
+    float a1 = fx * resize_coef_scale;
+
+    ialpha[dx * 2] = SATURATE_CAST_SHORT(a0);
+    ialpha[dx * 2 + 1] = SATURATE_CAST_SHORT(a1);
+  }
+  for (int dy = 0; dy < dsth; dy++) {
+    fy = static_cast<float>((dy + 0.5) * scale_y - 0.5);
+    sy = floor(fy);
+    fy -= sy;
+
+    if (sy < 0) {
+      sy = 0;
+      fy = 0.f;
+    }
+    if (sy >= srch - 1) {
+      sy = srch - 2;
+      fy = 1.f;
+    }
+
+    yofs[dy] = sy;
+
+    float b0 = (1.f - fy) * resize_coef_scale;
+    float b1 = fy * resize_coef_scale;
+
+    ibeta[dy * 2] = SATURATE_CAST_SHORT(b0);
+    ibeta[dy * 2 + 1] = SATURATE_CAST_SHORT(b1);
+  }
+#undef SATURATE_CAST_SHORT
+}
+
+template <int num>
+void hresize_row(const uint8_t* src,
+                 int16_t* dst,
+                 const int* xofs,
+                 const int16_t* ialpha,
+                 int dstw) {
+  for (int dx = 0; dx < dstw; dx++) {
+    int sx = xofs[dx] * num;
+    int16_t a0 = ialpha[dx * 2];
+    int16_t a1 = ialpha[dx * 2 + 1];
+    if (sx < 0) {
+      // the input of a single column
+      for (int i = 0; i < num; i++) {
+        *dst++ = (src[i] * a1) >> 4;
+      }
+    } else {
+      const uint8_t* sl = src + sx;
+      const uint8_t* sr = sl + num;
+      for (int i = 0; i < num; i++) {
+        *dst++ = (sl[i] * a0 + sr[i] * a1) >> 4;
+      }
+    }
+  }
+}
+
+void hresize_row(const uint8_t* src,
+                 int16_t* dst,
+                 const int* xofs,
+                 const int16_t* ialpha,
+                 int dstw,
+                 int num) {
+  switch (num) {
+    case 1:
+      hresize_row<1>(src, dst, xofs, ialpha, dstw);
+      break;
+    case 2:
+      hresize_row<2>(src, dst, xofs, ialpha, dstw);
+      break;
+    case 3:
+      hresize_row<3>(src, dst, xofs, ialpha, dstw);
+      break;
+    default:
+      hresize_row<4>(src, dst, xofs, ialpha, dstw);
+      break;
+  }
+}
+
+// D[x] = (rows0[x]*b0 + rows1[x]*b1) >> INTER_RESIZE_COEF_BITS, rounded the
+// same way as arm
+void vresize_row(const int16_t* rows0,
+                 const int16_t* rows1,
+                 uint8_t* dst,
+                 int16_t b0,
+                 int16_t b1,
+                 int width) {
+  int i = 0;
+#ifdef LITE_CV_WITH_AVX2
+  static const bool avx2 = lite::x86::MayIUse(lite::x86::avx2);
+  if (avx2) {
+    i = vresize_row_avx2(rows0, rows1, dst, b0, b1, width);
+  }
+#endif
+#ifdef __SSE2__
+  const __m128i vb0_4 = _mm_set1_epi16(b0);
+  const __m128i vb1_4 = _mm_set1_epi16(b1);
+  const __m128i v2_4 = _mm_set1_epi16(2);
+  for (; i + 8 <= width; i += 8) {
+    __m128i r0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows0 + i));
+    __m128i r1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows1 + i));
+    __m128i sum = _mm_add_epi16(
+        _mm_add_epi16(_mm_mulhi_epi16(r0, vb0_4), _mm_mulhi_epi16(r1, vb1_4)),
+        v2_4);
+    sum = _mm_srai_epi16(sum, 2);
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + i),
+                     _mm_packus_epi16(sum, sum));
+  }
+#endif
+  for (; i < width; i++) {
+    int sum = (((b0 * rows0[i]) >> 16) + ((b1 * rows1[i]) >> 16) + 2) >> 2;
+    // saturated as the vectorized ones
+    dst[i] = std::min(std::max(sum, 0), 255);
+  }
+}
+
+}  // namespace cv
+}  // namespace utils
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,114 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/utils/cv/image_rotate.h"
+#include <string.h>
+#include <algorithm>
+namespace paddle {
+namespace lite {
+namespace utils {
+namespace cv {
+void ImageRotate::choose(const uint8_t* src,
+                         uint8_t* dst,
+                         ImageFormat srcFormat,
+                         int srcw,
+                         int srch,
+                         float degree) {
+  if (degree != 90 && degree != 180 && degree != 270) {
+    printf("this degree: %f not support \n", degree);
+  }
+  if (srcFormat == GRAY) {
+    rotate_hwc1(src, dst, srcw, srch, degree);
+  } else if (srcFormat == BGR || srcFormat == RGB) {
+    rotate_hwc3(src, dst, srcw, srch, degree);
+  } else if (srcFormat == BGRA || srcFormat == RGBA) {
+    rotate_hwc4(src, dst, srcw, srch, degree);
+  } else {
+    printf("this srcFormat: %d does not support! \n", srcFormat);
+    return;
+  }
+}
+
+/*
+rotate clockwise, the output of 90 and 270 is srch wide and srcw high
+90: out(y, srch - 1 - x) = in(x, y)
+270: out(srcw - 1 - y, x) = in(x, y)
+the pixels are moved by the tiles, so both the reads and the writes stay in
+a few cache lines
+*/
+template <int num>
+void rotate_hwc(
+    const uint8_t* src, uint8_t* dst, int srcw, int srch, float degree) {
+  const int tile = 64;
+  int win = srcw * num;
+  if (degree == 180) {
+#pragma omp parallel for
+    for (int x = 0; x < srch; x++) {
+      const uint8_t* in = src + x * win;
+      uint8_t* out = dst + (srch - 1 - x) * win + (srcw - 1) * num;
+      for (int y = 0; y < srcw; y++) {
+        for (int c = 0; c < num; c++) {
+          out[c] = in[c];
+        }
+        in += num;
+        out -= num;
+      }
+    }
+    return;
+  }
+  if (degree != 90 && degree != 270) {
+    printf("this degree: %f does not support! \n", degree);
+    return;
+  }
+  int wout = srch * num;
+  int tiles = (srch + tile - 1) / tile;
+#pragma omp parallel for
+  for (int t = 0; t < tiles; t++) {
+    int x_end = std::min(srch, (t + 1) * tile);
+    for (int y0 = 0; y0 < srcw; y0 += tile) {
+      int y_end = std::min(srcw, y0 + tile);
+      for (int x = t * tile; x < x_end; x++) {
+        const uint8_t* in = src + x * win;
+        for (int y = y0; y < y_end; y++) {
+          uint8_t* out = degree == 90
+                             ? dst + y * wout + (srch - 1 - x) * num
+                             : dst + (srcw - 1 - y) * wout + x * num;
+          for (int c = 0; c < num; c++) {
+            out[c] = in[y * num + c];
+          }
+        }
+      }
+    }
+  }
+}
+
+void rotate_hwc1(
+    const uint8_t* src, uint8_t* dst, int srcw, int srch, float degree) {
+  rotate_hwc<1>(src, dst, srcw, srch, degree);
+}
+
+void rotate_hwc3(
+    const uint8_t* src, uint8_t* dst, int srcw, int srch, float degree) {
+  rotate_hwc<3>(src, dst, srcw, srch, degree);
+}
+
+void rotate_hwc4(
+    const uint8_t* src, uint8_t* dst, int srcw, int srch, float degree) {
+  rotate_hwc<4>(src, dst, srcw, srch, degree);
+}
+
+}  // namespace cv
+}  // namespace utils
+}  // namespace lite
+}  // namespace paddle
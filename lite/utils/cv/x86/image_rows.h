@@ -0,0 +1,190 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+#include <algorithm>
+#include <vector>
+#include "lite/utils/cv/paddle_image_preprocess.h"
+namespace paddle {
+namespace lite {
+namespace utils {
+namespace cv {
+/*
+ * The row kernels of the x86 image preprocess, both the whole image
+ * transforms and the fused ImageFuse are built on them, so they compute
+ * exactly the same results. The fixed point arithmetics follow the arm
+ * implementations, the outputs are the same on both platforms.
+ */
+
+// convert a row of width pixels, uv is the row of the interleaved chroma of
+// NV12/NV21, it is unused by the other formats
+typedef void (*convert_row_func)(const uint8_t* src,
+                                 const uint8_t* uv,
+                                 uint8_t* dst,
+                                 int width);
+// return nullptr if the conversion is not supported
+convert_row_func choose_convert_row(ImageFormat srcFormat,
+                                    ImageFormat dstFormat);
+
+// the number of the bytes of a pixel, 1 for the Y plane of NV12/NV21
+int pixel_bytes(ImageFormat format);
+
+/*
+ * write (x - means[c]) * scales[c] of the first channels of a row of width
+ * pixels of num channels
+ * normalize_row_chw writes the channel c to dst + c * plane, and
+ * normalize_row_hwc writes them interleaved
+ */
+void normalize_row_chw(const uint8_t* src,
+                       float* dst,
+                       int width,
+                       int num,
+                       int channels,
+                       int64_t plane,
+                       const float* means,
+                       const float* scales);
+void normalize_row_hwc(const uint8_t* src,
+                       float* dst,
+                       int width,
+                       int num,
+                       int channels,
+                       const float* means,
+                       const float* scales);
+
+// compute xofs, yofs and the 11 bits fixed point alpha, beta
+void compute_xy(int srcw,
+                int srch,
+                int dstw,
+                int dsth,
+                double scale_x,
+                double scale_y,
+                int* xofs,
+                int* yofs,
+                int16_t* ialpha,
+                int16_t* ibeta);
+// horizontal pass of a row of num channels to 15 bits
+void hresize_row(const uint8_t* src,
+                 int16_t* dst,
+                 const int* xofs,
+                 const int16_t* ialpha,
+                 int dstw,
+                 int num);
+// vertical pass of two horizontally resized rows of width values
+void vresize_row(const int16_t* rows0,
+                 const int16_t* rows1,
+                 uint8_t* dst,
+                 int16_t b0,
+                 int16_t b1,
+                 int width);
+
+/*
+ * Bilinear resize by rows, a range of the output rows is computed from the
+ * two cached horizontally resized input rows, and an input row is fetched and
+ * resized only once when the output rows move down, so the input rows can be
+ * produced on the fly, e.g. color converted.
+ */
+class BilinearRows {
+ public:
+  BilinearRows(int srcw,
+               int srch,
+               int dstw,
+               int dsth,
+               int num,
+               double scale_x,
+               double scale_y)
+      : dstw_(dstw),
+        num_(num),
+        xofs_(dstw),
+        yofs_(dsth),
+        ialpha_(dstw * 2),
+        ibeta_(dsth * 2) {
+    compute_xy(srcw,
+               srch,
+               dstw,
+               dsth,
+               scale_x,
+               scale_y,
+               xofs_.data(),
+               yofs_.data(),
+               ialpha_.data(),
+               ibeta_.data());
+  }
+
+  /*
+   * compute the output rows [begin, end)
+   * get_row(sy) returns the input row sy, it is read before the next call
+   * dst_row(dy) returns where to write the output row dy
+   * put_row(dy, row) is called when the output row dy is written
+   */
+  template <typename GetRow, typename DstRow, typename PutRow>
+  void Run(int begin,
+           int end,
+           GetRow get_row,
+           DstRow dst_row,
+           PutRow put_row) const {
+    int w_out = dstw_ * num_;
+    std::vector<int16_t> rowsbuf(w_out * 2);
+    int16_t* rows0 = rowsbuf.data();
+    int16_t* rows1 = rows0 + w_out;
+    // the input row of rows0, sy is -1 for the input of a single row
+    int prev_sy = -2;
+    for (int dy = begin; dy < end; dy++) {
+      int sy = yofs_[dy];
+      if (sy != prev_sy) {
+        if (sy == prev_sy + 1) {
+          std::swap(rows0, rows1);
+        } else if (sy < 0) {
+          memset(rows0, 0, sizeof(int16_t) * w_out);
+        } else {
+          hresize_row(get_row(sy),
+                      rows0,
+                      xofs_.data(),
+                      ialpha_.data(),
+                      dstw_,
+                      num_);
+        }
+        hresize_row(get_row(sy + 1),
+                    rows1,
+                    xofs_.data(),
+                    ialpha_.data(),
+                    dstw_,
+                    num_);
+        prev_sy = sy;
+      }
+      uint8_t* dst = dst_row(dy);
+      vresize_row(
+          rows0, rows1, dst, ibeta_[dy * 2], ibeta_[dy * 2 + 1], w_out);
+      put_row(dy, dst);
+    }
+  }
+
+ private:
+  int dstw_;
+  int num_;
+  std::vector<int> xofs_;
+  std::vector<int> yofs_;
+  std::vector<int16_t> ialpha_;
+  std::vector<int16_t> ibeta_;
+};
+
+// the output rows are computed by the bands of rows in parallel
+const int kBandRows = 16;
+
+}  // namespace cv
+}  // namespace utils
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,81 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <immintrin.h>
+#include "lite/utils/cv/x86/image_rows_simd.h"
+namespace paddle {
+namespace lite {
+namespace utils {
+namespace cv {
+
+int normalize_row_chw_avx2(const uint8_t* src,
+                           float* dst,
+                           int width,
+                           int num,
+                           int channels,
+                           int64_t plane,
+                           const float* means,
+                           const float* scales) {
+  int i = 0;
+  for (; i + 8 <= width; i += 8) {
+    __m128i px0 = load_planar4(src + i * num, num);
+    __m128i px1 = load_planar4(src + (i + 4) * num, num);
+    for (int c = 0; c < channels; c++) {
+      __m128i v = _mm_unpacklo_epi32(px0, px1);
+      __m256 x = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(v));
+      x = _mm256_mul_ps(_mm256_sub_ps(x, _mm256_set1_ps(means[c])),
+                        _mm256_set1_ps(scales[c]));
+      _mm256_storeu_ps(dst + c * plane + i, x);
+      px0 = _mm_srli_si128(px0, 4);
+      px1 = _mm_srli_si128(px1, 4);
+    }
+  }
+  return i;
+}
+
+int vresize_row_avx2(const int16_t* rows0,
+                     const int16_t* rows1,
+                     uint8_t* dst,
+                     int16_t b0,
+                     int16_t b1,
+                     int width) {
+  const __m256i vb0 = _mm256_set1_epi16(b0);
+  const __m256i vb1 = _mm256_set1_epi16(b1);
+  const __m256i v2 = _mm256_set1_epi16(2);
+  int i = 0;
+  for (; i + 32 <= width; i += 32) {
+    __m256i sum[2];
+    for (int k = 0; k < 2; k++) {
+      __m256i r0 = _mm256_loadu_si256(
+          reinterpret_cast<const __m256i*>(rows0 + i + k * 16));
+      __m256i r1 = _mm256_loadu_si256(
+          reinterpret_cast<const __m256i*>(rows1 + i + k * 16));
+      sum[k] = _mm256_add_epi16(_mm256_add_epi16(_mm256_mulhi_epi16(r0, vb0),
+                                                 _mm256_mulhi_epi16(r1, vb1)),
+                                v2);
+      sum[k] = _mm256_srai_epi16(sum[k], 2);
+    }
+    // packus works in the 128 bits lanes, restore the order
+    __m256i out = _mm256_permute4x64_epi64(
+        _mm256_packus_epi16(sum[0], sum[1]), _MM_SHUFFLE(3, 1, 2, 0));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), out);
+  }
+  return i;
+}
+
+}  // namespace cv
+}  // namespace utils
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,82 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+#ifdef __SSE4_1__
+#include <immintrin.h>
+#endif
+namespace paddle {
+namespace lite {
+namespace utils {
+namespace cv {
+/*
+ * The vectorized row kernels shared by the translation units built with the
+ * flags of their ISA. The AVX2 ones are only called if MayIUse(avx2) reports
+ * it, so this header is kept free of the inline functions of other headers,
+ * whose ISA specific copies could be picked by the linker.
+ */
+
+#ifdef __SSE4_1__
+// 4 pixels of num channels, 4 bytes per channel: c0 c0 c0 c0 c1 c1 c1 c1 ...
+static inline __m128i load_planar4(const uint8_t* src, int num) {
+  if (num == 1) {
+    int32_t v;
+    memcpy(&v, src, 4);
+    return _mm_cvtsi32_si128(v);
+  }
+  const __m128i hwc3 =
+      _mm_setr_epi8(0, 3, 6, 9, 1, 4, 7, 10, 2, 5, 8, 11, -1, -1, -1, -1);
+  const __m128i hwc4 =
+      _mm_setr_epi8(0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15);
+  if (num == 3) {
+    int32_t hi;
+    memcpy(&hi, src + 8, 4);
+    __m128i v = _mm_unpacklo_epi64(
+        _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src)),
+        _mm_cvtsi32_si128(hi));
+    return _mm_shuffle_epi8(v, hwc3);
+  }
+  return _mm_shuffle_epi8(
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(src)), hwc4);
+}
+#endif
+
+/*
+ * Built with AVX2_FLAG in image_rows_avx2.cc if LITE_CV_WITH_AVX2, they
+ * compute the leading values of a row by whole vectors exactly as
+ * normalize_row_chw and vresize_row do, and return the number of them.
+ */
+int normalize_row_chw_avx2(const uint8_t* src,
+                           float* dst,
+                           int width,
+                           int num,
+                           int channels,
+                           int64_t plane,
+                           const float* means,
+                           const float* scales);
+int vresize_row_avx2(const int16_t* rows0,
+                     const int16_t* rows1,
+                     uint8_t* dst,
+                     int16_t b0,
+                     int16_t b1,
+                     int width);
+
+}  // namespace cv
+}  // namespace utils
+}  // namespace lite
+}  // namespace paddle